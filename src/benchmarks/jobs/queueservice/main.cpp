@@ -10,6 +10,7 @@
 */
 #include <yuni/yuni.h>
 #include <yuni/job/queue/service.h>
+#include <yuni/job/scratch.h>
 #include <yuni/thread/utility.h>
 #include <yuni/core/logs.h>
 
@@ -20,11 +21,41 @@ using namespace Yuni;
 static Yuni::Logs::Logger<>  logs;
 
 
+//! Do some calculations just for fun, with a temporary list
+template<class ListT>
+static void Calculations()
+{
+	ListT list;
+	list.resize(1000);
+	for (uint z = 0; z != (uint) list.size(); ++z)
+		list[z] = z;
+
+	uint64 sum = 0;
+	for (uint z = 0; z != (uint) list.size(); ++z)
+		sum += list[z];
+}
+
 
 
-int main()
+
+int main(int argc, char** argv)
 {
 	Job::QueueService queueservice;
+	bool scratch = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		AnyString arg = argv[i];
+		if (arg == "--work-stealing")
+		{
+			logs.info() << "scheduling: work-stealing";
+			queueservice.scheduling(Job::QueueService::Scheduling::workStealing);
+		}
+		else if (arg == "--scratch")
+		{
+			logs.info() << "temporary allocations: scratch arena";
+			scratch = true;
+		}
+	}
 
 	Mutex mutexCounter;
 	uint howMany = 0;
@@ -37,17 +68,10 @@ int main()
 	{
 		async(queueservice, [&, i]()
 		{
-			// do some calculations just for fun
-			{
-				std::vector<uint> list;
-				list.resize(1000);
-				for (uint z = 0; z != (uint) list.size(); ++z)
-					list[z] = z;
-
-				uint64 sum = 0;
-				for (uint z = 0; z != (uint) list.size(); ++z)
-					sum += list[z];
-			}
+			if (scratch)
+				Calculations<Job::ScratchVector<uint>>();
+			else
+				Calculations<std::vector<uint>>();
 
 			// ahah ! wanna stop just for fun ?
 			if (false and i == 10000)
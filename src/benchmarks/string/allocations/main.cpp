@@ -0,0 +1,184 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include <yuni/core/dictionary.h>
+#include <yuni/core/logs.h>
+#ifdef YUNI_MODULE_MARSHAL
+#include <yuni/marshal/object.h>
+#endif
+#include <chrono>
+#include <vector>
+#include <stdlib.h>
+
+using namespace Yuni;
+
+
+
+static Yuni::Logs::Logger<>  logs;
+
+//! Number of requests per measure
+static const uint requestCount = 100000;
+
+//! Number of calls to malloc(), calloc() and realloc() (without pointer)
+static uint64 allocations = 0;
+//! Number of calls to realloc() on an existing block
+static uint64 reallocations = 0;
+
+
+#ifdef __GLIBC__
+// Counting the allocations, by interposing the allocator of glibc
+// (operator new relies on malloc() as well)
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+
+extern "C" void* malloc(size_t size)
+{
+	++allocations;
+	return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+	++allocations;
+	return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size)
+{
+	if (pointer)
+		++reallocations;
+	else
+		++allocations;
+	return __libc_realloc(pointer, size);
+}
+#endif
+
+
+
+
+/*!
+** \brief Fill the parameters of a request from its query string
+**
+** Same as the REST transport of the messaging module: only the parameters
+** declared by the method are updated.
+*/
+static void DecodeURLQuery(KeyValueStore& params, const AnyString& query)
+{
+	String key;
+	uint offset = 0;
+	uint start = 0;
+	AnyString value;
+	do
+	{
+		offset = query.find_first_of("=&", offset);
+		if (offset >= query.size())
+			break;
+		if (query[offset] == '=')
+		{
+			key.assign(query, offset - start, start);
+			++offset;
+			uint ampersand = query.find('&', offset);
+			if (ampersand >= query.size())
+				ampersand = query.size();
+			value.adapt(query, ampersand - offset, offset);
+
+			KeyValueStore::iterator i = params.find(key);
+			if (i != params.end())
+				i->second = value;
+			offset = ampersand;
+		}
+		start = ++offset;
+	}
+	while (true);
+}
+
+
+/*!
+** \brief A request to the method `sum` of the messaging sample (simple REST server)
+**
+** The parameters are copied from the defaults of the method then read from the
+** url, the response is exported as JSON (by hand without the marshal module),
+** and a few columns are read as strings, as the DBI module would do.
+*/
+static size_t Request(const KeyValueStore& defaults, Clob& out)
+{
+	// the url, as given by the http server
+	AnyString url = "/sum?a=42.5&b=17&format=json";
+	uint separator = url.find('?');
+	String path;
+	path.assign(url, separator);
+	KeyValueStore params = defaults;
+	DecodeURLQuery(params, AnyString(url, separator + 1));
+
+	double a = 0, b = 0;
+	params["a"].to(a);
+	params["b"].to(b);
+
+	std::vector<String> row;
+	row.reserve(4);
+	row.emplace_back("1138");
+	row.emplace_back("john.doe");
+	row.emplace_back("2026-10-17");
+	row.emplace_back("active");
+
+	out.clear();
+	#ifdef YUNI_MODULE_MARSHAL
+	Marshal::Object response;
+	response["a"] = a;
+	response["b"] = b;
+	response["sum"] = (a + b);
+	response["user"] = row[1];
+	response.toJSON(out);
+	#else
+	// without the marshal module, the same document written by hand
+	out << "{\"a\": " << a << ", \"b\": " << b << ", \"sum\": " << (a + b);
+	out << ", \"user\": \"" << row[1] << "\"}";
+	#endif
+	return out.size() + path.size() + row[0].size();
+}
+
+
+
+
+int main()
+{
+	logs.info() << "sizeof(String): " << sizeof(String) << " bytes, sizeof(AnyString): " << sizeof(AnyString) << " bytes";
+	#ifndef __GLIBC__
+	logs.warning() << "the allocations are only counted with glibc";
+	#endif
+
+	KeyValueStore defaults;
+	defaults["a"] = "0";
+	defaults["b"] = "0";
+	defaults["format"] = "json";
+	Clob out;
+
+	size_t sink = 0;
+	sink += Request(defaults, out); // warmup
+
+	allocations = 0;
+	reallocations = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint i = 0; i != requestCount; ++i)
+		sink += Request(defaults, out);
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+	String line;
+	line << "per request: ";
+	line.appendFormat("%.2f allocations, %.2f reallocations, %.0f ns",
+		static_cast<double>(allocations) / requestCount,
+		static_cast<double>(reallocations) / requestCount,
+		static_cast<double>(elapsed.count()) / requestCount);
+	logs.info() << line;
+	return (sink != 0) ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include <yuni/core/logs.h>
+#ifdef YUNI_MODULE_MARSHAL
+#include <yuni/marshal/object.h>
+#endif
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Yuni;
+
+
+
+static Yuni::Logs::Logger<>  logs;
+
+//! Sizes of the generated buffers
+static const uint bufferSizes[] = {64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024};
+
+//! Sink for the results, so that the buffers are not optimized away
+static volatile size_t sink = 0;
+
+
+
+/*!
+** \brief Buffer growing like the strings did before the growth policy
+**
+** The capacity is increased by one chunk at a time, and the buffer is reallocated
+** to exactly that capacity.
+*/
+template<uint ChunkSizeT>
+class LinearBuffer final
+{
+public:
+	LinearBuffer() = default;
+	LinearBuffer(const LinearBuffer&) = delete;
+	~LinearBuffer() { ::free(data); }
+
+	void append(const char* block, uint blockSize)
+	{
+		uint mincapacity = size + blockSize + 1;
+		if (capacity < mincapacity)
+		{
+			do
+			{
+				capacity += ChunkSizeT;
+			}
+			while (capacity < mincapacity);
+			data = reinterpret_cast<char*>(::realloc(data, capacity));
+			++reallocations;
+		}
+		memcpy(data + size, block, blockSize);
+		size += blockSize;
+		data[size] = '\0';
+	}
+
+	char* data = nullptr;
+	uint size = 0;
+	uint capacity = 0;
+	uint reallocations = 0;
+};
+
+
+//! Run a workload enough times to last about 200ms (nanoseconds per byte)
+template<class F>
+static double Measure(uint bytes, const F& workload)
+{
+	uint64 count = 0;
+	auto start = std::chrono::steady_clock::now();
+	std::chrono::nanoseconds elapsed;
+	do
+	{
+		sink = sink + workload();
+		++count;
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+	while (elapsed < std::chrono::milliseconds(200));
+	return static_cast<double>(elapsed.count()) / static_cast<double>(count * bytes);
+}
+
+
+//! Print the time per byte of a workload
+static void Print(const AnyString& title, double ns, const AnyString& details)
+{
+	String line;
+	line << "    " << title;
+	line.resize(32, " ");
+	line.appendFormat("%7.3f ns/byte (%6.2f GB/s)", ns, 1. / ns);
+	line << "  " << details;
+	logs.info() << line;
+}
+
+
+//! Log lines, as a log buffer would receive them
+static const char* LogLine(uint i, uint& length)
+{
+	static const char* const lines[] = {
+		"[2026-10-17 10:42:03][info] request handled in 12ms\n",
+		"[2026-10-17 10:42:03][notice] new connection from 10.0.0.42\n",
+		"[2026-10-17 10:42:04][warning] slow query (243ms)\n",
+		"[2026-10-17 10:42:04][info] GET /api/v1/users/1138/sessions 200\n",
+	};
+	const char* line = lines[i % 4];
+	length = static_cast<uint>(::strlen(line));
+	return line;
+}
+
+
+#ifdef YUNI_MODULE_MARSHAL
+//! Build a document of `count` dictionaries, for Marshal::Object::toJSON()
+static Marshal::Object Document(uint count)
+{
+	Marshal::Object document;
+	for (uint i = 0; i != count; ++i)
+	{
+		Marshal::Object item;
+		item["id"] = static_cast<sint64>(i);
+		item["name"] = "user name";
+		item["email"] = "someone@example.org";
+		item["active"] = (i % 3 != 0);
+		item["score"] = 0.5 * i;
+		document.append(item);
+	}
+	return document;
+}
+#endif
+
+
+
+
+int main()
+{
+	for (uint bytes: bufferSizes)
+	{
+		logs.info();
+		logs.info() << "buffer of " << (bytes / 1024) << " KiB";
+
+		// log buffer, previous growth (chunks of 128 bytes)
+		{
+			uint reallocations = 0;
+			double ns = Measure(bytes, [&]() -> size_t {
+				LinearBuffer<128> buffer;
+				uint length;
+				for (uint i = 0; buffer.size < bytes; ++i)
+				{
+					const char* line = LogLine(i, length);
+					buffer.append(line, length);
+				}
+				reallocations = buffer.reallocations;
+				return buffer.size;
+			});
+			String details;
+			details << reallocations << " reallocations";
+			Print("log lines (linear growth)", ns, details);
+		}
+
+		// log buffer, String
+		{
+			uint reallocations = 0;
+			double ns = Measure(bytes, [&]() -> size_t {
+				String buffer;
+				uint capacity = 0;
+				reallocations = 0;
+				uint length;
+				for (uint i = 0; buffer.size() < bytes; ++i)
+				{
+					const char* line = LogLine(i, length);
+					buffer.append(line, length);
+					if (buffer.capacity() != capacity)
+					{
+						capacity = buffer.capacity();
+						++reallocations;
+					}
+				}
+				return buffer.size();
+			});
+			String details;
+			details << reallocations << " reallocations";
+			Print("log lines (String)", ns, details);
+		}
+
+		// log buffer, Clob, with formatted values
+		{
+			double ns = Measure(bytes, [&]() -> size_t {
+				Clob buffer;
+				for (uint i = 0; buffer.size() < bytes; ++i)
+					buffer << "[info] request " << i << " handled in " << (i % 97) << "ms\n";
+				return buffer.size();
+			});
+			Print("formatted lines (Clob)", ns, "");
+		}
+
+		// char by char
+		{
+			double ns = Measure(bytes, [&]() -> size_t {
+				Clob buffer;
+				for (uint i = 0; i != bytes; ++i)
+					buffer += static_cast<char>('a' + (i % 26));
+				return buffer.size();
+			});
+			Print("single chars (Clob)", ns, "");
+		}
+
+		#ifdef YUNI_MODULE_MARSHAL
+		// Marshal::Object::toJSON, about 140 bytes per item
+		{
+			Marshal::Object document = Document(bytes / 140);
+			Clob json;
+			document.toJSON(json);
+			uint size = json.size();
+			double ns = Measure(size, [&]() -> size_t {
+				Clob out;
+				document.toJSON(out);
+				return out.size();
+			});
+			String details;
+			details << "(" << (size / 1024) << " KiB)";
+			Print("Marshal::Object::toJSON", ns, details);
+		}
+		#endif
+	}
+	return 0;
+}
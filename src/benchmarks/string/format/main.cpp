@@ -0,0 +1,145 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include <yuni/core/logs.h>
+#ifdef YUNI_MODULE_MARSHAL
+#include <yuni/marshal/object.h>
+#endif
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <cinttypes>
+
+using namespace Yuni;
+
+
+
+static Yuni::Logs::Logger<>  logs;
+
+//! Number of values per measure
+static const uint valueCount = 100000;
+
+//! Sink for the results, so that the buffers are not optimized away
+static volatile size_t sink = 0;
+
+
+
+//! Run a workload enough times to last about 200ms (nanoseconds per value)
+template<class F>
+static double Measure(const F& workload)
+{
+	uint64 count = 0;
+	auto start = std::chrono::steady_clock::now();
+	std::chrono::nanoseconds elapsed;
+	do
+	{
+		sink = sink + workload();
+		++count;
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+	while (elapsed < std::chrono::milliseconds(200));
+	return static_cast<double>(elapsed.count()) / static_cast<double>(count * valueCount);
+}
+
+
+//! Print the time per value of a workload
+static void Print(const AnyString& title, double ns)
+{
+	String line;
+	line << "    " << title;
+	line.resize(40, " ");
+	line.appendFormat("%8.2f ns/value", ns);
+	logs.info() << line;
+}
+
+
+//! Append values to a buffer with snprintf(), as the strings did before
+template<class T>
+static size_t WithPrintf(const std::vector<T>& values, const char* format)
+{
+	Clob buffer;
+	char tmp[256];
+	for (auto value: values)
+	{
+		int written = snprintf(tmp, sizeof(tmp), format, value);
+		buffer.append(static_cast<const char*>(tmp), static_cast<uint>(written));
+		buffer += ',';
+	}
+	return buffer.size();
+}
+
+
+//! Append values to a buffer with the operator <<
+template<class T>
+static size_t WithString(const std::vector<T>& values)
+{
+	Clob buffer;
+	for (auto value: values)
+		buffer << value << ',';
+	return buffer.size();
+}
+
+
+
+
+int main()
+{
+	// values with various magnitudes, as found in logs or JSON documents
+	std::vector<sint64> integers;
+	std::vector<uint32> smallIntegers;
+	std::vector<double> decimals;
+	std::vector<double> prices;
+	uint64 seed = 0x9E3779B97F4A7C15ull;
+	for (uint i = 0; i != valueCount; ++i)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		integers.push_back(static_cast<sint64>(seed >> (seed % 60)) * ((i % 2) ? -1 : 1));
+		smallIntegers.push_back(static_cast<uint32>(seed >> 33) % 1000);
+		decimals.push_back(static_cast<double>(seed >> 11) / 9007199254740992. * 1e6);
+		prices.push_back(static_cast<double>(seed % 100000) / 100.);
+	}
+
+	logs.info() << "integers";
+	Print("sint64, snprintf(\"%lld\")", Measure([&]() { return WithPrintf(integers, "%" PRId64); }));
+	Print("sint64, String", Measure([&]() { return WithString(integers); }));
+	Print("uint32 < 1000, snprintf(\"%u\")", Measure([&]() { return WithPrintf(smallIntegers, "%u"); }));
+	Print("uint32 < 1000, String", Measure([&]() { return WithString(smallIntegers); }));
+
+	logs.info() << "doubles";
+	Print("random, snprintf(\"%f\")", Measure([&]() { return WithPrintf(decimals, "%f"); }));
+	Print("random, snprintf(\"%.17g\")", Measure([&]() { return WithPrintf(decimals, "%.17g"); }));
+	Print("random, String (shortest)", Measure([&]() { return WithString(decimals); }));
+	Print("2 decimals, snprintf(\"%f\")", Measure([&]() { return WithPrintf(prices, "%f"); }));
+	Print("2 decimals, snprintf(\"%.17g\")", Measure([&]() { return WithPrintf(prices, "%.17g"); }));
+	Print("2 decimals, String (shortest)", Measure([&]() { return WithString(prices); }));
+
+	#ifdef YUNI_MODULE_MARSHAL
+	// Marshal::Object::toJSON, with numbers only
+	{
+		Marshal::Object document;
+		for (uint i = 0; i != valueCount; ++i)
+		{
+			Marshal::Object item;
+			item["id"] = integers[i];
+			item["price"] = prices[i];
+			document.append(item);
+		}
+		logs.info() << "json";
+		Print("Marshal::Object::toJSON", Measure([&]() -> size_t {
+			Clob out;
+			document.toJSON(out);
+			return out.size();
+		}));
+	}
+	#endif
+	return 0;
+}
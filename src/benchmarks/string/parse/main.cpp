@@ -0,0 +1,148 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include <yuni/core/logs.h>
+#include <chrono>
+#include <vector>
+
+using namespace Yuni;
+
+
+
+static Yuni::Logs::Logger<>  logs;
+
+//! Number of values per measure
+static const uint valueCount = 100000;
+
+//! Sink for the results, so that the conversions are not optimized away
+static volatile double sink = 0;
+
+
+
+//! Run a workload enough times to last about 200ms (nanoseconds per value)
+template<class F>
+static double Measure(const F& workload)
+{
+	uint64 count = 0;
+	auto start = std::chrono::steady_clock::now();
+	std::chrono::nanoseconds elapsed;
+	do
+	{
+		sink = sink + workload();
+		++count;
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+	while (elapsed < std::chrono::milliseconds(200));
+	return static_cast<double>(elapsed.count()) / static_cast<double>(count * valueCount);
+}
+
+
+//! Print the time per value of a workload
+static void Print(const AnyString& title, double ns)
+{
+	String line;
+	line << "    " << title;
+	line.resize(40, " ");
+	line.appendFormat("%8.2f ns/value", ns);
+	logs.info() << line;
+}
+
+
+/*!
+** \brief Values separated by commas, as read from a CSV file or a database
+**
+** The views are not zero-terminated, like the values of a query string.
+*/
+class Values final
+{
+public:
+	template<class T> void add(const T& value)
+	{
+		uint offset = text.size();
+		text << value;
+		bounds.push_back(std::make_pair(offset, text.size() - offset));
+		text << ',';
+	}
+
+	template<class T> double sum() const
+	{
+		double total = 0;
+		T value;
+		for (auto& bound: bounds)
+		{
+			AnyString(text.c_str() + bound.first, bound.second).to(value);
+			total += static_cast<double>(value);
+		}
+		return total;
+	}
+
+	//! Same values, as zero-terminated strings
+	template<class T> double sumZeroTerminated() const
+	{
+		double total = 0;
+		T value;
+		for (auto& copy: copies)
+		{
+			copy.to(value);
+			total += static_cast<double>(value);
+		}
+		return total;
+	}
+
+	void makeCopies()
+	{
+		for (auto& bound: bounds)
+			copies.emplace_back(text.c_str() + bound.first, bound.second);
+	}
+
+	Clob text;
+	std::vector<std::pair<uint, uint>> bounds;
+	std::vector<String> copies;
+};
+
+
+
+
+int main()
+{
+	Values ids;
+	Values integers;
+	Values prices;
+	Values decimals;
+	uint64 seed = 0x9E3779B97F4A7C15ull;
+	for (uint i = 0; i != valueCount; ++i)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		ids.add(static_cast<uint32>(seed >> 33) % 100000);
+		integers.add(static_cast<sint64>(seed >> (seed % 60)) * ((i % 2) ? -1 : 1));
+		prices.add(static_cast<double>(seed % 100000) / 100.);
+		decimals.add(static_cast<double>(seed >> 11) / 9007199254740992. * 1e6);
+	}
+	ids.makeCopies();
+	integers.makeCopies();
+	prices.makeCopies();
+	decimals.makeCopies();
+
+	logs.info() << "integers";
+	Print("uint32 < 100000, AnyString", Measure([&]() { return ids.sum<uint32>(); }));
+	Print("uint32 < 100000, String", Measure([&]() { return ids.sumZeroTerminated<uint32>(); }));
+	Print("sint64, AnyString", Measure([&]() { return integers.sum<sint64>(); }));
+	Print("sint64, String", Measure([&]() { return integers.sumZeroTerminated<sint64>(); }));
+
+	logs.info() << "doubles";
+	Print("2 decimals, AnyString", Measure([&]() { return prices.sum<double>(); }));
+	Print("2 decimals, String", Measure([&]() { return prices.sumZeroTerminated<double>(); }));
+	Print("shortest round-trip, AnyString", Measure([&]() { return decimals.sum<double>(); }));
+	Print("shortest round-trip, String", Measure([&]() { return decimals.sumZeroTerminated<double>(); }));
+	Print("float, AnyString", Measure([&]() { return decimals.sum<float>(); }));
+	return 0;
+}
@@ -0,0 +1,131 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include <yuni/core/logs.h>
+#include <chrono>
+#include <vector>
+
+using namespace Yuni;
+using namespace Yuni::Private::CStringImpl;
+
+
+
+static Yuni::Logs::Logger<>  logs;
+
+//! Sizes of the haystacks
+static const size_t haystackSizes[] = {16, 64, 256, 4096, 65536};
+//! Sizes of the needles, for the substring searches
+static const size_t needleSizes[] = {2, 4, 8, 16, 32};
+
+//! Sink for the results, so that the searches are not optimized away
+static volatile size_t sink = 0;
+
+
+
+/*!
+** \brief Generate a haystack looking like log lines
+**
+** The needle is only found at the very end, after many partial matches.
+*/
+static String Haystack(size_t size, const AnyString& needle)
+{
+	static const char* const words[] = {"request ", "Handled ", "in ", "ms, ", "status=200 ", "user=", "id ", "\n"};
+	String haystack;
+	uint i = 0;
+	while (haystack.size() < size)
+		haystack += words[(i++ * 7) % 8];
+	haystack.truncate(static_cast<uint>(size - needle.size()));
+	haystack += needle;
+	return haystack;
+}
+
+
+//! Run a search enough times to last about 20ms (nanoseconds per call)
+template<class F>
+static double Measure(const F& search)
+{
+	uint64 count = 0;
+	auto start = std::chrono::steady_clock::now();
+	std::chrono::nanoseconds elapsed;
+	do
+	{
+		for (uint i = 0; i != 256; ++i)
+			sink = sink + search();
+		count += 256;
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+	while (elapsed < std::chrono::milliseconds(20));
+	return static_cast<double>(elapsed.count()) / static_cast<double>(count);
+}
+
+
+//! Print the time per call and the throughput of a search, for all instruction sets
+template<class F>
+static void Compare(const AnyString& title, size_t size, const F& search)
+{
+	static const SearchInstructionSet sets[] = {
+		SearchInstructionSet::scalar, SearchInstructionSet::sse2, SearchInstructionSet::avx2
+	};
+	String line;
+	line << "    " << title;
+	line.resize(36, " ");
+	for (auto set: sets)
+	{
+		const SearchKernels* kernels = Search(set);
+		if (not kernels)
+			continue;
+		double ns = Measure([&]() { return search(*kernels); });
+		line << "  " << kernels->name << ": ";
+		line.appendFormat("%9.1f ns (%5.2f GB/s)", ns, static_cast<double>(size) / ns);
+	}
+	logs.info() << line;
+}
+
+
+
+
+int main()
+{
+	logs.info() << "kernels selected for this CPU: " << searchKernels.load()->name;
+
+	for (size_t size: haystackSizes)
+	{
+		logs.info();
+		logs.info() << "haystack of " << size << " bytes";
+
+		String haystack = Haystack(size, "$");
+		const char* s = haystack.c_str();
+		Compare("find char", size, [&](const SearchKernels& k) { return k.findChar(s, size, '$'); });
+		Compare("ifind char", size, [&](const SearchKernels& k) { return k.ifindChar(s, size, '$'); });
+		Compare("rfind char", size, [&](const SearchKernels& k) { return k.rfindChar(s, size, '#'); });
+		Compare("count char", size, [&](const SearchKernels& k) { return k.countChar(s, size, 'e'); });
+		Compare("find any of (3 chars)", size, [&](const SearchKernels& k) { return k.findAnyOf(s, size, "$#@", 3); });
+		Compare("find any of (12 chars)", size, [&](const SearchKernels& k) { return k.findAnyOf(s, size, "$#@&*!?;[]{}", 12); });
+
+		for (size_t len: needleSizes)
+		{
+			if (len >= size)
+				continue;
+			String needle;
+			needle.resize(static_cast<uint>(len - 1), "s");
+			needle += '$';
+			String text = Haystack(size, needle);
+			const char* t = text.c_str();
+			String title;
+			title << "find substring (" << len << " chars)";
+			Compare(title, size, [&](const SearchKernels& k) { return k.find(t, size, needle.c_str(), len); });
+			title.clear() << "ifind substring (" << len << " chars)";
+			Compare(title, size, [&](const SearchKernels& k) { return k.ifind(t, size, needle.c_str(), len); });
+		}
+	}
+	return 0;
+}
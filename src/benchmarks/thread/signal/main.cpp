@@ -0,0 +1,231 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/thread/signal.h>
+#include <yuni/thread/mutex.h>
+#include <yuni/thread/utility.h>
+#include <yuni/core/system/cpu.h>
+#include <yuni/core/logs.h>
+#include <chrono>
+#include <vector>
+#ifndef YUNI_OS_WINDOWS
+# include <pthread.h>
+#endif
+
+using namespace Yuni;
+
+
+
+static Yuni::Logs::Logger<>  logs;
+
+
+#ifndef YUNI_OS_WINDOWS
+
+/*!
+** \brief Reference implementation: a mutex / condition variable pair
+**
+** This is how Thread::Signal is implemented without futexes.
+*/
+class CondSignal final
+{
+public:
+	CondSignal()
+	{
+		::pthread_mutex_init(&pMutex, nullptr);
+		::pthread_cond_init(&pCondition, nullptr);
+	}
+
+	~CondSignal()
+	{
+		::pthread_cond_destroy(&pCondition);
+		::pthread_mutex_destroy(&pMutex);
+	}
+
+	void waitAndReset()
+	{
+		::pthread_mutex_lock(&pMutex);
+		while (not pSignalled)
+			::pthread_cond_wait(&pCondition, &pMutex);
+		pSignalled = false;
+		::pthread_mutex_unlock(&pMutex);
+	}
+
+	void notify()
+	{
+		::pthread_mutex_lock(&pMutex);
+		pSignalled = true;
+		::pthread_cond_signal(&pCondition);
+		::pthread_mutex_unlock(&pMutex);
+	}
+
+	void reset()
+	{
+		::pthread_mutex_lock(&pMutex);
+		pSignalled = false;
+		::pthread_mutex_unlock(&pMutex);
+	}
+
+private:
+	pthread_mutex_t pMutex;
+	pthread_cond_t pCondition;
+	bool pSignalled = false;
+};
+
+
+//! Reference implementation: a recursive pthread mutex (like Mutex), without spinning
+class PlainMutex final
+{
+public:
+	PlainMutex()
+	{
+		::pthread_mutexattr_t attr;
+		::pthread_mutexattr_init(&attr);
+		::pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+		::pthread_mutex_init(&pMutex, &attr);
+		::pthread_mutexattr_destroy(&attr);
+	}
+	~PlainMutex() { ::pthread_mutex_destroy(&pMutex); }
+	void lock() { ::pthread_mutex_lock(&pMutex); }
+	void unlock() { ::pthread_mutex_unlock(&pMutex); }
+
+private:
+	pthread_mutex_t pMutex;
+};
+
+#endif
+
+
+
+template<class ClockT>
+static double ElapsedNanoseconds(const typename ClockT::time_point& start, uint64 count)
+{
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(ClockT::now() - start);
+	return static_cast<double>(elapsed.count()) / static_cast<double>(count);
+}
+
+
+/*!
+** \brief Ping-pong between two threads, each waking up the other one
+**
+** \return The average latency of a handoff, in nanoseconds
+*/
+template<class SignalT>
+static double PingPong(uint64 roundtrips)
+{
+	SignalT ping;
+	SignalT pong;
+
+	auto thread = spawn([&]()
+	{
+		for (uint64 i = 0; i != roundtrips; ++i)
+		{
+			ping.waitAndReset();
+			pong.notify();
+		}
+	});
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint64 i = 0; i != roundtrips; ++i)
+	{
+		ping.notify();
+		pong.waitAndReset();
+	}
+	double result = ElapsedNanoseconds<std::chrono::steady_clock>(start, roundtrips * 2);
+	thread->wait();
+	return result;
+}
+
+
+//! Notify a signal nobody is waiting for (nanoseconds per notify + reset)
+template<class SignalT>
+static double NotifyWithoutWaiter(uint64 count)
+{
+	SignalT signal;
+	auto start = std::chrono::steady_clock::now();
+	for (uint64 i = 0; i != count; ++i)
+	{
+		signal.notify();
+		signal.reset();
+	}
+	return ElapsedNanoseconds<std::chrono::steady_clock>(start, count);
+}
+
+
+//! Mutex spinning before sleeping
+class SpinningMutex final
+{
+public:
+	void lock() { pMutex.lock(); }
+	void unlock() { pMutex.unlock(); }
+
+private:
+	Mutex pMutex{true, Mutex::Waiting::spin};
+};
+
+
+//! Several threads incrementing a counter protected by a mutex (nanoseconds per increment)
+template<class MutexT>
+static double ContendedMutex(uint threadCount, uint64 increments)
+{
+	MutexT mutex;
+	uint64 counter = 0;
+	std::vector<std::unique_ptr<Thread::IThread>> threads;
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint t = 0; t != threadCount; ++t)
+	{
+		threads.emplace_back(spawn([&]()
+		{
+			for (uint64 i = 0; i != increments; ++i)
+			{
+				mutex.lock();
+				++counter;
+				mutex.unlock();
+			}
+		}));
+	}
+	for (auto& thread: threads)
+		thread->wait();
+	return ElapsedNanoseconds<std::chrono::steady_clock>(start, counter);
+}
+
+
+
+
+int main()
+{
+	constexpr uint64 roundtrips = 200000;
+	constexpr uint64 notifications = 10000000;
+	constexpr uint64 increments = 1000000;
+	constexpr uint threadCount = 4;
+
+	logs.info() << "signal handoff latency (ping-pong, " << roundtrips << " round trips)";
+	logs.info() << "    Thread::Signal : " << PingPong<Thread::Signal>(roundtrips) << " ns";
+	#ifndef YUNI_OS_WINDOWS
+	logs.info() << "    mutex/condvar  : " << PingPong<CondSignal>(roundtrips) << " ns";
+	#endif
+
+	logs.info() << "notify without waiter (" << notifications << " times)";
+	logs.info() << "    Thread::Signal : " << NotifyWithoutWaiter<Thread::Signal>(notifications) << " ns";
+	#ifndef YUNI_OS_WINDOWS
+	logs.info() << "    mutex/condvar  : " << NotifyWithoutWaiter<CondSignal>(notifications) << " ns";
+	#endif
+
+	logs.info() << "contended mutex (" << threadCount << " threads, " << increments << " increments each)";
+	logs.info() << "    Mutex          : " << ContendedMutex<Mutex>(threadCount, increments) << " ns";
+	logs.info() << "    Mutex (spin)   : " << ContendedMutex<SpinningMutex>(threadCount, increments) << " ns";
+	if (System::CPU::Count() < 2)
+		logs.warning() << "    single processor: Mutex::Waiting::spin has no effect";
+	#ifndef YUNI_OS_WINDOWS
+	logs.info() << "    pthread mutex  : " << ContendedMutex<PlainMutex>(threadCount, increments) << " ns";
+	#endif
+	return 0;
+}
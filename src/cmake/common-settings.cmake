@@ -89,41 +89,17 @@ set(YUNI_COMMON_CC_OPTIONS_UNIX   "${YUNI_COMMON_CC_OPTIONS} -fPIC")
 include(CheckCXXCompilerFlag)
 if(NOT MSVC)
 	check_cxx_compiler_flag("-std=gnu++17"   YUNI_HAS_GNU17_SUPPORT)
-	check_cxx_compiler_flag("-std=gnu++14"   YUNI_HAS_GNU14_SUPPORT)
-	check_cxx_compiler_flag("-std=gnu++11"   YUNI_HAS_GNU11_SUPPORT)
 	check_cxx_compiler_flag("-std=c++17"     YUNI_HAS_CPP17_SUPPORT)
-	check_cxx_compiler_flag("-std=c++14"     YUNI_HAS_CPP14_SUPPORT)
-	check_cxx_compiler_flag("-std=c++11"     YUNI_HAS_CPP11_SUPPORT)
-	check_cxx_compiler_flag("-std=c++0x"     YUNI_HAS_GCC_CPP0X_SUPPORT)
 	check_cxx_compiler_flag("-stdlib=libc++" YUNI_HAS_LIB_CPP11_SUPPORT) # clang, Apple gcc...
-	if (NOT APPLE)
-		if (YUNI_HAS_GNU17_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=gnu++17")
-			set(YUNI_CPP_STD "-std=gnu++17" CACHE STRING "c++std" FORCE)
-		elseif (YUNI_HAS_GNU14_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=gnu++14")
-			set(YUNI_CPP_STD "-std=gnu++14" CACHE STRING "c++std" FORCE)
-		elseif (YUNI_HAS_GNU11_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=gnu++11")
-			set(YUNI_CPP_STD "-std=gnu++11" CACHE STRING "c++std" FORCE)
-		elseif (YUNI_HAS_GCC_CPP0X_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=c++0x")
-			set(YUNI_CPP_STD "-std=c++0x" CACHE STRING "c++std" FORCE)
-		endif()
+	# C++17 is required (`if constexpr`, inline variables, std::chrono::ceil...)
+	if (NOT APPLE AND YUNI_HAS_GNU17_SUPPORT)
+		set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=gnu++17")
+		set(YUNI_CPP_STD "-std=gnu++17" CACHE STRING "c++std" FORCE)
+	elseif (YUNI_HAS_CPP17_SUPPORT)
+		set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=c++17")
+		set(YUNI_CPP_STD "-std=c++17" CACHE STRING "c++std" FORCE)
 	else()
-		if (YUNI_HAS_CPP17_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=c++17")
-			set(YUNI_CPP_STD "-std=c++17" CACHE STRING "c++std" FORCE)
-		elseif (YUNI_HAS_CPP14_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=c++14")
-			set(YUNI_CPP_STD "-std=c++14" CACHE STRING "c++std" FORCE)
-		elseif (YUNI_HAS_CPP11_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=c++11")
-			set(YUNI_CPP_STD "-std=c++11" CACHE STRING "c++std" FORCE)
-		elseif (YUNI_HAS_GCC_CPP0X_SUPPORT)
-			set(YUNI_COMMON_CXX_OPTIONS  "${YUNI_COMMON_CXX_OPTIONS} -std=c++0x")
-			set(YUNI_CPP_STD "-std=c++0x" CACHE STRING "c++std" FORCE)
-		endif()
+		ynfatal("A C++17 compiler is required (g++ >= 7, clang++ >= 5)")
 	endif()
 	if (YUNI_HAS_LIB_CPP11_SUPPORT AND (NOT CLANG OR APPLE))
 		# clang seems to not like the option -stdlib, but required on MacOS...
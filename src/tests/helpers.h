@@ -0,0 +1,70 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include <yuni/yuni.h>
+#include <yuni/test/test.h>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+/*!
+** \file
+** \brief Helpers shared by all tests (a test is a program, see `yuni_add_test()`)
+**
+** \code
+** static void Something()
+** {
+**	Test::Checkpoint checkpoint("module: something");
+**	Check(checkpoint, 1 + 1 == 2, "the addition works");
+** }
+**
+** int main()
+** {
+**	Something();
+**	return ExitCode();
+** }
+** \endcode
+*/
+
+
+
+//! Number of failed checks
+inline uint errors = 0;
+
+
+//! Check a condition, counted as a failure if false
+inline void Check(Yuni::Test::Checkpoint& checkpoint, bool condition, const char* message)
+{
+	if (not checkpoint(condition, message))
+		++errors;
+}
+
+
+//! Wait until a condition is true (5 seconds at most)
+template<class F>
+inline bool WaitFor(const F& condition)
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (not condition())
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+			return false;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+
+//! Exit code of the test program
+inline int ExitCode()
+{
+	return (errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,341 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/job/queue/service.h>
+#include <yuni/job/taskgroup.h>
+#include <yuni/job/coroutine.h>
+#include <yuni/thread/signal.h>
+#include "../../helpers.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <cstdlib>
+
+#ifndef YUNI_HAS_CPP_COROUTINE
+# error "this test must be compiled with C++20 coroutines"
+#endif
+
+using namespace Yuni;
+
+
+
+//! A job counting its executions
+class Counter final : public Job::IJob
+{
+public:
+	explicit Counter(std::atomic<uint>& count) : count(count) {}
+
+protected:
+	virtual void onExecute() override
+	{
+		++count;
+	}
+
+private:
+	std::atomic<uint>& count;
+};
+
+
+//! Set a flag when destroyed (to know when the frame of a coroutine is destroyed)
+struct Guard final
+{
+	explicit Guard(std::atomic<bool>& destroyed) : destroyed(destroyed) {}
+	~Guard() { destroyed = true; }
+	std::atomic<bool>& destroyed;
+};
+
+
+//! Wait for a flag, or exit (a deadlock)
+static void Expect(Test::Checkpoint& checkpoint, const std::atomic<bool>& flag, const char* message)
+{
+	bool done = WaitFor([&]() { return flag.load(); });
+	Check(checkpoint, done, message);
+	if (not done)
+		std::_Exit(EXIT_FAILURE);
+}
+
+
+
+
+static Job::Task<int> Twice(int value)
+{
+	co_await Job::yield();
+	co_return value * 2;
+}
+
+
+static Job::Task<> Compute(std::atomic<int>& result, std::atomic<bool>& done)
+{
+	int value = co_await Twice(21);
+	result = value + co_await Twice(0);
+	done = true;
+}
+
+
+static void Start()
+{
+	Test::Checkpoint checkpoint("coroutine: start() and a nested task returning a value");
+	std::atomic<int> result{0};
+	std::atomic<bool> done{false};
+	Job::QueueService queueservice;
+	queueservice.start();
+
+	Job::Task<> task = Compute(result, done);
+	Check(checkpoint, task.valid(), "the task is valid before start()");
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	Check(checkpoint, not done.load(), "the task does nothing until started");
+	task.start(queueservice);
+	Check(checkpoint, not task.valid(), "the task owns itself once started");
+	Expect(checkpoint, done, "the task is complete");
+	Check(checkpoint, result.load() == 42, "the value of the nested task");
+	queueservice.stop();
+}
+
+
+
+
+static Job::Task<> Sleep(std::chrono::milliseconds& elapsed, std::atomic<bool>& done)
+{
+	auto start = std::chrono::steady_clock::now();
+	co_await Job::sleep(std::chrono::milliseconds(50));
+	elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	done = true;
+}
+
+
+static Job::Task<> Yield(std::atomic<uint>& count, uint& before, uint& after, std::atomic<bool>& done)
+{
+	before = count.load();
+	co_await Job::yield();
+	after = count.load();
+	done = true;
+}
+
+
+static void SleepAndYield()
+{
+	Test::Checkpoint checkpoint("coroutine: sleep() and yield()");
+	Job::QueueService queueservice;
+	queueservice.minmaxThreadCount({1, 1});
+
+	// yield: a job added after the task is executed before its resumption
+	std::atomic<uint> count{0};
+	uint before = 0;
+	uint after = 0;
+	std::atomic<bool> yielded{false};
+	Yield(count, before, after, yielded).start(queueservice);
+	queueservice.add(new Counter(count));
+	queueservice.start();
+	Expect(checkpoint, yielded, "the task is complete after yield()");
+	Check(checkpoint, before == 0 and after == 1, "the other jobs are executed meanwhile");
+
+	// sleep: the worker is not blocked meanwhile
+	std::chrono::milliseconds elapsed{0};
+	std::atomic<bool> slept{false};
+	Sleep(elapsed, slept).start(queueservice);
+	queueservice.add(new Counter(count));
+	bool executed = WaitFor([&]() { return count.load() == 2; });
+	Check(checkpoint, executed and not slept.load(), "a job is executed by the single worker while the task sleeps");
+	Expect(checkpoint, slept, "the task is complete after sleep()");
+	Check(checkpoint, elapsed.count() >= 50, "the task has slept for the whole delay");
+	queueservice.stop();
+}
+
+
+
+
+static Job::Task<> WaitSignal(Thread::Signal& signal, std::atomic<bool>& done)
+{
+	co_await Job::wait(signal);
+	done = true;
+}
+
+
+static Job::Task<> WaitTaskgroup(Job::Taskgroup& taskgroup, Job::Taskgroup::Status& status, std::atomic<bool>& done)
+{
+	status = co_await Job::wait(taskgroup);
+	done = true;
+}
+
+
+static void Wait()
+{
+	Test::Checkpoint checkpoint("coroutine: wait() on a signal and on a taskgroup");
+	Job::QueueService queueservice;
+	queueservice.minmaxThreadCount({1, 1});
+	queueservice.start();
+
+	Thread::Signal signal;
+	std::atomic<bool> notified{false};
+	WaitSignal(signal, notified).start(queueservice);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	Check(checkpoint, not notified.load(), "the task is suspended until the signal is notified");
+	std::atomic<uint> count{0};
+	queueservice.add(new Counter(count));
+	Check(checkpoint, WaitFor([&]() { return count.load() == 1; }), "the worker is not blocked meanwhile");
+	signal.notify();
+	Expect(checkpoint, notified, "the task is resumed once the signal is notified");
+
+	std::atomic<bool> already{false};
+	WaitSignal(signal, already).start(queueservice);
+	Expect(checkpoint, already, "the task is not suspended by a signal already notified");
+
+	std::atomic<bool> release{false};
+	Job::Taskgroup::Ptr taskgroup = new Job::Taskgroup(queueservice);
+	*taskgroup += [&](Job::IJob&) -> bool {
+		WaitFor([&]() { return release.load(); });
+		return true;
+	};
+	taskgroup->start();
+	// the job of the taskgroup is blocking the single worker: a second one for the task
+	queueservice.minmaxThreadCount({2, 2});
+	Job::Taskgroup::Status status = Job::Taskgroup::stRunning;
+	std::atomic<bool> completed{false};
+	WaitTaskgroup(*taskgroup, status, completed).start(queueservice);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	Check(checkpoint, not completed.load(), "the task is suspended until the taskgroup is complete");
+	release = true;
+	Expect(checkpoint, completed, "the task is resumed once the taskgroup is complete");
+	Check(checkpoint, status == Job::Taskgroup::stSucceeded, "the status of the taskgroup");
+	queueservice.stop();
+}
+
+
+
+
+static Job::Task<> Hop(Job::QueueService& other, Job::QueueService& back, std::thread::id& first,
+	std::thread::id& second, std::atomic<bool>& done)
+{
+	co_await Job::resumeOn(other);
+	first = std::this_thread::get_id();
+	co_await Job::resumeOn(back);
+	second = std::this_thread::get_id();
+	done = true;
+}
+
+
+//! Get the id of the single worker of a queueservice
+static std::thread::id WorkerOf(Job::QueueService& queueservice)
+{
+	Thread::Signal signal;
+	std::thread::id id;
+	Job::Taskgroup::Ptr taskgroup = new Job::Taskgroup(queueservice);
+	*taskgroup += [&](Job::IJob&) -> bool { id = std::this_thread::get_id(); return true; };
+	taskgroup->start();
+	taskgroup->wait();
+	return id;
+}
+
+
+static void ResumeOn()
+{
+	Test::Checkpoint checkpoint("coroutine: resumeOn() another queueservice");
+	Job::QueueService a;
+	Job::QueueService b;
+	a.minmaxThreadCount({1, 1});
+	b.minmaxThreadCount({1, 1});
+	a.start();
+	b.start();
+	std::thread::id workerA = WorkerOf(a);
+	std::thread::id workerB = WorkerOf(b);
+
+	std::thread::id first;
+	std::thread::id second;
+	std::atomic<bool> done{false};
+	Hop(b, a, first, second, done).start(a);
+	Expect(checkpoint, done, "the task is complete");
+	Check(checkpoint, first == workerB, "resumed by the worker of the other queueservice");
+	Check(checkpoint, second == workerA, "and back");
+	a.stop();
+	b.stop();
+}
+
+
+
+
+static Job::Task<int> Throwing()
+{
+	co_await Job::yield();
+	throw std::runtime_error("failure");
+	co_return 0;
+}
+
+
+static Job::Task<int> Intermediate()
+{
+	int value = co_await Throwing();
+	co_return value + 1; // never reached
+}
+
+
+static Job::Task<> Catching(std::atomic<bool>& caught, std::atomic<bool>& done)
+{
+	try
+	{
+		co_await Intermediate();
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+	done = true;
+}
+
+
+static Job::Task<> Never(std::unique_ptr<Guard> /*owned by the frame*/, std::atomic<bool>& resumed)
+{
+	resumed = true;
+	co_return;
+}
+
+
+static void Exceptions()
+{
+	Test::Checkpoint checkpoint("coroutine: exceptions and destruction");
+	Job::QueueService queueservice;
+	queueservice.start();
+
+	std::atomic<bool> caught{false};
+	std::atomic<bool> done{false};
+	Catching(caught, done).start(queueservice);
+	Expect(checkpoint, done, "the task is complete");
+	Check(checkpoint, caught.load(), "the exception of a nested task is rethrown to the awaiting task");
+
+	// an exception thrown by a started task is ignored
+	Intermediate().start(queueservice);
+	std::atomic<uint> count{0};
+	queueservice.add(new Counter(count));
+	Check(checkpoint, WaitFor([&]() { return count.load() == 1; }), "the queueservice is still running");
+	queueservice.stop();
+
+	// a task never executed is destroyed with its job
+	std::atomic<bool> destroyed{false};
+	std::atomic<bool> resumed{false};
+	Never(std::make_unique<Guard>(destroyed), resumed).start(queueservice);
+	Check(checkpoint, not destroyed.load(), "the task is alive while waiting");
+	queueservice.clear();
+	Check(checkpoint, destroyed.load() and not resumed.load(), "the task is destroyed with the job removed from the queue");
+}
+
+
+
+
+int main()
+{
+	Start();
+	SleepAndYield();
+	Wait();
+	ResumeOn();
+	Exceptions();
+	return ExitCode();
+}
@@ -0,0 +1,162 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/job/queue/service.h>
+#include <yuni/job/strand.h>
+#include "../../helpers.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+using namespace Yuni;
+
+
+
+//! A job counting its executions
+class Counter final : public Job::IJob
+{
+public:
+	explicit Counter(std::atomic<uint>& count) : count(count) {}
+
+protected:
+	virtual void onExecute() override
+	{
+		++count;
+	}
+
+private:
+	std::atomic<uint>& count;
+};
+
+
+//! Get the number of jobs dropped so far
+static uint64 Dropped(const Job::QueueService& queueservice)
+{
+	Job::Statistics statistics;
+	queueservice.statistics(statistics);
+	return statistics.dropped;
+}
+
+
+
+
+static void DropOldest()
+{
+	Test::Checkpoint checkpoint("queueservice: the oldest job is dropped");
+	Job::QueueService queueservice;
+	queueservice.capacity(2, Job::QueueService::Overflow::dropOldest);
+	std::atomic<uint> count{0};
+	Job::IJob::Ptr a = new Counter(count);
+	Job::IJob::Ptr b = new Counter(count);
+	Job::IJob::Ptr c = new Counter(count);
+	queueservice.add(a);
+	queueservice.add(b);
+	Check(checkpoint, queueservice.add(c), "the new job is accepted");
+	Check(checkpoint, a->canceling() and a->idle(), "the dropped job is canceled and idle");
+	Check(checkpoint, b->waiting() and c->waiting() and not b->canceling(), "the other jobs are still waiting");
+	Check(checkpoint, Dropped(queueservice) == 1, "the dropped job is counted");
+
+	// a job with a lower priority can not make some room for a higher one
+	Job::IJob::Ptr high = new Counter(count);
+	Check(checkpoint, queueservice.add(high, Job::Priority::high), "a job of a lower priority is dropped for a high one");
+	Job::IJob::Ptr low = new Counter(count);
+	Check(checkpoint, not queueservice.add(low, Job::Priority::low), "a high priority job is never dropped for a low one");
+
+	queueservice.start();
+	bool executed = WaitFor([&]() { return count.load() == 2; });
+	Check(checkpoint, executed, "the remaining jobs are executed");
+	queueservice.stop();
+}
+
+
+static void InternalJobsAreKept()
+{
+	Test::Checkpoint checkpoint("queueservice: the jobs of a strand are never dropped");
+	Job::QueueService queueservice;
+	queueservice.capacity(1, Job::QueueService::Overflow::dropOldest);
+	std::atomic<uint> count{0};
+	Job::Strand::Ptr strand = new Job::Strand(queueservice);
+	strand->add(new Counter(count)); // schedules the internal job of the strand
+	Check(checkpoint, queueservice.waitingJobsCount() == 1, "the strand is waiting");
+
+	Job::IJob::Ptr job = new Counter(count);
+	Check(checkpoint, not queueservice.add(job), "the new job is rejected");
+	Check(checkpoint, Dropped(queueservice) == 0, "no job has been dropped");
+
+	queueservice.start();
+	bool executed = WaitFor([&]() { return count.load() == 1; });
+	Check(checkpoint, executed, "the job of the strand is executed");
+	if (not executed)
+		std::_Exit(EXIT_FAILURE);
+	queueservice.stop();
+}
+
+
+static void DropWithDeadline()
+{
+	Test::Checkpoint checkpoint("queueservice: the jobs with a deadline can be dropped");
+	Job::QueueService queueservice;
+	queueservice.aging(10);
+	queueservice.capacity(2, Job::QueueService::Overflow::dropOldest);
+	std::atomic<uint> count{0};
+	Job::IJob::Ptr deadline = new Counter(count);
+	Job::IJob::Ptr a = new Counter(count);
+	Job::IJob::Ptr b = new Counter(count);
+	queueservice.addWithDeadline(deadline, std::chrono::steady_clock::now() + std::chrono::seconds(10));
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	queueservice.add(a);
+	Check(checkpoint, queueservice.add(b), "the new job is accepted");
+	Check(checkpoint, deadline->canceling() and deadline->idle(), "the job with a deadline (the oldest) is dropped");
+	Check(checkpoint, a->waiting() and b->waiting(), "the other jobs are still waiting");
+	Check(checkpoint, queueservice.waitingJobsCount() == 2, "the capacity is respected");
+
+	queueservice.start();
+	bool executed = WaitFor([&]() { return count.load() == 2; });
+	Check(checkpoint, executed, "the remaining jobs are executed");
+	queueservice.stop();
+}
+
+
+static void TraceOfTerminatedThreads()
+{
+	Test::Checkpoint checkpoint("queueservice: the trace buffers of the terminated threads are released");
+	Job::QueueService queueservice;
+	Job::QueueService::Tracing tracing;
+	tracing.enabled = true;
+	queueservice.tracing(tracing);
+	std::atomic<uint> count{0};
+	// short-lived producers, one trace buffer each
+	for (uint i = 0; i != 50; ++i)
+		std::thread([&]() { queueservice.add(new Counter(count)); }).join();
+	// another one, releasing the buffers of the terminated threads
+	queueservice.add(new Counter(count));
+
+	Clob trace;
+	queueservice.exportTrace(trace);
+	uint buffers = 0;
+	for (uint offset = 0; (offset = trace.find("\"thread_name\"", offset)) < trace.size(); ++offset)
+		++buffers;
+	Check(checkpoint, buffers > 1 and buffers <= 1 + 8, "only the most recent buffers are kept");
+	Check(checkpoint, queueservice.waitingJobsCount() == 51, "the jobs have been added");
+}
+
+
+
+
+int main()
+{
+	DropOldest();
+	InternalJobsAreKept();
+	DropWithDeadline();
+	TraceOfTerminatedThreads();
+	return ExitCode();
+}
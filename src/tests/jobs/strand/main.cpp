@@ -0,0 +1,207 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/job/queue/service.h>
+#include <yuni/job/strand.h>
+#include "../../helpers.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+using namespace Yuni;
+
+
+
+//! A job executing a lambda
+class Lambda final : public Job::IJob
+{
+public:
+	explicit Lambda(std::function<void ()> callback) : callback(std::move(callback)) {}
+
+protected:
+	virtual void onExecute() override
+	{
+		callback();
+	}
+
+private:
+	std::function<void ()> callback;
+};
+
+
+//! Jobs of a strand, recording their order and any concurrent execution
+struct Recorder final
+{
+	//! Add a job to a strand, recording `value` once executed
+	void add(Job::Strand& strand, uint value)
+	{
+		strand += new Lambda([this, value]() {
+			if (inside.fetch_add(1) != 0)
+				++overlaps;
+			if ((value % 8) == 0)
+				std::this_thread::yield(); // give a chance to another worker
+			order.push_back(value); // no lock: the jobs of a strand are never concurrent
+			inside.fetch_sub(1);
+			++count;
+		});
+	}
+
+	std::vector<uint> order;
+	std::atomic<uint> inside{0};
+	std::atomic<uint> overlaps{0};
+	std::atomic<uint> count{0};
+};
+
+
+
+
+static void Ordering()
+{
+	Test::Checkpoint checkpoint("strand: the jobs are executed in their order of arrival");
+	Recorder recorder;
+	Job::QueueService queueservice;
+	queueservice.minmaxThreadCount({4, 4});
+	queueservice.start();
+	Job::Strand::Ptr strand = new Job::Strand(queueservice);
+	const uint count = 1000;
+	for (uint i = 0; i != count; ++i)
+		recorder.add(*strand, i);
+
+	bool executed = WaitFor([&]() { return recorder.count.load() == count; });
+	Check(checkpoint, executed, "all jobs are executed");
+	if (not executed)
+		std::_Exit(EXIT_FAILURE);
+	bool ordered = (recorder.order.size() == count);
+	for (uint i = 0; ordered and i != count; ++i)
+		ordered = (recorder.order[i] == i);
+	Check(checkpoint, ordered, "the jobs are executed in order");
+	Check(checkpoint, recorder.overlaps.load() == 0, "no job is executed concurrently with another one");
+	Check(checkpoint, WaitFor([&]() { return strand->idle(); }), "the strand is idle");
+	queueservice.stop();
+}
+
+
+static void ConcurrentProducers()
+{
+	Test::Checkpoint checkpoint("strand: jobs added from several threads");
+	Recorder recorder;
+	Job::QueueService queueservice;
+	queueservice.minmaxThreadCount({4, 4});
+	queueservice.start();
+	Job::Strand::Ptr strand = new Job::Strand(queueservice);
+	const uint producers = 4;
+	const uint count = 500;
+	std::vector<std::thread> threads;
+	for (uint p = 0; p != producers; ++p)
+	{
+		threads.emplace_back([&, p]() {
+			for (uint i = 0; i != count; ++i)
+				recorder.add(*strand, p * count + i);
+		});
+	}
+	for (auto& thread: threads)
+		thread.join();
+
+	bool executed = WaitFor([&]() { return recorder.count.load() == producers * count; });
+	Check(checkpoint, executed, "all jobs are executed");
+	if (not executed)
+		std::_Exit(EXIT_FAILURE);
+	// the jobs of a given producer are executed in order
+	bool ordered = true;
+	std::vector<uint> next(producers, 0);
+	for (uint value: recorder.order)
+	{
+		uint p = value / count;
+		ordered = ordered and (value % count == next[p]);
+		++next[p];
+	}
+	Check(checkpoint, ordered, "the jobs of each producer are executed in order");
+	Check(checkpoint, recorder.overlaps.load() == 0, "no job is executed concurrently with another one");
+	queueservice.stop();
+}
+
+
+static void Keys()
+{
+	Test::Checkpoint checkpoint("strand: different keys run in parallel, never the same key");
+	std::atomic<bool> otherKey{false};
+	std::atomic<bool> sameKey{false};
+	std::atomic<bool> sawOtherKey{false};
+	std::atomic<bool> sawSameKey{true};
+	std::atomic<uint> count{0};
+	Job::QueueService queueservice;
+	queueservice.minmaxThreadCount({4, 4});
+	queueservice.start();
+	Job::Strands<uint> strands(queueservice);
+
+	// the first job of the key 1 waits for a job of the key 2, and for the next job of the key 1
+	strands.add(1, new Lambda([&]() {
+		sawOtherKey = WaitFor([&]() { return otherKey.load(); });
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+		while (not sameKey.load() and std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		sawSameKey = sameKey.load();
+		++count;
+	}));
+	strands.add(1, new Lambda([&]() { sameKey = true; ++count; }));
+	strands.add(2, new Lambda([&]() { otherKey = true; ++count; }));
+
+	bool executed = WaitFor([&]() { return count.load() == 3; });
+	Check(checkpoint, executed, "all jobs are executed");
+	if (not executed)
+		std::_Exit(EXIT_FAILURE);
+	Check(checkpoint, sawOtherKey.load(), "the job of another key runs while the first one is running");
+	Check(checkpoint, not sawSameKey.load(), "the next job of the same key waits for the first one");
+	Check(checkpoint, strands.size() == 2, "a strand per key");
+	queueservice.stop();
+}
+
+
+static void Clear()
+{
+	Test::Checkpoint checkpoint("strand: removing the pending jobs from the queueservice");
+	std::atomic<uint> count{0};
+	Job::QueueService queueservice;
+	queueservice.minmaxThreadCount({4, 4});
+	Job::Strand::Ptr strand = new Job::Strand(queueservice);
+	for (uint i = 0; i != 10; ++i)
+		*strand += new Lambda([&]() { ++count; });
+	Check(checkpoint, strand->pendingJobsCount() == 10, "the jobs are pending (the queueservice is not started)");
+	Check(checkpoint, queueservice.waitingJobsCount() == 1, "a single job of the queueservice for the strand");
+
+	queueservice.clear();
+	Check(checkpoint, strand->idle() and strand->pendingJobsCount() == 0, "the jobs of the strand are removed");
+
+	// the strand can still be used
+	queueservice.start();
+	*strand += new Lambda([&]() { count += 100; });
+	bool executed = WaitFor([&]() { return count.load() != 0; });
+	Check(checkpoint, executed, "a new job is executed");
+	if (not executed)
+		std::_Exit(EXIT_FAILURE);
+	queueservice.stop();
+	Check(checkpoint, count.load() == 100, "the removed jobs have never been executed");
+}
+
+
+
+
+int main()
+{
+	Ordering();
+	ConcurrentProducers();
+	Keys();
+	Clear();
+	return ExitCode();
+}
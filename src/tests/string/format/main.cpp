@@ -0,0 +1,193 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include "../../helpers.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+using namespace Yuni;
+
+
+
+//! Check the text of a value
+template<class T>
+static void Expect(Test::Checkpoint& checkpoint, T value, const char* expected)
+{
+	String text;
+	text << value;
+	String message;
+	message << expected << " (got " << text << ')';
+	Check(checkpoint, text == expected, message.c_str());
+}
+
+
+//! Get if a double is read back exactly (same bits) from its text
+static bool RoundTrip(double value, String& text)
+{
+	text.clear();
+	text << value;
+	double back = std::strtod(text.c_str(), nullptr);
+	return 0 == std::memcmp(&back, &value, sizeof(double));
+}
+
+
+//! Get if a float is read back exactly (same bits) from its text
+static bool RoundTrip(float value, String& text)
+{
+	text.clear();
+	text << value;
+	float back = std::strtof(text.c_str(), nullptr);
+	return 0 == std::memcmp(&back, &value, sizeof(float));
+}
+
+
+//! Number of significant digits of a text (without the exponent)
+static uint SignificantDigits(const String& text)
+{
+	uint count = 0;
+	bool leading = true;
+	uint trailingZeros = 0;
+	for (uint i = 0; i != text.size() and text[i] != 'e'; ++i)
+	{
+		char c = text[i];
+		if (c < '0' or c > '9')
+			continue;
+		if (leading and c == '0')
+			continue;
+		leading = false;
+		++count;
+		trailingZeros = (c == '0') ? trailingZeros + 1 : 0;
+	}
+	// the zeros of an integer written without exponent are not significant
+	return count - trailingZeros;
+}
+
+
+//! Number of significant digits of the shortest text read back exactly, found by printf
+static uint ShortestDigits(double value)
+{
+	char buffer[64];
+	for (int precision = 1; precision < 17; ++precision)
+	{
+		std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+		double back = std::strtod(buffer, nullptr);
+		if (0 == std::memcmp(&back, &value, sizeof(double)))
+			return static_cast<uint>(precision);
+	}
+	return 17;
+}
+
+
+
+
+static void BoundaryValues()
+{
+	Test::Checkpoint checkpoint("format: boundary values");
+	Expect(checkpoint, 0.1, "0.1");
+	Expect(checkpoint, 1., "1");
+	Expect(checkpoint, 1e20, "100000000000000000000");
+	Expect(checkpoint, 1e21, "1e+21");
+	Expect(checkpoint, 1e-6, "0.000001");
+	Expect(checkpoint, 1e-7, "1e-07");
+	Expect(checkpoint, 5e-324, "5e-324");
+	Expect(checkpoint, -0., "-0");
+	Expect(checkpoint, 0., "0");
+	Expect(checkpoint, DBL_MAX, "1.7976931348623157e+308");
+	Expect(checkpoint, DBL_MIN, "2.2250738585072014e-308");
+	Expect(checkpoint, 2.225073858507201e-308, "2.225073858507201e-308"); // largest subnormal
+	Expect(checkpoint, 9007199254740992., "9007199254740992");
+	Expect(checkpoint, 0.1f, "0.1");
+	Expect(checkpoint, 1.f, "1");
+	Expect(checkpoint, -0.f, "-0");
+	Expect(checkpoint, FLT_MAX, "3.4028235e+38");
+	Expect(checkpoint, FLT_MIN, "1.1754944e-38");
+	Expect(checkpoint, std::numeric_limits<float>::denorm_min(), "1e-45");
+	Expect(checkpoint, 16777216.f, "16777216");
+	Expect(checkpoint, std::numeric_limits<double>::infinity(), "inf");
+	Expect(checkpoint, -std::numeric_limits<double>::infinity(), "-inf");
+	Expect(checkpoint, std::numeric_limits<double>::quiet_NaN(), "nan");
+}
+
+
+static void RoundTripDoubles()
+{
+	Test::Checkpoint checkpoint("format: shortest round-trip of doubles");
+	String text;
+	uint failures = 0;
+	uint longer = 0;
+	// all exponents, random mantissas (the tables of powers of 5 are all used)
+	uint64 seed = 0x9E3779B97F4A7C15ull;
+	for (uint i = 0; i != 200000; ++i)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		uint64 bits = seed & 0x7FFFFFFFFFFFFFFFull;
+		if ((bits >> 52) == 0x7FF) // finite values only
+			continue;
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		if (not RoundTrip(value, text))
+			++failures;
+		else if ((i % 16) == 0 and bits != 0 and SignificantDigits(text) > ShortestDigits(value))
+			++longer;
+	}
+	// the extremities of the ranges of the exponents
+	for (int exponent = -1074; exponent <= 1023; ++exponent)
+	{
+		double value = std::ldexp(1., exponent);
+		if (not RoundTrip(value, text) or not RoundTrip(std::nextafter(value, 0.), text))
+			++failures;
+	}
+	Check(checkpoint, failures == 0, "all doubles are read back exactly");
+	Check(checkpoint, longer == 0, "no text is longer than the shortest one");
+}
+
+
+static void RoundTripFloats()
+{
+	Test::Checkpoint checkpoint("format: shortest round-trip of floats");
+	String text;
+	uint failures = 0;
+	uint32 seed = 0x9E3779B9u;
+	for (uint i = 0; i != 200000; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		uint32 bits = seed & 0x7FFFFFFFu;
+		if ((bits >> 23) == 0xFF) // finite values only
+			continue;
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		if (not RoundTrip(value, text))
+			++failures;
+	}
+	for (int exponent = -149; exponent <= 127; ++exponent)
+	{
+		float value = std::ldexp(1.f, exponent);
+		if (not RoundTrip(value, text) or not RoundTrip(std::nextafter(value, 0.f), text))
+			++failures;
+	}
+	Check(checkpoint, failures == 0, "all floats are read back exactly");
+}
+
+
+
+
+int main()
+{
+	BoundaryValues();
+	RoundTripDoubles();
+	RoundTripFloats();
+	return ExitCode();
+}
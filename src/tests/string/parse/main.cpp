@@ -0,0 +1,222 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include "../../helpers.h"
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+using namespace Yuni;
+
+
+
+//! Get if two values are identical (same bits, for the floating-point values)
+template<class T>
+static bool Same(T a, T b)
+{
+	return 0 == std::memcmp(&a, &b, sizeof(T));
+}
+
+
+/*!
+** \brief Check the conversion of a text, as a zero-terminated string and as a view
+**
+** The view is followed by some digits, which must be ignored.
+*/
+template<class T>
+static void Expect(Test::Checkpoint& checkpoint, const char* text, bool success, T expected)
+{
+	String zeroTerminated(text);
+	T value{};
+	bool result = zeroTerminated.to(value);
+
+	String buffer;
+	buffer << text << "12345";
+	T viewValue{};
+	bool viewResult = AnyString(buffer.c_str(), static_cast<uint>(std::strlen(text))).to(viewValue);
+
+	String message;
+	message << '"' << text << "\" -> " << expected << (success ? " (success)" : " (failure)");
+	Check(checkpoint, result == success and Same(value, expected)
+		and viewResult == success and Same(viewValue, expected), message.c_str());
+}
+
+
+
+
+static void Sign()
+{
+	Test::Checkpoint checkpoint("parse: sign");
+	Expect<int>(checkpoint, "+5", true, 5);
+	Expect<int>(checkpoint, "-5", true, -5);
+	Expect<int>(checkpoint, "-0", true, 0);
+	Expect<int>(checkpoint, "-", false, 0);
+	Expect<int>(checkpoint, "+", false, 0);
+	Expect<int>(checkpoint, "--5", false, 0);
+	Expect<uint>(checkpoint, "+5", true, 5u);
+	Expect<uint>(checkpoint, "-1", false, 0u); // was 4294967295 (success)
+	Expect<uint64>(checkpoint, "-1", false, 0ull);
+	Expect<double>(checkpoint, "-0", true, -0.);
+	Expect<double>(checkpoint, "+1.5", true, 1.5);
+}
+
+
+static void Overflow()
+{
+	Test::Checkpoint checkpoint("parse: overflow");
+	Expect<int>(checkpoint, "2147483647", true, INT_MAX);
+	Expect<int>(checkpoint, "2147483648", false, INT_MAX);
+	Expect<int>(checkpoint, "4294967296", false, INT_MAX); // was 0 (success)
+	Expect<int>(checkpoint, "-2147483648", true, INT_MIN);
+	Expect<int>(checkpoint, "-2147483649", false, INT_MIN);
+	Expect<uint>(checkpoint, "4294967295", true, UINT_MAX);
+	Expect<uint>(checkpoint, "4294967296", false, UINT_MAX);
+	Expect<sint64>(checkpoint, "9223372036854775807", true, std::numeric_limits<sint64>::max());
+	Expect<sint64>(checkpoint, "9223372036854775808", false, std::numeric_limits<sint64>::max());
+	Expect<sint64>(checkpoint, "-9223372036854775808", true, std::numeric_limits<sint64>::min());
+	Expect<sint64>(checkpoint, "-9223372036854775809", false, std::numeric_limits<sint64>::min());
+	Expect<uint64>(checkpoint, "18446744073709551615", true, std::numeric_limits<uint64>::max());
+	Expect<uint64>(checkpoint, "18446744073709551616", false, std::numeric_limits<uint64>::max());
+	Expect<double>(checkpoint, "1e400", true, std::numeric_limits<double>::infinity());
+	Expect<float>(checkpoint, "3.4028236e38", true, std::numeric_limits<float>::infinity());
+}
+
+
+static void Whitespaces()
+{
+	Test::Checkpoint checkpoint("parse: whitespaces");
+	Expect<int>(checkpoint, " 42", true, 42);
+	Expect<int>(checkpoint, "\t42", true, 42);
+	Expect<int>(checkpoint, "42 ", false, 42);
+	Expect<int>(checkpoint, " 42 ", false, 42);
+	Expect<int>(checkpoint, "4 2", false, 4);
+	Expect<int>(checkpoint, "4a", false, 4);
+	Expect<double>(checkpoint, " 1.5", true, 1.5);
+	Expect<double>(checkpoint, "1.5 ", false, 1.5);
+	Expect<double>(checkpoint, "1,5", false, 1.);
+}
+
+
+static void Hexadecimal()
+{
+	Test::Checkpoint checkpoint("parse: hexadecimal");
+	Expect<int>(checkpoint, "0x1F", true, 31); // was a failure for the zero-terminated strings
+	Expect<int>(checkpoint, "0x1f", true, 31);
+	Expect<int>(checkpoint, "#1F", true, 31);
+	Expect<uint>(checkpoint, "0xFFFFFFFF", true, UINT_MAX);
+	Expect<uint>(checkpoint, "0x100000000", false, UINT_MAX);
+	Expect<uint64>(checkpoint, "0xFFFFFFFFFFFFFFFF", true, std::numeric_limits<uint64>::max());
+	Expect<int>(checkpoint, "0x1G", false, 1);
+}
+
+
+static void ManyDigits()
+{
+	Test::Checkpoint checkpoint("parse: more than 19 digits");
+	Expect<uint64>(checkpoint, "00000000000000000000000000042", true, 42ull);
+	Expect<uint64>(checkpoint, "123456789012345678901234", false, std::numeric_limits<uint64>::max());
+	Expect<sint64>(checkpoint, "-123456789012345678901234", false, std::numeric_limits<sint64>::min());
+	Expect<double>(checkpoint, "123456789012345678901234", true, 123456789012345678901234.);
+	Expect<double>(checkpoint, "0.1000000000000000055511151231257827021181583404541015625", true, 0.1);
+	// exactly halfway between 1 and the next double, then just above
+	Expect<double>(checkpoint, "1.00000000000000011102230246251565404236316680908203125", true, 1.);
+	Expect<double>(checkpoint, "1.00000000000000011102230246251565404236316680908203126", true,
+		std::nextafter(1., 2.));
+}
+
+
+static void Subnormals()
+{
+	Test::Checkpoint checkpoint("parse: subnormals");
+	const double denormMin = std::numeric_limits<double>::denorm_min();
+	Expect<double>(checkpoint, "4.9e-324", true, denormMin);
+	Expect<double>(checkpoint, "2.4703282292062327e-324", true, 0.); // below the half of the smallest one
+	Expect<double>(checkpoint, "2.4703282292062328e-324", true, denormMin);
+	Expect<double>(checkpoint, "2.2250738585072011e-308", true, 2.2250738585072009e-308);
+	Expect<double>(checkpoint, "2.2250738585072014e-308", true, std::numeric_limits<double>::min());
+	Expect<double>(checkpoint, "1e-400", true, 0.);
+	Expect<float>(checkpoint, "1.4e-45", true, std::numeric_limits<float>::denorm_min());
+	Expect<float>(checkpoint, "1e-46", true, 0.f);
+	Expect<float>(checkpoint, "1.1754944e-38", true, std::numeric_limits<float>::min());
+}
+
+
+static void InfinityAndNaN()
+{
+	Test::Checkpoint checkpoint("parse: infinity and nan");
+	const double inf = std::numeric_limits<double>::infinity();
+	Expect<double>(checkpoint, "inf", true, inf);
+	Expect<double>(checkpoint, "-inf", true, -inf);
+	Expect<double>(checkpoint, "infinity", true, inf);
+	Expect<float>(checkpoint, "inf", true, std::numeric_limits<float>::infinity());
+
+	double value = 0;
+	Check(checkpoint, AnyString("nan").to(value) and std::isnan(value), "\"nan\" -> nan (success)");
+	value = 0;
+	Check(checkpoint, AnyString("NaN").to(value) and std::isnan(value), "\"NaN\" -> nan (success)");
+}
+
+
+static void SameAsStrtod()
+{
+	Test::Checkpoint checkpoint("parse: same values as strtod()");
+	uint mismatches = 0;
+	uint64 seed = 0x9E3779B97F4A7C15ull;
+	char text[64];
+	for (uint i = 0; i != 100000; ++i)
+	{
+		// 1 to 25 digits, with a decimal point and an exponent
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		uint digits = 1 + static_cast<uint>((seed >> 8) % 25);
+		uint point = static_cast<uint>((seed >> 16) % (digits + 1));
+		int exponent = static_cast<int>((seed >> 24) % 700) - 350;
+		uint length = 0;
+		uint64 random = seed;
+		for (uint d = 0; d != digits; ++d)
+		{
+			if (d == point and d != 0)
+				text[length++] = '.';
+			random = random * 6364136223846793005ull + 1442695040888963407ull;
+			text[length++] = static_cast<char>('0' + (random >> 59) % 10);
+		}
+		length += static_cast<uint>(std::snprintf(text + length, sizeof(text) - length, "e%d", exponent));
+
+		double value = 0;
+		AnyString(text, length).to(value);
+		if (not Same(value, std::strtod(text, nullptr)))
+			++mismatches;
+		float single = 0;
+		AnyString(text, length).to(single);
+		if (not Same(single, std::strtof(text, nullptr)))
+			++mismatches;
+	}
+	Check(checkpoint, mismatches == 0, "random decimal numbers");
+}
+
+
+
+
+int main()
+{
+	Sign();
+	Overflow();
+	Whitespaces();
+	Hexadecimal();
+	ManyDigits();
+	Subnormals();
+	InfinityAndNaN();
+	SameAsStrtod();
+	return ExitCode();
+}
@@ -0,0 +1,352 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include "../../helpers.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace Yuni;
+using namespace Yuni::Private::CStringImpl;
+
+
+
+//! The chars of the haystacks: letters, the chars around the letters, and some bytes >= 0x80
+static const char alphabet[] = {
+	'a', 'b', 'z', 'A', 'B', 'Z', '@', '[', '`', '{', '\0',
+	static_cast<char>(0x80), static_cast<char>(0xC1), static_cast<char>(0xE1), static_cast<char>(0xFF)
+};
+
+//! Random number generator (deterministic)
+static uint64 seed = 0x9E3779B97F4A7C15ull;
+
+//! Get a random number in [0, max)
+static uint Random(uint max)
+{
+	seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+	return static_cast<uint>((seed >> 33) % max);
+}
+
+//! Get a random char, mostly from the beginning of the alphabet (to find some matches)
+static char RandomChar()
+{
+	uint r = Random(3);
+	return alphabet[(r == 0) ? Random(sizeof(alphabet)) : Random(3 + r)];
+}
+
+//! Fill a buffer with random chars
+static void Fill(char* buffer, size_t n)
+{
+	for (size_t i = 0; i != n; ++i)
+		buffer[i] = RandomChar();
+}
+
+//! Number of mismatches between the functions and the references
+static uint mismatches = 0;
+
+//! Report a mismatch (the first ones only)
+static void Mismatch(const char* function, const char* kernels, size_t n, const char* what, size_t value,
+	size_t expected, size_t result)
+{
+	if (++mismatches <= 10)
+	{
+		std::cerr << "  mismatch: " << function << " (" << kernels << "), length " << n << ", " << what << ' '
+			<< value << ": expected " << expected << ", got " << result << std::endl;
+	}
+}
+
+
+
+
+//! \name References (scalar, naive)
+//@{
+static char Lower(char c)
+{
+	return (c >= 'A' and c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+static bool Same(char a, char b, bool insensitive)
+{
+	return insensitive ? (Lower(a) == Lower(b)) : (a == b);
+}
+
+static bool Matches(const char* s, const char* needle, size_t len, bool insensitive)
+{
+	for (size_t i = 0; i != len; ++i)
+	{
+		if (not Same(s[i], needle[i], insensitive))
+			return false;
+	}
+	return true;
+}
+
+static bool InSet(char c, const char* set, size_t setlen, bool insensitive)
+{
+	for (size_t j = 0; j != setlen; ++j)
+	{
+		if (Same(c, set[j], insensitive))
+			return true;
+	}
+	return false;
+}
+
+//! First index in [begin, end) matching a predicate, searchNotFound otherwise
+template<class F>
+static size_t First(size_t begin, size_t end, const F& predicate)
+{
+	for (size_t i = begin; i < end; ++i)
+	{
+		if (predicate(i))
+			return i;
+	}
+	return searchNotFound;
+}
+
+//! Last index in [0, end) matching a predicate, searchNotFound otherwise
+template<class F>
+static size_t Last(size_t end, const F& predicate)
+{
+	while (end--)
+	{
+		if (predicate(end))
+			return end;
+	}
+	return searchNotFound;
+}
+//@}
+
+
+
+
+/*!
+** \brief Compare the kernels of an instruction set with the references
+**
+** The haystacks are stored at various alignments, with lengths around 16 and
+** 32 bytes (the width of the SSE2 and AVX2 registers).
+*/
+static void Kernels(const SearchKernels& kernels)
+{
+	char storage[160];
+	char needle[24];
+	for (size_t n = 0; n <= 100; n = (n < 70) ? n + 1 : n + 10)
+	{
+		for (uint trial = 0; trial != 40; ++trial)
+		{
+			char* s = storage + Random(32);
+			Fill(s, n);
+			char c = RandomChar();
+			const uint code = static_cast<unsigned char>(c);
+
+			for (int insensitive = 0; insensitive != 2; ++insensitive)
+			{
+				bool i = (insensitive != 0);
+				auto equals = [&](size_t k) { return Same(s[k], c, i); };
+				size_t expected = First(0, n, equals);
+				size_t result = (i ? kernels.ifindChar : kernels.findChar)(s, n, c);
+				if (result != expected)
+					Mismatch(i ? "ifindChar" : "findChar", kernels.name, n, "char", code, expected, result);
+				expected = Last(n, equals);
+				result = (i ? kernels.irfindChar : kernels.rfindChar)(s, n, c);
+				if (result != expected)
+					Mismatch(i ? "irfindChar" : "rfindChar", kernels.name, n, "char", code, expected, result);
+
+				// sets of 0 to 20 chars (more than the chars handled by the vectorized kernels)
+				size_t setlen = Random(21);
+				Fill(needle, setlen);
+				auto any = [&](size_t k) { return InSet(s[k], needle, setlen, i); };
+				expected = First(0, n, any);
+				result = (i ? kernels.ifindAnyOf : kernels.findAnyOf)(s, n, needle, setlen);
+				if (result != expected)
+					Mismatch(i ? "ifindAnyOf" : "findAnyOf", kernels.name, n, "set of", setlen, expected, result);
+				expected = Last(n, any);
+				result = (i ? kernels.irfindAnyOf : kernels.rfindAnyOf)(s, n, needle, setlen);
+				if (result != expected)
+					Mismatch(i ? "irfindAnyOf" : "rfindAnyOf", kernels.name, n, "set of", setlen, expected, result);
+
+				// substrings of 1 to n chars, found at least once most of the time
+				if (n != 0)
+				{
+					size_t len = 1 + Random(static_cast<uint>((n < sizeof(needle)) ? n : sizeof(needle)));
+					if (Random(4) != 0)
+						std::memcpy(needle, s + Random(static_cast<uint>(n - len + 1)), len);
+					else
+						Fill(needle, len);
+					auto found = [&](size_t k) { return Matches(s + k, needle, len, i); };
+					expected = First(0, n - len + 1, found);
+					result = (i ? kernels.ifind : kernels.find)(s, n, needle, len);
+					if (result != expected)
+						Mismatch(i ? "ifind" : "find", kernels.name, n, "needle of", len, expected, result);
+					expected = Last(n - len + 1, found);
+					result = (i ? kernels.irfind : kernels.rfind)(s, n, needle, len);
+					if (result != expected)
+						Mismatch(i ? "irfind" : "rfind", kernels.name, n, "needle of", len, expected, result);
+				}
+			}
+
+			size_t count = 0;
+			for (size_t k = 0; k != n; ++k)
+				count += (s[k] == c) ? 1 : 0;
+			size_t result = kernels.countChar(s, n, c);
+			if (result != count)
+				Mismatch("countChar", kernels.name, n, "char", code, count, result);
+		}
+	}
+}
+
+
+//! Convert the result of a reference into the result of CString
+static String::Size Position(size_t r)
+{
+	return (r == searchNotFound) ? String::npos : static_cast<String::Size>(r);
+}
+
+
+/*!
+** \brief Compare the methods of CString with the references, with the kernels currently used
+**
+** The offsets are tested up to and past the end of the string.
+*/
+static void Methods(const char* name)
+{
+	for (uint n = 0; n <= 70; ++n)
+	{
+		for (uint trial = 0; trial != 20; ++trial)
+		{
+			char buffer[80];
+			Fill(buffer, n);
+			String s(buffer, n);
+			const char* data = s.c_str();
+			char c = RandomChar();
+
+			char set[20];
+			size_t setlen = Random(21);
+			Fill(set, setlen);
+			AnyString sequence(set, static_cast<uint>(setlen));
+
+			// a substring of the string, or random chars (possibly longer than the string)
+			char text[24];
+			uint len = 1 + Random(static_cast<uint>(sizeof(text)));
+			if (n != 0 and len <= n and Random(4) != 0)
+				std::memcpy(text, data + Random(n - len + 1), len);
+			else
+				Fill(text, len);
+			AnyString needle(text, len);
+
+			auto found = [&](size_t k, bool i) { return Matches(data + k, text, len, i); };
+			auto equals = [&](size_t k, bool i) { return Same(data[k], c, i); };
+			auto any = [&](size_t k, bool i) { return InSet(data[k], set, setlen, i); };
+
+			// without offset
+			size_t count = 0;
+			for (uint k = 0; k != n; ++k)
+				count += (data[k] == c) ? 1 : 0;
+			if (s.countChar(c) != count)
+				Mismatch("countChar", name, n, "offset", 0, count, s.countChar(c));
+			bool has = (First(0, n, [&](size_t k) { return equals(k, false); }) != searchNotFound);
+			if (s.contains(c) != has)
+				Mismatch("contains(char)", name, n, "offset", 0, has, s.contains(c));
+			has = (len <= n and First(0, n - len + 1, [&](size_t k) { return found(k, false); }) != searchNotFound);
+			if (s.contains(needle) != has)
+				Mismatch("contains(string)", name, n, "offset", 0, has, s.contains(needle));
+			if (s.contains(AnyString()))
+				Mismatch("contains(empty string)", name, n, "offset", 0, false, true);
+
+			const uint offsets[] = {0, 1, n / 2, n - 1, n, n + 1, n + 100, String::npos};
+			for (uint offset: offsets)
+			{
+				if (offset > n + 1000 and offset != String::npos)
+					continue; // n - 1, with n = 0
+				for (int insensitive = 0; insensitive != 2; ++insensitive)
+				{
+					bool i = (insensitive != 0);
+					// forward: from the offset, nothing at or past the end
+					size_t expected = (offset < n)
+						? First(offset, n, [&](size_t k) { return equals(k, i); }) : searchNotFound;
+					String::Size result = i ? s.ifind(c, offset) : s.find(c, offset);
+					if (result != Position(expected))
+						Mismatch(i ? "ifind(char)" : "find(char)", name, n, "offset", offset, expected, result);
+
+					expected = (offset < n) ? First(offset, n, [&](size_t k) { return any(k, i); }) : searchNotFound;
+					result = i ? s.ifind_first_of(sequence, offset) : s.find_first_of(sequence, offset);
+					if (result != Position(expected))
+						Mismatch(i ? "ifind_first_of" : "find_first_of", name, n, "offset", offset, expected, result);
+
+					// the occurence must be entirely within the string
+					expected = (len <= n and offset <= n - len)
+						? First(offset, n - len + 1, [&](size_t k) { return found(k, i); }) : searchNotFound;
+					result = i ? s.ifind(needle, offset) : s.find(needle, offset);
+					if (result != Position(expected))
+						Mismatch(i ? "ifind(string)" : "find(string)", name, n, "offset", offset, expected, result);
+
+					// backward: up to the offset (included)
+					size_t end = (offset >= n) ? n : offset + 1;
+					expected = Last(end, [&](size_t k) { return equals(k, i); });
+					result = i ? s.irfind(c, offset) : s.rfind(c, offset);
+					if (result != Position(expected))
+						Mismatch(i ? "irfind(char)" : "rfind(char)", name, n, "offset", offset, expected, result);
+					if (not i and s.find_last_of(c, offset) != result)
+						Mismatch("find_last_of(char)", name, n, "offset", offset, expected, s.find_last_of(c, offset));
+
+					expected = Last(end, [&](size_t k) { return any(k, i); });
+					result = i ? s.ifind_last_of(sequence, offset) : s.find_last_of(sequence, offset);
+					if (result != Position(expected))
+						Mismatch(i ? "ifind_last_of" : "find_last_of", name, n, "offset", offset, expected, result);
+
+					// the occurence must end at the offset at most (and the offset be at least its length)
+					expected = (len <= n and offset >= len and end >= len)
+						? Last(end - len + 1, [&](size_t k) { return found(k, i); }) : searchNotFound;
+					result = i ? s.irfind(needle, offset) : s.rfind(needle, offset);
+					if (result != Position(expected))
+						Mismatch(i ? "irfind(string)" : "rfind(string)", name, n, "offset", offset, expected, result);
+				}
+			}
+		}
+	}
+}
+
+
+
+
+static void SearchKernelsOf(SearchInstructionSet set, const char* name)
+{
+	String id;
+	id << "search: " << name << " kernels against the references";
+	Test::Checkpoint checkpoint(id.c_str());
+	const SearchKernels* kernels = Search(set);
+	if (not kernels)
+	{
+		Check(checkpoint, set != SearchInstructionSet::scalar, "not supported by this processor");
+		return;
+	}
+	const SearchKernels* previous = searchKernels.load();
+	mismatches = 0;
+	Kernels(*kernels);
+	Check(checkpoint, mismatches == 0, "kernels");
+
+	// the methods of CString, with these kernels
+	mismatches = 0;
+	searchKernels.store(kernels);
+	Methods(name);
+	searchKernels.store(previous);
+	Check(checkpoint, mismatches == 0, "methods of CString, with offsets up to and past the end");
+}
+
+
+
+
+int main()
+{
+	SearchKernelsOf(SearchInstructionSet::scalar, "scalar");
+	SearchKernelsOf(SearchInstructionSet::sse2, "sse2");
+	SearchKernelsOf(SearchInstructionSet::avx2, "avx2");
+	return ExitCode();
+}
@@ -0,0 +1,261 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/core/string.h>
+#include "../../helpers.h"
+#include <string>
+#include <utility>
+#include <cstdlib>
+
+using namespace Yuni;
+
+
+
+//! A content stored inline (15 bytes at most, with the final zero)
+static const char* const shortText = "short";
+//! A content stored on the heap
+static const char* const longText = "a content too long to be stored within the string";
+
+
+//! Get if the content of a string is stored within the string itself
+static bool Inline(const String& string)
+{
+	auto* begin = reinterpret_cast<const char*>(&string);
+	return string.data() >= begin and string.data() < begin + sizeof(String);
+}
+
+
+//! Get if a string has the expected content (and is zero-terminated)
+static bool Equals(const String& string, const std::string& expected)
+{
+	return string.size() == expected.size() and string == AnyString(expected.c_str(), static_cast<uint>(expected.size()))
+		and string.c_str()[string.size()] == '\0';
+}
+
+
+
+
+static void Copy()
+{
+	Test::Checkpoint checkpoint("sso: copy");
+	String inlined = shortText;
+	String heap = longText;
+	Check(checkpoint, Inline(inlined) and not Inline(heap), "short contents inline, long ones on the heap");
+
+	String a(inlined);
+	String b(heap);
+	Check(checkpoint, Inline(a) and Equals(a, shortText), "copy of an inline string");
+	Check(checkpoint, not Inline(b) and b.data() != heap.data() and Equals(b, longText), "copy of a heap string");
+	a << '!';
+	b << '!';
+	Check(checkpoint, Equals(inlined, shortText) and Equals(heap, longText), "the copies are independent");
+
+	// assignment in both directions
+	a = heap;
+	b = inlined;
+	Check(checkpoint, Equals(a, longText) and not Inline(a), "inline string assigned from a heap one");
+	Check(checkpoint, Equals(b, shortText), "heap string assigned from an inline one");
+}
+
+
+static void Move()
+{
+	Test::Checkpoint checkpoint("sso: move");
+	String inlined = shortText;
+	String a(std::move(inlined));
+	Check(checkpoint, Inline(a) and Equals(a, shortText), "move of an inline string (copied)");
+	Check(checkpoint, inlined.empty(), "the moved inline string is empty");
+	inlined << "reused";
+	Check(checkpoint, Equals(inlined, "reused") and Equals(a, shortText), "the moved inline string can be reused");
+
+	String heap = longText;
+	const char* buffer = heap.data();
+	String b(std::move(heap));
+	Check(checkpoint, b.data() == buffer and Equals(b, longText), "move of a heap string (buffer taken)");
+	Check(checkpoint, heap.empty(), "the moved heap string is empty");
+	heap << "reused";
+	Check(checkpoint, Equals(heap, "reused"), "the moved heap string can be reused");
+
+	// move assignment, between inline and heap strings
+	String c = longText;
+	String d = shortText;
+	c = std::move(d);
+	Check(checkpoint, Inline(c) and Equals(c, shortText), "heap string, move-assigned from an inline one");
+	String e = shortText;
+	String f = longText;
+	buffer = f.data();
+	e = std::move(f);
+	Check(checkpoint, e.data() == buffer and Equals(e, longText), "inline string, move-assigned from a heap one");
+}
+
+
+static void Swap()
+{
+	Test::Checkpoint checkpoint("sso: swap");
+	String inlined = shortText;
+	String heap = longText;
+	const char* buffer = heap.data();
+	inlined.swap(heap);
+	Check(checkpoint, inlined.data() == buffer and Equals(inlined, longText), "inline <-> heap: the heap buffer is exchanged");
+	Check(checkpoint, Inline(heap) and Equals(heap, shortText), "inline <-> heap: the inline content is copied");
+	inlined.swap(heap);
+	Check(checkpoint, Inline(inlined) and Equals(inlined, shortText) and Equals(heap, longText), "and back");
+
+	String a = "first";
+	String b = "second";
+	a.swap(b);
+	Check(checkpoint, Inline(a) and Inline(b) and Equals(a, "second") and Equals(b, "first"), "inline <-> inline");
+	a << " and more, on the heap";
+	Check(checkpoint, Equals(a, "second and more, on the heap") and Equals(b, "first"), "still independent");
+
+	String empty;
+	empty.swap(a);
+	Check(checkpoint, a.empty() and Equals(empty, "second and more, on the heap"), "empty <-> heap");
+	b.swap(a);
+	Check(checkpoint, b.empty() and Equals(a, "first"), "inline <-> empty");
+}
+
+
+static void Shrink()
+{
+	Test::Checkpoint checkpoint("sso: truncate then shrink");
+	String string = longText;
+	string.truncate(10);
+	Check(checkpoint, not Inline(string) and Equals(string, std::string(longText, 10)), "truncate() keeps the buffer");
+	string.shrink();
+	Check(checkpoint, Inline(string) and Equals(string, std::string(longText, 10)), "shrink() goes back to the inline storage");
+	Check(checkpoint, string.capacity() == 16, "inline capacity");
+
+	String boundary = longText;
+	boundary.truncate(15);
+	boundary.shrink();
+	Check(checkpoint, Inline(boundary) and Equals(boundary, std::string(longText, 15)), "15 bytes: inline");
+	boundary = longText;
+	boundary.truncate(16);
+	boundary.shrink();
+	Check(checkpoint, not Inline(boundary) and Equals(boundary, std::string(longText, 16)), "16 bytes: on the heap");
+
+	string << longText;
+	Check(checkpoint, not Inline(string) and Equals(string, std::string(longText, 10) + longText), "grows again");
+	string.clear();
+	string.shrink();
+	Check(checkpoint, string.empty() and string.capacity() == 0, "shrink() of an empty string releases the buffer");
+	string << shortText;
+	Check(checkpoint, Inline(string) and Equals(string, shortText), "reused");
+}
+
+
+static void ForgetContent()
+{
+	Test::Checkpoint checkpoint("sso: forgetContent()");
+	String inlined = shortText;
+	char* content = inlined.forgetContent();
+	auto* begin = reinterpret_cast<const char*>(&inlined);
+	bool within = (content >= begin and content < begin + sizeof(String));
+	Check(checkpoint, content and not within, "inline: a new block is returned");
+	Check(checkpoint, content and std::string(content) == shortText, "inline: the content is copied");
+	Check(checkpoint, inlined.empty() and inlined.capacity() == 0, "inline: the string is reset");
+	::free(content);
+	inlined << shortText;
+	Check(checkpoint, Equals(inlined, shortText), "inline: the string can be reused");
+
+	String heap = longText;
+	const char* buffer = heap.data();
+	content = heap.forgetContent();
+	Check(checkpoint, content == buffer and std::string(content) == longText, "heap: the buffer itself is returned");
+	Check(checkpoint, heap.empty() and heap.capacity() == 0, "heap: the string is reset");
+	::free(content);
+	heap << longText;
+	Check(checkpoint, Equals(heap, longText), "heap: the string can be reused");
+}
+
+
+static void SelfAppend()
+{
+	Test::Checkpoint checkpoint("sso: self-append");
+	// all sizes around the inline capacity, and the growth of a heap buffer
+	for (uint length = 1; length != 40; ++length)
+	{
+		std::string expected = std::string(longText, length);
+		String string = expected.c_str();
+		string.append(string);
+		bool whole = Equals(string, expected + expected);
+
+		string.assign(expected.c_str(), length);
+		string.append(string.c_str() + length / 2, length - length / 2);
+		bool part = Equals(string, expected + expected.substr(length / 2));
+
+		string.assign(expected.c_str(), length);
+		string += string;
+		string += string;
+		bool twice = Equals(string, expected + expected + expected + expected);
+
+		if (not whole or not part or not twice)
+		{
+			String message;
+			message << "self-append of " << length << " bytes";
+			Check(checkpoint, false, message.c_str());
+			return;
+		}
+	}
+	Check(checkpoint, true, "1 to 39 bytes");
+}
+
+
+static void SelfInsert()
+{
+	Test::Checkpoint checkpoint("sso: self-insert");
+	for (uint length = 1; length != 40; ++length)
+	{
+		std::string expected = std::string(longText, length);
+		bool success = true;
+		for (uint offset = 0; offset <= length and success; ++offset)
+		{
+			String string = expected.c_str();
+			string.insert(offset, string);
+			success = Equals(string, std::string(expected).insert(offset, expected));
+
+			// a part of the string after the offset (moved by the insertion)
+			string.assign(expected.c_str(), length);
+			uint from = (offset + length) / 2;
+			string.insert(offset, string.c_str() + from, length - from);
+			success = success and Equals(string, std::string(expected).insert(offset, expected.substr(from)));
+
+			// a part of the string before the offset
+			string.assign(expected.c_str(), length);
+			string.insert(offset, string.c_str(), offset);
+			success = success and Equals(string, std::string(expected).insert(offset, expected.substr(0, offset)));
+		}
+		if (not success)
+		{
+			String message;
+			message << "self-insert into " << length << " bytes";
+			Check(checkpoint, false, message.c_str());
+			return;
+		}
+	}
+	Check(checkpoint, true, "1 to 39 bytes, at all offsets");
+}
+
+
+
+
+int main()
+{
+	Copy();
+	Move();
+	Swap();
+	Shrink();
+	ForgetContent();
+	SelfAppend();
+	SelfInsert();
+	return ExitCode();
+}
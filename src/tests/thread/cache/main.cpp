@@ -0,0 +1,105 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/thread/thread.h>
+#include <yuni/thread/utility.h>
+#include "../../helpers.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+using namespace Yuni;
+
+
+
+//! A thread from the cache, ignoring the requests to stop for a while
+class SlowThread final : public Thread::IThread
+{
+public:
+	SlowThread()
+	{
+		useThreadCache();
+	}
+
+	virtual ~SlowThread()
+	{
+		stop();
+	}
+
+	std::atomic<bool> finished {false};
+
+protected:
+	virtual bool onExecute() override
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		finished = true;
+		return false;
+	}
+};
+
+
+
+
+static void Reuse()
+{
+	Test::Checkpoint checkpoint("thread cache: the native threads are reused");
+	std::thread::id first;
+	std::thread::id second;
+	spawn([&]() { first = std::this_thread::get_id(); })->wait();
+	spawn([&]() { second = std::this_thread::get_id(); })->wait();
+	# ifndef YUNI_OS_WINDOWS
+	Check(checkpoint, first == second, "the second thread runs on the native thread of the first one");
+	# else
+	Check(checkpoint, true, "no cache on Windows");
+	# endif
+}
+
+
+static void Join()
+{
+	Test::Checkpoint checkpoint("thread cache: joining threads released at any time");
+	std::atomic<uint> count{0};
+	for (uint i = 0; i != 2000; ++i)
+	{
+		// the thread is released before, while, or after being joined
+		auto thread = spawn([&]() { ++count; }, false);
+		thread->start();
+		if (i % 2)
+			std::this_thread::yield();
+		thread->stop();
+	}
+	Check(checkpoint, count.load() == 2000, "all threads have been joined");
+}
+
+
+static void StopWithTimeout()
+{
+	Test::Checkpoint checkpoint("thread cache: a thread from the cache is never killed");
+	SlowThread thread;
+	thread.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	Check(checkpoint, thread.stop(10) == Thread::errTimeout, "the timeout is reported");
+	Check(checkpoint, thread.finished.load(), "the thread has not been killed, stop() waited for it");
+}
+
+
+
+
+int main()
+{
+	spawnKeepAlive(30000);
+	Reuse();
+	Join();
+	StopWithTimeout();
+	spawnKeepAlive(0);
+	return ExitCode();
+}
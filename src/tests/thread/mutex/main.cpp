@@ -0,0 +1,99 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/thread/mutex.h>
+#include "../../helpers.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+using namespace Yuni;
+
+
+
+static void Exclusion(const char* id, Mutex::Waiting waiting)
+{
+	Test::Checkpoint checkpoint(id);
+	Mutex mutex(true, waiting);
+	uint64 counter = 0;
+	std::atomic<uint> inside{0};
+	std::atomic<uint> overlaps{0};
+	std::vector<std::thread> threads;
+	for (uint t = 0; t != 4; ++t)
+	{
+		threads.emplace_back([&]()
+		{
+			for (uint i = 0; i != 50000; ++i)
+			{
+				MutexLocker locker(mutex);
+				if (inside.fetch_add(1) != 0)
+					++overlaps;
+				++counter;
+				inside.fetch_sub(1);
+			}
+		});
+	}
+	for (auto& thread: threads)
+		thread.join();
+	Check(checkpoint, overlaps.load() == 0, "a single thread at a time");
+	Check(checkpoint, counter == 200000, "no increment is lost");
+}
+
+
+static void Recursive(const char* id, Mutex::Waiting waiting)
+{
+	Test::Checkpoint checkpoint(id);
+	Mutex mutex(true, waiting);
+	mutex.lock();
+	Check(checkpoint, mutex.trylock(), "locked twice by the same thread");
+	mutex.lock();
+
+	bool other = true;
+	std::thread([&]() { other = mutex.trylock(); }).join();
+	Check(checkpoint, not other, "not available to another thread");
+
+	mutex.unlock();
+	mutex.unlock();
+	mutex.unlock();
+	std::thread([&]()
+	{
+		other = mutex.trylock();
+		if (other)
+			mutex.unlock();
+	}).join();
+	Check(checkpoint, other, "available once unlocked as many times as locked");
+}
+
+
+static void Copy()
+{
+	Test::Checkpoint checkpoint("mutex: copy");
+	Mutex mutex(false, Mutex::Waiting::spin);
+	Mutex copy(mutex);
+	copy.lock();
+	Check(checkpoint, mutex.trylock(), "the copy is another mutex");
+	mutex.unlock();
+	copy.unlock();
+}
+
+
+
+
+int main()
+{
+	Exclusion("mutex: exclusion", Mutex::Waiting::sleep);
+	Exclusion("mutex: exclusion (spinning)", Mutex::Waiting::spin);
+	Recursive("mutex: recursive", Mutex::Waiting::sleep);
+	Recursive("mutex: recursive (spinning)", Mutex::Waiting::spin);
+	Copy();
+	return ExitCode();
+}
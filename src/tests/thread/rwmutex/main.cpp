@@ -0,0 +1,152 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/thread/rwmutex.h>
+#include "../../helpers.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+using namespace Yuni;
+
+
+
+static void ConcurrentReaders()
+{
+	Test::Checkpoint checkpoint("rwmutex: more than 64 concurrent readers");
+	RWMutex mutex;
+	const uint count = 100;
+	std::atomic<uint> inside{0};
+	std::atomic<bool> all{true};
+	std::vector<std::thread> threads;
+	for (uint i = 0; i != count; ++i)
+	{
+		threads.emplace_back([&]()
+		{
+			ReadMutexLocker locker(mutex);
+			++inside;
+			if (not WaitFor([&]() { return inside.load() == count; }))
+				all = false;
+		});
+	}
+	for (auto& thread: threads)
+		thread.join();
+	Check(checkpoint, all.load(), "all readers hold the lock at the same time");
+}
+
+
+static void WriterExclusion()
+{
+	Test::Checkpoint checkpoint("rwmutex: exclusion between writers and readers");
+	RWMutex mutex;
+	uint64 a = 0;
+	uint64 b = 0;
+	std::atomic<uint> inconsistencies{0};
+	std::vector<std::thread> threads;
+	for (uint t = 0; t != 4; ++t)
+	{
+		threads.emplace_back([&]()
+		{
+			for (uint i = 0; i != 20000; ++i)
+			{
+				WriteMutexLocker locker(mutex);
+				++a;
+				std::atomic_signal_fence(std::memory_order_seq_cst);
+				++b;
+			}
+		});
+		threads.emplace_back([&]()
+		{
+			for (uint i = 0; i != 20000; ++i)
+			{
+				ReadMutexLocker locker(mutex);
+				if (a != b)
+					++inconsistencies;
+			}
+		});
+	}
+	for (auto& thread: threads)
+		thread.join();
+	Check(checkpoint, inconsistencies.load() == 0, "the readers never see a write in progress");
+	Check(checkpoint, a == 80000 and b == 80000, "no write is lost");
+}
+
+
+static void WriterWaitsForReaders()
+{
+	Test::Checkpoint checkpoint("rwmutex: a writer waits for the readers");
+	RWMutex mutex;
+	std::atomic<bool> written{false};
+	mutex.readLock();
+	std::thread writer([&]()
+	{
+		WriteMutexLocker locker(mutex);
+		written = true;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	Check(checkpoint, not written.load(), "the writer is blocked by a reader");
+	mutex.readUnlock();
+	bool acquired = WaitFor([&]() { return written.load(); });
+	Check(checkpoint, acquired, "the writer acquires the lock once the reader has gone");
+	if (not acquired)
+		std::_Exit(EXIT_FAILURE);
+	writer.join();
+}
+
+
+static void CrossThreadUnlock()
+{
+	Test::Checkpoint checkpoint("rwmutex: read lock released by another thread");
+	RWMutex mutex;
+	// several locks, to be sure to use other counters than the one of the unlocking thread
+	std::vector<std::thread> threads;
+	for (uint i = 0; i != 32; ++i)
+		threads.emplace_back([&]() { mutex.readLock(); });
+	for (auto& thread: threads)
+		thread.join();
+	std::thread unlocker([&]()
+	{
+		for (uint i = 0; i != 32; ++i)
+			mutex.readUnlock();
+	});
+	unlocker.join();
+
+	std::atomic<bool> written{false};
+	std::thread writer([&]()
+	{
+		WriteMutexLocker locker(mutex);
+		written = true;
+	});
+	bool acquired = WaitFor([&]() { return written.load(); });
+	Check(checkpoint, acquired, "the writer acquires the lock");
+	if (not acquired)
+		std::_Exit(EXIT_FAILURE);
+	writer.join();
+
+	// the readers must still be able to come in
+	mutex.readLock();
+	mutex.readUnlock();
+	Check(checkpoint, true, "the readers acquire the lock");
+}
+
+
+
+
+int main()
+{
+	ConcurrentReaders();
+	WriterExclusion();
+	WriterWaitsForReaders();
+	CrossThreadUnlock();
+	return ExitCode();
+}
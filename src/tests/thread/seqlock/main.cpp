@@ -0,0 +1,130 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include <yuni/yuni.h>
+#include <yuni/thread/seqlock.h>
+#include "../../helpers.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+using namespace Yuni;
+
+
+
+//! A value larger than a word, torn if a reader sees a partial write
+struct Value final
+{
+	uint64 a;
+	uint64 b;
+	uint64 c;
+	uint64 d;
+
+	bool consistent() const
+	{
+		return b == a * 2 and c == a * 3 and d == ~a;
+	}
+
+	static Value From(uint64 a)
+	{
+		return Value{a, a * 2, a * 3, ~a};
+	}
+};
+
+
+
+
+static void ReadersAgainstWriter()
+{
+	Test::Checkpoint checkpoint("seqlock: concurrent readers against a writer");
+	const uint64 writes = 200000;
+	SeqLock<Value> lock(Value::From(0));
+	std::atomic<bool> finished{false};
+	std::atomic<uint> torn{0};
+	std::atomic<uint> backwards{0};
+	std::atomic<uint64> reads{0};
+	std::vector<std::thread> readers;
+	for (uint r = 0; r != 4; ++r)
+	{
+		readers.emplace_back([&]() {
+			uint64 last = 0;
+			uint64 count = 0;
+			do
+			{
+				Value value = lock.load();
+				if (not value.consistent())
+					++torn;
+				if (value.a < last)
+					++backwards;
+				last = value.a;
+				++count;
+			}
+			while (not finished.load());
+			reads += count;
+		});
+	}
+	for (uint64 i = 1; i <= writes; ++i)
+	{
+		if (i % 2)
+			lock.store(Value::From(i));
+		else
+			lock.update([i](Value& value) { value = Value::From(i); });
+		if ((i % 1024) == 0)
+			std::this_thread::yield(); // let the readers run, even on a single core
+	}
+	finished = true;
+	for (auto& thread: readers)
+		thread.join();
+
+	Check(checkpoint, torn.load() == 0, "no reader has seen a partial write");
+	Check(checkpoint, backwards.load() == 0, "no reader has seen an older value after a newer one");
+	Check(checkpoint, reads.load() >= 4, "the readers have run");
+	Check(checkpoint, lock.load().a == writes and lock.load().consistent(), "the last value is kept");
+}
+
+
+static void SerializedWriters()
+{
+	Test::Checkpoint checkpoint("seqlock: concurrent writers are serialized");
+	const uint64 increments = 100000;
+	SeqLock<Value> lock(Value::From(0));
+	std::atomic<uint> torn{0};
+	std::vector<std::thread> threads;
+	for (uint w = 0; w != 4; ++w)
+	{
+		threads.emplace_back([&]() {
+			for (uint64 i = 0; i != increments; ++i)
+				lock.update([](Value& value) { value = Value::From(value.a + 1); });
+		});
+	}
+	threads.emplace_back([&]() {
+		for (uint64 i = 0; i != increments; ++i)
+		{
+			if (not lock.load().consistent())
+				++torn;
+		}
+	});
+	for (auto& thread: threads)
+		thread.join();
+
+	Check(checkpoint, torn.load() == 0, "no reader has seen a partial write");
+	Check(checkpoint, lock.load().a == 4 * increments, "no update has been lost");
+}
+
+
+
+
+int main()
+{
+	ReadersAgainstWriter();
+	SerializedWriters();
+	return ExitCode();
+}
@@ -35,6 +35,18 @@ if (UNIX)
 endif()
 
 
+# malloc_usable_size() - glibc, musl
+if (UNIX AND NOT APPLE)
+	check_cxx_source_compiles("
+		#include <malloc.h>
+		#include <stdlib.h>
+		int main() {
+			void* p = malloc(42);
+			return (malloc_usable_size(p) >= 42) ? 0 : 1;
+		} " YUNI_HAS_MALLOC_USABLE_SIZE)
+endif()
+
+
 # pthread_getthreadid_np()
 if (UNIX)
 	check_cxx_source_compiles("
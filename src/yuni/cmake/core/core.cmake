@@ -121,6 +121,7 @@ add_library(yuni-static-core STATIC
 		core/event/loop.fwd.h
 		core/event/loop.h
 		core/event/loop.hxx
+		private/core/event/intake.h
 		core/event/observer/item.h
 		core/event/observer/item.hxx
 		core/event/observer/observer.h
@@ -282,8 +283,20 @@ add_library(yuni-static-core STATIC
 		core/string/traits/append.h
 		core/string/traits/assign.h
 		core/string/traits/fill.h
+		core/string/traits/format.h
+		core/string/traits/format.hxx
+		core/string/traits/format.inc.hpp
+		core/string/traits/format.cpp
 		core/string/traits/integer.h
 		core/string/traits/into.h
+		core/string/traits/parse.h
+		core/string/traits/parse.hxx
+		core/string/traits/parse.inc.hpp
+		core/string/traits/parse.cpp
+		core/string/traits/search.h
+		core/string/traits/search.hxx
+		core/string/traits/search.inc.hpp
+		core/string/traits/search.cpp
 		core/string/traits/traits.cpp
 		core/string/traits/traits.h
 		core/string/traits/traits.hxx
@@ -302,6 +315,7 @@ add_library(yuni-static-core STATIC
 		core/system/console.h
 		core/system/cpu.cpp
 		core/system/cpu.h
+		core/system/cpu.hxx
 		core/system/endian.h
 		core/system/environment.h
 		core/system/environment.cpp
@@ -434,15 +448,60 @@ add_library(yuni-static-core STATIC
 		job/queue/service.h
 		job/queue/service.hxx
 		job/queue/q-event.h
+		job/queue/statistics.cpp
+		job/queue/statistics.h
+		job/timer/service.cpp
+		job/timer/service.h
+		job/timer/service.hxx
 		job/queue/waitingroom.cpp
 		job/queue/waitingroom.h
 		job/queue/waitingroom.hxx
 		job/taskgroup.h
 		job/taskgroup.hxx
 		job/taskgroup.cpp
+		job/graph.h
+		job/graph.hxx
+		job/graph.cpp
+		job/coroutine.h
+		job/coroutine.hxx
+		job/strand.h
+		job/strand.hxx
+		job/strand.cpp
+		job/scratch.h
+		job/scratch.hxx
+		job/scratch.cpp
+		parallel/algorithm.h
+		parallel/algorithm.hxx
+		private/parallel/partitioner.h
+		private/parallel/partitioner.hxx
+		private/parallel/partitioner.cpp
 		private/jobs/queue/thread.h
 		private/jobs/queue/thread.cpp
 		private/jobs/queue/thread.hxx
+		private/jobs/queue/stealingdeque.h
+		private/jobs/queue/stealingdeque.hxx
+		private/jobs/queue/idleworkers.h
+		private/jobs/queue/idleworkers.hxx
+		private/jobs/queue/idleworkers.cpp
+		private/jobs/queue/ringbuffer.h
+		private/jobs/queue/ringbuffer.hxx
+		private/jobs/queue/statistics.h
+		private/jobs/queue/statistics.hxx
+		private/jobs/queue/statistics.cpp
+		private/jobs/queue/trace.h
+		private/jobs/queue/trace.hxx
+		private/jobs/queue/trace.cpp
+		private/jobs/pool.h
+		private/jobs/pool.cpp
+		private/jobs/lambda.h
+		private/jobs/coroutine.h
+		private/jobs/timerwheel.h
+		private/jobs/timerwheel.hxx
+		private/jobs/timerwheel.cpp
+		private/thread/futex.h
+		private/thread/futex.cpp
+		private/thread/cache.h
+		private/thread/cache.cpp
 
 		thread/array.h
 		thread/array.hxx
@@ -459,6 +518,8 @@ add_library(yuni-static-core STATIC
 		thread/rwmutex.cpp
 		thread/rwmutex.h
 		thread/rwmutex.hxx
+		thread/seqlock.h
+		thread/seqlock.hxx
 		thread/semaphore.cpp
 		thread/semaphore.h
 		thread/semaphore.hxx
@@ -473,6 +534,7 @@ add_library(yuni-static-core STATIC
 		thread/timer.h
 		thread/timer.hxx
 		thread/utility.h
+		thread/utility.hxx
 
 		${yuni_additional_os_specific}
 	)
@@ -115,6 +115,9 @@
 /* pthread pthread_attr_setstacksize */
 #cmakedefine YUNI_HAS_PTHREAD_ATTR_SETSTACKSIZE
 
+/* malloc_usable_size(), from malloc.h */
+#cmakedefine YUNI_HAS_MALLOC_USABLE_SIZE
+
 
 
 
@@ -171,3 +174,8 @@
 #if defined(YUNI_HAS_CPP_MOVE) && defined(YUNI_HAS_CPP_LAMBDA)
 # define YUNI_HAS_CPP_BIND_LAMBDA
 # endif
+
+/* C++20 coroutines (depending on the standard of the code using yuni, see 'job/coroutine.h') */
+#if defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L)
+# define YUNI_HAS_CPP_COROUTINE
+#endif
@@ -96,36 +96,45 @@ namespace Atomic
 	template<int Size, template<class> class TP>
 	inline typename Int<Size,TP>::ScalarType Int<Size,TP>::operator ++ ()
 	{
-		return (threadSafe)
-			? Private::AtomicImpl::Operator<size,TP>::Increment(*this)
-			: (++pValue);
+		if (threadSafe)
+			return Private::AtomicImpl::Operator<size,TP>::Increment(*this);
+		// read and write (the compound operators on a volatile are deprecated in C++20)
+		ScalarType value = static_cast<ScalarType>(pValue + 1);
+		pValue = value;
+		return value;
 	}
 
 
 	template<int Size, template<class> class TP>
 	inline typename Int<Size,TP>::ScalarType Int<Size,TP>::operator -- ()
 	{
-		return (threadSafe)
-			? Private::AtomicImpl::Operator<size,TP>::Decrement(*this)
-			: (--pValue);
+		if (threadSafe)
+			return Private::AtomicImpl::Operator<size,TP>::Decrement(*this);
+		ScalarType value = static_cast<ScalarType>(pValue - 1);
+		pValue = value;
+		return value;
 	}
 
 
 	template<int Size, template<class> class TP>
 	inline typename Int<Size,TP>::ScalarType Int<Size,TP>::operator ++ (int)
 	{
-		return (threadSafe)
-			? Private::AtomicImpl::Operator<size,TP>::Increment(*this) - 1
-			: (pValue++);
+		if (threadSafe)
+			return static_cast<ScalarType>(Private::AtomicImpl::Operator<size,TP>::Increment(*this) - 1);
+		ScalarType value = pValue;
+		pValue = static_cast<ScalarType>(value + 1);
+		return value;
 	}
 
 
 	template<int Size, template<class> class TP>
 	inline typename Int<Size,TP>::ScalarType Int<Size,TP>::operator -- (int)
 	{
-		return (threadSafe)
-			? Private::AtomicImpl::Operator<size,TP>::Decrement(*this) + 1
-			: (pValue--);
+		if (threadSafe)
+			return static_cast<ScalarType>(Private::AtomicImpl::Operator<size,TP>::Decrement(*this) + 1);
+		ScalarType value = pValue;
+		pValue = static_cast<ScalarType>(value - 1);
+		return value;
 	}
 
 
@@ -156,7 +165,7 @@ namespace Atomic
 		if (threadSafe)
 			Private::AtomicImpl::Operator<size,TP>::Increment(*this, v);
 		else
-			pValue += v;
+			pValue = static_cast<ScalarType>(pValue + v);
 		return *this;
 	}
 
@@ -167,7 +176,7 @@ namespace Atomic
 		if (threadSafe)
 			Private::AtomicImpl::Operator<size,TP>::Decrement(*this, v);
 		else
-			pValue -= v;
+			pValue = static_cast<ScalarType>(pValue - v);
 		return *this;
 	}
 
@@ -60,7 +60,7 @@ namespace Flow
 		/*!
 		** \brief A new request has just been added into the queue
 		**
-		** The event loop is locked when this method is called
+		** No lock is provided (the method may be called concurrently by several threads)
 		** \param request The request (bind, see EventLoopType::RequestType)
 		** \return True to allow the request to be posted
 		*/
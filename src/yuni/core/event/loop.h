@@ -11,8 +11,6 @@
 #pragma once
 #include "../../yuni.h"
 #include "event.h"
-#include "../atomic/bool.h"
-#include "../slist/slist.h"
 #include "flow/continuous.h"
 #include "flow/timer.h"
 #include "statistics/none.h"
@@ -22,6 +20,8 @@
 #include <cassert>
 #include "../../thread/thread.h"
 #include "loop.fwd.h"
+#include "../../private/core/event/intake.h"
+#include <vector>
 
 
 
@@ -86,8 +86,8 @@ namespace EventLoop
 		typedef ParentT  ParentType;
 		//! A request
 		typedef Bind<bool ()>  RequestType;
-		//! List of requests
-		typedef LinkedList<RequestType>  RequestListType;
+		//! Intake of the incoming requests
+		typedef Yuni::Private::Core::EventLoop::RequestIntake<RequestType>  RequestIntakeType;
 
 		//! The Event loop
 		typedef IEventLoop<ParentType, FlowT, StatsT, DetachedT>  EventLoopType;
@@ -165,9 +165,32 @@ namespace EventLoop
 		/*!
 		** \brief Post a new request into the queue
 		**
+		** The request is pushed without acquiring any lock (lock-free intake shared
+		** by all producers), and will be executed by the event loop in the order
+		** of arrival.
+		**
 		** \param request A request, which is merely a delegate via the class Bind<>)
 		*/
 		void dispatch(const RequestType& request);
+
+		/*!
+		** \brief Post several requests at once into the queue
+		**
+		** All requests are published with a single atomic operation, and will
+		** be executed in a row, in the same order.
+		** \code
+		** std::vector<MyEventLoop::RequestType> requests;
+		** ...
+		** loop.dispatch(requests.begin(), requests.end());
+		** \endcode
+		**
+		** \param begin Iterator to the first request
+		** \param end Iterator past the last request
+		*/
+		template<class IteratorT> void dispatch(IteratorT begin, IteratorT end);
+
+		//! Post several requests at once into the queue
+		void dispatch(const std::vector<RequestType>& requests);
 		//@}
 
 
@@ -200,14 +223,15 @@ namespace EventLoop
 		//! Perform all requests synchronously
 		bool performAllRequestsWL();
 
+		//! Post the request stopping the loop (the object must be locked)
+		void dispatchStopWL();
+
 		//! Run incoming events if any and one cycle
 		bool runCycleWL();
 
 	private:
-		//! The number of events that wait to be triggered from the inner thread
-		Atomic::Bool pHasRequests;
-		//! List of incoming request
-		RequestListType* pRequests;
+		//! Incoming requests
+		RequestIntakeType pRequests;
 		//! True if the event loop is running
 		bool pIsRunning;
 		//! External thread when ran in detached mode
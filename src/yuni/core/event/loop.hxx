@@ -101,8 +101,6 @@ namespace EventLoop
 	template<class ParentT, template<class> class FlowT, template<class> class StatsT,
 		bool DetachedT>
 	inline IEventLoop<ParentT,FlowT,StatsT,DetachedT>::IEventLoop() :
-		pHasRequests(),
-		pRequests(nullptr),
 		pIsRunning(false),
 		pThread(nullptr)
 	{
@@ -129,9 +127,6 @@ namespace EventLoop
 			if (detached)
 				delete pThread;
 			pThread = NULL; // for code safety
-			// Destroying the request list
-			delete pRequests;
-			pRequests = NULL; // for code safety
 		}
 	}
 
@@ -153,10 +148,6 @@ namespace EventLoop
 				// The event loop is running
 				pIsRunning = true;
 			}
-
-			// Initializing the request list
-			if (NULL == pRequests)
-				pRequests = new RequestListType();
 		}
 
 		if (detached)
@@ -186,17 +177,19 @@ namespace EventLoop
 		if (not pIsRunning or not FlowPolicy::onStop())
 			return;
 
+		dispatchStopWL();
+	}
+
+
+	template<class ParentT, template<class> class FlowT, template<class> class StatsT,
+		bool DetachedT>
+	inline void IEventLoop<ParentT,FlowT,StatsT,DetachedT>::dispatchStopWL()
+	{
 		// Posting a request that will fail (return false) in order to stop
 		// the event loop.
 		// The object is still locked and we directly inject the request into
-		// the request list.
-		if (NULL == pRequests)
-			pRequests = new RequestListType();
-
-		pRequests->push_back(RequestStop);
-
-		// Informing the event loop that a new request is available
-		pHasRequests = true;
+		// the request list (without the flow policy).
+		pRequests.push(new typename RequestIntakeType::Node(RequestType(RequestStop)));
 	}
 
 
@@ -211,17 +204,7 @@ namespace EventLoop
 			if (not pIsRunning or not FlowPolicy::onStop())
 				return;
 
-			// Posting a request that will fail (return false) in order to stop
-			// the event loop.
-			// The object is still locked and we directly inject the request into
-			// the request list.
-			if (NULL == pRequests)
-				pRequests = new RequestListType();
-
-			pRequests->push_back(RequestStop);
-
-			// Informing the event loop that a new request is available
-			pHasRequests = true;
+			dispatchStopWL();
 		}
 
 
@@ -270,23 +253,50 @@ namespace EventLoop
 		bool DetachedT>
 	void IEventLoop<ParentT,FlowT,StatsT,DetachedT>::dispatch(const typename IEventLoop<ParentT,FlowT,StatsT,DetachedT>::RequestType& request)
 	{
-		// Locking for inserting the new request
+		// Flow
+		if (not FlowPolicy::onRequestPosted(request))
+			return;
+		// Inserting the new request (the request may be dispatched before calling start())
+		pRequests.push(new typename RequestIntakeType::Node(request));
+		// Statistics
+		StatisticsPolicy::onRequestPosted(request);
+	}
+
+
+	template<class ParentT, template<class> class FlowT, template<class> class StatsT,
+		bool DetachedT>
+	template<class IteratorT>
+	void IEventLoop<ParentT,FlowT,StatsT,DetachedT>::dispatch(IteratorT begin, IteratorT end)
+	{
+		// building the chain from the oldest request to the newest one, to
+		// publish all of them at once
+		typename RequestIntakeType::Node* newest = nullptr;
+		typename RequestIntakeType::Node* oldest = nullptr;
+		for (; begin != end; ++begin)
 		{
-			typename ThreadingPolicy::MutexLocker locker(*this);
-			// Initializing pRequests allows for dispatching a request before calling start()
-			if (not pRequests)
-				pRequests = new RequestListType();
+			const RequestType& request = *begin;
 			// Flow
 			if (not FlowPolicy::onRequestPosted(request))
-				return;
-			// Inserting the new request
-			pRequests->push_back(request);
+				continue;
+			auto* node = new typename RequestIntakeType::Node(request);
+			node->next = newest;
+			newest = node;
+			if (not oldest)
+				oldest = node;
 			// Statistics
 			StatisticsPolicy::onRequestPosted(request);
 		}
 
-		// Informing the event loop that a new request is available
-		pHasRequests = true;
+		if (newest)
+			pRequests.push(newest, oldest);
+	}
+
+
+	template<class ParentT, template<class> class FlowT, template<class> class StatsT,
+		bool DetachedT>
+	inline void IEventLoop<ParentT,FlowT,StatsT,DetachedT>::dispatch(const std::vector<RequestType>& requests)
+	{
+		dispatch(requests.begin(), requests.end());
 	}
 
 
@@ -318,7 +328,7 @@ namespace EventLoop
 		StatisticsPolicy::onNewCycle();
 
 		// Performing requests, if any
-		if (pHasRequests)
+		if (not pRequests.empty())
 		{
 			if (not performAllRequestsWL())
 			{
@@ -341,55 +351,29 @@ namespace EventLoop
 		bool DetachedT>
 	bool IEventLoop<ParentT,FlowT,StatsT,DetachedT>::performAllRequestsWL()
 	{
-		// The request list. The pointer will be retrieved as soon as the
-		// inner mutex is locked
-		const RequestListType* requests;
-
-		// Lock and retrieve the request list
-		// We will keep a pointer to the request list, and will create a new one
-		// to release the mutex as soon as possible, to allow other threads to
-		// dispatch new requests while the event loop is working.
-		{
-			// Locking
-			typename ThreadingPolicy::MutexLocker locker(*this);
-			// No request will remain into the queue after this method
-			pHasRequests = false;
-
-			// This method may sometimes be called even if there is no request
-			// in the list.
-			if (pRequests->empty())
-				return true;
+		// Taking all requests at once, without any lock. The requests posted
+		// meanwhile will be processed by the next cycle.
+		typename RequestIntakeType::Node* node = pRequests.takeAll();
 
-			// We will take the ownership on the list, and will create a new one
-			// to release the mutex as soon as possible and to process the requests
-			// asynchronously.
-			requests = pRequests;
-			pRequests = new RequestListType();
-
-			// The mutex is unlocked here
-		}
-
-		// Assert
-		assert(requests != NULL && "IEventLoop: the request list is NULL");
-
-		// Executing all requests
-		typename RequestListType::const_iterator end = requests->end();
-		for (typename RequestListType::const_iterator i = requests->begin(); i != end; ++i)
+		// Executing all requests, in their order of arrival
+		while (node)
 		{
 			// Statistics
-			StatisticsPolicy::onProcessRequest(*i);
+			StatisticsPolicy::onProcessRequest(node->request);
 
 			// Processing the request
-			if (not (*i)())
+			if (not node->request())
 			{
 				// The request has failed. Aborting now.
-				delete requests;
+				RequestIntakeType::Release(node);
 				return false;
 			}
-		}
 
-		// The request list has been processed and can be destroyed
-		delete requests;
+			// The request has been processed and can be destroyed
+			auto* next = node->next;
+			delete node;
+			node = next;
+		}
 		return true;
 	}
 
@@ -60,7 +60,7 @@ namespace Statistics
 		/*!
 		** \brief A new request has just been added into the queue
 		**
-		** The event loop is locked when this method is called
+		** No lock is provided (the method may be called concurrently by several threads)
 		** \param request The request (bind, see EventLoopType::RequestType)
 		*/
 		template<class U> static void onRequestPosted(const U& request)
@@ -31,7 +31,7 @@ namespace GetOptImpl
 	public:
 		static bool Add(T& out, const char* c_str, const String::size_type len)
 		{
-			out = (len) ? String(c_str, len).to<T>() : T();
+			out = (len) ? AnyString(c_str, len).to<T>() : T();
 			return true;
 		}
 
@@ -72,7 +72,7 @@ namespace GetOptImpl
 		static bool Add(L<T,Alloc>& out, const char* c_str, const String::size_type len)
 		{
 			if (len)
-				out.push_back(String(c_str, len).to<T>());
+				out.push_back(AnyString(c_str, len).to<T>());
 			else
 				out.push_back(T());
 			return true;
@@ -44,6 +44,7 @@
 #include "traits/fill.h"
 #include "traits/vnsprintf.h"
 #include "traits/into.h"
+#include "traits/search.h"
 #include <utility>
 
 
@@ -107,6 +108,15 @@ namespace Yuni
 	** std::cout << "Conversion from string to rgba : " << rgba << std::endl;
 	** \endcode
 	**
+	** The floats and doubles are written with the shortest representation reading
+	** back to the same value (`42.6`, `0.1`, `1e+21`), and not with a fixed number
+	** of decimals. Use appendFormat() for a specific format.
+	**
+	** The expandable strings store the short contents (15 bytes or less) within the
+	** object itself, without any allocation. Like for std::string, the pointer
+	** returned by data() or c_str() (and the adapters on it) is thus not preserved
+	** when the string is moved or swapped.
+	**
 	** \warning This class is not thread-safe
 	** \tparam ChunkSizeT The size for a single chunk (> 3)
 	** \tparam ExpandableT True to make a growable string. Otherwise it will be a
@@ -1355,6 +1365,9 @@ namespace Yuni
 
 		/*!
 		** \brief Return the inner C-string and clear the string without freeing the inner pointer
+		**
+		** The returned pointer must be released with ::free(). A short content stored
+		** within the string itself is copied into a new block beforehand.
 		*/
 		char* forgetContent();
 
@@ -1517,6 +1530,9 @@ namespace Yuni
 		** - const char* (equivalent to `c_str()`)
 		** - numeric (int, long, uint, double...)
 		** - bool
+		**
+		** The integers are read in decimal, or in hexadecimal with the prefix `#` or `0x`.
+		** An integer out of range is clamped to the limits of the type (and the conversion fails).
 		*/
 		template<class U> U to() const;
 
@@ -1530,6 +1546,25 @@ namespace Yuni
 		** \return True if the conversion succeeded. False otherwise
 		*/
 		template<class U> bool to(U& out) const;
+
+		/*!
+		** \brief Convert the string into a number, with the position of the error
+		**
+		** The supported types are the integers, float and double. The conversions
+		** do not allocate any memory.
+		** \code
+		** uint offset;
+		** sint32 value;
+		** if (not AnyString("42px").to(value, offset))
+		**	std::cout << "invalid char at offset " << offset << std::endl; // 2
+		** \endcode
+		**
+		** \param[out] out The variable where to store the result of the conversion
+		** \param[out] offset The offset of the first invalid char (or of the digit from which
+		**   an integer is out of range), the size of the string if the conversion succeeded
+		** \return True if the conversion succeeded. False otherwise
+		*/
+		template<class U> bool to(U& out, uint& offset) const;
 		//@}
 
 
@@ -1596,7 +1631,9 @@ namespace Yuni
 		/*!
 		** \brief Ensure that there is enough allocated space for X characters
 		**
-		** The content will remain untouched.
+		** The content will remain untouched. When the buffer must be reallocated,
+		** the capacity grows by half of the current one at least, rounded up to
+		** the chunk size (see Private::CStringImpl::Growth).
 		** \param minCapacity The minimum capacity of the string (in bytes)
 		*/
 		void reserve(Size minCapacity);
@@ -1643,6 +1680,9 @@ namespace Yuni
 		** of memory used by the string.
 		** It does not modify the size of the string, only its capacity.
 		** This method has no effect if the string is not expandable.
+		**
+		** The capacity is never reduced by any other method, which would only
+		** lead to reallocate the buffer again the next time the string grows.
 		*/
 		void shrink();
 
@@ -121,7 +121,7 @@ namespace Yuni
 	template<uint ChunkSizeT, bool ExpandableT>
 	inline
 	CString<ChunkSizeT,ExpandableT>::CString(CString<ChunkSizeT,ExpandableT>&& rhs) :
-		AncestorType(rhs)
+		AncestorType(std::move(rhs))
 	{}
 
 
@@ -771,29 +771,18 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	bool
+	inline bool
 	CString<ChunkSizeT,ExpandableT>::hasChar(char c) const
 	{
-		for (Size i = 0; i != AncestorType::size; ++i)
-		{
-			if (c == AncestorType::data[i])
-				return true;
-		}
-		return false;
+		return Private::CStringImpl::searchNotFound != Private::CStringImpl::FindChar(AncestorType::data, AncestorType::size, c);
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	uint
+	inline uint
 	CString<ChunkSizeT,ExpandableT>::countChar(char c) const
 	{
-		uint r = 0;
-		for (Size i = 0; i != AncestorType::size; ++i)
-		{
-			if (c == AncestorType::data[i])
-				++r;
-		}
-		return r;
+		return static_cast<uint>(Private::CStringImpl::CountChar(AncestorType::data, AncestorType::size, c));
 	}
 
 
@@ -814,42 +803,26 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::find(char c, Size offset) const
 	{
 		if (offset < AncestorType::size)
 		{
-			const char* p   = AncestorType::data + offset;
-			const char* end = AncestorType::data + (AncestorType::size);
-
-			for (; p != end; ++p)
-			{
-				if (c == *p)
-					return static_cast<Size>(p - AncestorType::data);
-			}
+			size_t r = Private::CStringImpl::FindChar(AncestorType::data + offset, AncestorType::size - offset, c);
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) + offset : npos;
 		}
 		return npos;
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::find(const char* const cstr, Size offset, Size len) const
 	{
-		if (cstr and len and len <= AncestorType::size)
+		if (cstr and len and len <= AncestorType::size and offset <= AncestorType::size - len)
 		{
-			// Size end = AncestorType::size - len + 1;
-			const char* p   = AncestorType::data + offset;
-			const char* end = AncestorType::data + (AncestorType::size - len + 1);
-			char needle     = *cstr;
-			for (; p != end; ++p)
-			{
-				if (*p == needle)
-				{
-					if (0 == ::memcmp(p, cstr, len))
-						return static_cast<Size>(p - AncestorType::data);
-				}
-			}
+			size_t r = Private::CStringImpl::Find(AncestorType::data + offset, AncestorType::size - offset, cstr, len);
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) + offset : npos;
 		}
 		return npos;
 	}
@@ -885,48 +858,34 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::ifind(char c) const
 	{
-		c = static_cast<char>(ToLower(c));
-		for (Size i = 0; i != AncestorType::size; ++i)
-		{
-			if (c == static_cast<char>(ToLower(AncestorType::data[i])))
-				return i;
-		}
-		return npos;
+		return ifind(c, 0);
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::ifind(char c, Size offset) const
 	{
-		c = static_cast<char>(ToLower(c));
-		for (Size i = offset; i < AncestorType::size; ++i)
+		if (offset < AncestorType::size)
 		{
-			if (c == static_cast<char>(ToLower(AncestorType::data[i])))
-				return i;
+			size_t r = Private::CStringImpl::IFindChar(AncestorType::data + offset, AncestorType::size - offset, c);
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) + offset : npos;
 		}
 		return npos;
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::ifind(const char* const cstr, Size offset, Size len) const
 	{
-		if (cstr and len and len <= AncestorType::size)
+		if (cstr and len and len <= AncestorType::size and offset <= AncestorType::size - len)
 		{
-			Size end = AncestorType::size - len + 1;
-			for (Size i = offset; i < end; ++i)
-			{
-				if (ToLower(AncestorType::data[i]) == ToLower(*cstr))
-				{
-					if (!CompareInsensitive(AncestorType::data + i, len, cstr, len))
-						return i;
-				}
-			}
+			size_t r = Private::CStringImpl::IFind(AncestorType::data + offset, AncestorType::size - offset, cstr, len);
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) + offset : npos;
 		}
 		return npos;
 	}
@@ -963,49 +922,34 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::rfind(char c) const
 	{
-		Size i = AncestorType::size;
-		while (i--)
-		{
-			if (c == AncestorType::data[i])
-				return i;
-		}
-		return npos;
+		size_t r = Private::CStringImpl::RFindChar(AncestorType::data, AncestorType::size, c);
+		return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::rfind(char c, Size offset) const
 	{
-		Size i = (offset >= AncestorType::size) ? AncestorType::size : 1+offset;
-		while (i--)
-		{
-			if (c == AncestorType::data[i])
-				return i;
-		}
-		return npos;
+		Size n = (offset >= AncestorType::size) ? AncestorType::size : 1 + offset;
+		size_t r = Private::CStringImpl::RFindChar(AncestorType::data, n, c);
+		return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::rfind(const char* const cstr, Size offset, Size len) const
 	{
-		if (len and len <= AncestorType::size and offset >= len)
+		if (cstr and len and len <= AncestorType::size and offset >= len)
 		{
-			Size i = (offset >= AncestorType::size) ? AncestorType::size : 1+offset;
-			i -= len - 1;
-			while (i--)
-			{
-				if (AncestorType::data[i] == *cstr)
-				{
-					if (0 == ::memcmp(AncestorType::data + i, cstr, len))
-						return i;
-				}
-			}
+			// the occurence must end before `offset` (included)
+			Size n = (offset >= AncestorType::size) ? AncestorType::size : 1 + offset;
+			size_t r = Private::CStringImpl::RFind(AncestorType::data, n, cstr, len);
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 		}
 		return npos;
 	}
@@ -1041,51 +985,34 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::irfind(char c) const
 	{
-		c = static_cast<char>(ToLower(c));
-		Size i = AncestorType::size;
-		while (i--)
-		{
-			if (c == static_cast<char>(ToLower(AncestorType::data[i])))
-				return i;
-		}
-		return npos;
+		size_t r = Private::CStringImpl::IRFindChar(AncestorType::data, AncestorType::size, c);
+		return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::irfind(char c, Size offset) const
 	{
-		c = static_cast<char>(ToLower(c));
-		Size i = (offset >= AncestorType::size) ? AncestorType::size : 1+offset;
-		while (i--)
-		{
-			if (c == static_cast<char>(ToLower(AncestorType::data[i])))
-				return i;
-		}
-		return npos;
+		Size n = (offset >= AncestorType::size) ? AncestorType::size : 1 + offset;
+		size_t r = Private::CStringImpl::IRFindChar(AncestorType::data, n, c);
+		return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	typename CString<ChunkSizeT,ExpandableT>::Size
+	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::irfind(const char* const cstr, Size offset, Size len) const
 	{
-		if (len and len <= AncestorType::size and offset >= len)
+		if (cstr and len and len <= AncestorType::size and offset >= len)
 		{
-			Size i = (offset >= AncestorType::size) ? AncestorType::size : 1+offset;
-			i -= len - 1;
-			while (i--)
-			{
-				if (ToLower(AncestorType::data[i]) == ToLower(*cstr))
-				{
-					if (!CompareInsensitive(AncestorType::data + i, len, cstr, len))
-						return i;
-				}
-			}
+			// the occurence must end before `offset` (included)
+			Size n = (offset >= AncestorType::size) ? AncestorType::size : 1 + offset;
+			size_t r = Private::CStringImpl::IRFind(AncestorType::data, n, cstr, len);
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 		}
 		return npos;
 	}
@@ -1123,17 +1050,10 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	bool
+	inline bool
 	CString<ChunkSizeT,ExpandableT>::contains(char c) const
 	{
-		const char* p   = AncestorType::data;
-		const char* end = AncestorType::data + AncestorType::size;
-		for (; p != end; ++p)
-		{
-			if (c == *p)
-				return true;
-		}
-		return false;
+		return hasChar(c);
 	}
 
 
@@ -1141,7 +1061,7 @@ namespace Yuni
 	inline bool
 	CString<ChunkSizeT,ExpandableT>::contains(const char* const cstr, Size len) const
 	{
-		return find(cstr, len) < size();
+		return find(cstr, 0, len) != npos;
 	}
 
 
@@ -1149,41 +1069,23 @@ namespace Yuni
 	inline bool
 	CString<ChunkSizeT,ExpandableT>::contains(const AnyString& string) const
 	{
-		return find(string.c_str(), string.size()) < size();
+		return find(string.c_str(), 0, string.size()) != npos;
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	bool
+	inline bool
 	CString<ChunkSizeT,ExpandableT>::icontains(char c) const
 	{
-		c = static_cast<char>(ToLower(c));
-		for (Size i = 0; i != AncestorType::size; ++i)
-		{
-			if (c == static_cast<char>(ToLower(AncestorType::data[i])))
-				return true;
-		}
-		return false;
+		return Private::CStringImpl::searchNotFound != Private::CStringImpl::IFindChar(AncestorType::data, AncestorType::size, c);
 	}
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	bool
+	inline bool
 	CString<ChunkSizeT,ExpandableT>::icontains(const char* const cstr, Size len) const
 	{
-		if (cstr and len and len <= AncestorType::size)
-		{
-			Size end = AncestorType::size - len + 1;
-			for (Size i = 0; i != end; ++i)
-			{
-				if (ToLower(AncestorType::data[i]) == ToLower(*cstr))
-				{
-					if (!CompareInsensitive(AncestorType::data + i, len, cstr, len))
-						return true;
-				}
-			}
-		}
-		return false;
+		return ifind(cstr, 0, len) != npos;
 	}
 
 
@@ -1199,15 +1101,10 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	uint
+	inline uint
 	CString<ChunkSizeT,ExpandableT>::indexOf(Size offset, char c) const
 	{
-		for (; offset < AncestorType::size; ++offset)
-		{
-			if (c == AncestorType::data[offset])
-				return offset;
-		}
-		return npos;
+		return find(c, offset);
 	}
 
 
@@ -1393,22 +1290,10 @@ namespace Yuni
 
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	uint
+	inline uint
 	CString<ChunkSizeT,ExpandableT>::indexOf(Size offset, const char* const cstr, Size len) const
 	{
-		if (cstr and len and len <= AncestorType::size)
-		{
-			Size end = AncestorType::size - len + 1;
-			for (; offset < end; ++offset)
-			{
-				if (AncestorType::data[offset] == *cstr)
-				{
-					if (0 == ::memcmp(AncestorType::data + offset, cstr, len))
-						return offset;
-				}
-			}
-		}
-		return npos;
+		return find(cstr, offset, len);
 	}
 
 
@@ -1455,19 +1340,7 @@ namespace Yuni
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::ifind_first_of(char c, Size offset) const
 	{
-		if (offset < AncestorType::size)
-		{
-			c = static_cast<char>(ToLower(c));
-			const char* p   = AncestorType::data + offset;
-			const char* end = AncestorType::data + (AncestorType::size);
-
-			for (; p != end; ++p)
-			{
-				if (c == static_cast<char>(ToLower(*p)))
-					return static_cast<Size>(p - AncestorType::data);
-			}
-		}
-		return npos;
+		return ifind(c, offset);
 	}
 
 
@@ -1476,22 +1349,10 @@ namespace Yuni
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::find_first_of(const AnyString& sequence, Size offset) const
 	{
-		if (offset < AncestorType::size and not sequence.empty())
+		if (offset < AncestorType::size)
 		{
-			const char* p    = AncestorType::data + offset;
-			const char* end  = AncestorType::data + (AncestorType::size);
-
-			const char* jfirst = sequence.c_str();
-			const char* jend   = jfirst + sequence.size();
-
-			for (; p != end; ++p)
-			{
-				for (const char* j = jfirst; j != jend; ++j)
-				{
-					if (*j == *p)
-						return static_cast<Size>(p - AncestorType::data);
-				}
-			}
+			size_t r = Private::CStringImpl::FindAnyOf(AncestorType::data + offset, AncestorType::size - offset, sequence.c_str(), sequence.size());
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) + offset : npos;
 		}
 		return npos;
 	}
@@ -1566,20 +1427,10 @@ namespace Yuni
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::ifind_first_of(const AnyString& sequence, Size offset) const
 	{
-		// The given sequence
-		const char* const s = sequence.c_str();
-		Size len = sequence.size();
-		Size j;
-
-		for (Size i = offset; i < AncestorType::size; ++i)
+		if (offset < AncestorType::size)
 		{
-			// alias to the current character
-			char c = static_cast<char>(ToLower(AncestorType::data[i]));
-			for (j = 0; j != len; ++j)
-			{
-				if (static_cast<char>(ToLower(s[j])) == c)
-					return i;
-			}
+			size_t r = Private::CStringImpl::IFindAnyOf(AncestorType::data + offset, AncestorType::size - offset, sequence.c_str(), sequence.size());
+			return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) + offset : npos;
 		}
 		return npos;
 	}
@@ -1619,41 +1470,21 @@ namespace Yuni
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::find_last_of(char c) const
 	{
-		Size i = AncestorType::size;
-		while (i--)
-		{
-			if (c == AncestorType::data[i])
-				return i;
-		}
-		return npos;
+		return rfind(c);
 	}
 
 	template<uint ChunkSizeT, bool ExpandableT>
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::ifind_last_of(char c) const
 	{
-		c = static_cast<char>(ToLower(c));
-		Size i = AncestorType::size;
-		while (i--)
-		{
-			if (c == static_cast<char>(ToLower(AncestorType::data[i])))
-				return i;
-		}
-		return npos;
+		return irfind(c);
 	}
 
 	template<uint ChunkSizeT, bool ExpandableT>
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::find_last_of(char c, Size offset) const
 	{
-		c = static_cast<char>(ToLower(c));
-		Size i = ((offset >= AncestorType::size) ? AncestorType::size : 1+offset);
-		while (i--)
-		{
-			if (c == static_cast<char>(ToLower(AncestorType::data[i])))
-				return i;
-		}
-		return npos;
+		return rfind(c, offset);
 	}
 
 
@@ -1661,23 +1492,9 @@ namespace Yuni
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::find_last_of(const AnyString& sequence, Size offset) const
 	{
-		// The given sequence
-		const char* const s = sequence.c_str();
-		Size len = sequence.size();
-		Size j;
-
-		Size i = ((offset >= AncestorType::size) ? AncestorType::size : 1+offset);
-		while (i--)
-		{
-			// alias to the current character
-			char c = AncestorType::data[i];
-			for (j = 0; j != len; ++j)
-			{
-				if (s[j] == c)
-					return i;
-			}
-		}
-		return npos;
+		Size n = (offset >= AncestorType::size) ? AncestorType::size : 1 + offset;
+		size_t r = Private::CStringImpl::RFindAnyOf(AncestorType::data, n, sequence.c_str(), sequence.size());
+		return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 	}
 
 
@@ -1685,23 +1502,9 @@ namespace Yuni
 	inline typename CString<ChunkSizeT,ExpandableT>::Size
 	CString<ChunkSizeT,ExpandableT>::ifind_last_of(const AnyString& sequence, Size offset) const
 	{
-		// The given sequence
-		const char* const s = sequence.c_str();
-		Size len = sequence.size();
-		Size j;
-
-		Size i = ((offset >= AncestorType::size) ? AncestorType::size : 1+offset);
-		while (i--)
-		{
-			// alias to the current character
-			char c = static_cast<char>(ToLower(AncestorType::data[i]));
-			for (j = 0; j != len; ++j)
-			{
-				if (static_cast<char>(ToLower(s[j])) == c)
-					return i;
-			}
-		}
-		return npos;
+		Size n = (offset >= AncestorType::size) ? AncestorType::size : 1 + offset;
+		size_t r = Private::CStringImpl::IRFindAnyOf(AncestorType::data, n, sequence.c_str(), sequence.size());
+		return (r != Private::CStringImpl::searchNotFound) ? static_cast<Size>(r) : npos;
 	}
 
 
@@ -1879,6 +1682,15 @@ namespace Yuni
 		return Yuni::Extension::CString::Into<UType>::Perform(*this, out);
 	}
 
+	template<uint ChunkSizeT, bool ExpandableT>
+	template<class U>
+	inline bool
+	CString<ChunkSizeT,ExpandableT>::to(U& out, uint& offset) const
+	{
+		typedef typename Static::Remove::Const<typename Static::Remove::RefOnly<U>::Type>::Type UType;
+		return Yuni::Extension::CString::Into<UType>::Perform(*this, out, offset);
+	}
+
 
 	template<uint ChunkSizeT, bool ExpandableT>
 	template<class ModelT, bool ConstT>
@@ -2164,7 +1976,11 @@ namespace Yuni
 	CString<ChunkSizeT,ExpandableT>::truncate(Size newSize)
 	{
 		if (newSize < AncestorType::size)
+		{
 			AncestorType::size = newSize;
+			if (zeroTerminated)
+				Yuni::Private::CStringImpl::FinalZero<adapter>::Set(AncestorType::data, AncestorType::size);
+		}
 	}
 
 
@@ -2468,7 +2284,7 @@ namespace Yuni
 		{
 			// Dynamic cstr
 			if (not adapter)
-				AncestorType::reserve(len + 1 /*AncestorType::zeroTerminated*/);
+				AncestorType::reserve(len);
 			AncestorType::size = len;
 		}
 		else
@@ -3458,7 +3274,7 @@ namespace Yuni
 			return false;
 
 		// resize the internal buffer
-		reserve(AncestorType::size + static_cast<Size>(needed) + zeroTerminated);
+		reserve(AncestorType::size + static_cast<Size>(needed));
 
 		Size maxAllowedSize = capacity() - AncestorType::size;
 		if (maxAllowedSize <= 1)
@@ -3497,11 +3313,10 @@ namespace Yuni
 	inline char*
 	CString<ChunkSizeT,ExpandableT>::forgetContent()
 	{
-		char* cstring = data();
 		if (not adapter)
-			AncestorType::forgetContent();
-		else
-			AncestorType::size = 0;
+			return AncestorType::forgetContent();
+		char* cstring = data();
+		AncestorType::size = 0;
 		return cstring;
 	}
 
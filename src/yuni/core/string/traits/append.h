@@ -11,6 +11,7 @@
 #pragma once
 #include "../../traits/length.h"
 #include "integer.h"
+#include "format.h"
 #include <stdio.h>
 #include <cassert>
 
@@ -210,32 +211,25 @@ namespace CString
 
 
 
-# define YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL(BUFSIZE, FORMAT, TYPE) \
+# define YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL_INT(TYPE) \
 	template<class CStringT> \
 	class Append<CStringT, TYPE> final \
 	{ \
 	public: \
 		static void Perform(CStringT& s, const TYPE rhs) \
 		{ \
-			typename CStringT::Type buffer[BUFSIZE]; \
-			/* On Windows, it may return a negative value */ \
-			if (YUNI_PRIVATE_MEMBUF_SPTRINF(buffer, BUFSIZE, FORMAT, rhs) >= 0) \
-			{ \
-				buffer[BUFSIZE - 1] = '\0'; /* making sure that it is zero-terminated */ \
-				s.appendWithoutChecking(buffer, \
-					Yuni::Traits::Length<typename CStringT::Type*, typename CStringT::Size>::Value(buffer)); \
-			} \
+			Yuni::Private::CStringImpl::AppendInteger(s, rhs); \
 		} \
 	}
 
-# define YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL_INT(TYPE) \
+# define YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL_DECIMAL(TYPE) \
 	template<class CStringT> \
 	class Append<CStringT, TYPE> final \
 	{ \
 	public: \
 		static void Perform(CStringT& s, const TYPE rhs) \
 		{ \
-			Yuni::Private::CStringImpl::From<Math::Base::Decimal, TYPE>::AppendTo(s, rhs); \
+			Yuni::Private::CStringImpl::AppendDecimal(s, rhs); \
 		} \
 	}
 
@@ -251,8 +245,8 @@ namespace CString
 	YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL_INT(unsigned long);
 	# endif
 
-	YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL(256, "%f",  float);
-	YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL(256, "%f",  double);
+	YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL_DECIMAL(float);
+	YUNI_PRIVATE_MEMORY_BUFFER_APPEND_IMPL_DECIMAL(double);
 
 
 
@@ -0,0 +1,582 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "format.h"
+#include <cassert>
+#include <string.h>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	const char formatDigitPairs[200] =
+	{
+		'0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+		'1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+		'2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+		'3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+		'4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+		'5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+		'6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+		'7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+		'8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+		'9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+	};
+
+
+
+
+	namespace // anonymous
+	{
+
+		// The shortest representation is computed as described by Ulf Adams,
+		// "Ryu: fast float-to-string conversion" (PLDI 2018): the interval of the
+		// decimal values rounding to the binary value is computed with fixed-point
+		// multiplications by powers of 5, and the digits are removed while the
+		// bounds of the interval differ.
+
+		enum
+		{
+			doublePow5InvBitCount = 125,
+			doublePow5BitCount = 125,
+			doublePow5InvTableSize = 342,
+			doublePow5TableSize = 326,
+			floatPow5InvBitCount = 59,
+			floatPow5BitCount = 61,
+			floatPow5InvTableSize = 31,
+			floatPow5TableSize = 48,
+		};
+
+		#include "format.inc.hpp"
+
+
+		//! A decimal value, `mantissa * 10^exponent`
+		struct DecimalValue final
+		{
+			uint64 mantissa;
+			int exponent;
+		};
+
+
+		//! ceil(log2(5^e)), 1 for e == 0 (0 <= e <= 3528)
+		inline int Pow5Bits(int e)
+		{
+			return static_cast<int>((static_cast<uint32>(e) * 1217359u) >> 19) + 1;
+		}
+
+		//! floor(log10(2^e)) (0 <= e <= 1650)
+		inline uint32 Log10Pow2(int e)
+		{
+			return (static_cast<uint32>(e) * 78913u) >> 18;
+		}
+
+		//! floor(log10(5^e)) (0 <= e <= 2620)
+		inline uint32 Log10Pow5(int e)
+		{
+			return (static_cast<uint32>(e) * 732923u) >> 20;
+		}
+
+		template<class T> inline uint32 Pow5Factor(T value)
+		{
+			uint32 count = 0;
+			while (value % 5 == 0)
+			{
+				value /= 5;
+				++count;
+			}
+			return count;
+		}
+
+		template<class T> inline bool MultipleOfPowerOf5(T value, uint32 p)
+		{
+			return Pow5Factor(value) >= p;
+		}
+
+		template<class T> inline bool MultipleOfPowerOf2(T value, uint32 p)
+		{
+			return (value & ((T(1) << p) - 1)) == 0;
+		}
+
+
+		//! (m * mul) >> j, with mul a 128-bit factor and 64 <= j < 192
+		inline uint64 MulShift64(uint64 m, const uint64* const mul, int j)
+		{
+			# ifdef YUNI_HAS_INT128_T
+			uint128 b0 = static_cast<uint128>(m) * mul[0];
+			uint128 b2 = static_cast<uint128>(m) * mul[1];
+			return static_cast<uint64>(((b0 >> 64) + b2) >> (j - 64));
+			# else
+			// 64x64 -> 128 bits multiplications, with 32-bit halves
+			struct Mul final
+			{
+				static uint64 Full(uint64 a, uint64 b, uint64& high)
+				{
+					uint64 aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+					uint64 bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+					uint64 b00 = aLo * bLo, b01 = aLo * bHi, b10 = aHi * bLo, b11 = aHi * bHi;
+					uint64 mid1 = b10 + (b00 >> 32);
+					uint64 mid2 = b01 + (mid1 & 0xFFFFFFFFu);
+					high = b11 + (mid1 >> 32) + (mid2 >> 32);
+					return (mid2 << 32) | (b00 & 0xFFFFFFFFu);
+				}
+			};
+			uint64 high1;
+			uint64 low1 = Mul::Full(m, mul[1], high1);
+			uint64 high0;
+			Mul::Full(m, mul[0], high0);
+			uint64 sum = high0 + low1;
+			if (sum < high0)
+				++high1;
+			int shift = j - 64;
+			if (shift >= 64)
+				return high1 >> (shift - 64);
+			return (shift == 0) ? sum : ((high1 << (64 - shift)) | (sum >> shift));
+			# endif
+		}
+
+
+		//! (m * factor) >> shift, with 32 <= shift
+		inline uint32 MulShift32(uint32 m, uint64 factor, int shift)
+		{
+			uint64 bits0 = static_cast<uint64>(m) * (factor & 0xFFFFFFFFu);
+			uint64 bits1 = static_cast<uint64>(m) * (factor >> 32);
+			uint64 sum = (bits0 >> 32) + bits1;
+			return static_cast<uint32>(sum >> (shift - 32));
+		}
+
+
+		DecimalValue ShortestDecimal(uint64 ieeeMantissa, uint32 ieeeExponent)
+		{
+			enum { mantissaBits = 52, bias = 1023 };
+
+			int e2;
+			uint64 m2;
+			if (ieeeExponent == 0)
+			{
+				// subnormal
+				e2 = 1 - bias - mantissaBits - 2;
+				m2 = ieeeMantissa;
+			}
+			else
+			{
+				e2 = static_cast<int>(ieeeExponent) - bias - mantissaBits - 2;
+				m2 = (uint64(1) << mantissaBits) | ieeeMantissa;
+			}
+			// the bounds are part of the interval when the mantissa is even (round half to even)
+			bool acceptBounds = (m2 & 1) == 0;
+
+			// interval of the valid representations: [mv - 1 - mmShift, mv + 2] / 4
+			uint64 mv = 4 * m2;
+			uint32 mmShift = (ieeeMantissa != 0 or ieeeExponent <= 1) ? 1 : 0;
+
+			// conversion to a decimal power base
+			uint64 vr, vp, vm;
+			int e10;
+			bool vmIsTrailingZeros = false;
+			bool vrIsTrailingZeros = false;
+			if (e2 >= 0)
+			{
+				uint32 q = Log10Pow2(e2) - (e2 > 3 ? 1 : 0);
+				e10 = static_cast<int>(q);
+				int k = doublePow5InvBitCount + Pow5Bits(static_cast<int>(q)) - 1;
+				int i = -e2 + static_cast<int>(q) + k;
+				assert(q < doublePow5InvTableSize);
+				vr = MulShift64(4 * m2, doublePow5InvSplit[q], i);
+				vp = MulShift64(4 * m2 + 2, doublePow5InvSplit[q], i);
+				vm = MulShift64(4 * m2 - 1 - mmShift, doublePow5InvSplit[q], i);
+				if (q <= 21)
+				{
+					// only one of mp, mv, and mm can be a multiple of 5, if any
+					if (mv % 5 == 0)
+						vrIsTrailingZeros = MultipleOfPowerOf5(mv, q);
+					else if (acceptBounds)
+						vmIsTrailingZeros = MultipleOfPowerOf5(mv - 1 - mmShift, q);
+					else
+						vp -= MultipleOfPowerOf5(mv + 2, q) ? 1 : 0;
+				}
+			}
+			else
+			{
+				uint32 q = Log10Pow5(-e2) - (-e2 > 1 ? 1 : 0);
+				e10 = static_cast<int>(q) + e2;
+				int i = -e2 - static_cast<int>(q);
+				int k = Pow5Bits(i) - doublePow5BitCount;
+				int j = static_cast<int>(q) - k;
+				assert(i < doublePow5TableSize);
+				vr = MulShift64(4 * m2, doublePow5Split[i], j);
+				vp = MulShift64(4 * m2 + 2, doublePow5Split[i], j);
+				vm = MulShift64(4 * m2 - 1 - mmShift, doublePow5Split[i], j);
+				if (q <= 1)
+				{
+					// mv = 4 * m2 has at least 2 trailing zero bits
+					vrIsTrailingZeros = true;
+					if (acceptBounds)
+						vmIsTrailingZeros = (mmShift == 1);
+					else
+						--vp;
+				}
+				else if (q < 63)
+					vrIsTrailingZeros = MultipleOfPowerOf2(mv, q);
+			}
+
+			// removing the digits while the bounds differ
+			int removed = 0;
+			uint64 output;
+			if (vmIsTrailingZeros or vrIsTrailingZeros)
+			{
+				// general case (rare)
+				uint32 lastRemovedDigit = 0;
+				while (vp / 10 > vm / 10)
+				{
+					vmIsTrailingZeros &= (vm % 10 == 0);
+					vrIsTrailingZeros &= (lastRemovedDigit == 0);
+					lastRemovedDigit = static_cast<uint32>(vr % 10);
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					++removed;
+				}
+				if (vmIsTrailingZeros)
+				{
+					while (vm % 10 == 0)
+					{
+						vrIsTrailingZeros &= (lastRemovedDigit == 0);
+						lastRemovedDigit = static_cast<uint32>(vr % 10);
+						vr /= 10;
+						vp /= 10;
+						vm /= 10;
+						++removed;
+					}
+				}
+				if (vrIsTrailingZeros and lastRemovedDigit == 5 and vr % 2 == 0)
+					lastRemovedDigit = 4; // round half to even
+				output = vr + (((vr == vm and (not acceptBounds or not vmIsTrailingZeros)) or lastRemovedDigit >= 5) ? 1 : 0);
+			}
+			else
+			{
+				// common case
+				bool roundUp = false;
+				if (vp / 100 > vm / 100)
+				{
+					// two digits at once
+					roundUp = (vr % 100) >= 50;
+					vr /= 100;
+					vp /= 100;
+					vm /= 100;
+					removed += 2;
+				}
+				while (vp / 10 > vm / 10)
+				{
+					roundUp = (vr % 10) >= 5;
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					++removed;
+				}
+				output = vr + ((vr == vm or roundUp) ? 1 : 0);
+			}
+
+			DecimalValue result;
+			result.mantissa = output;
+			result.exponent = e10 + removed;
+			return result;
+		}
+
+
+		DecimalValue ShortestDecimal(uint32 ieeeMantissa, uint32 ieeeExponent)
+		{
+			enum { mantissaBits = 23, bias = 127 };
+
+			int e2;
+			uint32 m2;
+			if (ieeeExponent == 0)
+			{
+				// subnormal
+				e2 = 1 - bias - mantissaBits - 2;
+				m2 = ieeeMantissa;
+			}
+			else
+			{
+				e2 = static_cast<int>(ieeeExponent) - bias - mantissaBits - 2;
+				m2 = (1u << mantissaBits) | ieeeMantissa;
+			}
+			bool acceptBounds = (m2 & 1) == 0;
+
+			uint32 mv = 4 * m2;
+			uint32 mp = 4 * m2 + 2;
+			uint32 mmShift = (ieeeMantissa != 0 or ieeeExponent <= 1) ? 1 : 0;
+			uint32 mm = 4 * m2 - 1 - mmShift;
+
+			uint32 vr, vp, vm;
+			int e10;
+			bool vmIsTrailingZeros = false;
+			bool vrIsTrailingZeros = false;
+			uint32 lastRemovedDigit = 0;
+			if (e2 >= 0)
+			{
+				uint32 q = Log10Pow2(e2);
+				e10 = static_cast<int>(q);
+				int k = floatPow5InvBitCount + Pow5Bits(static_cast<int>(q)) - 1;
+				int i = -e2 + static_cast<int>(q) + k;
+				assert(q < floatPow5InvTableSize);
+				vr = MulShift32(mv, floatPow5InvSplit[q], i);
+				vp = MulShift32(mp, floatPow5InvSplit[q], i);
+				vm = MulShift32(mm, floatPow5InvSplit[q], i);
+				if (q != 0 and (vp - 1) / 10 <= vm / 10)
+				{
+					// the loop below would not remove any digit, but the last removed
+					// digit is still required for the rounding
+					int l = floatPow5InvBitCount + Pow5Bits(static_cast<int>(q - 1)) - 1;
+					lastRemovedDigit = MulShift32(mv, floatPow5InvSplit[q - 1], -e2 + static_cast<int>(q) - 1 + l) % 10;
+				}
+				if (q <= 9)
+				{
+					// only one of mp, mv, and mm can be a multiple of 5, if any
+					if (mv % 5 == 0)
+						vrIsTrailingZeros = MultipleOfPowerOf5(mv, q);
+					else if (acceptBounds)
+						vmIsTrailingZeros = MultipleOfPowerOf5(mm, q);
+					else
+						vp -= MultipleOfPowerOf5(mp, q) ? 1 : 0;
+				}
+			}
+			else
+			{
+				uint32 q = Log10Pow5(-e2);
+				e10 = static_cast<int>(q) + e2;
+				int i = -e2 - static_cast<int>(q);
+				int k = Pow5Bits(i) - floatPow5BitCount;
+				int j = static_cast<int>(q) - k;
+				assert(i < floatPow5TableSize);
+				vr = MulShift32(mv, floatPow5Split[i], j);
+				vp = MulShift32(mp, floatPow5Split[i], j);
+				vm = MulShift32(mm, floatPow5Split[i], j);
+				if (q != 0 and (vp - 1) / 10 <= vm / 10)
+				{
+					j = static_cast<int>(q) - 1 - (Pow5Bits(i + 1) - floatPow5BitCount);
+					assert(i + 1 < floatPow5TableSize);
+					lastRemovedDigit = MulShift32(mv, floatPow5Split[i + 1], j) % 10;
+				}
+				if (q <= 1)
+				{
+					vrIsTrailingZeros = true;
+					if (acceptBounds)
+						vmIsTrailingZeros = (mmShift == 1);
+					else
+						--vp;
+				}
+				else if (q < 31)
+					vrIsTrailingZeros = MultipleOfPowerOf2(mv, q - 1);
+			}
+
+			int removed = 0;
+			uint32 output;
+			if (vmIsTrailingZeros or vrIsTrailingZeros)
+			{
+				while (vp / 10 > vm / 10)
+				{
+					vmIsTrailingZeros &= (vm % 10 == 0);
+					vrIsTrailingZeros &= (lastRemovedDigit == 0);
+					lastRemovedDigit = vr % 10;
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					++removed;
+				}
+				if (vmIsTrailingZeros)
+				{
+					while (vm % 10 == 0)
+					{
+						vrIsTrailingZeros &= (lastRemovedDigit == 0);
+						lastRemovedDigit = vr % 10;
+						vr /= 10;
+						vp /= 10;
+						vm /= 10;
+						++removed;
+					}
+				}
+				if (vrIsTrailingZeros and lastRemovedDigit == 5 and vr % 2 == 0)
+					lastRemovedDigit = 4; // round half to even
+				output = vr + (((vr == vm and (not acceptBounds or not vmIsTrailingZeros)) or lastRemovedDigit >= 5) ? 1 : 0);
+			}
+			else
+			{
+				while (vp / 10 > vm / 10)
+				{
+					lastRemovedDigit = vr % 10;
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					++removed;
+				}
+				output = vr + ((vr == vm or lastRemovedDigit >= 5) ? 1 : 0);
+			}
+
+			DecimalValue result;
+			result.mantissa = output;
+			result.exponent = e10 + removed;
+			return result;
+		}
+
+
+		/*!
+		** \brief Write `mantissa * 10^exponent`
+		**
+		** The decimal notation is used when the decimal point lies between 6 digits
+		** before the first digit and 21 digits after it (as ECMAScript does), the
+		** exponent notation otherwise.
+		*/
+		uint WriteDecimalValue(char* const buffer, bool negative, const DecimalValue& value)
+		{
+			char* p = buffer;
+			if (negative)
+				*p++ = '-';
+
+			uint length = DecimalLength(value.mantissa);
+			// position of the decimal point, relative to the first digit
+			int point = static_cast<int>(length) + value.exponent;
+
+			if (point > 21 or point <= -6)
+			{
+				// exponent notation: d[.ddd]e+XX
+				// the digits are written one char further, then the first one is moved
+				WriteDecimal(p + 1 + length, value.mantissa);
+				p[0] = p[1];
+				if (length > 1)
+				{
+					p[1] = '.';
+					p += length + 1;
+				}
+				else
+					++p;
+				*p++ = 'e';
+				int exponent = point - 1;
+				if (exponent < 0)
+				{
+					*p++ = '-';
+					exponent = -exponent;
+				}
+				else
+					*p++ = '+';
+				if (exponent >= 100)
+				{
+					*p++ = static_cast<char>('0' + exponent / 100);
+					exponent %= 100;
+				}
+				*p++ = formatDigitPairs[exponent * 2];
+				*p++ = formatDigitPairs[exponent * 2 + 1];
+				return static_cast<uint>(p - buffer);
+			}
+
+			if (point <= 0)
+			{
+				// 0.000ddd
+				p[0] = '0';
+				p[1] = '.';
+				p += 2;
+				for (int i = point; i < 0; ++i)
+					*p++ = '0';
+				WriteDecimal(p + length, value.mantissa);
+				return static_cast<uint>(p + length - buffer);
+			}
+
+			if (static_cast<uint>(point) >= length)
+			{
+				// ddd000 (integer)
+				WriteDecimal(p + length, value.mantissa);
+				p += length;
+				for (uint i = length; i != static_cast<uint>(point); ++i)
+					*p++ = '0';
+				return static_cast<uint>(p - buffer);
+			}
+
+			// ddd.ddd
+			// the digits are written one char further, then the integral part is moved
+			WriteDecimal(p + 1 + length, value.mantissa);
+			memmove(p, p + 1, static_cast<size_t>(point));
+			p[point] = '.';
+			return static_cast<uint>(p + 1 + length - buffer);
+		}
+
+
+		//! Write the special values (nan, inf, zero), or return 0
+		inline uint WriteSpecialValue(char* const buffer, bool negative, bool maxExponent, bool zeroMantissa)
+		{
+			if (maxExponent)
+			{
+				if (not zeroMantissa)
+				{
+					memcpy(buffer, "nan", 3);
+					return 3;
+				}
+				if (negative)
+				{
+					memcpy(buffer, "-inf", 4);
+					return 4;
+				}
+				memcpy(buffer, "inf", 3);
+				return 3;
+			}
+			// zero (the sign is kept)
+			if (negative)
+			{
+				memcpy(buffer, "-0", 2);
+				return 2;
+			}
+			buffer[0] = '0';
+			return 1;
+		}
+
+
+	} // anonymous namespace
+
+
+
+
+	uint FormatDouble(char* buffer, double value)
+	{
+		uint64 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		bool negative = (bits >> 63) != 0;
+		uint64 ieeeMantissa = bits & ((uint64(1) << 52) - 1);
+		uint32 ieeeExponent = static_cast<uint32>((bits >> 52) & 0x7FFu);
+
+		if (YUNI_UNLIKELY(ieeeExponent == 0x7FFu or (ieeeExponent == 0 and ieeeMantissa == 0)))
+			return WriteSpecialValue(buffer, negative, ieeeExponent == 0x7FFu, ieeeMantissa == 0);
+
+		return WriteDecimalValue(buffer, negative, ShortestDecimal(ieeeMantissa, ieeeExponent));
+	}
+
+
+	uint FormatFloat(char* buffer, float value)
+	{
+		uint32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		bool negative = (bits >> 31) != 0;
+		uint32 ieeeMantissa = bits & ((1u << 23) - 1);
+		uint32 ieeeExponent = (bits >> 23) & 0xFFu;
+
+		if (YUNI_UNLIKELY(ieeeExponent == 0xFFu or (ieeeExponent == 0 and ieeeMantissa == 0)))
+			return WriteSpecialValue(buffer, negative, ieeeExponent == 0xFFu, ieeeMantissa == 0);
+
+		return WriteDecimalValue(buffer, negative, ShortestDecimal(ieeeMantissa, ieeeExponent));
+	}
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
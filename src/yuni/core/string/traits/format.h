@@ -0,0 +1,90 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include <type_traits>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	enum
+	{
+		//! Maximum number of chars written by FormatDouble() and FormatFloat()
+		formatDecimalCapacity = 32,
+	};
+
+
+	//! The pairs of digits "00" to "99", for writing two digits at once
+	YUNI_DECL extern const char formatDigitPairs[200];
+
+
+	//! Number of digits of an unsigned integer (decimal base)
+	uint DecimalLength(uint32 value);
+	uint DecimalLength(uint64 value);
+
+	/*!
+	** \brief Write the digits of an unsigned integer (decimal base), backward
+	**
+	** \param end Pointer to the char following the last digit to write
+	** \param value The value to write (DecimalLength() chars are written)
+	*/
+	void WriteDecimal(char* end, uint32 value);
+	void WriteDecimal(char* end, uint64 value);
+
+
+	/*!
+	** \brief Format a double with the shortest representation that reads back to the same value
+	**
+	** The decimal notation is used when the decimal point is not too far from the
+	** digits (ex: `0.1`, `42`, `1234.5678`), the exponent notation otherwise (ex:
+	** `1e+21`, `-1.5e-07`). The special values are written `nan`, `inf` and `-inf`.
+	**
+	** \param buffer A buffer of `formatDecimalCapacity` chars at least (not zero-terminated)
+	** \return The number of chars written
+	*/
+	YUNI_DECL uint FormatDouble(char* buffer, double value);
+
+	/*!
+	** \brief Format a float with the shortest representation that reads back to the same value
+	**
+	** \see FormatDouble()
+	*/
+	YUNI_DECL uint FormatFloat(char* buffer, float value);
+
+
+	/*!
+	** \brief Append an integer to a string (decimal base)
+	**
+	** The digits are written directly into the reserved tail of the expandable strings.
+	*/
+	template<class CStringT, class T>
+	void AppendInteger(CStringT& s, T value);
+
+	/*!
+	** \brief Append a double or a float to a string (shortest round-trip representation)
+	*/
+	template<class CStringT, class T>
+	void AppendDecimal(CStringT& s, T value);
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
+
+#include "format.hxx"
@@ -0,0 +1,182 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "format.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	inline uint DecimalLength(uint32 value)
+	{
+		if (value < 10) return 1;
+		if (value < 100) return 2;
+		if (value < 1000) return 3;
+		if (value < 10000) return 4;
+		if (value < 100000) return 5;
+		if (value < 1000000) return 6;
+		if (value < 10000000) return 7;
+		if (value < 100000000) return 8;
+		if (value < 1000000000) return 9;
+		return 10;
+	}
+
+
+	inline uint DecimalLength(uint64 value)
+	{
+		if (value <= 0xFFFFFFFFu)
+			return DecimalLength(static_cast<uint32>(value));
+		// 10 digits at least
+		if (value < 100000000000000ull)
+		{
+			if (value < 10000000000ull) return 10;
+			if (value < 100000000000ull) return 11;
+			if (value < 1000000000000ull) return 12;
+			if (value < 10000000000000ull) return 13;
+			return 14;
+		}
+		if (value < 1000000000000000ull) return 15;
+		if (value < 10000000000000000ull) return 16;
+		if (value < 100000000000000000ull) return 17;
+		if (value < 1000000000000000000ull) return 18;
+		if (value < 10000000000000000000ull) return 19;
+		return 20;
+	}
+
+
+	//! Write exactly 8 digits (leading zeros included)
+	inline void WriteDecimal8(char* p, uint32 value)
+	{
+		uint32 high = value / 10000;
+		uint32 low = value % 10000;
+		uint32 pair = (high / 100) * 2;
+		p[0] = formatDigitPairs[pair];
+		p[1] = formatDigitPairs[pair + 1];
+		pair = (high % 100) * 2;
+		p[2] = formatDigitPairs[pair];
+		p[3] = formatDigitPairs[pair + 1];
+		pair = (low / 100) * 2;
+		p[4] = formatDigitPairs[pair];
+		p[5] = formatDigitPairs[pair + 1];
+		pair = (low % 100) * 2;
+		p[6] = formatDigitPairs[pair];
+		p[7] = formatDigitPairs[pair + 1];
+	}
+
+
+	inline void WriteDecimal(char* end, uint32 value)
+	{
+		while (value >= 100)
+		{
+			uint32 pair = (value % 100) * 2;
+			value /= 100;
+			end -= 2;
+			end[0] = formatDigitPairs[pair];
+			end[1] = formatDigitPairs[pair + 1];
+		}
+		if (value >= 10)
+		{
+			end[-2] = formatDigitPairs[value * 2];
+			end[-1] = formatDigitPairs[value * 2 + 1];
+		}
+		else
+			end[-1] = static_cast<char>('0' + value);
+	}
+
+
+	inline void WriteDecimal(char* end, uint64 value)
+	{
+		// 64-bit divisions only for splitting the value into blocks of 8 digits
+		while (value > 0xFFFFFFFFu)
+		{
+			end -= 8;
+			WriteDecimal8(end, static_cast<uint32>(value % 100000000u));
+			value /= 100000000u;
+		}
+		WriteDecimal(end, static_cast<uint32>(value));
+	}
+
+
+	//! Sign and magnitude of an integer, as expected by DecimalLength() and WriteDecimal()
+	template<class T, bool SignedT = std::is_signed<T>::value>
+	struct IntegerMagnitude final
+	{
+		typedef typename std::conditional<(sizeof(T) > 4), uint64, uint32>::type Type;
+		static bool Negative(T) { return false; }
+		static Type Value(T value) { return static_cast<Type>(value); }
+	};
+
+	template<class T>
+	struct IntegerMagnitude<T, true> final
+	{
+		typedef typename std::conditional<(sizeof(T) > 4), uint64, uint32>::type Type;
+		static bool Negative(T value) { return value < 0; }
+		static Type Value(T value)
+		{
+			// the unsigned negation is well-defined, even for the minimum value
+			return (value < 0) ? static_cast<Type>(Type(0) - static_cast<Type>(value)) : static_cast<Type>(value);
+		}
+	};
+
+
+	template<class CStringT, class T>
+	inline void AppendInteger(CStringT& s, T value)
+	{
+		typedef IntegerMagnitude<T> Magnitude;
+		typename Magnitude::Type magnitude = Magnitude::Value(value);
+		uint negative = Magnitude::Negative(value) ? 1u : 0u;
+		uint length = negative + DecimalLength(magnitude);
+
+		if (CStringT::expandable)
+		{
+			// writing directly into the tail of the string
+			typename CStringT::Size size = s.size();
+			s.reserve(size + length);
+			char* p = s.data() + size;
+			if (negative)
+				*p = '-';
+			WriteDecimal(p + length, magnitude);
+			s.resize(size + length);
+		}
+		else
+		{
+			// the string may be truncated
+			char buffer[24];
+			if (negative)
+				buffer[0] = '-';
+			WriteDecimal(buffer + length, magnitude);
+			s.append(static_cast<const char*>(buffer), length);
+		}
+	}
+
+
+	template<class CStringT, class T>
+	inline void AppendDecimal(CStringT& s, T value)
+	{
+		static_assert(std::is_floating_point<T>::value, "float or double expected");
+		char buffer[formatDecimalCapacity];
+		uint length = (sizeof(T) == sizeof(float))
+			? FormatFloat(buffer, static_cast<float>(value))
+			: FormatDouble(buffer, static_cast<double>(value));
+		s.append(static_cast<const char*>(buffer), length);
+	}
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
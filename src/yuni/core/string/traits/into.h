@@ -11,6 +11,7 @@
 #pragma once
 #include <stdlib.h>
 #include <ctype.h>
+#include "parse.h"
 
 
 
@@ -233,296 +234,54 @@ namespace CString
 
 
 
-	namespace // anonymous
-	{
-
-		class AutoDetectBaseNumber final
-		{
-		public:
-			static inline const char* Value(const char* const s, uint length, int& base)
-			{
-				switch (s[0])
-				{
-					case '#' :
-						{
-							base = 16;
-							return s + 1;
-						}
-					case '0' :
-						{
-							if (length > 2 and (s[1] == 'x' or s[1] == 'X'))
-							{
-								base = 16;
-								return s + 2;
-							}
-						}
-				}
-				base = 10;
-				return s;
-			}
-
-		}; // class AutoDetectBaseNumber
-
-	} // anonymous namespace
-
-
-
-
-# define YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(TYPE,CONVERT)  \
+# define YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(TYPE, PARSE)  \
 	template<> \
 	class Into<TYPE> final \
 	{ \
 	public: \
 		typedef TYPE IntoType; \
 		enum { valid = 1 }; \
-		enum { bufferSize = 256u }; \
 		\
 		template<class StringT> static bool Perform(const StringT& s, IntoType& out) \
 		{ \
-			if (s.empty()) \
-			{ \
-				out = IntoType(); \
-				return true; \
-			} \
-			char* pend; \
-			int base; \
-			if (not StringT::zeroTerminated) \
-			{ \
-				char buffer[bufferSize]; \
-				if (s.size() < bufferSize) \
-				{ \
-					YUNI_MEMCPY(buffer, bufferSize, s.data(), s.size()); \
-					buffer[s.size()] = '\0'; \
-				} \
-				else \
-				{ \
-					YUNI_MEMCPY(buffer, bufferSize, s.data(), bufferSize - 1); \
-					buffer[bufferSize - 1] = '\0'; \
-				} \
-				const char* p = AutoDetectBaseNumber::Value(buffer, s.size(), base); \
-				out = static_cast<IntoType>(::CONVERT(p, &pend, base)); \
-				return (NULL != pend and '\0' == *pend); \
-			} \
-			else \
-			{ \
-				const char* p = AutoDetectBaseNumber::Value(s.c_str(), s.size(), base); \
-				out = static_cast<IntoType>(::CONVERT(p, &pend, base)); \
-				return NULL != pend and (pend - p == s.size()); \
-			} \
+			uint offset; \
+			return PARSE(out, s.data(), s.size(), offset); \
+		} \
+		\
+		template<class StringT> static bool Perform(const StringT& s, IntoType& out, uint& offset) \
+		{ \
+			return PARSE(out, s.data(), s.size(), offset); \
 		} \
 		\
 		template<class StringT> static IntoType Perform(const StringT& s) \
 		{ \
-			if (s.empty()) \
-				return IntoType(); \
-			char* pend; \
-			int base; \
-			if (!StringT::zeroTerminated) \
-			{ \
-				char buffer[bufferSize]; \
-				if (s.size() < bufferSize) \
-				{ \
-					YUNI_MEMCPY(buffer, bufferSize, s.data(), s.size()); \
-					buffer[s.size()] = '\0'; \
-				} \
-				else \
-				{ \
-					YUNI_MEMCPY(buffer, bufferSize, s.data(), bufferSize - 1); \
-					buffer[bufferSize - 1] = '\0'; \
-				} \
-				const char* p = AutoDetectBaseNumber::Value(buffer, s.size(), base); \
-				return static_cast<IntoType>(::CONVERT(p, &pend, base)); \
-			} \
-			else \
-			{ \
-				const char* p = AutoDetectBaseNumber::Value(s.c_str(), s.size(), base); \
-				return static_cast<IntoType>(::CONVERT(p, &pend, base)); \
-			} \
+			IntoType out; \
+			uint offset; \
+			PARSE(out, s.data(), s.size(), offset); \
+			return out; \
 		} \
 	}
 
 
 
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(sint16, strtol);
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(sint32, strtol);
-	# ifdef YUNI_OS_MSVC
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(sint64, _strtoi64);
-	# else
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(sint64, strtoll);
-	# endif
-
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(uint16, strtoul);
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(uint32, strtoul);
-	# ifdef YUNI_OS_MSVC
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(uint64, _strtoui64);
-	# else
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(uint64, strtoull);
-	# endif
-
-
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(sint16, Yuni::Private::CStringImpl::ParseInteger);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(sint32, Yuni::Private::CStringImpl::ParseInteger);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(sint64, Yuni::Private::CStringImpl::ParseInteger);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(uint16, Yuni::Private::CStringImpl::ParseInteger);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(uint32, Yuni::Private::CStringImpl::ParseInteger);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(uint64, Yuni::Private::CStringImpl::ParseInteger);
 	# ifdef YUNI_HAS_LONG
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(long, strtol);
-	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(unsigned long, strtoul);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(long, Yuni::Private::CStringImpl::ParseInteger);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(unsigned long, Yuni::Private::CStringImpl::ParseInteger);
 	# endif
 
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(float, Yuni::Private::CStringImpl::ParseFloat);
+	YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC(double, Yuni::Private::CStringImpl::ParseDouble);
 
-# undef YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC
-
-
-
-
-	/*!
-	** \brief float
-	*/
-	template<>
-	class Into<float> final
-	{
-	public:
-		enum { valid = 1 };
-		enum { bufferSize = 256u };
-
-		template<class StringT> static bool Perform(const StringT& s, float& out)
-		{
-			if (not s.empty())
-			{
-				char* pend;
-				const char* cstr;
-				char buffer[bufferSize];
-				if (!StringT::zeroTerminated)
-				{
-					if (s.size() < bufferSize)
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), s.size());
-						buffer[s.size()] = '\0';
-					}
-					else
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), bufferSize - 1);
-						buffer[bufferSize - 1] = '\0';
-					}
-					cstr = buffer;
-				}
-				else
-					cstr = s.c_str();
-
-				# ifdef YUNI_OS_MSVC
-				// Visual Studio does not support strtof
-				out = static_cast<float>(strtod(cstr, &pend));
-				# else
-				out = static_cast<float>(strtof(cstr, &pend));
-				# endif
-				return (pend and pend - cstr == s.size());
-			}
-			out = 0.f;
-			return true;
-		}
-
-		template<class StringT> static float Perform(const StringT& s)
-		{
-			if (not s.empty())
-			{
-				char* pend;
-				const char* cstr;
-				char buffer[bufferSize];
-				if (!StringT::zeroTerminated)
-				{
-					if (s.size() < bufferSize)
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), s.size());
-						buffer[s.size()] = '\0';
-					}
-					else
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), bufferSize - 1);
-						buffer[bufferSize - 1] = '\0';
-					}
-					cstr = buffer;
-				}
-				else
-					cstr = s.c_str();
-
-				# ifdef YUNI_OS_MSVC
-				// Visual Studio does not support strtof
-				return static_cast<float>(::strtod(cstr, &pend));
-				# else
-				return static_cast<float>(::strtof(cstr, &pend));
-				# endif
-			}
-			return 0.f;
-		}
-	};
-
-
-	/*!
-	** \brief double
-	*/
-	template<>
-	class Into<double> final
-	{
-	public:
-		enum { valid = 1 };
-		enum { bufferSize = 256u };
-
-		template<class StringT> static bool Perform(const StringT& s, double& out)
-		{
-			if (not s.empty())
-			{
-				char* pend;
-				const char* cstr;
-				char buffer[bufferSize];
-				if (!StringT::zeroTerminated)
-				{
-					if (s.size() < bufferSize)
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), s.size());
-						buffer[s.size()] = '\0';
-					}
-					else
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), bufferSize - 1);
-						buffer[bufferSize - 1] = '\0';
-					}
-					cstr = buffer;
-				}
-				else
-					cstr = s.c_str();
 
-				out = static_cast<double>(::strtod(cstr, &pend));
-				return (NULL != pend and '\0' == *pend);
-			}
-			out = 0.;
-			return true;
-		}
+# undef YUNI_CORE_EXTENSION_ISTRING_TO_NUMERIC
 
-		template<class StringT> static double Perform(const StringT& s)
-		{
-			if (not s.empty())
-			{
-				char* pend;
-				const char* cstr;
-				char buffer[bufferSize];
-				if (!StringT::zeroTerminated)
-				{
-					if (s.size() < bufferSize)
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), s.size());
-						buffer[s.size()] = '\0';
-					}
-					else
-					{
-						YUNI_MEMCPY(buffer, bufferSize, s.data(), bufferSize - 1);
-						buffer[bufferSize - 1] = '\0';
-					}
-					cstr = buffer;
-				}
-				else
-					cstr = s.c_str();
 
-				return static_cast<double>(::strtod(cstr, &pend));
-			}
-			return 0.;
-		}
-	};
 
 
 	/*!
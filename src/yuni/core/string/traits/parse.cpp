@@ -0,0 +1,561 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "parse.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	namespace // anonymous
+	{
+
+		// The decimal numbers are converted as described by Daniel Lemire, "Number
+		// Parsing at a Gigabyte per Second" (2021), from the algorithm of Michael
+		// Eisel: the 19 most significant digits are multiplied by a 128-bit
+		// approximation of the power of 5, which is always enough to round the
+		// result correctly (Mushtak and Lemire, "Fast Number Parsing Without
+		// Fallback", 2023).
+
+		enum
+		{
+			parsePow5Min = -342,
+			parsePow5Max = 308,
+			//! Number of significant digits given to strtod() by the slow path (768 are enough)
+			parseSlowPathDigits = 780,
+		};
+
+		#include "parse.inc.hpp"
+
+
+		//! IEEE 754 formats
+		template<class T> struct BinaryFormat;
+
+		template<> struct BinaryFormat<double> final
+		{
+			typedef uint64 Bits;
+			enum
+			{
+				mantissaBits = 52,
+				minimumExponent = -1023,
+				infinitePower = 0x7FF,
+				minExponentRoundToEven = -4,
+				maxExponentRoundToEven = 23,
+				smallestPowerOfTen = -342,
+				largestPowerOfTen = 308,
+			};
+			static double Strtod(const char* s, char** end) { return ::strtod(s, end); }
+		};
+
+		template<> struct BinaryFormat<float> final
+		{
+			typedef uint32 Bits;
+			enum
+			{
+				mantissaBits = 23,
+				minimumExponent = -127,
+				infinitePower = 0xFF,
+				minExponentRoundToEven = -17,
+				maxExponentRoundToEven = 10,
+				smallestPowerOfTen = -65,
+				largestPowerOfTen = 38,
+			};
+			static float Strtod(const char* s, char** end)
+			{
+				# ifdef YUNI_OS_MSVC
+				// Visual Studio does not support strtof
+				return static_cast<float>(::strtod(s, end));
+				# else
+				return ::strtof(s, end);
+				# endif
+			}
+		};
+
+
+		//! A binary floating-point number, mantissa (without the implicit bit) and biased exponent
+		struct AdjustedMantissa final
+		{
+			uint64 mantissa;
+			int power2;
+
+			bool operator != (const AdjustedMantissa& rhs) const
+			{
+				return mantissa != rhs.mantissa or power2 != rhs.power2;
+			}
+		};
+
+
+		//! Full 64x64 -> 128 bits multiplication
+		inline uint64 Multiply(uint64 a, uint64 b, uint64& high)
+		{
+			# ifdef YUNI_HAS_INT128_T
+			uint128 product = static_cast<uint128>(a) * b;
+			high = static_cast<uint64>(product >> 64);
+			return static_cast<uint64>(product);
+			# else
+			uint64 aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+			uint64 bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+			uint64 b00 = aLo * bLo, b01 = aLo * bHi, b10 = aHi * bLo, b11 = aHi * bHi;
+			uint64 mid1 = b10 + (b00 >> 32);
+			uint64 mid2 = b01 + (mid1 & 0xFFFFFFFFu);
+			high = b11 + (mid1 >> 32) + (mid2 >> 32);
+			return (mid2 << 32) | (b00 & 0xFFFFFFFFu);
+			# endif
+		}
+
+
+		inline int LeadingZeroes(uint64 value) // value != 0
+		{
+			# if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(value);
+			# else
+			int count = 0;
+			for (int shift = 32; shift != 0; shift >>= 1)
+			{
+				if (value < (uint64(1) << (64 - shift)))
+				{
+					value <<= shift;
+					count += shift;
+				}
+			}
+			return count;
+			# endif
+		}
+
+
+		//! floor(log2(10^q)) + 63 (-342 <= q <= 308)
+		inline int Power(int q)
+		{
+			return (((152170 + 65536) * q) >> 16) + 63;
+		}
+
+
+		//! Correctly rounded value of w * 10^q
+		template<class T>
+		AdjustedMantissa ComputeFloat(sint64 q, uint64 w)
+		{
+			typedef BinaryFormat<T> Format;
+			AdjustedMantissa answer;
+			if (w == 0 or q < Format::smallestPowerOfTen)
+			{
+				answer.mantissa = 0;
+				answer.power2 = 0;
+				return answer;
+			}
+			if (q > Format::largestPowerOfTen)
+			{
+				answer.mantissa = 0;
+				answer.power2 = Format::infinitePower;
+				return answer;
+			}
+
+			// the most significant bit of w must be set
+			int lz = LeadingZeroes(w);
+			w <<= lz;
+
+			// product with the 128-bit approximation of 5^q, the second half only being
+			// required when the bits below the precision of the first product are all set
+			const uint64* const pow5 = parsePow5[q - parsePow5Min];
+			uint64 high;
+			uint64 low = Multiply(w, pow5[0], high);
+			const uint64 precisionMask = uint64(0xFFFFFFFFFFFFFFFFull) >> (Format::mantissaBits + 3);
+			if ((high & precisionMask) == precisionMask)
+			{
+				uint64 secondHigh;
+				Multiply(w, pow5[1], secondHigh);
+				low += secondHigh;
+				if (secondHigh > low)
+					++high;
+			}
+
+			int upperbit = static_cast<int>(high >> 63);
+			int shift = upperbit + 64 - Format::mantissaBits - 3;
+			answer.mantissa = high >> shift;
+			answer.power2 = Power(static_cast<int>(q)) + upperbit - lz - Format::minimumExponent;
+
+			if (answer.power2 <= 0)
+			{
+				// subnormal
+				if (-answer.power2 + 1 >= 64)
+				{
+					answer.mantissa = 0;
+					answer.power2 = 0;
+					return answer;
+				}
+				answer.mantissa >>= -answer.power2 + 1;
+				answer.mantissa += (answer.mantissa & 1); // round up
+				answer.mantissa >>= 1;
+				// the rounding may give the smallest normal number
+				answer.power2 = (answer.mantissa < (uint64(1) << Format::mantissaBits)) ? 0 : 1;
+				return answer;
+			}
+
+			// exactly between two floats (only possible when 5^q fits in 64 bits):
+			// round half to even instead of up
+			if (low <= 1 and q >= Format::minExponentRoundToEven and q <= Format::maxExponentRoundToEven
+				and (answer.mantissa & 3) == 1 and (answer.mantissa << shift) == high)
+			{
+				answer.mantissa &= ~uint64(1);
+			}
+
+			answer.mantissa += (answer.mantissa & 1); // round up
+			answer.mantissa >>= 1;
+			if (answer.mantissa >= (uint64(2) << Format::mantissaBits))
+			{
+				answer.mantissa = (uint64(1) << Format::mantissaBits);
+				++answer.power2;
+			}
+			answer.mantissa &= ~(uint64(1) << Format::mantissaBits);
+			if (answer.power2 >= Format::infinitePower)
+			{
+				answer.mantissa = 0;
+				answer.power2 = Format::infinitePower;
+			}
+			return answer;
+		}
+
+
+		template<class T>
+		inline T ToFloat(bool negative, const AdjustedMantissa& am)
+		{
+			typedef BinaryFormat<T> Format;
+			typedef typename Format::Bits Bits;
+			Bits bits = static_cast<Bits>(am.mantissa)
+				| (static_cast<Bits>(am.power2) << Format::mantissaBits)
+				| (static_cast<Bits>(negative ? 1 : 0) << (sizeof(Bits) * 8 - 1));
+			T value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+
+		//! Case-insensitive comparison with a lowercase word
+		inline bool MatchWord(const char* s, uint length, uint i, const char* word, uint wordLength)
+		{
+			if (length - i < wordLength)
+				return false;
+			for (uint j = 0; j != wordLength; ++j)
+			{
+				if ((s[i + j] | 0x20) != word[j])
+					return false;
+			}
+			return true;
+		}
+
+
+		//! Decimal digits of a number, as found in the string
+		struct DecimalDigits final
+		{
+			const char* integer;
+			uint integerLength;
+			const char* fraction;
+			uint fractionLength;
+			//! The explicit exponent (`e` notation)
+			sint64 exponent;
+		};
+
+
+		/*!
+		** \brief Exact conversion with strtod(), of the significant digits only
+		**
+		** The digits are written as an integer followed by an exponent, without any
+		** decimal point, thus the conversion does not depend on the locale.
+		*/
+		template<class T>
+		T SlowPath(bool negative, const DecimalDigits& digits)
+		{
+			char buffer[parseSlowPathDigits + 32];
+			char* p = buffer;
+			if (negative)
+				*p++ = '-';
+
+			uint kept = 0;
+			sint64 dropped = 0;
+			bool sticky = false;
+			for (uint part = 0; part != 2; ++part)
+			{
+				const char* d = (part == 0) ? digits.integer : digits.fraction;
+				uint count = (part == 0) ? digits.integerLength : digits.fractionLength;
+				for (uint j = 0; j != count; ++j)
+				{
+					if (kept == 0 and d[j] == '0')
+						continue; // leading zeros
+					if (kept != parseSlowPathDigits)
+					{
+						*p++ = d[j];
+						++kept;
+					}
+					else
+					{
+						++dropped;
+						sticky |= (d[j] != '0');
+					}
+				}
+			}
+			if (kept == 0)
+				return negative ? -T(0) : T(0);
+			if (sticky)
+			{
+				// the digits beyond do not matter, except if they are all zeros
+				*p++ = '1';
+				--dropped;
+			}
+
+			sint64 exponent = digits.exponent - static_cast<sint64>(digits.fractionLength) + dropped;
+			if (exponent > 99999999)
+				exponent = 99999999;
+			else if (exponent < -99999999)
+				exponent = -99999999;
+			*p++ = 'e';
+			if (exponent < 0)
+			{
+				*p++ = '-';
+				exponent = -exponent;
+			}
+			char* start = p;
+			do
+			{
+				*p++ = static_cast<char>('0' + exponent % 10);
+				exponent /= 10;
+			}
+			while (exponent != 0);
+			for (char* end = p - 1; start < end; ++start, --end)
+			{
+				char c = *start;
+				*start = *end;
+				*end = c;
+			}
+			*p = '\0';
+			return BinaryFormat<T>::Strtod(buffer, nullptr);
+		}
+
+
+		//! Hexadecimal notation, with strtod()
+		template<class T>
+		bool ParseHexadecimal(T& out, const char* const s, uint length, uint start, uint& offset)
+		{
+			enum { bufferSize = 256u };
+			char buffer[bufferSize];
+			uint count = length - start;
+			if (count >= bufferSize)
+				count = bufferSize - 1;
+			YUNI_MEMCPY(buffer, bufferSize, s + start, count);
+			buffer[count] = '\0';
+			char* end = nullptr;
+			out = BinaryFormat<T>::Strtod(buffer, &end);
+			offset = start + static_cast<uint>(end - buffer);
+			return offset == length;
+		}
+
+
+		template<class T>
+		bool ParseDecimal(T& out, const char* const s, uint length, uint& offset)
+		{
+			if (YUNI_UNLIKELY(length == 0))
+			{
+				out = T();
+				offset = 0;
+				return true;
+			}
+
+			uint i = 0;
+			while (i != length and ParseIsSpace(s[i]))
+				++i;
+			const uint start = i;
+			bool negative = false;
+			if (i != length and (s[i] == '-' or s[i] == '+'))
+			{
+				negative = (s[i] == '-');
+				++i;
+			}
+
+			if (YUNI_UNLIKELY(i != length and static_cast<uint>(static_cast<unsigned char>(s[i])) - '0' > 9 and s[i] != '.'))
+			{
+				// special values
+				if (MatchWord(s, length, i, "nan", 3))
+				{
+					i += 3;
+					if (i != length and s[i] == '(')
+					{
+						// nan(n-char-sequence)
+						uint j = i + 1;
+						while (j != length and (s[j] == '_' or (static_cast<uint>(static_cast<unsigned char>(s[j]) | 0x20) - 'a' < 26u)
+							or (static_cast<uint>(static_cast<unsigned char>(s[j])) - '0' < 10)))
+							++j;
+						if (j != length and s[j] == ')')
+							i = j + 1;
+					}
+					out = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+					offset = i;
+					return i == length;
+				}
+				if (MatchWord(s, length, i, "inf", 3))
+				{
+					i += 3;
+					if (MatchWord(s, length, i, "inity", 5))
+						i += 5;
+					out = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+					offset = i;
+					return i == length;
+				}
+				out = T();
+				offset = start;
+				return false;
+			}
+			if (s[i] == '0' and i + 1 < length and (s[i + 1] | 0x20) == 'x')
+				return ParseHexadecimal(out, s, length, start, offset);
+
+			// integral part
+			DecimalDigits digits;
+			uint64 w = 0;
+			digits.integer = s + i;
+			while (length - i >= 8)
+			{
+				uint64 chars = ParseLoad8(s + i);
+				if (not ParseIsEightDigits(chars))
+					break;
+				w = w * 100000000u + ParseEightDigits(chars); // may overflow, see below
+				i += 8;
+			}
+			for (; i != length and static_cast<uint>(static_cast<unsigned char>(s[i])) - '0' < 10; ++i)
+				w = w * 10 + static_cast<uint>(s[i] - '0');
+			digits.integerLength = static_cast<uint>(s + i - digits.integer);
+
+			// fractional part
+			digits.fraction = s + i;
+			digits.fractionLength = 0;
+			if (i != length and s[i] == '.')
+			{
+				++i;
+				digits.fraction = s + i;
+				while (length - i >= 8)
+				{
+					uint64 chars = ParseLoad8(s + i);
+					if (not ParseIsEightDigits(chars))
+						break;
+					w = w * 100000000u + ParseEightDigits(chars);
+					i += 8;
+				}
+				for (; i != length and static_cast<uint>(static_cast<unsigned char>(s[i])) - '0' < 10; ++i)
+					w = w * 10 + static_cast<uint>(s[i] - '0');
+				digits.fractionLength = static_cast<uint>(s + i - digits.fraction);
+			}
+
+			uint digitCount = digits.integerLength + digits.fractionLength;
+			if (YUNI_UNLIKELY(digitCount == 0))
+			{
+				out = T();
+				offset = start;
+				return false;
+			}
+
+			// exponent
+			digits.exponent = 0;
+			if (i != length and (s[i] | 0x20) == 'e')
+			{
+				uint e = i + 1;
+				bool negativeExponent = false;
+				if (e != length and (s[e] == '-' or s[e] == '+'))
+				{
+					negativeExponent = (s[e] == '-');
+					++e;
+				}
+				if (e != length and static_cast<uint>(static_cast<unsigned char>(s[e])) - '0' < 10)
+				{
+					sint64 exponent = 0;
+					for (; e != length and static_cast<uint>(static_cast<unsigned char>(s[e])) - '0' < 10; ++e)
+					{
+						if (exponent < 0x10000000)
+							exponent = exponent * 10 + (s[e] - '0');
+					}
+					digits.exponent = negativeExponent ? -exponent : exponent;
+					i = e;
+				}
+				// otherwise the `e` is not part of the number
+			}
+			offset = i;
+
+			sint64 q = digits.exponent - static_cast<sint64>(digits.fractionLength);
+			bool truncated = false;
+			if (digitCount > 19)
+			{
+				// the leading zeros are not significant
+				for (const char* p = digits.integer; p != s + offset and (*p == '0' or *p == '.'); ++p)
+				{
+					if (*p == '0')
+						--digitCount;
+				}
+				if (digitCount > 19)
+				{
+					// keeping the 19 most significant digits only
+					truncated = true;
+					const uint64 minNineteenDigits = 1000000000000000000ull;
+					w = 0;
+					const char* p = digits.integer;
+					const char* end = digits.integer + digits.integerLength;
+					for (; w < minNineteenDigits and p != end; ++p)
+						w = w * 10 + static_cast<uint>(*p - '0');
+					if (w >= minNineteenDigits)
+						q = digits.exponent + (end - p);
+					else
+					{
+						p = digits.fraction;
+						end = digits.fraction + digits.fractionLength;
+						for (; w < minNineteenDigits and p != end; ++p)
+							w = w * 10 + static_cast<uint>(*p - '0');
+						q = digits.exponent - (p - digits.fraction);
+					}
+				}
+			}
+
+			AdjustedMantissa am = ComputeFloat<T>(q, w);
+			if (truncated)
+			{
+				// the value lies between w and w + 1, the rounding must be the same for both
+				if (YUNI_UNLIKELY(am != ComputeFloat<T>(q, w + 1)))
+				{
+					out = SlowPath<T>(negative, digits);
+					return offset == length;
+				}
+			}
+			out = ToFloat<T>(negative, am);
+			return offset == length;
+		}
+
+
+	} // anonymous namespace
+
+
+
+
+	bool ParseDouble(double& out, const char* const s, uint length, uint& offset)
+	{
+		return ParseDecimal<double>(out, s, length, offset);
+	}
+
+
+	bool ParseFloat(float& out, const char* const s, uint length, uint& offset)
+	{
+		return ParseDecimal<float>(out, s, length, offset);
+	}
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
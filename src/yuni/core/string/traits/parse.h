@@ -0,0 +1,90 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include <type_traits>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	//! Get if a char is a whitespace, as isspace() in the C locale
+	bool ParseIsSpace(char c);
+
+	//! Get if the 8 chars of a word (loaded by ParseLoad8()) are all decimal digits
+	bool ParseIsEightDigits(uint64 chars);
+
+	//! Value of 8 decimal digits (loaded by ParseLoad8())
+	uint32 ParseEightDigits(uint64 chars);
+
+	//! Load 8 chars into a word, the first char being the least significant byte
+	uint64 ParseLoad8(const char* p);
+
+
+	/*!
+	** \brief Convert a string into an integer
+	**
+	** The accepted syntax is `[spaces][+|-](digits|#hexdigits|0xhexdigits)`. The
+	** runs of decimal digits are validated and converted 8 or 16 digits at once.
+	** An empty string is converted into 0.
+	**
+	** \param[out] out The value. Clamped to the limits of the type when out of range,
+	**   the value of the digits before the invalid char otherwise
+	** \param s The string (not necessarily zero-terminated)
+	** \param length The length of the string
+	** \param[out] offset The offset of the first invalid char (or of the digit from which
+	**   the value is out of range), `length` if the conversion succeeded
+	** \return True if the whole string has been converted
+	*/
+	template<class T>
+	bool ParseInteger(T& out, const char* const s, uint length, uint& offset);
+
+
+	/*!
+	** \brief Convert a string into a double (correctly rounded)
+	**
+	** The accepted syntax is the one of strtod() in the C locale (`nan`, `inf` and
+	** the hexadecimal notation included), with leading spaces. An empty string is
+	** converted into 0.
+	**
+	** The conversion relies on the algorithm of Eisel and Lemire (128-bit product
+	** with a power of 5), without any allocation. strtod() is only used for the
+	** hexadecimal notation and when more than 19 significant digits are given and
+	** the truncated value is ambiguous.
+	**
+	** \param[out] out The value
+	** \param s The string (not necessarily zero-terminated)
+	** \param length The length of the string
+	** \param[out] offset The offset of the first invalid char, `length` if the conversion succeeded
+	** \return True if the whole string has been converted
+	*/
+	YUNI_DECL bool ParseDouble(double& out, const char* const s, uint length, uint& offset);
+
+	/*!
+	** \brief Convert a string into a float (correctly rounded)
+	**
+	** \see ParseDouble()
+	*/
+	YUNI_DECL bool ParseFloat(float& out, const char* const s, uint length, uint& offset);
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
+
+#include "parse.hxx"
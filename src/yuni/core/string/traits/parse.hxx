@@ -0,0 +1,181 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "parse.h"
+#include <limits>
+#include <string.h>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	inline bool ParseIsSpace(char c)
+	{
+		// ' ', '\t', '\n', '\v', '\f', '\r'
+		return c == ' ' or (static_cast<uint>(static_cast<unsigned char>(c)) - 9u < 5u);
+	}
+
+
+	inline uint64 ParseLoad8(const char* p)
+	{
+		uint64 chars;
+		memcpy(&chars, p, sizeof(chars));
+		# if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		chars = __builtin_bswap64(chars);
+		# endif
+		return chars;
+	}
+
+
+	inline bool ParseIsEightDigits(uint64 chars)
+	{
+		// each byte must be in [0x30, 0x39]: its high nibble is 3, and still 3 once 6 added
+		return ((chars & 0xF0F0F0F0F0F0F0F0ull)
+			| (((chars + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+	}
+
+
+	inline uint32 ParseEightDigits(uint64 chars)
+	{
+		// pairs of digits, then groups of 4, then the 8 digits
+		chars -= 0x3030303030303030ull;
+		chars = (chars * 10) + (chars >> 8);
+		chars = (((chars & 0x000000FF000000FFull) * 0x000F424000000064ull)
+			+ (((chars >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+		return static_cast<uint32>(chars);
+	}
+
+
+	template<class T>
+	bool ParseInteger(T& out, const char* const s, uint length, uint& offset)
+	{
+		static_assert(std::is_integral<T>::value and sizeof(T) <= sizeof(uint64), "integer expected");
+		if (YUNI_UNLIKELY(length == 0))
+		{
+			out = T();
+			offset = 0;
+			return true;
+		}
+
+		uint i = 0;
+		while (i != length and ParseIsSpace(s[i]))
+			++i;
+		bool negative = false;
+		if (i != length and (s[i] == '-' or s[i] == '+'))
+		{
+			negative = (s[i] == '-');
+			++i;
+		}
+
+		// the greatest magnitude allowed for the sign
+		const uint64 limit = (not negative)
+			? static_cast<uint64>(std::numeric_limits<T>::max())
+			: (std::is_signed<T>::value ? static_cast<uint64>(std::numeric_limits<T>::max()) + 1 : 0);
+		uint64 magnitude = 0;
+		bool overflow = false;
+		uint first;
+
+		if (i != length and (s[i] == '#' or (s[i] == '0' and i + 1 < length and (s[i + 1] | 0x20) == 'x')))
+		{
+			// hexadecimal
+			i += (s[i] == '#') ? 1 : 2;
+			first = i;
+			for (; i != length; ++i)
+			{
+				uint c = static_cast<unsigned char>(s[i]);
+				uint digit = c - '0';
+				if (digit > 9)
+				{
+					digit = (c | 0x20) - 'a';
+					if (digit > 5)
+						break;
+					digit += 10;
+				}
+				if (magnitude > (limit >> 4) or (magnitude == (limit >> 4) and digit > (limit & 15)))
+				{
+					overflow = true;
+					break;
+				}
+				magnitude = magnitude * 16 + digit;
+			}
+		}
+		else
+		{
+			first = i;
+			// 16 digits at once, as long as the value can not exceed the limit
+			if (limit >= 9999999999999999ull)
+			{
+				const uint64 bound = (limit - 9999999999999999ull) / 10000000000000000ull;
+				while (length - i >= 16 and magnitude <= bound)
+				{
+					uint64 high = ParseLoad8(s + i);
+					uint64 low = ParseLoad8(s + i + 8);
+					if (not ParseIsEightDigits(high) or not ParseIsEightDigits(low))
+						break;
+					magnitude = magnitude * 10000000000000000ull
+						+ static_cast<uint64>(ParseEightDigits(high)) * 100000000u + ParseEightDigits(low);
+					i += 16;
+				}
+			}
+			// 8 digits at once
+			if (limit >= 99999999u)
+			{
+				const uint64 bound = (limit - 99999999u) / 100000000u;
+				while (length - i >= 8 and magnitude <= bound)
+				{
+					uint64 chars = ParseLoad8(s + i);
+					if (not ParseIsEightDigits(chars))
+						break;
+					magnitude = magnitude * 100000000u + ParseEightDigits(chars);
+					i += 8;
+				}
+			}
+			// the remaining digits, one by one
+			const uint64 limitTens = limit / 10;
+			const uint limitUnits = static_cast<uint>(limit % 10);
+			for (; i != length; ++i)
+			{
+				uint digit = static_cast<uint>(static_cast<unsigned char>(s[i])) - '0';
+				if (digit > 9)
+					break;
+				if (magnitude >= limitTens and (magnitude > limitTens or digit > limitUnits))
+				{
+					overflow = true;
+					break;
+				}
+				magnitude = magnitude * 10 + digit;
+			}
+		}
+
+		offset = i;
+		if (YUNI_UNLIKELY(overflow))
+		{
+			// clamped, as strtol() does
+			out = (not negative)
+				? std::numeric_limits<T>::max()
+				: (std::is_signed<T>::value ? std::numeric_limits<T>::min() : T());
+			return false;
+		}
+		out = static_cast<T>((not negative) ? magnitude : (0 - magnitude));
+		return (i == length and i != first);
+	}
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
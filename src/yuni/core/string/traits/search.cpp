@@ -0,0 +1,386 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "search.h"
+#include <cstdint>
+#include <string.h>
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+# define YUNI_SEARCH_X86
+# include <immintrin.h>
+# ifdef YUNI_MSVC
+#	include <intrin.h>
+# endif
+#endif
+
+#if defined(YUNI_SEARCH_X86) && !defined(YUNI_MSVC)
+# define YUNI_SEARCH_TARGET_SSE2  __attribute__((target("sse2")))
+# define YUNI_SEARCH_TARGET_AVX2  __attribute__((target("avx2")))
+#else
+# define YUNI_SEARCH_TARGET_SSE2
+# define YUNI_SEARCH_TARGET_AVX2
+#endif
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	namespace // anonymous
+	{
+
+		inline uint LowestBit(uint32_t mask)
+		{
+			# ifdef YUNI_MSVC
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return static_cast<uint>(index);
+			# else
+			return static_cast<uint>(__builtin_ctz(mask));
+			# endif
+		}
+
+
+		inline uint HighestBit(uint32_t mask)
+		{
+			# ifdef YUNI_MSVC
+			unsigned long index;
+			_BitScanReverse(&index, mask);
+			return static_cast<uint>(index);
+			# else
+			return 31u - static_cast<uint>(__builtin_clz(mask));
+			# endif
+		}
+
+
+		template<bool InsensitiveT>
+		inline bool SearchEquals(const char* a, const char* b, size_t len)
+		{
+			if (not InsensitiveT)
+				return 0 == ::memcmp(a, b, len);
+			for (size_t i = 0; i != len; ++i)
+			{
+				if (SearchToLower(a[i]) != SearchToLower(b[i]))
+					return false;
+			}
+			return true;
+		}
+
+
+		//! Set of chars, as a bitmap
+		struct CharSet final
+		{
+			template<bool InsensitiveT>
+			void add(const char* set, size_t setlen)
+			{
+				for (size_t i = 0; i != setlen; ++i)
+				{
+					char c = InsensitiveT ? SearchToLower(set[i]) : set[i];
+					map[static_cast<unsigned char>(c) >> 5] |= 1u << (static_cast<unsigned char>(c) & 31);
+				}
+			}
+
+			bool contains(char c) const
+			{
+				return 0 != (map[static_cast<unsigned char>(c) >> 5] & (1u << (static_cast<unsigned char>(c) & 31)));
+			}
+
+			uint32_t map[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		};
+
+
+
+
+		template<bool InsensitiveT>
+		size_t ScalarFindChar(const char* s, size_t n, char c)
+		{
+			if (InsensitiveT)
+				c = SearchToLower(c);
+			for (size_t i = 0; i != n; ++i)
+			{
+				if ((InsensitiveT ? SearchToLower(s[i]) : s[i]) == c)
+					return i;
+			}
+			return searchNotFound;
+		}
+
+
+		template<bool InsensitiveT>
+		size_t ScalarRFindChar(const char* s, size_t n, char c)
+		{
+			if (InsensitiveT)
+				c = SearchToLower(c);
+			while (n--)
+			{
+				if ((InsensitiveT ? SearchToLower(s[n]) : s[n]) == c)
+					return n;
+			}
+			return searchNotFound;
+		}
+
+
+		template<bool InsensitiveT>
+		size_t ScalarFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+		{
+			CharSet chars;
+			chars.add<InsensitiveT>(set, setlen);
+			for (size_t i = 0; i != n; ++i)
+			{
+				if (chars.contains(InsensitiveT ? SearchToLower(s[i]) : s[i]))
+					return i;
+			}
+			return searchNotFound;
+		}
+
+
+		template<bool InsensitiveT>
+		size_t ScalarRFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+		{
+			CharSet chars;
+			chars.add<InsensitiveT>(set, setlen);
+			while (n--)
+			{
+				if (chars.contains(InsensitiveT ? SearchToLower(s[n]) : s[n]))
+					return n;
+			}
+			return searchNotFound;
+		}
+
+
+		template<bool InsensitiveT>
+		size_t ScalarFind(const char* s, size_t n, const char* needle, size_t len)
+		{
+			if (len == 0 or len > n)
+				return searchNotFound;
+			char first = InsensitiveT ? SearchToLower(*needle) : *needle;
+			size_t end = n - len + 1;
+			for (size_t i = 0; i != end; ++i)
+			{
+				if ((InsensitiveT ? SearchToLower(s[i]) : s[i]) == first)
+				{
+					if (SearchEquals<InsensitiveT>(s + i + 1, needle + 1, len - 1))
+						return i;
+				}
+			}
+			return searchNotFound;
+		}
+
+
+		template<bool InsensitiveT>
+		size_t ScalarRFind(const char* s, size_t n, const char* needle, size_t len)
+		{
+			if (len == 0 or len > n)
+				return searchNotFound;
+			char first = InsensitiveT ? SearchToLower(*needle) : *needle;
+			size_t i = n - len + 1;
+			while (i--)
+			{
+				if ((InsensitiveT ? SearchToLower(s[i]) : s[i]) == first)
+				{
+					if (SearchEquals<InsensitiveT>(s + i + 1, needle + 1, len - 1))
+						return i;
+				}
+			}
+			return searchNotFound;
+		}
+
+
+		size_t ScalarCountChar(const char* s, size_t n, char c)
+		{
+			size_t count = 0;
+			for (size_t i = 0; i != n; ++i)
+				count += (s[i] == c) ? 1 : 0;
+			return count;
+		}
+
+
+		const SearchKernels scalarKernels =
+		{
+			"scalar",
+			ScalarFindChar<false>, ScalarFindChar<true>, ScalarRFindChar<false>, ScalarRFindChar<true>,
+			ScalarCountChar,
+			ScalarFindAnyOf<false>, ScalarFindAnyOf<true>, ScalarRFindAnyOf<false>, ScalarRFindAnyOf<true>,
+			ScalarFind<false>, ScalarFind<true>, ScalarRFind<false>, ScalarRFind<true>,
+		};
+
+
+
+
+		# ifdef YUNI_SEARCH_X86
+
+		namespace SSE2
+		{
+
+			# define YUNI_SEARCH_TARGET  YUNI_SEARCH_TARGET_SSE2
+
+			typedef __m128i Vec;
+			enum : size_t { width = 16 };
+			const char* const name = "sse2";
+			const SearchKernels& narrower = scalarKernels;
+
+			YUNI_SEARCH_TARGET inline Vec Load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+			YUNI_SEARCH_TARGET inline Vec Set1(char c) { return _mm_set1_epi8(c); }
+			YUNI_SEARCH_TARGET inline Vec Zero() { return _mm_setzero_si128(); }
+			YUNI_SEARCH_TARGET inline Vec CmpEq(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+			YUNI_SEARCH_TARGET inline Vec And(Vec a, Vec b) { return _mm_and_si128(a, b); }
+			YUNI_SEARCH_TARGET inline Vec Or(Vec a, Vec b) { return _mm_or_si128(a, b); }
+			YUNI_SEARCH_TARGET inline Vec SubBytes(Vec a, Vec b) { return _mm_sub_epi8(a, b); }
+			YUNI_SEARCH_TARGET inline uint32_t MoveMask(Vec a) { return static_cast<uint32_t>(_mm_movemask_epi8(a)); }
+
+			YUNI_SEARCH_TARGET inline size_t SumBytes(Vec a)
+			{
+				// 2 sums of 8 bytes, 2040 at most
+				__m128i sums = _mm_sad_epu8(a, _mm_setzero_si128());
+				return static_cast<size_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+			}
+
+			YUNI_SEARCH_TARGET inline Vec Fold(Vec a)
+			{
+				// 'A' <= a <= 'Z' (signed comparisons, the chars >= 0x80 are negative)
+				__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(a, _mm_set1_epi8('A' - 1)),
+					_mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), a));
+				return _mm_or_si128(a, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+			}
+
+			# include "search.inc.hpp"
+			# undef YUNI_SEARCH_TARGET
+
+		} // namespace SSE2
+
+
+		namespace AVX2
+		{
+
+			# define YUNI_SEARCH_TARGET  YUNI_SEARCH_TARGET_AVX2
+
+			typedef __m256i Vec;
+			enum : size_t { width = 32 };
+			const char* const name = "avx2";
+			const SearchKernels& narrower = SSE2::kernels;
+
+			YUNI_SEARCH_TARGET inline Vec Load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+			YUNI_SEARCH_TARGET inline Vec Set1(char c) { return _mm256_set1_epi8(c); }
+			YUNI_SEARCH_TARGET inline Vec Zero() { return _mm256_setzero_si256(); }
+			YUNI_SEARCH_TARGET inline Vec CmpEq(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+			YUNI_SEARCH_TARGET inline Vec And(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+			YUNI_SEARCH_TARGET inline Vec Or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+			YUNI_SEARCH_TARGET inline Vec SubBytes(Vec a, Vec b) { return _mm256_sub_epi8(a, b); }
+			YUNI_SEARCH_TARGET inline uint32_t MoveMask(Vec a) { return static_cast<uint32_t>(_mm256_movemask_epi8(a)); }
+
+			YUNI_SEARCH_TARGET inline size_t SumBytes(Vec a)
+			{
+				// 4 sums of 8 bytes, 2040 at most
+				__m256i sums = _mm256_sad_epu8(a, _mm256_setzero_si256());
+				__m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+				return static_cast<size_t>(_mm_cvtsi128_si32(half) + _mm_extract_epi16(half, 4));
+			}
+
+			YUNI_SEARCH_TARGET inline Vec Fold(Vec a)
+			{
+				__m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(a, _mm256_set1_epi8('A' - 1)),
+					_mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), a));
+				return _mm256_or_si256(a, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+			}
+
+			# include "search.inc.hpp"
+			# undef YUNI_SEARCH_TARGET
+
+		} // namespace AVX2
+
+
+		bool CPUSupports(SearchInstructionSet set)
+		{
+			# ifdef YUNI_MSVC
+			int info[4];
+			__cpuid(info, 1);
+			if (set == SearchInstructionSet::sse2)
+				return 0 != (info[3] & (1 << 26));
+			// AVX enabled by the operating system (OSXSAVE, and the YMM registers saved)
+			if (0 == (info[2] & (1 << 27)) or 0 == (info[2] & (1 << 28)) or (_xgetbv(0) & 6) != 6)
+				return false;
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+			__cpuidex(info, 7, 0);
+			return 0 != (info[1] & (1 << 5));
+			# else
+			__builtin_cpu_init();
+			return (set == SearchInstructionSet::sse2)
+				? (0 != __builtin_cpu_supports("sse2"))
+				: (0 != __builtin_cpu_supports("avx2"));
+			# endif
+		}
+
+		# endif // YUNI_SEARCH_X86
+
+
+		const SearchKernels* SelectKernels()
+		{
+			const SearchKernels* kernels = Search(SearchInstructionSet::avx2);
+			if (not kernels)
+				kernels = Search(SearchInstructionSet::sse2);
+			return (kernels) ? kernels : &scalarKernels;
+		}
+
+	} // anonymous namespace
+
+
+
+
+	// the portable kernels until the library is initialized
+	std::atomic<const SearchKernels*> searchKernels {&scalarKernels};
+
+	namespace // anonymous
+	{
+		const bool kernelsSelected = (searchKernels.store(SelectKernels(), std::memory_order_relaxed), true);
+	}
+
+
+	const SearchKernels* Search(SearchInstructionSet set)
+	{
+		switch (set)
+		{
+			case SearchInstructionSet::scalar:
+				return &scalarKernels;
+			# ifdef YUNI_SEARCH_X86
+			case SearchInstructionSet::sse2:
+			{
+				# if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+				return &SSE2::kernels;
+				# else
+				return CPUSupports(set) ? &SSE2::kernels : nullptr;
+				# endif
+			}
+			case SearchInstructionSet::avx2:
+			{
+				# ifdef __AVX2__
+				return &AVX2::kernels;
+				# else
+				return CPUSupports(set) ? &AVX2::kernels : nullptr;
+				# endif
+			}
+			# else
+			case SearchInstructionSet::sse2:
+			case SearchInstructionSet::avx2:
+				break;
+			# endif
+		}
+		return nullptr;
+	}
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
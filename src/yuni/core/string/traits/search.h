@@ -0,0 +1,145 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include <atomic>
+#include <cstddef>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	enum : size_t
+	{
+		//! Result of a search when nothing has been found
+		searchNotFound = static_cast<size_t>(-1),
+		//! Length below which a single char is searched inline, without calling a kernel
+		searchInlineLength = 16,
+		//! Maximum number of chars of a set handled by the vectorized kernels
+		searchMaxSetSize = 16,
+	};
+
+
+	//! Instruction set of the search kernels
+	enum class SearchInstructionSet
+	{
+		//! Portable implementation
+		scalar,
+		//! SSE2 (16 bytes at once)
+		sse2,
+		//! AVX2 (32 bytes at once)
+		avx2,
+	};
+
+
+	/*!
+	** \brief Search kernels for a given instruction set
+	**
+	** All kernels return the index of the first char matching (or the last one for
+	** the reverse variants), `searchNotFound` otherwise. The case-insensitive
+	** variants only consider ASCII letters, like `CString::ToLower()`.
+	*/
+	struct SearchKernels final
+	{
+		//! Name of the instruction set
+		const char* name;
+
+		//! Find a char
+		size_t (*findChar)(const char* s, size_t n, char c);
+		//! Find a char (case-insensitive)
+		size_t (*ifindChar)(const char* s, size_t n, char c);
+		//! Find the last occurence of a char
+		size_t (*rfindChar)(const char* s, size_t n, char c);
+		//! Find the last occurence of a char (case-insensitive)
+		size_t (*irfindChar)(const char* s, size_t n, char c);
+		//! Count the occurences of a char
+		size_t (*countChar)(const char* s, size_t n, char c);
+
+		//! Find any char of a set
+		size_t (*findAnyOf)(const char* s, size_t n, const char* set, size_t setlen);
+		//! Find any char of a set (case-insensitive)
+		size_t (*ifindAnyOf)(const char* s, size_t n, const char* set, size_t setlen);
+		//! Find the last occurence of any char of a set
+		size_t (*rfindAnyOf)(const char* s, size_t n, const char* set, size_t setlen);
+		//! Find the last occurence of any char of a set (case-insensitive)
+		size_t (*irfindAnyOf)(const char* s, size_t n, const char* set, size_t setlen);
+
+		//! Find a substring
+		size_t (*find)(const char* s, size_t n, const char* needle, size_t len);
+		//! Find a substring (case-insensitive)
+		size_t (*ifind)(const char* s, size_t n, const char* needle, size_t len);
+		//! Find the last occurence of a substring
+		size_t (*rfind)(const char* s, size_t n, const char* needle, size_t len);
+		//! Find the last occurence of a substring (case-insensitive)
+		size_t (*irfind)(const char* s, size_t n, const char* needle, size_t len);
+	};
+
+
+	/*!
+	** \brief The kernels used by CString
+	**
+	** The best instruction set supported by the CPU is selected on the first call
+	** (SSE2 or AVX2 on x86, according to `cpuid`; the kernels compiled for an
+	** instruction set enabled by the compiler flags need no check).
+	*/
+	extern YUNI_DECL std::atomic<const SearchKernels*> searchKernels;
+
+	/*!
+	** \brief Get the kernels for a given instruction set
+	**
+	** \return The kernels, or null if the instruction set is not supported by the CPU
+	*/
+	YUNI_DECL const SearchKernels* Search(SearchInstructionSet set);
+
+
+
+	//! Find a char
+	size_t FindChar(const char* s, size_t n, char c);
+	//! Find a char (case-insensitive)
+	size_t IFindChar(const char* s, size_t n, char c);
+	//! Find the last occurence of a char
+	size_t RFindChar(const char* s, size_t n, char c);
+	//! Find the last occurence of a char (case-insensitive)
+	size_t IRFindChar(const char* s, size_t n, char c);
+	//! Count the occurences of a char
+	size_t CountChar(const char* s, size_t n, char c);
+
+	//! Find any char of a set
+	size_t FindAnyOf(const char* s, size_t n, const char* set, size_t setlen);
+	//! Find any char of a set (case-insensitive)
+	size_t IFindAnyOf(const char* s, size_t n, const char* set, size_t setlen);
+	//! Find the last occurence of any char of a set
+	size_t RFindAnyOf(const char* s, size_t n, const char* set, size_t setlen);
+	//! Find the last occurence of any char of a set (case-insensitive)
+	size_t IRFindAnyOf(const char* s, size_t n, const char* set, size_t setlen);
+
+	//! Find a substring
+	size_t Find(const char* s, size_t n, const char* needle, size_t len);
+	//! Find a substring (case-insensitive)
+	size_t IFind(const char* s, size_t n, const char* needle, size_t len);
+	//! Find the last occurence of a substring
+	size_t RFind(const char* s, size_t n, const char* needle, size_t len);
+	//! Find the last occurence of a substring (case-insensitive)
+	size_t IRFind(const char* s, size_t n, const char* needle, size_t len);
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
+
+#include "search.hxx"
@@ -0,0 +1,152 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "search.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace CStringImpl
+{
+
+	inline char SearchToLower(char c)
+	{
+		return (static_cast<uint>(static_cast<unsigned char>(c)) - 'A' < 26) ? static_cast<char>(c | 32) : c;
+	}
+
+
+	inline const SearchKernels& Kernels()
+	{
+		return *searchKernels.load(std::memory_order_relaxed);
+	}
+
+
+	inline size_t FindChar(const char* s, size_t n, char c)
+	{
+		if (n >= searchInlineLength)
+			return Kernels().findChar(s, n, c);
+		for (size_t i = 0; i != n; ++i)
+		{
+			if (s[i] == c)
+				return i;
+		}
+		return searchNotFound;
+	}
+
+
+	inline size_t IFindChar(const char* s, size_t n, char c)
+	{
+		if (n >= searchInlineLength)
+			return Kernels().ifindChar(s, n, c);
+		c = SearchToLower(c);
+		for (size_t i = 0; i != n; ++i)
+		{
+			if (SearchToLower(s[i]) == c)
+				return i;
+		}
+		return searchNotFound;
+	}
+
+
+	inline size_t RFindChar(const char* s, size_t n, char c)
+	{
+		if (n >= searchInlineLength)
+			return Kernels().rfindChar(s, n, c);
+		while (n--)
+		{
+			if (s[n] == c)
+				return n;
+		}
+		return searchNotFound;
+	}
+
+
+	inline size_t IRFindChar(const char* s, size_t n, char c)
+	{
+		if (n >= searchInlineLength)
+			return Kernels().irfindChar(s, n, c);
+		c = SearchToLower(c);
+		while (n--)
+		{
+			if (SearchToLower(s[n]) == c)
+				return n;
+		}
+		return searchNotFound;
+	}
+
+
+	inline size_t CountChar(const char* s, size_t n, char c)
+	{
+		if (n >= searchInlineLength)
+			return Kernels().countChar(s, n, c);
+		size_t count = 0;
+		for (size_t i = 0; i != n; ++i)
+			count += (s[i] == c) ? 1 : 0;
+		return count;
+	}
+
+
+	inline size_t FindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return Kernels().findAnyOf(s, n, set, setlen);
+	}
+
+
+	inline size_t IFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return Kernels().ifindAnyOf(s, n, set, setlen);
+	}
+
+
+	inline size_t RFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return Kernels().rfindAnyOf(s, n, set, setlen);
+	}
+
+
+	inline size_t IRFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return Kernels().irfindAnyOf(s, n, set, setlen);
+	}
+
+
+	inline size_t Find(const char* s, size_t n, const char* needle, size_t len)
+	{
+		return Kernels().find(s, n, needle, len);
+	}
+
+
+	inline size_t IFind(const char* s, size_t n, const char* needle, size_t len)
+	{
+		return Kernels().ifind(s, n, needle, len);
+	}
+
+
+	inline size_t RFind(const char* s, size_t n, const char* needle, size_t len)
+	{
+		return Kernels().rfind(s, n, needle, len);
+	}
+
+
+	inline size_t IRFind(const char* s, size_t n, const char* needle, size_t len)
+	{
+		return Kernels().irfind(s, n, needle, len);
+	}
+
+
+
+
+} // namespace CStringImpl
+} // namespace Private
+} // namespace Yuni
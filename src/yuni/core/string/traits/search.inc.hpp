@@ -0,0 +1,355 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+
+// Vectorized search kernels, included once per instruction set by search.cpp
+// The includer defines, within the current namespace:
+//  - YUNI_SEARCH_TARGET, the attribute enabling the instruction set
+//  - Vec and `width`, the vector type and its size in bytes
+//  - `narrower`, the kernels for the haystacks shorter than `width`
+//  - Load(), Set1(), Zero(), CmpEq(), And(), Or(), SubBytes(), SumBytes(),
+//    MoveMask() and Fold() (ASCII lowercase)
+
+
+	//! Matcher of a single char, for ScanForward() and ScanBackward()
+	template<bool InsensitiveT>
+	struct CharMatcher final
+	{
+		YUNI_SEARCH_TARGET explicit CharMatcher(char c)
+			: needle(Set1(InsensitiveT ? SearchToLower(c) : c))
+		{}
+
+		YUNI_SEARCH_TARGET uint32_t match(const char* p) const
+		{
+			Vec block = Load(p);
+			return MoveMask(CmpEq(InsensitiveT ? Fold(block) : block, needle));
+		}
+
+		YUNI_SEARCH_TARGET bool verify(const char*) const
+		{
+			return true;
+		}
+
+		Vec needle;
+	};
+
+
+	//! Matcher of any char of a set (`searchMaxSetSize` chars at most)
+	template<bool InsensitiveT>
+	struct SetMatcher final
+	{
+		YUNI_SEARCH_TARGET SetMatcher(const char* set, size_t setlen)
+			: count(setlen)
+		{
+			for (size_t i = 0; i != setlen; ++i)
+				needles[i] = Set1(InsensitiveT ? SearchToLower(set[i]) : set[i]);
+		}
+
+		YUNI_SEARCH_TARGET uint32_t match(const char* p) const
+		{
+			Vec block = Load(p);
+			if (InsensitiveT)
+				block = Fold(block);
+			Vec result = CmpEq(block, needles[0]);
+			for (size_t i = 1; i < count; ++i)
+				result = Or(result, CmpEq(block, needles[i]));
+			return MoveMask(result);
+		}
+
+		YUNI_SEARCH_TARGET bool verify(const char*) const
+		{
+			return true;
+		}
+
+		Vec needles[searchMaxSetSize];
+		size_t count;
+	};
+
+
+	/*!
+	** \brief Matcher of a substring (at least 2 chars)
+	**
+	** The first and the last chars of the needle are compared at once for all
+	** positions of a block, the middle of the needle is only compared for the
+	** positions where both match.
+	*/
+	template<bool InsensitiveT>
+	struct SubstringMatcher final
+	{
+		YUNI_SEARCH_TARGET SubstringMatcher(const char* string, size_t length)
+			: first(Set1(InsensitiveT ? SearchToLower(string[0]) : string[0]))
+			, last(Set1(InsensitiveT ? SearchToLower(string[length - 1]) : string[length - 1]))
+			, needle(string)
+			, len(length)
+		{}
+
+		YUNI_SEARCH_TARGET uint32_t match(const char* p) const
+		{
+			Vec head = Load(p);
+			Vec tail = Load(p + len - 1);
+			if (InsensitiveT)
+			{
+				head = Fold(head);
+				tail = Fold(tail);
+			}
+			return MoveMask(And(CmpEq(head, first), CmpEq(tail, last)));
+		}
+
+		YUNI_SEARCH_TARGET bool verify(const char* p) const
+		{
+			return SearchEquals<InsensitiveT>(p + 1, needle + 1, len - 2);
+		}
+
+		Vec first;
+		Vec last;
+		const char* needle;
+		size_t len;
+	};
+
+
+
+
+	/*!
+	** \brief Find the first position matching, from `positions` positions
+	**
+	** The last `width` positions are read at once, thus `positions >= width`.
+	** `MatcherT::match()` returns a bit per position of a block, and
+	** `MatcherT::verify()` confirms a candidate position.
+	*/
+	template<class MatcherT>
+	YUNI_SEARCH_TARGET inline size_t ScanForward(const char* s, size_t positions, const MatcherT& matcher)
+	{
+		size_t i = 0;
+		for (; i + width <= positions; i += width)
+		{
+			uint32_t mask = matcher.match(s + i);
+			while (mask)
+			{
+				size_t index = i + LowestBit(mask);
+				if (matcher.verify(s + index))
+					return index;
+				mask &= mask - 1;
+			}
+		}
+		if (i != positions)
+		{
+			// the remaining positions, from a block overlapping the previous one
+			size_t start = positions - width;
+			uint32_t mask = matcher.match(s + start) >> (i - start);
+			while (mask)
+			{
+				size_t index = i + LowestBit(mask);
+				if (matcher.verify(s + index))
+					return index;
+				mask &= mask - 1;
+			}
+		}
+		return searchNotFound;
+	}
+
+
+	//! Find the last position matching, from `positions` positions (`positions >= width`)
+	template<class MatcherT>
+	YUNI_SEARCH_TARGET inline size_t ScanBackward(const char* s, size_t positions, const MatcherT& matcher)
+	{
+		size_t i = positions;
+		while (i >= width)
+		{
+			i -= width;
+			uint32_t mask = matcher.match(s + i);
+			while (mask)
+			{
+				uint bit = HighestBit(mask);
+				if (matcher.verify(s + i + bit))
+					return i + bit;
+				mask &= ~(1u << bit);
+			}
+		}
+		if (i != 0)
+		{
+			// the remaining positions, from a block overlapping the next one
+			uint32_t mask = matcher.match(s) & static_cast<uint32_t>((static_cast<uint64_t>(1) << i) - 1);
+			while (mask)
+			{
+				uint bit = HighestBit(mask);
+				if (matcher.verify(s + bit))
+					return bit;
+				mask &= ~(1u << bit);
+			}
+		}
+		return searchNotFound;
+	}
+
+
+
+
+	// The kernels themselves only handle the haystacks long enough, the shorter
+	// ones are given to the narrower kernels before any vector register is used
+	// (mixing legacy SSE and AVX instructions would stall when switching)
+
+	template<bool InsensitiveT>
+	YUNI_SEARCH_TARGET size_t FindCharT(const char* s, size_t n, char c)
+	{
+		return ScanForward(s, n, CharMatcher<InsensitiveT>(c));
+	}
+
+
+	template<bool InsensitiveT>
+	YUNI_SEARCH_TARGET size_t RFindCharT(const char* s, size_t n, char c)
+	{
+		return ScanBackward(s, n, CharMatcher<InsensitiveT>(c));
+	}
+
+
+	YUNI_SEARCH_TARGET size_t CountCharT(const char* s, size_t n, char c)
+	{
+		const Vec needle = Set1(c);
+		size_t count = 0;
+		size_t i = 0;
+		while (i + width <= n)
+		{
+			// a counter per byte, summed before overflowing
+			Vec counters = Zero();
+			size_t blocks = (n - i) / width;
+			if (blocks > 255)
+				blocks = 255;
+			for (; blocks != 0; --blocks, i += width)
+				counters = SubBytes(counters, CmpEq(Load(s + i), needle));
+			count += SumBytes(counters);
+		}
+		for (; i != n; ++i)
+			count += (s[i] == c) ? 1 : 0;
+		return count;
+	}
+
+
+	template<bool InsensitiveT>
+	YUNI_SEARCH_TARGET size_t FindAnyOfT(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return ScanForward(s, n, SetMatcher<InsensitiveT>(set, setlen));
+	}
+
+
+	template<bool InsensitiveT>
+	YUNI_SEARCH_TARGET size_t RFindAnyOfT(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return ScanBackward(s, n, SetMatcher<InsensitiveT>(set, setlen));
+	}
+
+
+	template<bool InsensitiveT>
+	YUNI_SEARCH_TARGET size_t FindT(const char* s, size_t n, const char* needle, size_t len)
+	{
+		return ScanForward(s, n - len + 1, SubstringMatcher<InsensitiveT>(needle, len));
+	}
+
+
+	template<bool InsensitiveT>
+	YUNI_SEARCH_TARGET size_t RFindT(const char* s, size_t n, const char* needle, size_t len)
+	{
+		return ScanBackward(s, n - len + 1, SubstringMatcher<InsensitiveT>(needle, len));
+	}
+
+
+
+
+	size_t FindChar(const char* s, size_t n, char c)
+	{
+		return (n < width) ? narrower.findChar(s, n, c) : FindCharT<false>(s, n, c);
+	}
+
+	size_t IFindChar(const char* s, size_t n, char c)
+	{
+		return (n < width) ? narrower.ifindChar(s, n, c) : FindCharT<true>(s, n, c);
+	}
+
+	size_t RFindChar(const char* s, size_t n, char c)
+	{
+		return (n < width) ? narrower.rfindChar(s, n, c) : RFindCharT<false>(s, n, c);
+	}
+
+	size_t IRFindChar(const char* s, size_t n, char c)
+	{
+		return (n < width) ? narrower.irfindChar(s, n, c) : RFindCharT<true>(s, n, c);
+	}
+
+	size_t CountChar(const char* s, size_t n, char c)
+	{
+		return (n < width) ? narrower.countChar(s, n, c) : CountCharT(s, n, c);
+	}
+
+
+	inline bool UseSetMatcher(size_t n, size_t setlen)
+	{
+		return n >= width and setlen != 0 and setlen <= searchMaxSetSize;
+	}
+
+	size_t FindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return UseSetMatcher(n, setlen) ? FindAnyOfT<false>(s, n, set, setlen) : narrower.findAnyOf(s, n, set, setlen);
+	}
+
+	size_t IFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return UseSetMatcher(n, setlen) ? FindAnyOfT<true>(s, n, set, setlen) : narrower.ifindAnyOf(s, n, set, setlen);
+	}
+
+	size_t RFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return UseSetMatcher(n, setlen) ? RFindAnyOfT<false>(s, n, set, setlen) : narrower.rfindAnyOf(s, n, set, setlen);
+	}
+
+	size_t IRFindAnyOf(const char* s, size_t n, const char* set, size_t setlen)
+	{
+		return UseSetMatcher(n, setlen) ? RFindAnyOfT<true>(s, n, set, setlen) : narrower.irfindAnyOf(s, n, set, setlen);
+	}
+
+
+	inline bool UseSubstringMatcher(size_t n, size_t len)
+	{
+		return len >= 2 and len <= n and n - len + 1 >= width;
+	}
+
+	size_t Find(const char* s, size_t n, const char* needle, size_t len)
+	{
+		if (len == 1)
+			return FindChar(s, n, *needle);
+		return UseSubstringMatcher(n, len) ? FindT<false>(s, n, needle, len) : narrower.find(s, n, needle, len);
+	}
+
+	size_t IFind(const char* s, size_t n, const char* needle, size_t len)
+	{
+		if (len == 1)
+			return IFindChar(s, n, *needle);
+		return UseSubstringMatcher(n, len) ? FindT<true>(s, n, needle, len) : narrower.ifind(s, n, needle, len);
+	}
+
+	size_t RFind(const char* s, size_t n, const char* needle, size_t len)
+	{
+		if (len == 1)
+			return RFindChar(s, n, *needle);
+		return UseSubstringMatcher(n, len) ? RFindT<false>(s, n, needle, len) : narrower.rfind(s, n, needle, len);
+	}
+
+	size_t IRFind(const char* s, size_t n, const char* needle, size_t len)
+	{
+		if (len == 1)
+			return IRFindChar(s, n, *needle);
+		return UseSubstringMatcher(n, len) ? RFindT<true>(s, n, needle, len) : narrower.irfind(s, n, needle, len);
+	}
+
+
+	const SearchKernels kernels =
+	{
+		name,
+		FindChar, IFindChar, RFindChar, IRFindChar, CountChar,
+		FindAnyOf, IFindAnyOf, RFindAnyOf, IRFindAnyOf,
+		Find, IFind, RFind, IRFind,
+	};
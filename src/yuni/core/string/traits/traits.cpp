@@ -17,6 +17,13 @@
 #include "../../../core/system/windows.hdr.h"
 #endif
 #include <limits.h>
+#if defined(YUNI_HAS_MALLOC_USABLE_SIZE)
+#	include <malloc.h>
+#elif defined(YUNI_OS_MAC)
+#	include <malloc/malloc.h>
+#elif defined(YUNI_OS_MSVC)
+#	include <malloc.h>
+#endif
 
 
 
@@ -160,6 +167,35 @@ namespace CStringImpl
 	}
 
 
+	void* GrowToUsableSize(void* block, uint requested, uint& capacity)
+	{
+		#if defined(YUNI_HAS_MALLOC_USABLE_SIZE)
+		size_t usable = ::malloc_usable_size(block);
+		#elif defined(YUNI_OS_MAC)
+		size_t usable = ::malloc_size(block);
+		#elif defined(YUNI_OS_MSVC)
+		size_t usable = ::_msize(block);
+		#else
+		size_t usable = 0;
+		#endif
+		capacity = requested;
+		if (usable <= requested)
+			return block;
+
+		// the capacity of a string is stored as an uint
+		if (usable > static_cast<size_t>(UINT_MAX))
+			usable = UINT_MAX;
+		// the extra bytes must be really allocated to be used: accessing them
+		// without realloc() is detected by _FORTIFY_SOURCE=3, ASan or Valgrind
+		if (void* grown = ::realloc(block, usable))
+		{
+			capacity = static_cast<uint>(usable);
+			return grown;
+		}
+		return block; // still valid
+	}
+
+
 
 
 
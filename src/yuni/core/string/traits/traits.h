@@ -14,6 +14,7 @@
 #	include <stdlib.h>
 #endif
 #include <string.h>
+#include <functional>
 #include "../../math/math.h"
 
 
@@ -44,6 +45,40 @@ namespace CStringImpl
 	YUNI_DECL size_t WCharToUTF8(char*& out, size_t maxlength, const wchar_t* wbuffer, size_t length);
 
 
+	/*!
+	** \brief Grow a block returned by malloc() or realloc() up to its real capacity
+	**
+	** The allocators round the requested sizes up to their size classes. The block
+	** is reallocated to this size (in place with the usual allocators), thus the
+	** remaining bytes can be used by the string without exceeding the size of the
+	** object known by the compiler (`_FORTIFY_SOURCE=3`) or the memory checkers.
+	** \param block The block
+	** \param requested Its size (in bytes)
+	** \param[out] capacity The usable size (in bytes, at least `requested`)
+	** \return The block (possibly moved)
+	*/
+	YUNI_DECL void* GrowToUsableSize(void* block, uint requested, uint& capacity);
+
+
+
+	/*!
+	** \brief Growth policy of the expandable strings
+	**
+	** The capacity grows geometrically (by half of the current one) and is rounded
+	** up to a multiple of the chunk size. Thus, building a string by successive
+	** appends only costs a constant amortized time per byte, whatever its final size.
+	**
+	** The capacity is never reduced implicitly (`clear()`, `truncate()`...),
+	** only by an explicit call to `shrink()`.
+	*/
+	template<uint ChunkSizeT>
+	struct Growth final
+	{
+		//! Get the new capacity for at least `mincapacity` bytes
+		static uint Capacity(uint capacity, uint mincapacity);
+	};
+
+
 
 	template<bool AdapterT>
 	struct FinalZero final
@@ -109,18 +144,80 @@ namespace CStringImpl
 
 
 
+	//! Capacity of the inline buffer of the expandable strings (final zero included)
+	enum { stringInlineCapacity = 16 };
+
+
+	/*!
+	** \brief Inline buffer of the expandable strings (small string optimization)
+	**
+	** The short contents are stored within the string itself, and are only moved
+	** to the heap when they grow beyond `CapacityT` bytes. The string adapters have
+	** no inline buffer (`CapacityT` = 0).
+	*/
+	template<uint CapacityT>
+	class InlineStorage
+	{
+	public:
+		enum { inlineCapacity = CapacityT };
+
+	public:
+		//! Get if a buffer is the inline one
+		bool isInline(const void* buffer) const { return buffer == pInline; }
+		//! The inline buffer
+		char* inlineBuffer() { return pInline; }
+
+		/*!
+		** \brief Exchange the inline buffers of two strings
+		**
+		** The pointers referring to one of the inline buffers are updated accordingly.
+		*/
+		template<class T> void swapInline(InlineStorage& rhs, T& data, T& rhsdata)
+		{
+			char tmp[CapacityT];
+			YUNI_MEMCPY(tmp, CapacityT, pInline, CapacityT);
+			YUNI_MEMCPY(pInline, CapacityT, rhs.pInline, CapacityT);
+			YUNI_MEMCPY(rhs.pInline, CapacityT, tmp, CapacityT);
+			if (data == rhs.pInline)
+				data = pInline;
+			if (rhsdata == pInline)
+				rhsdata = rhs.pInline;
+		}
+
+	private:
+		char pInline[CapacityT];
+	};
+
+	template<>
+	class InlineStorage<0>
+	{
+	public:
+		enum { inlineCapacity = 0 };
+
+	public:
+		static bool isInline(const void*) { return false; }
+		static char* inlineBuffer() { return nullptr; }
+		template<class T> static void swapInline(InlineStorage&, T&, T&) {}
+	};
+
+
+
+
 	template<uint ChunkSizeT, bool ExpandableT>
-	class Data
+	class Data : protected InlineStorage<(ChunkSizeT != 0) ? (uint) stringInlineCapacity : 0>
 	{
 	public:
 		typedef char C;
 		typedef uint Size;
+		//! Inline buffer (none for the adapters)
+		typedef InlineStorage<(ChunkSizeT != 0) ? (uint) stringInlineCapacity : 0> InlineStorageType;
 		enum
 		{
 			chunkSize = ChunkSizeT,
 			zeroTerminated = 1, //(ZeroTerminatedT ? 1 : 0),
 			expandable = 1,
 			adapter  = (!chunkSize and expandable and !static_cast<uint>(zeroTerminated)),
+			inlineCapacity = InlineStorageType::inlineCapacity,
 		};
 
 	public:
@@ -144,7 +241,7 @@ namespace CStringImpl
 
 		void clear();
 
-		void forgetContent();
+		C* forgetContent();
 
 		bool null() const { return (data == NULL); }
 
@@ -153,12 +250,14 @@ namespace CStringImpl
 			std::swap(size, rhs.size);
 			std::swap(capacity, rhs.capacity);
 			std::swap(data, rhs.data);
+			// the contents stored inline must follow their pointers
+			InlineStorageType::swapInline(rhs, data, rhs.data);
 		}
 
 		Size assignWithoutChecking(const C* const block, const Size blockSize)
 		{
 			// Making sure that we have enough space
-			reserve(blockSize + static_cast<uint>(zeroTerminated));
+			reserve(blockSize);
 			// Raw copy
 			YUNI_MEMCPY(const_cast<char*>(data), static_cast<uint>(capacity), block, sizeof(C) * blockSize);
 			// New size
@@ -171,8 +270,10 @@ namespace CStringImpl
 
 		Size appendWithoutChecking(const C* const block, const Size blockSize)
 		{
+			if (YUNI_UNLIKELY(overlaps(block)))
+				return appendItself(static_cast<Size>(block - data), blockSize);
 			// Making sure that we have enough space
-			reserve(size + blockSize + static_cast<uint>(zeroTerminated));
+			reserve(size + blockSize);
 			// Raw copy
 			YUNI_MEMCPY(const_cast<char*>(data) + size * sizeof(C), static_cast<uint>(capacity), block, blockSize * sizeof(C));
 			// New size
@@ -185,7 +286,7 @@ namespace CStringImpl
 		Size assignWithoutChecking(const C c)
 		{
 			// Making sure that we have enough space
-			reserve(1 + static_cast<uint>(zeroTerminated));
+			reserve(1);
 			// Raw copy
 			(const_cast<char*>(data))[0] = c;
 			// New size
@@ -199,7 +300,7 @@ namespace CStringImpl
 		Size appendWithoutChecking(const C c)
 		{
 			// Making sure that we have enough space
-			reserve(size + 1 + static_cast<uint>(zeroTerminated));
+			reserve(size + 1);
 			// Raw copy
 			(const_cast<char*>(data))[size] = c;
 			// New size
@@ -226,6 +327,7 @@ namespace CStringImpl
 
 		void put(const C rhs);
 
+		//! Ensure enough space for `mincapacity` chars (the final zero is always counted)
 		void reserve(Size mincapacity);
 
 		void insert(Size offset, const C* const buffer, const Size len);
@@ -238,10 +340,26 @@ namespace CStringImpl
 		Data& operator = (Data&& rhs);
 		# endif
 
+	protected:
+		//! Release the buffer, if owned by the string
+		void release();
+		//! Take the content of another string (moved or copied if stored inline)
+		void steal(Data& rhs);
+
+		//! Get if a block is a part of the content of the string
+		bool overlaps(const C* const block) const
+		{
+			return std::less_equal<const C*>()(data, block) and std::less<const C*>()(block, data + size);
+		}
+		//! Append a part of the string itself (see `overlaps()`)
+		Size appendItself(Size offset, Size blockSize);
+		//! Insert a part of the string itself (see `overlaps()`)
+		void insertItself(Size offset, Size from, Size len);
+
 	protected:
 		Size size;
 		Size capacity;
-		//! Our buffer
+		//! Our buffer (the inline one, or allocated on the heap)
 		typename QualifierFromAdapterMode<(0 != adapter), C>::Type data;
 		// Friend
 		template<uint SizeT, bool ExpT> friend class Yuni::CString;
@@ -300,9 +418,10 @@ namespace CStringImpl
 				data[0] = C();
 		}
 
-		void forgetContent()
+		C* forgetContent()
 		{
 			clear();
+			return data;
 		}
 
 		static bool null() { return false; }
@@ -20,6 +20,26 @@ namespace Private
 namespace CStringImpl
 {
 
+	template<uint ChunkSizeT>
+	inline uint Growth<ChunkSizeT>::Capacity(uint capacity, uint mincapacity)
+	{
+		// the chunk size is null for the adapters, which never allocate anything
+		enum { granularity = (ChunkSizeT > 1) ? ChunkSizeT : 1 };
+		const uint maxCapacity = static_cast<uint>(-1);
+
+		// +50%: below the golden ratio, the blocks previously released by the
+		// string can be merged by the allocator and reused for the next growths
+		uint newcapacity = (capacity < maxCapacity / 3 * 2) ? capacity + (capacity >> 1) : maxCapacity;
+		if (newcapacity < mincapacity)
+			newcapacity = mincapacity;
+
+		uint remainder = newcapacity % static_cast<uint>(granularity);
+		if (remainder != 0 and newcapacity <= maxCapacity - (granularity - remainder))
+			newcapacity += granularity - remainder;
+		return newcapacity;
+	}
+
+
 	template<uint ChunkSizeT, bool ExpandableT>
 	inline Data<ChunkSizeT,ExpandableT>::Data() :
 		size(),
@@ -39,7 +59,13 @@ namespace CStringImpl
 			if (chunkSize != 0)
 			{
 				capacity += static_cast<uint>(zeroTerminated);
-				data = reinterpret_cast<C*>(::malloc(sizeof(C) * static_cast<uint>(capacity)));
+				if (static_cast<uint>(capacity) <= static_cast<uint>(inlineCapacity))
+				{
+					capacity = static_cast<uint>(inlineCapacity);
+					data = InlineStorageType::inlineBuffer();
+				}
+				else
+					data = reinterpret_cast<C*>(::malloc(sizeof(C) * static_cast<uint>(capacity)));
 				YUNI_MEMCPY(const_cast<void*>(static_cast<const void*>(data)), static_cast<uint>(capacity), rhs.data, sizeof(C) * size);
 				if (static_cast<uint>(zeroTerminated))
 					(const_cast<char*>(data))[size] = C();
@@ -56,13 +82,11 @@ namespace CStringImpl
 	# ifdef YUNI_HAS_CPP_MOVE
 	template<uint ChunkSizeT, bool ExpandableT>
 	inline Data<ChunkSizeT,ExpandableT>::Data(Data&& rhs) :
-		size(rhs.size),
-		capacity(rhs.size),
-		data(rhs.data)
+		size(),
+		capacity(),
+		data(NULL)
 	{
-		rhs.size = 0;
-		rhs.capacity = 0;
-		rhs.data = nullptr;
+		steal(rhs);
 	}
 	# endif
 
@@ -70,31 +94,52 @@ namespace CStringImpl
 	template<uint ChunkSizeT, bool ExpandableT>
 	inline Data<ChunkSizeT,ExpandableT>::~Data()
 	{
-		// Release the internal buffer if allocated
-		// The string is a string adapter only if the chunk size if null
-		// When the string is an adapter, the variable is const
-		if (chunkSize != 0)
-			::free(const_cast<void*>(static_cast<const void*>(data)));
+		release();
 	}
 
 
-	# ifdef YUNI_HAS_CPP_MOVE
 	template<uint ChunkSizeT, bool ExpandableT>
-	inline Data<ChunkSizeT,ExpandableT>& Data<ChunkSizeT,ExpandableT>::operator = (Data&& rhs)
+	inline void
+	Data<ChunkSizeT,ExpandableT>::release()
 	{
 		// Release the internal buffer if allocated
 		// The string is a string adapter only if the chunk size if null
 		// When the string is an adapter, the variable is const
-		if (chunkSize != 0)
+		if (chunkSize != 0 and not InlineStorageType::isInline(data))
 			::free(const_cast<void*>(static_cast<const void*>(data)));
+	}
 
+
+	template<uint ChunkSizeT, bool ExpandableT>
+	inline void
+	Data<ChunkSizeT,ExpandableT>::steal(Data& rhs)
+	{
 		size = rhs.size;
 		capacity = rhs.capacity;
 		data = rhs.data;
-
+		if (rhs.isInline(rhs.data))
+		{
+			// the inline content can not be taken, only copied
+			data = InlineStorageType::inlineBuffer();
+			YUNI_MEMCPY(const_cast<char*>(data), static_cast<uint>(inlineCapacity), rhs.data, sizeof(C) * size);
+			if (static_cast<uint>(zeroTerminated))
+				(const_cast<char*>(data))[size] = C();
+		}
 		rhs.size = 0;
 		rhs.capacity = 0;
 		rhs.data = nullptr;
+	}
+
+
+	# ifdef YUNI_HAS_CPP_MOVE
+	template<uint ChunkSizeT, bool ExpandableT>
+	inline Data<ChunkSizeT,ExpandableT>& Data<ChunkSizeT,ExpandableT>::operator = (Data&& rhs)
+	{
+		if (this != &rhs)
+		{
+			release();
+			steal(rhs);
+		}
 		return *this;
 	}
 	# endif
@@ -135,12 +180,24 @@ namespace CStringImpl
 	}
 
 	template<uint ChunkSizeT, bool ExpandableT>
-	inline void
+	inline typename Data<ChunkSizeT,ExpandableT>::C*
 	Data<ChunkSizeT,ExpandableT>::forgetContent()
 	{
+		C* cstring = const_cast<C*>(data);
+		if (InlineStorageType::isInline(data))
+		{
+			// the caller takes the ownership of the returned pointer
+			cstring = reinterpret_cast<C*>(::malloc(sizeof(C) * (size + static_cast<uint>(zeroTerminated))));
+			if (!cstring)
+				throw "Yuni::CString: Impossible to malloc";
+			YUNI_MEMCPY(cstring, size + static_cast<uint>(zeroTerminated), data, sizeof(C) * size);
+			if (static_cast<uint>(zeroTerminated))
+				cstring[size] = C();
+		}
 		capacity = 0;
 		size = 0;
 		data = nullptr; // forget me !
+		return cstring;
 	}
 
 
@@ -152,13 +209,36 @@ namespace CStringImpl
 		{
 			if (size)
 			{
-				capacity = size + static_cast<uint>(zeroTerminated);
-				data = reinterpret_cast<char*>(::realloc(const_cast<char*>(data), static_cast<uint>(capacity)));
+				if (InlineStorageType::isInline(data))
+					return;
+				Size newcapacity = size + static_cast<uint>(zeroTerminated);
+				if (newcapacity <= static_cast<uint>(inlineCapacity))
+				{
+					// back to the inline buffer
+					C* inlinedata = InlineStorageType::inlineBuffer();
+					YUNI_MEMCPY(inlinedata, static_cast<uint>(inlineCapacity), data, sizeof(C) * size);
+					::free(const_cast<void*>(static_cast<const void*>(data)));
+					data = inlinedata;
+					capacity = static_cast<uint>(inlineCapacity);
+				}
+				else if (newcapacity < static_cast<uint>(capacity))
+				{
+					C* newdata = reinterpret_cast<C*>(::realloc(const_cast<char*>(data), sizeof(C) * newcapacity));
+					// keeping the current buffer if the allocator refuses to shrink it
+					if (newdata)
+					{
+						uint usable;
+						data = reinterpret_cast<C*>(GrowToUsableSize(newdata, newcapacity, usable));
+						capacity = usable;
+					}
+				}
+				if (static_cast<uint>(zeroTerminated))
+					(const_cast<char*>(data))[size] = C();
 			}
 			else
 			{
+				release();
 				capacity = 0;
-				::free(const_cast<void*>(static_cast<const void*>(data)));
 				data = nullptr;
 			}
 		}
@@ -169,8 +249,13 @@ namespace CStringImpl
 	inline void
 	Data<ChunkSizeT,ExpandableT>::insert(Size offset, const C* const buffer, const Size len)
 	{
+		if (YUNI_UNLIKELY(overlaps(buffer)))
+		{
+			insertItself(offset, static_cast<Size>(buffer - data), len);
+			return;
+		}
 		// Reserving enough space to insert the buffer
-		reserve(len + size + static_cast<uint>(zeroTerminated));
+		reserve(len + size);
 		// Move the existing block of data
 		(void)::memmove(const_cast<char*>(data) + sizeof(C) * (offset + len),
 			const_cast<char*>(data) + sizeof(C) * (offset), sizeof(C) * (size - offset));
@@ -184,12 +269,52 @@ namespace CStringImpl
 	}
 
 
+	template<uint ChunkSizeT, bool ExpandableT>
+	typename Data<ChunkSizeT,ExpandableT>::Size
+	Data<ChunkSizeT,ExpandableT>::appendItself(Size offset, Size blockSize)
+	{
+		// the block is moved along with the string by reserve()
+		reserve(size + blockSize);
+		C* const buffer = const_cast<C*>(data);
+		YUNI_MEMCPY(buffer + size, static_cast<uint>(capacity), buffer + offset, sizeof(C) * blockSize);
+		size += blockSize;
+		if (static_cast<uint>(zeroTerminated))
+			buffer[size] = C();
+		return blockSize;
+	}
+
+
+	template<uint ChunkSizeT, bool ExpandableT>
+	void
+	Data<ChunkSizeT,ExpandableT>::insertItself(Size offset, Size from, Size len)
+	{
+		// the block is moved along with the string by reserve(), and its part
+		// after the offset is moved by the insertion itself
+		reserve(len + size);
+		C* const buffer = const_cast<C*>(data);
+		(void)::memmove(buffer + offset + len, buffer + offset, sizeof(C) * (size - offset));
+		// the part before the offset, not moved
+		Size before = (from >= offset) ? 0 : ((from + len <= offset) ? len : offset - from);
+		if (before)
+			YUNI_MEMCPY(buffer + offset, static_cast<uint>(capacity), buffer + from, sizeof(C) * before);
+		// the part after the offset, moved by `len`
+		if (before != len)
+		{
+			YUNI_MEMCPY(buffer + offset + before, static_cast<uint>(capacity),
+				buffer + from + before + len, sizeof(C) * (len - before));
+		}
+		size += len;
+		if (static_cast<uint>(zeroTerminated))
+			buffer[size] = C();
+	}
+
+
 	template<uint ChunkSizeT, bool ExpandableT>
 	inline void
 	Data<ChunkSizeT,ExpandableT>::put(const C rhs)
 	{
 		// Making sure that we have enough space
-		reserve(size + 1 + static_cast<uint>(zeroTerminated));
+		reserve(size + 1);
 		// Raw copy
 		(const_cast<char*>(data))[size] = rhs;
 		// New size
@@ -208,25 +333,38 @@ namespace CStringImpl
 		mincapacity += static_cast<uint>(zeroTerminated);
 		if (static_cast<uint>(capacity) < mincapacity)
 		{
-			// This loop may be a little faster than the following replacement code :
-			// static_cast<uint>(capacity) = minstatic_cast<uint>(capacity) + minstatic_cast<uint>(capacity) % chunkSize;
-			// Especially when chunkSize is not a power of 2
-			Size newcapacity = static_cast<uint>(capacity);
-			do
+			if (!data and mincapacity <= static_cast<uint>(inlineCapacity))
 			{
-				// Increase the static_cast<uint>(capacity) until we have enough space
-				newcapacity += chunkSize;
+				// short content, stored within the string itself
+				data = InlineStorageType::inlineBuffer();
+				capacity = static_cast<uint>(inlineCapacity);
+				if (static_cast<uint>(zeroTerminated))
+					(const_cast<char*>(data))[size] = C();
+				return;
 			}
-			while (newcapacity < mincapacity);
 
-			// Realloc the internal buffer
-			C* newdata = reinterpret_cast<C*>(::realloc(const_cast<char*>(data), (sizeof(C) * newcapacity)));
+			Size newcapacity = Growth<ChunkSizeT>::Capacity(static_cast<uint>(capacity), mincapacity);
+
+			C* newdata;
+			if (not InlineStorageType::isInline(data))
+			{
+				// Realloc the internal buffer
+				newdata = reinterpret_cast<C*>(::realloc(const_cast<char*>(data), (sizeof(C) * newcapacity)));
+			}
+			else
+			{
+				// Moving the inline content to the heap
+				newdata = reinterpret_cast<C*>(::malloc(sizeof(C) * newcapacity));
+				if (newdata)
+					YUNI_MEMCPY(newdata, newcapacity, data, sizeof(C) * size);
+			}
 			// The returned value can be NULL
 			if (!newdata)
 				throw "Yuni::CString: Impossible to realloc";
 			{
-				data = newdata;
-				capacity = newcapacity;
+				uint usable;
+				data = reinterpret_cast<C*>(GrowToUsableSize(newdata, newcapacity, usable));
+				capacity = usable;
 				if (static_cast<uint>(zeroTerminated))
 					(const_cast<char*>(data))[size] = C();
 			}
@@ -13,6 +13,14 @@
 #include <unistd.h>
 #endif
 #include "windows.hdr.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <algorithm>
+#ifdef YUNI_OS_LINUX
+# include <cstdio>
+# include <cstdlib>
+#endif
 
 
 
@@ -61,6 +69,303 @@ namespace CPU
 
 
 
+	namespace // anonymous
+	{
+
+		#ifdef YUNI_OS_LINUX
+
+		//! Read a small file from /sys (without the final new line)
+		bool readSysFile(const std::string& path, std::string& out)
+		{
+			out.clear();
+			FILE* f = fopen(path.c_str(), "r");
+			if (not f)
+				return false;
+			char buffer[4096];
+			size_t numread = fread(buffer, 1, sizeof(buffer), f);
+			fclose(f);
+			out.assign(buffer, numread);
+			while (not out.empty() and (out.back() == '\n' or out.back() == ' '))
+				out.pop_back();
+			return not out.empty();
+		}
+
+
+		bool readSysUInt(const std::string& path, uint& out)
+		{
+			std::string content;
+			if (not readSysFile(path, content))
+				return false;
+			long value = strtol(content.c_str(), nullptr, 10);
+			out = (value < 0) ? 0 : static_cast<uint>(value);
+			return true;
+		}
+
+
+		//! Parse a list of processors, like "0-3,8,10-11"
+		void parseList(const std::string& list, std::vector<uint>& out)
+		{
+			out.clear();
+			const char* cursor = list.c_str();
+			while (*cursor != '\0')
+			{
+				char* next;
+				unsigned long first = strtoul(cursor, &next, 10);
+				if (next == cursor)
+					break;
+				unsigned long last = first;
+				cursor = next;
+				if (*cursor == '-')
+				{
+					last = strtoul(cursor + 1, &next, 10);
+					cursor = next;
+				}
+				for (unsigned long i = first; i <= last; ++i)
+					out.push_back(static_cast<uint>(i));
+				if (*cursor == ',')
+					++cursor;
+				else if (*cursor != '\0')
+					break;
+			}
+		}
+
+
+		//! Parse a size like "32K"
+		uint64 parseSize(const std::string& text)
+		{
+			char* suffix;
+			uint64 size = strtoull(text.c_str(), &suffix, 10);
+			switch (*suffix)
+			{
+				case 'K': size *= 1024; break;
+				case 'M': size *= 1024 * 1024; break;
+				case 'G': size *= 1024 * 1024 * 1024; break;
+			}
+			return size;
+		}
+
+
+		//! Dense index for any key, in the order of appearance
+		template<class KeyT>
+		uint denseIndex(std::map<KeyT, uint>& indexes, const KeyT& key)
+		{
+			auto it = indexes.find(key);
+			if (it != indexes.end())
+				return it->second;
+			uint index = static_cast<uint>(indexes.size());
+			indexes.emplace(key, index);
+			return index;
+		}
+
+
+		bool detectFromSys(std::vector<Topology::Processor>& processors, std::vector<Topology::Cache>& caches,
+			uint& coreCount, uint& socketCount, uint& numaNodeCount, uint& cacheGroupCount)
+		{
+			const std::string root = "/sys/devices/system/cpu/";
+			std::string content;
+			std::vector<uint> ids;
+			if (not readSysFile(root + "online", content))
+				return false;
+			parseList(content, ids);
+			if (ids.empty())
+				return false;
+
+			std::map<uint, uint> sockets;
+			std::map<std::pair<uint, uint>, uint> cores;
+			std::map<std::pair<uint, std::string>, uint> cacheIndexes;
+			std::map<std::pair<bool, uint>, uint> cacheGroups;
+			std::vector<uint> lookup(ids.back() + 1, static_cast<uint>(-1));
+
+			processors.resize(ids.size());
+			for (uint i = 0; i != ids.size(); ++i)
+			{
+				auto& processor = processors[i];
+				processor.id = ids[i];
+				lookup[ids[i]] = i;
+
+				std::string path = root + "cpu" + std::to_string(ids[i]) + '/';
+				uint package = 0;
+				uint core = ids[i];
+				readSysUInt(path + "topology/physical_package_id", package);
+				readSysUInt(path + "topology/core_id", core);
+				processor.socket = denseIndex(sockets, package);
+				processor.core = denseIndex(cores, std::make_pair(package, core));
+
+				// caches
+				uint lastLevel = 0;
+				uint lastLevelCache = static_cast<uint>(-1);
+				for (uint index = 0; ; ++index)
+				{
+					std::string cachepath = path + "cache/index" + std::to_string(index) + '/';
+					uint level;
+					if (not readSysUInt(cachepath + "level", level))
+						break;
+					if (readSysFile(cachepath + "type", content) and content == "Instruction")
+						continue;
+					std::string shared;
+					if (not readSysFile(cachepath + "shared_cpu_list", shared))
+						shared = std::to_string(ids[i]);
+
+					auto key = std::make_pair(level, shared);
+					uint cacheIndex;
+					auto it = cacheIndexes.find(key);
+					if (it == cacheIndexes.end())
+					{
+						cacheIndex = static_cast<uint>(caches.size());
+						cacheIndexes.emplace(key, cacheIndex);
+						caches.emplace_back();
+						auto& cache = caches.back();
+						cache.level = level;
+						if (readSysFile(cachepath + "size", content))
+							cache.size = parseSize(content);
+						parseList(shared, cache.processors);
+					}
+					else
+						cacheIndex = it->second;
+
+					if (level >= lastLevel)
+					{
+						lastLevel = level;
+						lastLevelCache = cacheIndex;
+					}
+				}
+				// no cache information: the core is the best approximation
+				processor.cacheGroup = (lastLevelCache != static_cast<uint>(-1))
+					? denseIndex(cacheGroups, std::make_pair(true, lastLevelCache))
+					: denseIndex(cacheGroups, std::make_pair(false, processor.core));
+			}
+
+			// NUMA nodes
+			std::vector<uint> nodes;
+			if (readSysFile("/sys/devices/system/node/online", content))
+				parseList(content, nodes);
+			std::map<uint, uint> numaNodes;
+			for (uint node: nodes)
+			{
+				std::vector<uint> list;
+				if (not readSysFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", content))
+					continue;
+				parseList(content, list);
+				for (uint id: list)
+				{
+					if (id < lookup.size() and lookup[id] != static_cast<uint>(-1))
+						processors[lookup[id]].numaNode = denseIndex(numaNodes, node);
+				}
+			}
+
+			coreCount = static_cast<uint>(cores.size());
+			socketCount = static_cast<uint>(sockets.size());
+			numaNodeCount = numaNodes.empty() ? 1 : static_cast<uint>(numaNodes.size());
+			cacheGroupCount = static_cast<uint>(cacheGroups.size());
+			return true;
+		}
+
+		#endif // YUNI_OS_LINUX
+
+	} // anonymous namespace
+
+
+
+
+	Topology::Topology()
+	{
+		refresh();
+	}
+
+
+	void Topology::refresh()
+	{
+		pProcessors.clear();
+		pCaches.clear();
+
+		#ifdef YUNI_OS_LINUX
+		if (detectFromSys(pProcessors, pCaches, pCoreCount, pSocketCount, pNumaNodeCount, pCacheGroupCount))
+			return;
+		pProcessors.clear();
+		pCaches.clear();
+		#endif
+
+		// generic implementation: each logical processor is a distinct core
+		uint count = Count();
+		pProcessors.resize(count);
+		for (uint i = 0; i != count; ++i)
+		{
+			pProcessors[i].id = i;
+			pProcessors[i].core = i;
+			pProcessors[i].cacheGroup = i;
+		}
+		pCoreCount = count;
+		pSocketCount = 1;
+		pNumaNodeCount = 1;
+		pCacheGroupCount = count;
+	}
+
+
+	std::vector<uint> Topology::siblings(uint id) const
+	{
+		std::vector<uint> result;
+		auto it = std::find_if(pProcessors.begin(), pProcessors.end(),
+			[id](const Processor& processor) { return processor.id == id; });
+		if (it != pProcessors.end())
+		{
+			for (auto& processor: pProcessors)
+			{
+				if (processor.core == it->core)
+					result.push_back(processor.id);
+			}
+		}
+		return result;
+	}
+
+
+	std::vector<uint> Topology::numaNode(uint node) const
+	{
+		std::vector<uint> result;
+		for (auto& processor: pProcessors)
+		{
+			if (processor.numaNode == node)
+				result.push_back(processor.id);
+		}
+		return result;
+	}
+
+
+	std::vector<uint> Topology::spread() const
+	{
+		std::vector<uint> result;
+		result.reserve(pProcessors.size());
+		for (uint node = 0; node != pNumaNodeCount; ++node)
+		{
+			// processors of the node, by core
+			std::vector<std::vector<uint>> cores(pCoreCount);
+			for (auto& processor: pProcessors)
+			{
+				if (processor.numaNode == node)
+					cores[processor.core].push_back(processor.id);
+			}
+			// the first thread of each core, then the second one...
+			for (size_t round = 0; ; ++round)
+			{
+				bool found = false;
+				for (auto& threads: cores)
+				{
+					if (round < threads.size())
+					{
+						result.push_back(threads[round]);
+						found = true;
+					}
+				}
+				if (not found)
+					break;
+			}
+		}
+		return result;
+	}
+
+
+
+
+
 } // namespace CPU
 } // namespace System
 } // namespace Yuni
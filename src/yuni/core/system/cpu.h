@@ -10,6 +10,7 @@
 */
 #pragma once
 #include "../../yuni.h"
+#include <vector>
 
 
 
@@ -29,7 +30,129 @@ namespace CPU
 
 
 
+	/*!
+	** \brief Topology of the logical processors (sockets, cores, SMT siblings, caches, NUMA nodes)
+	**
+	** On Linux, the topology is read from `/sys/devices/system/cpu` and
+	** `/sys/devices/system/node`. On other platforms (or if this information is
+	** not available), each logical processor is considered as a distinct
+	** core of a single socket and a single NUMA node.
+	**
+	** \code
+	** System::CPU::Topology topology;
+	** std::cout << topology.socketCount() << " sockets, " << topology.coreCount() << " cores, "
+	**	<< topology.processorCount() << " threads, " << topology.numaNodeCount() << " NUMA nodes\n";
+	** \endcode
+	*/
+	class YUNI_DECL Topology final
+	{
+	public:
+		//! A logical processor (hardware thread)
+		struct Processor final
+		{
+			//! Index of the processor for the operating system (used for affinity)
+			uint id = 0;
+			//! Index of its physical core, [0, coreCount())
+			uint core = 0;
+			//! Index of its socket, [0, socketCount())
+			uint socket = 0;
+			//! Index of its NUMA node, [0, numaNodeCount())
+			uint numaNode = 0;
+			//! Index of the group of processors sharing the same last level cache, [0, cacheGroupCount())
+			uint cacheGroup = 0;
+		};
+
+		//! A cache (data or unified) shared by one or several processors
+		struct Cache final
+		{
+			//! Level (1 for L1, 2 for L2...)
+			uint level = 0;
+			//! Size in bytes (0 if unknown)
+			uint64 size = 0;
+			//! Operating system indexes of all processors sharing the cache
+			std::vector<uint> processors;
+		};
+
+
+	public:
+		//! \name Constructor
+		//@{
+		//! Default constructor, detecting the topology of the current machine
+		Topology();
+		//@}
+
+
+		//! Detect again the topology of the current machine
+		void refresh();
+
+		//! \name Counts
+		//@{
+		//! Number of logical processors
+		uint processorCount() const;
+		//! Number of physical cores
+		uint coreCount() const;
+		//! Number of sockets
+		uint socketCount() const;
+		//! Number of NUMA nodes
+		uint numaNodeCount() const;
+		//! Number of groups of processors sharing the same last level cache
+		uint cacheGroupCount() const;
+		//@}
+
+
+		//! \name Processors
+		//@{
+		//! All logical processors, sorted by operating system index
+		const std::vector<Processor>& processors() const;
+		//! All caches (data or unified)
+		const std::vector<Cache>& caches() const;
+
+		/*!
+		** \brief Get the operating system indexes of all processors sharing the same core
+		** \param id Operating system index of a processor (included in the result)
+		*/
+		std::vector<uint> siblings(uint id) const;
+
+		/*!
+		** \brief Get the operating system indexes of all processors of a NUMA node
+		** \param node Index of the NUMA node
+		*/
+		std::vector<uint> numaNode(uint node) const;
+
+		/*!
+		** \brief Get all processors, ordered to spread the load over the machine
+		**
+		** Processors are grouped by NUMA node, and within a node, the first processor
+		** of each core comes before any SMT sibling. Thus, pinning N threads to the N
+		** first processors of this list avoid sharing a core as long as possible.
+		** \return The operating system indexes of the processors
+		*/
+		std::vector<uint> spread() const;
+		//@}
+
+
+	private:
+		//! All processors
+		std::vector<Processor> pProcessors;
+		//! All caches
+		std::vector<Cache> pCaches;
+		//! Number of cores
+		uint pCoreCount;
+		//! Number of sockets
+		uint pSocketCount;
+		//! Number of NUMA nodes
+		uint pNumaNodeCount;
+		//! Number of last level cache groups
+		uint pCacheGroupCount;
+
+	}; // class Topology
+
+
+
+
 } // namespace CPU
 } // namespace System
 } // namespace Yuni
 
+#include "cpu.hxx"
+
@@ -0,0 +1,69 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "cpu.h"
+
+
+
+namespace Yuni
+{
+namespace System
+{
+namespace CPU
+{
+
+	inline uint Topology::processorCount() const
+	{
+		return static_cast<uint>(pProcessors.size());
+	}
+
+
+	inline uint Topology::coreCount() const
+	{
+		return pCoreCount;
+	}
+
+
+	inline uint Topology::socketCount() const
+	{
+		return pSocketCount;
+	}
+
+
+	inline uint Topology::numaNodeCount() const
+	{
+		return pNumaNodeCount;
+	}
+
+
+	inline uint Topology::cacheGroupCount() const
+	{
+		return pCacheGroupCount;
+	}
+
+
+	inline const std::vector<Topology::Processor>& Topology::processors() const
+	{
+		return pProcessors;
+	}
+
+
+	inline const std::vector<Topology::Cache>& Topology::caches() const
+	{
+		return pCaches;
+	}
+
+
+
+
+} // namespace CPU
+} // namespace System
+} // namespace Yuni
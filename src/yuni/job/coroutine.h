@@ -0,0 +1,198 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../yuni.h"
+#ifdef YUNI_HAS_CPP_COROUTINE
+#include "../private/jobs/coroutine.h"
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	/*!
+	** \brief Coroutine executed by the workers of a queueservice (C++20)
+	**
+	** Any function returning a `Job::Task<>` is a coroutine which can wait for
+	** an event (`co_await`) without blocking its worker: the coroutine is suspended,
+	** and resumed from a new job of its queueservice once the event has occurred.
+	** Thus a small pool of workers can handle a large number of waiting tasks.
+	**
+	** \code
+	** Job::Task<int> compute(int value)
+	** {
+	**	co_await Job::sleep(std::chrono::milliseconds(100)); // timer, no blocked thread
+	**	co_return value * 2;
+	** }
+	**
+	** Job::Task<> process(Thread::Signal& ready, Job::Taskgroup& taskgroup)
+	** {
+	**	co_await Job::wait(ready); // Thread::Signal
+	**	int value = co_await compute(21); // another task, executed inline
+	**	if (Job::Taskgroup::stSucceeded != co_await Job::wait(taskgroup))
+	**		co_return;
+	**	std::cout << value << std::endl;
+	** }
+	**
+	** Job::QueueService queueservice;
+	** queueservice.start();
+	** process(ready, taskgroup).start(queueservice);
+	** \endcode
+	**
+	** A task does nothing until started (`start()`), or awaited by another task
+	** (it then inherits the queueservice and the priority of the awaiting task).
+	** An exception thrown by a task is rethrown to the awaiting task, and is
+	** ignored for a started task (like any job).
+	**
+	** A started task is destroyed once complete. It is destroyed as well if the job
+	** resuming it is removed from the queue (`QueueService::clear()`, or when the
+	** queueservice is destroyed) or its timer canceled. A task waiting for a signal
+	** (or a taskgroup) must be resumed before the signal is destroyed.
+	**
+	** This class is only available when compiling with C++20 coroutines.
+	*/
+	template<class T = void>
+	class Task final
+	{
+	public:
+		//! The promise (required by the compiler)
+		typedef Yuni::Private::Jobs::TaskPromise<T> promise_type;
+		//! Handle of the coroutine
+		typedef std::coroutine_handle<promise_type> Handle;
+
+		//! Awaiter of the task
+		class Awaiter final
+		{
+		public:
+			explicit Awaiter(Handle handle) noexcept;
+
+			bool await_ready() const noexcept;
+			template<class PromiseT>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> awaiting) noexcept;
+			T await_resume();
+
+		private:
+			//! The awaited task
+			Handle pHandle;
+		};
+
+	public:
+		//! \name Constructors & Destructor
+		//@{
+		//! Default constructor (invalid task)
+		Task() noexcept = default;
+		//! Move constructor
+		Task(Task&& rhs) noexcept;
+		//! No copy
+		Task(const Task&) = delete;
+		//! Destructor
+		~Task();
+		//@}
+
+		//! \name Execution
+		//@{
+		/*!
+		** \brief Start the task, from a job of a queueservice
+		**
+		** The task owns itself from now on (it is destroyed once complete), and this
+		** object is not valid anymore.
+		** \param queueservice The queueservice executing the task
+		** \param priority Priority of all the jobs resuming the task
+		*/
+		void start(QueueService& queueservice, Priority priority = Priority::normal);
+
+		//! Get if the task can be started or awaited
+		bool valid() const noexcept;
+		//@}
+
+		//! \name Operators
+		//@{
+		//! Execute the task from another task, and get its result
+		Awaiter operator co_await () const noexcept;
+		//! Move assignment
+		Task& operator = (Task&& rhs) noexcept;
+		//! No copy
+		Task& operator = (const Task&) = delete;
+		//@}
+
+	private:
+		//! Constructor from the coroutine
+		explicit Task(Handle handle) noexcept;
+
+	private:
+		//! The coroutine (null if not valid)
+		Handle pHandle;
+		// Nakama !
+		friend class Yuni::Private::Jobs::TaskPromise<T>;
+
+	}; // class Task
+
+
+
+
+	//! \name Awaitables for coroutine tasks
+	//@{
+	/*!
+	** \brief Suspend the task, to resume it from a new job of its queueservice
+	**
+	** The other jobs of the queue are executed meanwhile.
+	** \code
+	** co_await Job::yield();
+	** \endcode
+	*/
+	Yuni::Private::Jobs::ScheduleAwaiter yield();
+
+	/*!
+	** \brief Resume the task from a job of another queueservice
+	**
+	** Useful to execute some blocking code (like a database query) by the
+	** workers of a dedicated queueservice, before going back.
+	** \code
+	** co_await Job::resumeOn(databaseQueueservice);
+	** auto result = query();
+	** co_await Job::resumeOn(queueservice);
+	** \endcode
+	*/
+	Yuni::Private::Jobs::ScheduleAwaiter resumeOn(QueueService& queueservice, Priority priority = Priority::normal);
+
+	//! Suspend the task during a delay (see `TimerService`, with a precision of 1ms)
+	Yuni::Private::Jobs::TimerAwaiter sleep(std::chrono::milliseconds delay);
+
+	//! Suspend the task until a given time (see `TimerService`, with a precision of 1ms)
+	Yuni::Private::Jobs::TimerAwaiter sleepUntil(std::chrono::steady_clock::time_point deadline);
+
+	/*!
+	** \brief Suspend the task until a signal is notified
+	**
+	** The task is not suspended if the signal has already been notified.
+	*/
+	Yuni::Private::Jobs::SignalAwaiter wait(Thread::Signal& signal);
+
+	/*!
+	** \brief Suspend the task until a taskgroup is complete, and get its status
+	**
+	** The task is not suspended if the taskgroup is not running.
+	*/
+	Yuni::Private::Jobs::TaskgroupAwaiter wait(Taskgroup& taskgroup);
+	//@}
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
+
+#include "coroutine.hxx"
+
+#endif // YUNI_HAS_CPP_COROUTINE
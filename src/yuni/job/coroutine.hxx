@@ -0,0 +1,196 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "coroutine.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	template<class T>
+	inline Yuni::Job::Task<T> TaskPromise<T>::get_return_object() noexcept
+	{
+		return Yuni::Job::Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+	}
+
+
+	inline Yuni::Job::Task<void> TaskPromise<void>::get_return_object() noexcept
+	{
+		return Yuni::Job::Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+	}
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
+
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	template<class T>
+	inline Task<T>::Awaiter::Awaiter(Handle handle) noexcept
+		: pHandle(handle)
+	{}
+
+
+	template<class T>
+	inline bool Task<T>::Awaiter::await_ready() const noexcept
+	{
+		return false;
+	}
+
+
+	template<class T>
+	template<class PromiseT>
+	inline std::coroutine_handle<> Task<T>::Awaiter::await_suspend(std::coroutine_handle<PromiseT> awaiting) noexcept
+	{
+		static_assert(std::is_base_of<Yuni::Private::Jobs::CoroutinePromise, PromiseT>::value,
+			"a task can only be awaited by another task");
+		Yuni::Private::Jobs::CoroutinePromise& parent = awaiting.promise();
+		promise_type& promise = pHandle.promise();
+		promise.queueservice = parent.queueservice;
+		promise.priority = parent.priority;
+		promise.root = parent.root;
+		promise.continuation = awaiting;
+		// executed right now, by the same worker
+		return pHandle;
+	}
+
+
+	template<class T>
+	inline T Task<T>::Awaiter::await_resume()
+	{
+		return pHandle.promise().get();
+	}
+
+
+
+
+	template<class T>
+	inline Task<T>::Task(Handle handle) noexcept
+		: pHandle(handle)
+	{}
+
+
+	template<class T>
+	inline Task<T>::Task(Task&& rhs) noexcept
+		: pHandle(rhs.pHandle)
+	{
+		rhs.pHandle = nullptr;
+	}
+
+
+	template<class T>
+	inline Task<T>::~Task()
+	{
+		if (pHandle)
+			pHandle.destroy();
+	}
+
+
+	template<class T>
+	inline Task<T>& Task<T>::operator = (Task&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			if (pHandle)
+				pHandle.destroy();
+			pHandle = rhs.pHandle;
+			rhs.pHandle = nullptr;
+		}
+		return *this;
+	}
+
+
+	template<class T>
+	inline bool Task<T>::valid() const noexcept
+	{
+		return !(!pHandle);
+	}
+
+
+	template<class T>
+	void Task<T>::start(QueueService& queueservice, Priority priority)
+	{
+		assert(valid() and "invalid coroutine task");
+		Handle handle = pHandle;
+		pHandle = nullptr;
+
+		promise_type& promise = handle.promise();
+		promise.queueservice = &queueservice;
+		promise.priority = priority;
+		promise.root = handle;
+		promise.detached = true;
+		promise.schedule(handle);
+	}
+
+
+	template<class T>
+	inline typename Task<T>::Awaiter Task<T>::operator co_await () const noexcept
+	{
+		assert(valid() and "invalid coroutine task");
+		return Awaiter(pHandle);
+	}
+
+
+
+
+	inline Yuni::Private::Jobs::ScheduleAwaiter yield()
+	{
+		return Yuni::Private::Jobs::ScheduleAwaiter(nullptr, Priority::normal);
+	}
+
+
+	inline Yuni::Private::Jobs::ScheduleAwaiter resumeOn(QueueService& queueservice, Priority priority)
+	{
+		return Yuni::Private::Jobs::ScheduleAwaiter(&queueservice, priority);
+	}
+
+
+	inline Yuni::Private::Jobs::TimerAwaiter sleep(std::chrono::milliseconds delay)
+	{
+		return Yuni::Private::Jobs::TimerAwaiter(std::chrono::steady_clock::now() + delay);
+	}
+
+
+	inline Yuni::Private::Jobs::TimerAwaiter sleepUntil(std::chrono::steady_clock::time_point deadline)
+	{
+		return Yuni::Private::Jobs::TimerAwaiter(deadline);
+	}
+
+
+	inline Yuni::Private::Jobs::SignalAwaiter wait(Thread::Signal& signal)
+	{
+		return Yuni::Private::Jobs::SignalAwaiter(signal);
+	}
+
+
+	inline Yuni::Private::Jobs::TaskgroupAwaiter wait(Taskgroup& taskgroup)
+	{
+		return Yuni::Private::Jobs::TaskgroupAwaiter(taskgroup);
+	}
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
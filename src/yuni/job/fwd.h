@@ -10,6 +10,8 @@
 */
 #pragma once
 #include "enum.h"
+#include <atomic>
+#include <cstdint>
 
 
 
@@ -21,11 +23,24 @@ namespace Job
 
 	// Forward declaration
 	class IJob;
+	class ScratchArena;
 
 } // namespace Job
 } // namespace Yuni
 
 
+namespace Yuni
+{
+namespace Thread
+{
+
+	// Forward declaration
+	class IThread;
+
+} // namespace Thread
+} // namespace Yuni
+
+
 
 namespace Yuni
 {
@@ -56,10 +71,44 @@ namespace QueueService
 			job.pState  = static_cast<int>(Yuni::Job::State::waiting);
 		}
 
-		static void AddedInTheWaitingRoom(JobT& job)
+		static void AddedInTheWaitingRoom(JobT& job, Yuni::Job::Priority priority, uint64_t time)
 		{
 			job.pState = static_cast<int>(Yuni::Job::State::waiting);
 			job.pProgression = 0;
+			// the same job may be added several times at once, the last one wins
+			job.pEnqueuedAt.store(time, std::memory_order_relaxed);
+			job.pPriority.store(static_cast<uint32_t>(priority), std::memory_order_relaxed);
+		}
+
+		static void Evictable(JobT& job, bool value)
+		{
+			job.pEvictable.store(value, std::memory_order_relaxed);
+		}
+
+		static bool Evictable(const JobT& job)
+		{
+			return job.pEvictable.load(std::memory_order_relaxed);
+		}
+
+		static void Dropped(JobT& job)
+		{
+			job.cancel();
+			job.pState = static_cast<int>(Yuni::Job::State::idle);
+		}
+
+		static Yuni::Thread::IThread* AttachedThread(const JobT& job)
+		{
+			return job.pThread;
+		}
+
+		static uint64_t EnqueuedAt(const JobT& job)
+		{
+			return job.pEnqueuedAt.load(std::memory_order_relaxed);
+		}
+
+		static Yuni::Job::Priority Priority(const JobT& job)
+		{
+			return static_cast<Yuni::Job::Priority>(job.pPriority.load(std::memory_order_relaxed));
 		}
 
 	}; // class JobAccessor
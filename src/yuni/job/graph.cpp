@@ -0,0 +1,434 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "graph.h"
+#include "queue/service.h"
+#include "../core/smartptr/intrusive.h"
+#include "../thread/signal.h"
+#include <atomic>
+#include <vector>
+
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	namespace // anonymous
+	{
+
+		class GraphJob;
+
+	} // anonymous namespace
+
+
+
+	class Graph::State final : public IIntrusiveSmartPtr<Graph::State, false>
+	{
+	public:
+		//! Ancestor
+		typedef IIntrusiveSmartPtr<Graph::State, false>  Ancestor;
+		//! The threading policy
+		typedef Ancestor::ThreadingPolicy ThreadingPolicy;
+
+	public:
+		State(Graph& graph, QueueService& queueservice, bool cancelOnError)
+			: graph(&graph)
+			, queueservice(queueservice)
+			, cancelOnError(cancelOnError)
+		{}
+
+		~State();
+
+		//! Dispatch a job whose predecessors have all terminated
+		void dispatch(GraphJob& job);
+		//! A job has failed
+		void jobHasFailed();
+		//! A job has terminated (after having dispatched its successors)
+		void jobHasTerminated();
+
+
+	public:
+		//! The attached graph (null if destroyed)
+		Graph* graph;
+		//! All nodes
+		std::vector<GraphJob*> jobs;
+		//! The default queueservice
+		QueueService& queueservice;
+		//! True to stop dispatching jobs when the first error is encountered
+		const bool cancelOnError;
+
+		//! The graph has been told to start (and is running)
+		bool started = false;
+		//! Current status (should not be directly used if the graph is still running)
+		Status status = stSucceeded;
+		//! Signal for notifying that the graph has finished
+		Thread::Signal signalStopped;
+
+		//! Number of jobs dispatched and not terminated yet
+		std::atomic<uint32_t> inflight {0};
+		//! Number of terminated jobs
+		std::atomic<uint32_t> done {0};
+		//! Flag to stop dispatching jobs
+		std::atomic<bool> aborted {false};
+
+	}; // class Graph::State
+
+
+
+
+	namespace // anonymous
+	{
+
+		class GraphJob final : public IJob
+		{
+		public:
+			GraphJob(Graph::State& state, QueueService& queueservice, const Bind<bool (IJob&)>& callback)
+				: state(state)
+				, queueservice(queueservice)
+				, callback(callback)
+			{}
+
+			virtual ~GraphJob() {}
+
+		public:
+			//! The graph
+			Graph::State& state;
+			//! The attached queueservice
+			QueueService& queueservice;
+			//! The callback to call
+			Bind<bool (IJob&)> callback;
+			//! Index of all successors
+			std::vector<uint> successors;
+			//! Number of predecessors
+			uint predecessorCount = 0;
+			//! Number of predecessors not terminated yet (for the current run)
+			std::atomic<uint> remaining {0};
+
+		protected:
+			virtual void onExecute() override
+			{
+				// keeping a local reference: the graph may be destroyed as soon as
+				// the job is terminated
+				Graph::State& state = this->state;
+
+				if (not state.aborted.load(std::memory_order_relaxed))
+				{
+					bool success = false;
+					try { success = callback(*this); } catch (...) {}
+					if (not success)
+						state.jobHasFailed();
+
+					if (not state.aborted.load(std::memory_order_relaxed))
+					{
+						// dispatching all successors which are now ready
+						for (uint index: successors)
+						{
+							GraphJob& successor = *(state.jobs[index]);
+							if (successor.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+								state.dispatch(successor);
+						}
+					}
+				}
+				state.jobHasTerminated();
+			}
+
+		}; // class GraphJob
+
+	} // anonymous namespace
+
+
+
+
+	Graph::State::~State()
+	{
+		for (auto* job: jobs)
+		{
+			if (job->release())
+				delete job;
+		}
+	}
+
+
+	inline void Graph::State::dispatch(GraphJob& job)
+	{
+		// the state is kept alive as long as a job may access it
+		addRef();
+		inflight.fetch_add(1, std::memory_order_relaxed);
+		job.queueservice.push(&job, Priority::normal);
+	}
+
+
+	void Graph::State::jobHasFailed()
+	{
+		ThreadingPolicy::MutexLocker locker(*this);
+		if (status == stSucceeded) // no update if == stCanceled for example
+			status = stFailed;
+		if (cancelOnError)
+			aborted = true;
+	}
+
+
+	void Graph::State::jobHasTerminated()
+	{
+		done.fetch_add(1, std::memory_order_relaxed);
+		if (inflight.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			// no job is running anymore and no job will be dispatched
+			ThreadingPolicy::MutexLocker locker(*this);
+			if (started)
+			{
+				if (graph)
+					graph->on.terminated(status);
+				// mark as stopped *after* calling the event (see Taskgroup)
+				started = false;
+				signalStopped.notify();
+			}
+		}
+
+		if (release())
+			delete this;
+	}
+
+
+
+
+
+
+	Graph::Graph(QueueService& queueservice, bool cancelOnError)
+		: pState(new State(*this, queueservice, cancelOnError))
+	{
+		pState->addRef();
+	}
+
+
+	Graph::~Graph()
+	{
+		cancel();
+		{
+			State::ThreadingPolicy::MutexLocker locker(*pState);
+			pState->graph = nullptr;
+		}
+		if (pState->release())
+			delete pState;
+	}
+
+
+	Graph::Node Graph::add(QueueService& queueservice, const Bind<bool (IJob&)>& callback,
+		std::initializer_list<Node> predecessors)
+	{
+		State::ThreadingPolicy::MutexLocker locker(*pState);
+		if (pState->started)
+			return Node();
+
+		auto& jobs = pState->jobs;
+		uint index = static_cast<uint>(jobs.size());
+		for (auto& predecessor: predecessors)
+		{
+			if (predecessor.pGraph != this or predecessor.pIndex >= index)
+				return Node();
+		}
+
+		auto* job = new GraphJob(*pState, queueservice, callback);
+		job->addRef();
+		jobs.push_back(job);
+
+		for (auto& predecessor: predecessors)
+		{
+			jobs[predecessor.pIndex]->successors.push_back(index);
+			++(job->predecessorCount);
+		}
+		return Node(this, index);
+	}
+
+
+	Graph::Node Graph::add(QueueService& queueservice, const Bind<bool (IJob&)>& callback)
+	{
+		return add(queueservice, callback, {});
+	}
+
+
+	Graph::Node Graph::add(const Bind<bool (IJob&)>& callback)
+	{
+		return add(pState->queueservice, callback, {});
+	}
+
+
+	Graph::Node Graph::add(const Bind<bool (IJob&)>& callback, std::initializer_list<Node> predecessors)
+	{
+		return add(pState->queueservice, callback, predecessors);
+	}
+
+
+	bool Graph::precede(const Node& before, const Node& after)
+	{
+		State::ThreadingPolicy::MutexLocker locker(*pState);
+		auto& jobs = pState->jobs;
+		if (pState->started or before.pGraph != this or after.pGraph != this
+			or before.pIndex >= jobs.size() or after.pIndex >= jobs.size()
+			or before.pIndex == after.pIndex)
+			return false;
+
+		jobs[before.pIndex]->successors.push_back(after.pIndex);
+		++(jobs[after.pIndex]->predecessorCount);
+		return true;
+	}
+
+
+	uint Graph::size() const
+	{
+		State::ThreadingPolicy::MutexLocker locker(*pState);
+		return static_cast<uint>(pState->jobs.size());
+	}
+
+
+	bool Graph::start()
+	{
+		State::ThreadingPolicy::MutexLocker locker(*pState);
+		if (pState->started)
+			return true;
+
+		auto& jobs = pState->jobs;
+		uint count = static_cast<uint>(jobs.size());
+
+		// resetting the counters and looking for the roots
+		std::vector<GraphJob*> roots;
+		for (auto* job: jobs)
+		{
+			job->remaining.store(job->predecessorCount, std::memory_order_relaxed);
+			if (0 == job->predecessorCount)
+				roots.push_back(job);
+		}
+
+		// checking for cycles (Kahn's algorithm), since those jobs would never run
+		{
+			std::vector<uint> indegrees(count);
+			std::vector<uint> ready;
+			ready.reserve(count);
+			for (uint i = 0; i != count; ++i)
+			{
+				indegrees[i] = jobs[i]->predecessorCount;
+				if (0 == indegrees[i])
+					ready.push_back(i);
+			}
+			for (uint i = 0; i != ready.size(); ++i)
+			{
+				for (uint index: jobs[ready[i]]->successors)
+				{
+					if (0 == --indegrees[index])
+						ready.push_back(index);
+				}
+			}
+			if (ready.size() != count)
+				return false;
+		}
+
+		pState->status = stSucceeded; // success by default
+		pState->aborted = false;
+		pState->done = 0;
+		on.started();
+
+		if (roots.empty())
+		{
+			on.terminated(stSucceeded);
+			return true;
+		}
+
+		pState->started = true;
+		pState->signalStopped.reset();
+		// all roots must be accounted for before being dispatched: the first one
+		// may be terminated before the others are dispatched
+		pState->inflight.store(static_cast<uint32_t>(roots.size()));
+		for (uint i = 0; i != roots.size(); ++i)
+			pState->addRef();
+
+		// adding the jobs by batch (most of the time, all jobs share the same queueservice)
+		auto first = roots.begin();
+		while (first != roots.end())
+		{
+			QueueService& queueservice = (*first)->queueservice;
+			auto last = first + 1;
+			while (last != roots.end() and &((*last)->queueservice) == &queueservice)
+				++last;
+			queueservice.push(first, last, Priority::normal);
+			first = last;
+		}
+		return true;
+	}
+
+
+	void Graph::cancel()
+	{
+		State::ThreadingPolicy::MutexLocker locker(*pState);
+		if (not pState->started)
+			return;
+
+		pState->status = stCanceled;
+		pState->aborted = true;
+		for (auto* job: pState->jobs)
+			job->cancel();
+	}
+
+
+	Graph::Status Graph::wait()
+	{
+		// checking if not already stopped
+		{
+			State::ThreadingPolicy::MutexLocker locker(*pState);
+			if (not pState->started)
+				return pState->status;
+		}
+
+		pState->signalStopped.wait();
+
+		State::ThreadingPolicy::MutexLocker locker(*pState);
+		return pState->status;
+	}
+
+
+	Graph::Status Graph::wait(uint timeout)
+	{
+		// checking if not already stopped
+		{
+			State::ThreadingPolicy::MutexLocker locker(*pState);
+			if (not pState->started)
+				return pState->status;
+		}
+
+		if (pState->signalStopped.wait(timeout)) // received notification
+		{
+			State::ThreadingPolicy::MutexLocker locker(*pState);
+			return pState->status;
+		}
+
+		// the timeout has been reached
+		return stRunning;
+	}
+
+
+	Graph::Status Graph::status(uint* jobCount, uint* doneCount) const
+	{
+		State::ThreadingPolicy::MutexLocker locker(*pState);
+		if (jobCount != nullptr)
+			*jobCount = static_cast<uint>(pState->jobs.size());
+		if (doneCount != nullptr)
+			*doneCount = pState->done.load();
+
+		return (not pState->started) ? pState->status : stRunning;
+	}
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
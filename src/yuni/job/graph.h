@@ -0,0 +1,271 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../yuni.h"
+#include "../core/event/event.h"
+#include "../core/noncopyable.h"
+#include <initializer_list>
+
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	//! Forward declaration
+	class IJob;
+	class QueueService;
+
+
+
+	/*!
+	** \brief Graph of jobs with dependencies between them
+	**
+	** A job (a node) is dispatched to its queueservice as soon as all its
+	** predecessors have terminated. The ready jobs are detected by the jobs themselves
+	** (each node has an atomic counter of unfinished predecessors), thus no
+	** coordinating thread is involved.
+	**
+	** \code
+	** Job::QueueService queueservice;
+	** Job::Graph graph(queueservice);
+	**
+	** auto a = graph.add([&](IJob&) -> bool { std::cout << "A" << std::endl; return true; });
+	** auto b = a.then([&](IJob&) -> bool { std::cout << "B" << std::endl; return true; });
+	** auto c = a.then([&](IJob&) -> bool { std::cout << "C" << std::endl; return true; });
+	** auto d = graph.add([&](IJob&) -> bool { std::cout << "D" << std::endl; return true; }, {b, c});
+	**
+	** queueservice.start();
+	** graph.start();
+	** graph.wait();
+	** \endcode
+	**
+	** The graph can only be modified while not running, and can be run several times.
+	** When a job fails (its callback returns false or throws an exception), the
+	** graph is marked as failed and, if `cancelOnError` is set, no other job
+	** will be dispatched.
+	*/
+	class YUNI_DECL Graph final : private NonCopyable<Graph>
+	{
+	public:
+		//! Internal state, shared with the jobs
+		class State;
+
+		enum Status
+		{
+			//! The graph is currently running
+			stRunning,
+			//! All jobs have succeeded
+			stSucceeded,
+			//! At least one job has failed
+			stFailed,
+			//! The graph has been canceled
+			stCanceled,
+		};
+
+
+		/*!
+		** \brief Handle to a node of a graph
+		*/
+		class YUNI_DECL Node final
+		{
+		public:
+			//! Default constructor (invalid node)
+			Node() = default;
+
+			//! Get if the node is valid
+			bool valid() const;
+			//! Index of the node within its graph
+			uint index() const;
+
+			/*!
+			** \brief Add a new job, to execute after this one
+			**
+			** \param callback A functor / lambda
+			** \return The new node (invalid if the graph is running)
+			*/
+			Node then(const Bind<bool (IJob&)>& callback);
+
+			/*!
+			** \brief Add a new job, to execute after this one
+			**
+			** \param queueservice Any queueservice can be used
+			** \param callback A functor / lambda
+			** \return The new node (invalid if the graph is running)
+			*/
+			Node then(QueueService& queueservice, const Bind<bool (IJob&)>& callback);
+
+			/*!
+			** \brief Execute this job after another one
+			** \return True if the dependency has been added
+			*/
+			bool after(const Node& predecessor);
+
+		private:
+			Node(Graph* graph, uint index);
+
+		private:
+			//! The attached graph
+			Graph* pGraph = nullptr;
+			//! Index of the node within its graph
+			uint pIndex = 0;
+			// our friend
+			friend class Graph;
+
+		}; // class Node
+
+
+	public:
+		//! \name Constructors & Destructor
+		//@{
+		/*!
+		** \brief Default constructor
+		** \param queueservice The default queueservice to use when not specified
+		** \param cancelOnError True to stop dispatching jobs when the first error is encountered
+		*/
+		explicit Graph(QueueService& queueservice, bool cancelOnError = true);
+		/*!
+		** \brief Destructor
+		**
+		** The graph will be canceled if running. Use `wait()` to avoid this behavior.
+		*/
+		~Graph();
+		//@}
+
+
+		//! \name Nodes
+		//@{
+		/*!
+		** \brief Add a new job without any predecessor
+		**
+		** \param callback A functor / lambda
+		** \return The new node (invalid if the graph is running)
+		*/
+		Node add(const Bind<bool (IJob&)>& callback);
+
+		/*!
+		** \brief Add a new job without any predecessor
+		**
+		** \param queueservice Any queueservice can be used
+		** \param callback A functor / lambda
+		** \return The new node (invalid if the graph is running)
+		*/
+		Node add(QueueService& queueservice, const Bind<bool (IJob&)>& callback);
+
+		/*!
+		** \brief Add a new job, to execute after some other ones
+		**
+		** \param callback A functor / lambda
+		** \param predecessors All jobs which must have terminated first
+		** \return The new node (invalid if the graph is running)
+		*/
+		Node add(const Bind<bool (IJob&)>& callback, std::initializer_list<Node> predecessors);
+
+		/*!
+		** \brief Add a new job, to execute after some other ones
+		**
+		** \param queueservice Any queueservice can be used
+		** \param callback A functor / lambda
+		** \param predecessors All jobs which must have terminated first
+		** \return The new node (invalid if the graph is running)
+		*/
+		Node add(QueueService& queueservice, const Bind<bool (IJob&)>& callback,
+			std::initializer_list<Node> predecessors);
+
+		/*!
+		** \brief Add a dependency between two nodes
+		**
+		** \param before The job which must terminate first
+		** \param after The job to execute after `before`
+		** \return True if the dependency has been added (both nodes must belong to the graph
+		**   and the graph must not be running)
+		*/
+		bool precede(const Node& before, const Node& after);
+
+		//! Get the number of nodes
+		uint size() const;
+		//@}
+
+
+		//! \name Execution
+		//@{
+		/*!
+		** \brief Run the graph
+		**
+		** All jobs without predecessor are dispatched immediatly.
+		** This method has no effect if the graph is already running.
+		** \return False if the graph contains a cycle (nothing is run)
+		*/
+		bool start();
+
+		/*!
+		** \brief Cancel the execution
+		**
+		** No more job will be dispatched and all running jobs are asked to stop
+		** as soon as possible.
+		*/
+		void cancel();
+
+		/*!
+		** \brief Wait for the graph being complete
+		** \return The status of the graph
+		*/
+		Status wait();
+
+		/*!
+		** \brief Wait for the graph being complete (with timeout)
+		**
+		** \param timeout A timeout, in milliseconds
+		** \return The status of the graph. stRunning if the timeout has been reached
+		*/
+		Status wait(uint timeout);
+
+		/*!
+		** \brief Get the current status of the graph and fetch various information in the same time
+		**
+		** \param[out] jobCount The total number of jobs [optional]
+		** \param[out] doneCount The total number of jobs which have terminated [optional]
+		** \return status The current status of the graph
+		*/
+		Status status(uint* jobCount = nullptr, uint* doneCount = nullptr) const;
+		//@}
+
+
+	public:
+		//! All events
+		struct
+		{
+			//! Event: the graph has started (can be called from any thread)
+			Event<void ()> started;
+			//! Event: the graph has terminated its work (can be called from any thread)
+			Event<void (Status status)> terminated;
+		}
+		on;
+
+
+	private:
+		//! The internal state (reference counted, may outlive the graph)
+		State* pState;
+
+	}; // class Graph
+
+
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
+
+#include "graph.hxx"
@@ -0,0 +1,61 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "graph.h"
+
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	inline Graph::Node::Node(Graph* graph, uint index)
+		: pGraph(graph)
+		, pIndex(index)
+	{}
+
+
+	inline bool Graph::Node::valid() const
+	{
+		return pGraph != nullptr;
+	}
+
+
+	inline uint Graph::Node::index() const
+	{
+		return pIndex;
+	}
+
+
+	inline Graph::Node Graph::Node::then(const Bind<bool (IJob&)>& callback)
+	{
+		return (pGraph) ? pGraph->add(callback, {*this}) : Node();
+	}
+
+
+	inline Graph::Node Graph::Node::then(QueueService& queueservice, const Bind<bool (IJob&)>& callback)
+	{
+		return (pGraph) ? pGraph->add(queueservice, callback, {*this}) : Node();
+	}
+
+
+	inline bool Graph::Node::after(const Node& predecessor)
+	{
+		return (pGraph) and pGraph->precede(predecessor, *this);
+	}
+
+
+
+
+} // namespace Job
+} // namespace Yuni
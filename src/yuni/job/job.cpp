@@ -10,6 +10,7 @@
 */
 #include "job.h"
 #include "../core/math.h"
+#include "scratch.h"
 
 
 
@@ -44,6 +45,12 @@ namespace Job
 	}
 
 
+	ScratchArena& IJob::scratch() const
+	{
+		return ScratchArena::Current();
+	}
+
+
 	void IJob::execute(Thread::IThread* t)
 	{
 		// note: \p t can be null
@@ -58,6 +65,11 @@ namespace Job
 		// Here we go !
 		pState = static_cast<int>(State::running);
 
+		// all temporary allocations of the job will be released at once
+		// (the job may run within another one, using the same arena)
+		ScratchArena& arena = ScratchArena::Current();
+		ScratchArena::Marker marker = arena.mark();
+
 		// Execute the specific implementation of the job
 		try
 		{
@@ -67,6 +79,7 @@ namespace Job
 		{
 			uncaughtException();
 		}
+		arena.rewind(marker);
 
 		// The state must be reset to idle as soon as possible while the
 		// other values are still valid.
@@ -15,6 +15,7 @@
 #include "../core/string.h"
 #include "../core/atomic/bool.h"
 #include "../core/smartptr/intrusive.h"
+#include <atomic>
 
 
 
@@ -181,6 +182,16 @@ namespace Job
 		*/
 		bool shouldAbort() const;
 
+		/*!
+		** \brief Get the scratch arena, for the temporary allocations of the job
+		**
+		** All blocks allocated from the arena are released at the end of the execution
+		** of the job (see ScratchArena).
+		**
+		** \attention This method must only be called inside the execution of the job
+		*/
+		ScratchArena& scratch() const;
+
 
 	private:
 		//! State of the job
@@ -191,6 +202,12 @@ namespace Job
 		Atomic::Bool pCanceling;
 		//! The attached thread to this job, if any
 		ThreadingPolicy::Volatile<Thread::IThread*>::Type pThread = nullptr;
+		//! Time when the job has been added to a queue, for statistics (see QueueService::statistics())
+		std::atomic<uint64_t> pEnqueuedAt {0};
+		//! Priority of the job when added to a queue
+		std::atomic<uint32_t> pPriority {static_cast<uint32_t>(Priority::normal)};
+		//! Flag to know if the job may be removed from a full queue (see QueueService::Overflow::dropOldest)
+		std::atomic<bool> pEvictable {false};
 
 		// our friends !
 		template<class JobT> friend class Yuni::Private::QueueService::JobAccessor;
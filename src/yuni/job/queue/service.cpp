@@ -12,6 +12,8 @@
 #include "../../core/system/cpu.h"
 #include "../../thread/array.h"
 #include "../../private/jobs/queue/thread.h"
+#include "../../private/thread/futex.h"
+#include "../../io/file.h"
 #ifndef YUNI_OS_WINDOWS
 	#include <unistd.h>
 #endif
@@ -30,6 +32,14 @@ namespace Job
 
 	using ThreadArray = Yuni::Thread::Array<Yuni::Private::QueueService::QueueThread>;
 
+	//! Number of attempts on a single victim when another thief wins the race
+	constexpr static uint32_t maxStealAttempts = 4;
+
+	//! Number of times an idle worker looks for some work before parking
+	constexpr static uint32_t spinRounds = 64;
+	//! Number of pause instructions between two lookups
+	constexpr static uint32_t pausesPerSpinRound = 32;
+
 	inline uint32_t optimalCPUCount()
 	{
 		auto count = System::CPU::Count();
@@ -43,6 +53,8 @@ namespace Job
 
 
 	QueueService::QueueService()
+		: pIdleWorkers(maxNumberOfThreads)
+		, pTracer(*this)
 	{
 		auto count = optimalCPUCount();
 		pMinimumThreadCount = count;
@@ -51,6 +63,8 @@ namespace Job
 
 
 	QueueService::QueueService(bool autostart)
+		: pIdleWorkers(maxNumberOfThreads)
+		, pTracer(*this)
 	{
 		auto count = optimalCPUCount();
 		pMinimumThreadCount = count;
@@ -64,6 +78,9 @@ namespace Job
 	{
 		// making sure that the queueservice is stopped before being destroyed
 		stop();
+		// no job can be executed from now on, thus no periodic timer can be rearmed
+		if (pHasTimers.load(std::memory_order_acquire))
+			TimerService::Instance().cancel(*this);
 	}
 
 
@@ -160,11 +177,50 @@ namespace Job
 			// recreate the thread pool
 			// adding the minimum number of threads
 			array.clear();
-			for (uint i = 0; i != pMinimumThreadCount; ++i)
-				array += new Yuni::Private::QueueService::QueueThread(*this);
+			pWorkers.clear();
+			pIdleWorkers.reset();
+
+			// with auto-scaling, all workers up to the maximum are created but only
+			// the minimum is started (the others are dormant)
+			bool elastic = pAutoScaling.enabled and pMaximumThreadCount > pMinimumThreadCount;
+			uint count = elastic ? pMaximumThreadCount : pMinimumThreadCount;
+			for (uint i = 0; i != count; ++i)
+			{
+				auto* worker = new Yuni::Private::QueueService::QueueThread(*this, i);
+				worker->pDormant = (i >= pMinimumThreadCount);
+				pWorkers.push_back(worker);
+				array += worker;
+			}
+			pRunningWorkers.store(pMinimumThreadCount);
+			pLastScaleUp.store(0);
+			if (elastic)
+			{
+				uint32_t depth = pAutoScaling.queueDepth;
+				pScaleUpQueueDepth = (depth != 0) ? depth : 1;
+				pScaleUpQueueWait = static_cast<uint64_t>(pAutoScaling.queueWait) * 1000u;
+				pScaleUpInterval = static_cast<uint64_t>(pAutoScaling.interval) * 1000000u;
+				pRetirableFrom = pMinimumThreadCount;
+			}
+			else
+			{
+				pScaleUpQueueDepth = 0;
+				pScaleUpQueueWait = (uint64_t) -1;
+				pRetirableFrom = (uint32_t) -1;
+			}
+
+			if (pPinning != Pinning::none)
+				pinWorkersWL();
 
-			// Start all threads at once
-			array.start();
+			if (not elastic)
+			{
+				// Start all threads at once
+				array.start();
+			}
+			else
+			{
+				for (uint i = 0; i != pMinimumThreadCount; ++i)
+					pWorkers[i]->start();
+			}
 			// Ok now we have started
 			pStatus = State::running;
 		}
@@ -175,6 +231,7 @@ namespace Job
 	void QueueService::stop(uint timeout)
 	{
 		std::unique_ptr<ThreadArray> threads; // the thread pool
+		uint32_t workerCount;
 		// getting the thread pool
 		{
 			MutexLocker locker(*this);
@@ -183,13 +240,25 @@ namespace Job
 			threads.reset((ThreadArray*) pThreads);
 			pThreads = nullptr;
 			pStatus  = State::stopping;
+			workerCount = static_cast<uint32_t>(pWorkers.size());
 		}
 
 		// Destroying the thread pool
 		if (YUNI_LIKELY(threads))
 		{
+			// parked workers must be woken up to notice that they should stop
+			threads->gracefulStop();
+			pIdleWorkers.wakeAll(workerCount);
 			// stopping all threads (**before** deleting them)
 			threads->stop(timeout);
+			// the workers may still steal from each other until all of them are stopped
+			{
+				MutexLocker locker(*this);
+				// keeping the statistics of the workers before their destruction
+				for (auto* worker: pWorkers)
+					worker->statistics().exportTo(pStatisticsHistory);
+				pWorkers.clear();
+			}
 			threads.reset(nullptr);
 		}
 		MutexLocker locker(*this);
@@ -202,26 +271,27 @@ namespace Job
 	}
 
 
-	void QueueService::registerWorker(void* threadself)
+	void QueueService::registerWorker(Yuni::Private::QueueService::QueueThread& worker)
 	{
-		assert(threadself != nullptr);
-		MutexLocker locker(*this);
-		if (pWorkerSet.count(threadself) == 0)
-			pWorkerSet.insert(threadself);
+		// The workers may need to unregister several times. The flag is only
+		// modified by the worker itself (or once it is dead, when killed)
+		if (not worker.pActive)
+		{
+			worker.pActive = true;
+			++pActiveWorkers;
+		}
 	}
 
 
-	void QueueService::unregisterWorker(void* threadself)
+	void QueueService::unregisterWorker(Yuni::Private::QueueService::QueueThread& worker)
 	{
-		assert(threadself != nullptr);
-		MutexLocker locker(*this);
-
-		Yuni::Set<void*>::Unordered::iterator it = pWorkerSet.find(threadself);
-		if (pWorkerSet.end() != it)
+		if (worker.pActive)
 		{
-			pWorkerSet.erase(it);
-			if (pWorkerSet.empty())
+			worker.pActive = false;
+			if (0 == --pActiveWorkers)
 			{
+				// the lock guarantees that waitForAllThreads() can not miss the notification
+				MutexLocker locker(*this);
 				if (pStatus == State::stopping)
 					pStatus = State::stopped;
 				pSignalAllThreadHaveStopped.notify();
@@ -246,6 +316,7 @@ namespace Job
 			pStatus = State::stopping;
 			// ask to stop to all threads
 			((ThreadArray*) pThreads)->gracefulStop();
+			pIdleWorkers.wakeAll(static_cast<uint32_t>(pWorkers.size()));
 			// notifying that the queueservice is stopped (or will stop soon)
 			pSignalShouldStop.notify();
 		}
@@ -271,7 +342,7 @@ namespace Job
 			// if the queue is running, we may have to reset our internal state
 			if (pStatus == State::running)
 			{
-				if (not pWorkerSet.empty() or not pWaitingRoom.empty())
+				if (0 != pActiveWorkers or hasWaitingJobs())
 				{
 					pSignalAllThreadHaveStopped.reset();
 					continue;
@@ -355,40 +426,571 @@ namespace Job
 	}
 
 
-	inline void QueueService::wakeupWorkers()
+	void QueueService::wakeupWorkers()
+	{
+		// the job must be visible before looking for idle workers (see IdleWorkers::prepareToPark)
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		// a spinning worker will pick up the job, no need to wake anybody
+		if (0 == pIdleWorkers.spinning())
+		{
+			uint32_t index;
+			if (not pIdleWorkers.wakeOne(index))
+				scaleUpIfOverloaded();
+			else if (YUNI_UNLIKELY(pTracer.enabled()))
+				pTracer.woken(index);
+		}
+	}
+
+
+	void QueueService::wakeupWorkers(uint count)
+	{
+		// the jobs must be visible before looking for idle workers (see IdleWorkers::prepareToPark)
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		// each spinning worker will pick up a job
+		for (uint32_t i = pIdleWorkers.spinning(); i < count; ++i)
+		{
+			uint32_t index;
+			if (not pIdleWorkers.wakeOne(index)) // no idle worker left
+			{
+				scaleUpIfOverloaded();
+				break;
+			}
+			if (YUNI_UNLIKELY(pTracer.enabled()))
+				pTracer.woken(index);
+		}
+	}
+
+
+	void QueueService::scaleUp()
+	{
+		// an idle worker will pick up the jobs
+		if (static_cast<uint32_t>(pActiveWorkers) < pRunningWorkers.load(std::memory_order_relaxed))
+			return;
+
+		// hysteresis: a single new worker per interval
+		uint64_t now = Yuni::Private::QueueService::MonotonicTime();
+		uint64_t last = pLastScaleUp.load(std::memory_order_relaxed);
+		if (now - last < pScaleUpInterval or not pLastScaleUp.compare_exchange_strong(last, now))
+			return;
+
+		MutexLocker locker(*this);
+		if (pStatus != State::running)
+			return;
+		for (auto* worker: pWorkers)
+		{
+			// the thread of a worker just retired may not be finished yet
+			if (worker->pDormant and not worker->started())
+			{
+				worker->pDormant = false;
+				pRunningWorkers.fetch_add(1, std::memory_order_relaxed);
+				pScaledUp.fetch_add(1, std::memory_order_relaxed);
+				worker->start();
+				return;
+			}
+		}
+	}
+
+
+	bool QueueService::retire(Yuni::Private::QueueService::QueueThread& worker)
+	{
+		MutexLocker locker(*this);
+		// some jobs may have been added meanwhile
+		if (pStatus != State::running or hasWaitingJobs())
+			return false;
+		worker.pDormant = true;
+		pRunningWorkers.fetch_sub(1, std::memory_order_relaxed);
+		pScaledDown.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+
+	bool QueueService::autoScaling(const AutoScaling& settings)
+	{
+		MutexLocker locker(*this);
+		if (pStatus != State::stopped)
+			return false;
+		pAutoScaling = settings;
+		return true;
+	}
+
+
+	bool QueueService::aging(uint quantum)
 	{
 		MutexLocker locker(*this);
-		if (pWorkerSet.size() < pMaximumThreadCount and pThreads)
-			((ThreadArray*) pThreads)->wakeUp();
+		if (pStatus != State::stopped)
+			return false;
+		pWaitingRoom.aging(static_cast<uint64_t>(quantum) * 1000000u);
+		return true;
+	}
+
+
+	bool QueueService::exportTrace(const AnyString& filename) const
+	{
+		Clob content;
+		pTracer.exportJSON(content);
+		return IO::File::SetContent(filename, content);
+	}
+
+
+	bool QueueService::hasWaitingJobs() const
+	{
+		if (not pWaitingRoom.empty())
+			return true;
+		if (pScheduling == Scheduling::workStealing)
+		{
+			for (auto* worker: pWorkers)
+			{
+				if (worker->localJobsCount() != 0)
+					return true;
+			}
+		}
+		return false;
 	}
 
 
-	void QueueService::add(const IJob::Ptr& job)
+	bool QueueService::waitForJob(Yuni::Private::QueueService::QueueThread& worker)
+	{
+		// spinning for a while, a new job may come very soon
+		uint32_t maxSpinning = static_cast<uint32_t>(pWorkers.size() / 2);
+		if (pIdleWorkers.startSpinning(maxSpinning != 0 ? maxSpinning : 1))
+		{
+			bool found = false;
+			for (uint32_t i = 0; i != spinRounds and not found; ++i)
+			{
+				for (uint32_t p = 0; p != pausesPerSpinRound; ++p)
+					Yuni::Private::Thread::CPUPause();
+				found = hasWaitingJobs();
+			}
+			pIdleWorkers.stopSpinning();
+			// the jobs added from now on must see that we are no longer spinning
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (found)
+				return not worker.shouldAbort();
+		}
+
+		// parking
+		unregisterWorker(worker);
+		uint32_t index = worker.index();
+		bool expired = false;
+		pIdleWorkers.prepareToPark(index);
+		// last chance - a job may have been added before we were visible
+		if (hasWaitingJobs() or worker.shouldAbort())
+			pIdleWorkers.cancelPark(index);
+		else
+		{
+			bool tracing = pTracer.enabled();
+			if (YUNI_UNLIKELY(tracing))
+				pTracer.parked(true);
+			if (index < pRetirableFrom)
+				pIdleWorkers.park(index);
+			else
+				expired = not pIdleWorkers.park(index, pAutoScaling.keepAlive);
+			if (YUNI_UNLIKELY(tracing))
+				pTracer.parked(false);
+		}
+
+		if (worker.shouldAbort())
+			return false;
+		// idle for too long, the thread can stop (auto-scaling)
+		if (expired and retire(worker))
+			return false;
+		registerWorker(worker);
+		return true;
+	}
+
+
+	Yuni::Private::QueueService::QueueThread* QueueService::localWorker(Priority priority) const
+	{
+		// the deques are not ordered by priority, a high priority job must not wait
+		// behind the jobs of its worker
+		if (pScheduling == Scheduling::workStealing and priority == Priority::normal)
+		{
+			// jobs created by a worker are kept on its own deque
+			auto* worker = Yuni::Private::QueueService::QueueThread::Current();
+			if (worker and worker->queueservice() == this)
+				return worker;
+		}
+		return nullptr;
+	}
+
+
+	void QueueService::pushLocal(Yuni::Private::QueueService::QueueThread& worker, const IJob::Ptr& job,
+		Priority priority, uint64_t time)
 	{
 		assert(!(!job) and "invalid job");
-		pWaitingRoom.add(job);
+		worker.pushLocal(job, priority, time);
+		if (YUNI_UNLIKELY(pTracer.enabled()))
+			pTracer.enqueued(*job);
+	}
+
+
+	bool QueueService::add(const IJob::Ptr& job, Priority priority)
+	{
+		if (0 != pCapacity.load(std::memory_order_relaxed) and not localWorker(priority))
+		{
+			if (not admit(1, priority))
+				return false;
+		}
+		push(job, priority, true);
+		return true;
+	}
+
+
+	void QueueService::push(const IJob::Ptr& job, Priority priority, bool evictable)
+	{
+		assert(!(!job) and "invalid job");
+		Yuni::Private::QueueService::JobAccessor<IJob>::Evictable(*job, evictable);
+		if (auto* worker = localWorker(priority))
+			pushLocal(*worker, job, priority, Yuni::Private::QueueService::MonotonicTime());
+		else
+		{
+			pWaitingRoom.add(job, priority);
+			updateHighWatermark();
+			if (YUNI_UNLIKELY(pTracer.enabled()))
+				pTracer.enqueued(*job);
+		}
 		wakeupWorkers();
 	}
 
 
-	void QueueService::add(const IJob::Ptr& job, Priority priority)
+	void QueueService::capacity(uint count, Overflow overflow, uint timeout)
+	{
+		pOverflow.store(overflow, std::memory_order_relaxed);
+		pBlockTimeout.store(timeout, std::memory_order_relaxed);
+		pCapacity.store(count, std::memory_order_seq_cst);
+		// the blocked producers must check the new capacity
+		if (0 != pBlockedProducers.load(std::memory_order_seq_cst))
+		{
+			pRoomEvent.fetch_add(1, std::memory_order_release);
+			Yuni::Private::Thread::FutexWakeAll(pRoomEvent);
+		}
+	}
+
+
+	uint QueueService::resetHighWatermark()
+	{
+		return pHighWatermark.exchange(pWaitingRoom.size(), std::memory_order_relaxed);
+	}
+
+
+	bool QueueService::admit(uint count, Priority priority)
+	{
+		uint capacity = pCapacity.load(std::memory_order_relaxed);
+		uint size = pWaitingRoom.size();
+		if (capacity == 0 or size + count <= capacity)
+			return true;
+
+		switch (pOverflow.load(std::memory_order_relaxed))
+		{
+			case Overflow::block:
+			{
+				// a worker of this queueservice must never wait for itself
+				auto* worker = Yuni::Private::QueueService::QueueThread::Current();
+				if (worker and worker->queueservice() == this)
+					return true;
+				return waitForRoom(count, capacity);
+			}
+			case Overflow::dropOldest:
+			{
+				uint excess = size + count - capacity;
+				for (uint i = 0; i != excess; ++i)
+				{
+					IJob::Ptr dropped;
+					if (not pWaitingRoom.dropOldest(dropped, priority))
+					{
+						pRejected.fetch_add(count, std::memory_order_relaxed);
+						return false;
+					}
+					// the owner of the job may know it will never be executed
+					Yuni::Private::QueueService::JobAccessor<IJob>::Dropped(*dropped);
+					pDropped.fetch_add(1, std::memory_order_relaxed);
+					if (YUNI_UNLIKELY(pTracer.enabled()))
+						pTracer.dropped(*dropped);
+				}
+				return true;
+			}
+			case Overflow::reject:
+				break;
+		}
+		pRejected.fetch_add(count, std::memory_order_relaxed);
+		return false;
+	}
+
+
+	bool QueueService::waitForRoom(uint count, uint capacity)
+	{
+		// a batch larger than the queue can only wait for an empty queue
+		uint needed = (count < capacity) ? count : capacity;
+		uint timeout = pBlockTimeout.load(std::memory_order_relaxed);
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		pBlocked.fetch_add(1, std::memory_order_relaxed);
+
+		do
+		{
+			uint32_t event = pRoomEvent.load(std::memory_order_acquire);
+			// visible to the workers before checking the size (see notifyRoom())
+			pBlockedProducers.fetch_add(1, std::memory_order_seq_cst);
+			capacity = pCapacity.load(std::memory_order_seq_cst);
+			bool full = (capacity != 0 and pWaitingRoom.size() + needed > capacity);
+			bool expired = false;
+			if (full)
+			{
+				if (timeout == 0)
+					Yuni::Private::Thread::FutexWait(pRoomEvent, event);
+				else
+				{
+					auto now = std::chrono::steady_clock::now();
+					if (now < deadline)
+					{
+						auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+						Yuni::Private::Thread::FutexWait(pRoomEvent, event, static_cast<uint>(remaining));
+					}
+					else
+						expired = true;
+				}
+			}
+			pBlockedProducers.fetch_sub(1, std::memory_order_relaxed);
+
+			if (not full)
+				return true;
+			if (expired)
+			{
+				pRejected.fetch_add(count, std::memory_order_relaxed);
+				return false;
+			}
+			if (capacity < needed) // capacity lowered meanwhile
+				needed = capacity;
+		}
+		while (true);
+	}
+
+
+	bool QueueService::addWithDeadline(const IJob::Ptr& job, std::chrono::steady_clock::time_point deadline,
+		Priority priority)
 	{
 		assert(!(!job) and "invalid job");
-		pWaitingRoom.add(job, priority);
+		if (0 != pCapacity.load(std::memory_order_relaxed) and not localWorker(priority))
+		{
+			if (not admit(1, priority))
+				return false;
+		}
+		Yuni::Private::QueueService::JobAccessor<IJob>::Evictable(*job, true);
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+		// always into the waiting room, even from a worker, to be ordered with the other jobs
+		pWaitingRoom.add(job, priority, (ns > 0) ? static_cast<uint64_t>(ns) : 0);
+		updateHighWatermark();
+		if (YUNI_UNLIKELY(pTracer.enabled()))
+			pTracer.enqueued(*job);
 		wakeupWorkers();
+		return true;
+	}
+
+
+	TimerService::Timer::Ptr QueueService::add(const IJob::Ptr& job, std::chrono::milliseconds delay, Priority priority)
+	{
+		pHasTimers.store(true, std::memory_order_release);
+		uint64_t milliseconds = (delay.count() > 0) ? static_cast<uint64_t>(delay.count()) : 0;
+		return TimerService::Instance().add(*this, job, milliseconds, priority);
+	}
+
+
+	TimerService::Timer::Ptr QueueService::add(const IJob::Ptr& job, std::chrono::steady_clock::time_point deadline,
+		Priority priority)
+	{
+		pHasTimers.store(true, std::memory_order_release);
+		// the timers use the same clock, rounded up to the next millisecond
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+		uint64_t milliseconds = (ns > 0) ? ((static_cast<uint64_t>(ns) + 999999u) / 1000000u) : 0;
+		return TimerService::Instance().addAt(*this, job, milliseconds, priority);
+	}
+
+
+	TimerService::Timer::Ptr QueueService::every(uint interval, const Bind<bool ()>& callback, Priority priority)
+	{
+		pHasTimers.store(true, std::memory_order_release);
+		return TimerService::Instance().every(*this, interval, callback, priority);
+	}
+
+
+	bool QueueService::nextJob(IJob::Ptr& out, Yuni::Private::QueueService::QueueThread& worker)
+	{
+		if (pScheduling == Scheduling::workStealing)
+		{
+			if (worker.popLocal(out))
+				return true;
+			if (pWaitingRoom.pop(out))
+			{
+				notifyRoom();
+				return true;
+			}
+			return steal(out, worker);
+		}
+		if (pWaitingRoom.pop(out))
+		{
+			notifyRoom();
+			return true;
+		}
+		return false;
+	}
+
+
+	bool QueueService::steal(IJob::Ptr& out, Yuni::Private::QueueService::QueueThread& thief)
+	{
+		uint32_t count = static_cast<uint32_t>(pWorkers.size());
+		if (count < 2)
+			return false;
+
+		// starting from a random victim to spread the thieves
+		uint32_t offset = thief.randomNumber() % count;
+		// the victims from the same NUMA node first (all workers share the same node
+		// when not pinned), then the others
+		for (uint32_t pass = 0; pass != 2; ++pass)
+		{
+			bool local = (pass == 0);
+			for (uint32_t i = 0; i != count; ++i)
+			{
+				auto* victim = pWorkers[(offset + i) % count];
+				if (victim == &thief or (victim->pNumaNode == thief.pNumaNode) != local)
+					continue;
+				for (uint32_t attempt = 0; attempt != maxStealAttempts; ++attempt)
+				{
+					using Steal = Yuni::Private::QueueService::QueueThread::LocalJobs::Steal;
+					Steal result = victim->stealLocal(out);
+					if (result == Steal::success)
+					{
+						thief.pStatistics.stolen();
+						if (YUNI_UNLIKELY(pTracer.enabled()))
+							pTracer.stolen(*out, victim->index());
+						return true;
+					}
+					if (result == Steal::empty)
+						break;
+				}
+			}
+		}
+		return false;
+	}
+
+
+	uint QueueService::waitingJobsCount() const
+	{
+		uint count = pWaitingRoom.size();
+		MutexLocker locker(*this);
+		for (auto* worker: pWorkers)
+			count += worker->localJobsCount();
+		return count;
+	}
+
+
+	bool QueueService::scheduling(Scheduling mode)
+	{
+		MutexLocker locker(*this);
+		if (pStatus != State::stopped)
+			return false;
+		pScheduling = mode;
+		return true;
+	}
+
+
+	void QueueService::pinWorkersWL()
+	{
+		auto& workers = pWorkers;
+		System::CPU::Topology topology;
+		auto& processors = topology.processors();
+		if (processors.empty())
+			return;
+
+		switch (pPinning)
+		{
+			case Pinning::cores:
+			{
+				auto spread = topology.spread();
+				for (uint i = 0; i != workers.size(); ++i)
+				{
+					uint id = spread[i % spread.size()];
+					for (auto& processor: processors)
+					{
+						if (processor.id == id)
+						{
+							workers[i]->pNumaNode = processor.numaNode;
+							break;
+						}
+					}
+					workers[i]->affinity(std::vector<uint>{id});
+				}
+				break;
+			}
+			case Pinning::numaNodes:
+			{
+				uint nodeCount = topology.numaNodeCount();
+				for (uint i = 0; i != workers.size(); ++i)
+				{
+					uint node = i % nodeCount;
+					workers[i]->pNumaNode = node;
+					workers[i]->affinity(topology.numaNode(node));
+				}
+				break;
+			}
+			case Pinning::none:
+				break;
+		}
+	}
+
+
+	bool QueueService::pinning(Pinning mode)
+	{
+		MutexLocker locker(*this);
+		if (pStatus != State::stopped)
+			return false;
+		pPinning = mode;
+		return true;
 	}
 
 
 	void QueueService::clear()
 	{
 		pWaitingRoom.clear();
+		// room for all producers blocked by a full queue
+		if (0 != pBlockedProducers.load(std::memory_order_seq_cst))
+		{
+			pRoomEvent.fetch_add(1, std::memory_order_release);
+			Yuni::Private::Thread::FutexWakeAll(pRoomEvent);
+		}
+		MutexLocker locker(*this);
+		for (auto* worker: pWorkers)
+			worker->clearLocal();
 	}
 
 
 	uint QueueService::threadCount() const
 	{
 		MutexLocker locker(*this);
-		return pThreads ? ((const ThreadArray*) pThreads)->size() : 0;
+		return pThreads ? pRunningWorkers.load(std::memory_order_relaxed) : 0;
+	}
+
+
+	void QueueService::statistics(Statistics& out) const
+	{
+		out.clear();
+		for (uint p = 0; p != priorityCount; ++p)
+			out.enqueued += pWaitingRoom.enqueued(static_cast<Priority>(p));
+		out.rejected = pRejected.load(std::memory_order_relaxed);
+		out.dropped = pDropped.load(std::memory_order_relaxed);
+		out.blocked = pBlocked.load(std::memory_order_relaxed);
+		out.highWatermark = pHighWatermark.load(std::memory_order_relaxed);
+		out.scaledUp = pScaledUp.load(std::memory_order_relaxed);
+		out.scaledDown = pScaledDown.load(std::memory_order_relaxed);
+
+		MutexLocker locker(*this);
+		out += pStatisticsHistory;
+		out.workers.resize(pWorkers.size());
+		for (uint i = 0; i != pWorkers.size(); ++i)
+		{
+			auto& counters = pWorkers[i]->statistics();
+			counters.exportTo(out);
+			out.workers[i].index = pWorkers[i]->index();
+			counters.exportTo(out.workers[i]);
+		}
 	}
 
 
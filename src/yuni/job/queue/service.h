@@ -12,12 +12,34 @@
 #include "../../yuni.h"
 #include "../job.h"
 #include "waitingroom.h"
+#include "statistics.h"
+#include "../timer/service.h"
+#include "../../private/jobs/queue/idleworkers.h"
+#include "../../private/jobs/queue/trace.h"
 #include "../../core/atomic/bool.h"
 #include "../../thread/signal.h"
 #include "q-event.h"
-#include "../../core/dictionary.h"
 #include "../../core/smartptr/intrusive.h"
 #include <memory>
+#include <vector>
+#include <chrono>
+#include <atomic>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	// Forward declaration
+	class CoroutinePromise;
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
 
 
 
@@ -26,6 +48,12 @@ namespace Yuni
 namespace Job
 {
 
+	// Forward declaration
+	class Strand;
+	class Taskgroup;
+	class Graph;
+
+
 	/*!
 	** \brief Multithreaded Job QueueService
 	*/
@@ -47,6 +75,109 @@ namespace Job
 			defaultTimeout = Yuni::Thread::defaultTimeout,
 		};
 
+		//! Scheduling strategy used by the workers
+		enum class Scheduling
+		{
+			//! A single waiting room shared by all workers, ordered by priority (default)
+			priority,
+			/*!
+			** \brief Work-stealing
+			**
+			** Each worker owns a lock-free deque. Jobs of the default priority added
+			** from a worker are pushed onto its own deque, the other jobs (from any other
+			** thread, or with a low or high priority) go to the waiting room (which acts as
+			** an injection queue, still ordered by priority). Idle workers steal from the
+			** deques of the others.
+			*/
+			workStealing,
+		};
+
+		//! Placement of the workers on the logical processors
+		enum class Pinning
+		{
+			//! The workers are not restricted to any processor (default)
+			none,
+			/*!
+			** \brief Each worker is pinned to a single logical processor
+			**
+			** All physical cores are used before any SMT sibling, and the workers
+			** fill a NUMA node before the next one (see `System::CPU::Topology::spread()`).
+			*/
+			cores,
+			/*!
+			** \brief Each worker is restricted to the processors of a NUMA node
+			**
+			** The workers are distributed in a round-robin fashion between all NUMA nodes.
+			*/
+			numaNodes,
+		};
+
+		//! Behavior when a job is added while the queue is full (see `capacity()`)
+		enum class Overflow
+		{
+			//! The producer waits until some room is available (with a timeout)
+			block,
+			//! The new job is rejected (`add()` returns false)
+			reject,
+			/*!
+			** \brief The oldest job of the lowest priority is removed from the queue
+			**
+			** Only a job with a priority not higher than the new one can be removed,
+			** the new job is rejected otherwise. The removed job is canceled (see
+			** `IJob::canceling()`), goes back to the idle state, and is counted in
+			** `Statistics::dropped` (and traced, see `tracing()`).
+			**
+			** Only the jobs given to `add()` or `addWithDeadline()` can be removed:
+			** the jobs of a taskgroup, a graph, a timer, a strand or a coroutine task
+			** are never removed, nor the jobs in the local deque of a worker.
+			*/
+			dropOldest,
+		};
+
+		/*!
+		** \brief Settings of the auto-scaling of the workers
+		**
+		** With auto-scaling, the queueservice starts with the minimum number of
+		** workers, and adds some more (up to the maximum) when all workers are busy
+		** and the jobs pile up (see `queueDepth`) or wait for too long (see `queueWait`),
+		** like when the workers are blocked in I/O. An extra worker is retired once
+		** idle for `keepAlive` milliseconds. The long keep-alive compared to the
+		** interval between two new workers provides the hysteresis.
+		*/
+		struct AutoScaling final
+		{
+			//! Flag to enable the auto-scaling (disabled by default)
+			bool enabled = false;
+			//! Number of waiting jobs per running worker above which a worker is added
+			uint queueDepth = 4;
+			//! Time a job may wait in the queue (in microseconds) before a worker is added
+			uint queueWait = 2000;
+			//! Minimum delay between two new workers (in milliseconds)
+			uint interval = 5;
+			//! Time an extra worker may stay idle before being retired (in milliseconds)
+			uint keepAlive = 30000;
+		};
+
+		/*!
+		** \brief Settings of the tracing of the scheduling events
+		**
+		** Each thread records its events (jobs added, started, finished, stolen and dropped,
+		** workers parked and woken up) into its own ring buffer of `capacity` events,
+		** the oldest ones being overwritten. With `sampling`, only one job out of N
+		** is recorded, thus the tracing can be left enabled in production. The buffer
+		** of a thread is released once it has terminated (only the buffers of the 8
+		** most recently terminated threads are kept for the next export).
+		*/
+		struct Tracing final
+		{
+			//! Flag to record the events (disabled by default)
+			bool enabled = false;
+			//! Record one job out of N (1 for all jobs)
+			uint sampling = 1;
+			//! Number of events per thread (for the threads without events so far)
+			uint capacity = 16384;
+		};
+
 		//! Information about a single thread
 		struct ThreadInfo final
 		{
@@ -162,6 +293,32 @@ namespace Job
 		//@}
 
 
+		//! \name Scheduling
+		//@{
+		//! Get the scheduling strategy
+		Scheduling scheduling() const;
+		/*!
+		** \brief Set the scheduling strategy
+		**
+		** \param mode The new scheduling strategy
+		** \return False if the queueservice is not stopped (the strategy can not be changed)
+		*/
+		bool scheduling(Scheduling mode);
+
+		//! Get the placement of the workers on the logical processors
+		Pinning pinning() const;
+		/*!
+		** \brief Set the placement of the workers on the logical processors
+		**
+		** With work stealing, idle workers steal from the workers of their own
+		** NUMA node first.
+		** \param mode The new placement
+		** \return False if the queueservice is not stopped (the placement can not be changed)
+		*/
+		bool pinning(Pinning mode);
+		//@}
+
+
 		//! \name Jobs handling
 		//@{
 		/*!
@@ -172,8 +329,9 @@ namespace Job
 		** thread-safety in this case.
 		**
 		** \param job The job to add
+		** \return False if the job has been rejected (see `capacity()`)
 		*/
-		void add(const IJob::Ptr& job);
+		bool add(const IJob::Ptr& job);
 
 		/*!
 		** \brief Add a job into the queue
@@ -184,8 +342,104 @@ namespace Job
 		**
 		** \param job The job to add
 		** \param priority Its priority execution
+		** \return False if the job has been rejected (see `capacity()`)
 		*/
-		void add(const IJob::Ptr& job, Priority priority);
+		bool add(const IJob::Ptr& job, Priority priority);
+
+		/*!
+		** \brief Add several jobs at once into the queue
+		**
+		** All jobs are inserted with a single lock acquisition, and at most one
+		** worker per job is woken up.
+		**
+		** \code
+		** std::vector<Job::IJob::Ptr> jobs;
+		** ...
+		** queueservice.add(jobs.begin(), jobs.end());
+		** \endcode
+		**
+		** \param begin Iterator on the first job (any type convertible to IJob::Ptr)
+		** \param end Iterator past the last job
+		** \param priority Their priority execution
+		** \return False if the jobs have been rejected, all at once (see `capacity()`)
+		*/
+		template<class IteratorT>
+		bool add(IteratorT begin, IteratorT end, Priority priority = Priority::normal);
+
+		/*!
+		** \brief Add several jobs at once into the queue
+		**
+		** \param jobs The jobs to add
+		** \param priority Their priority execution
+		** \return False if the jobs have been rejected, all at once (see `capacity()`)
+		*/
+		bool add(const std::vector<IJob::Ptr>& jobs, Priority priority = Priority::normal);
+
+		/*!
+		** \brief Add a job into the queue after a delay
+		**
+		** The job is held by the shared timer service (see `TimerService::Instance()`),
+		** no thread is blocked meanwhile.
+		** \code
+		** queueservice.add(job, std::chrono::milliseconds(250));
+		** \endcode
+		**
+		** \param job The job to add
+		** \param delay The delay (with a precision of 1ms)
+		** \param priority Its priority execution
+		** \return The timer, which can be canceled before the job is added
+		*/
+		TimerService::Timer::Ptr add(const IJob::Ptr& job, std::chrono::milliseconds delay,
+			Priority priority = Priority::normal);
+
+		/*!
+		** \brief Add a job into the queue at a given time
+		**
+		** Like any job added by a timer, the job is never removed by `Overflow::dropOldest`.
+		**
+		** \param job The job to add
+		** \param deadline The deadline (with a precision of 1ms)
+		** \param priority Its priority execution
+		** \return The timer, which can be canceled before the job is added
+		*/
+		TimerService::Timer::Ptr add(const IJob::Ptr& job, std::chrono::steady_clock::time_point deadline,
+			Priority priority = Priority::normal);
+
+		/*!
+		** \brief Add a job into the queue, to be executed before a deadline
+		**
+		** With aging (see `aging()`), the jobs are executed by earliest deadline first,
+		** along with the other jobs (whose virtual deadline depends on their priority).
+		** Otherwise, the deadline is ignored and the job is added with its priority.
+		** Unlike `add(job, deadline)`, the job is added immediately.
+		** \code
+		** queueservice.aging(10);
+		** queueservice.start();
+		** queueservice.addWithDeadline(job, std::chrono::steady_clock::now() + std::chrono::milliseconds(5));
+		** \endcode
+		**
+		** \param job The job to add
+		** \param deadline The deadline
+		** \param priority Its priority execution
+		** \return False if the job has been rejected (see `capacity()`)
+		*/
+		bool addWithDeadline(const IJob::Ptr& job, std::chrono::steady_clock::time_point deadline,
+			Priority priority = Priority::normal);
+
+		/*!
+		** \brief Execute a callback every X milliseconds, as a job
+		**
+		** All periodic callbacks share the thread of the timer service (see
+		** `TimerService::every()`). The callback is never executed concurrently
+		** with itself.
+		**
+		** \param interval The interval, in milliseconds
+		** \param callback The callback (return false to stop the timer)
+		** \param priority Its priority execution
+		** \return The timer, to cancel it
+		*/
+		TimerService::Timer::Ptr every(uint interval, const Bind<bool ()>& callback,
+			Priority priority = Priority::normal);
 
 		/*!
 		** \brief Retrieve information about the activity of the queue manager
@@ -195,6 +449,19 @@ namespace Job
 		*/
 		void activitySnapshot(std::vector<std::unique_ptr<ThreadInfo>>&);
 
+		/*!
+		** \brief Retrieve the statistics of the queueservice
+		**
+		** The counters are maintained by each worker without any contention and
+		** merged here, thus this method can be called at any time, even while
+		** the queueservice is running (the values may be slightly inconsistent
+		** with each other in this case). The statistics of the workers are kept
+		** when the queueservice is stopped.
+		**
+		** \param[out] out The statistics (see Job::Statistics)
+		*/
+		void statistics(Statistics& out) const;
+
 		/*!
 		** \brief Get the number of jobs waiting to be executed
 		**
@@ -212,6 +479,57 @@ namespace Job
 		//@}
 
 
+		//! \name Flow control
+		//@{
+		/*!
+		** \brief Set the maximum number of jobs waiting to be executed
+		**
+		** When the queue is full, the overflow policy applies to the new jobs (see
+		** `Overflow`), and `add()` returns false for a rejected job. The limit is
+		** checked without any global lock, thus it may be exceeded by the number of
+		** producers adding jobs at the very same time: the bound is approximate.
+		**
+		** \code
+		** // at most 10000 waiting jobs, the producers wait up to 500ms
+		** queueservice.capacity(10000, Job::QueueService::Overflow::block, 500);
+		** if (not queueservice.add(job))
+		**	... // overloaded
+		** \endcode
+		**
+		** The jobs added by a worker of the queueservice are never blocked (the queue
+		** would not be consumed anymore), and the jobs added by a worker into its local
+		** deque (work stealing) are neither counted nor checked. The jobs of a taskgroup,
+		** a graph, a timer, a strand or a coroutine task are always accepted and never
+		** dropped, since they would never complete otherwise, but they are counted.
+		**
+		** \param count The maximum number of waiting jobs, 0 for no limit (default)
+		** \param overflow The policy when the queue is full
+		** \param timeout Maximum time a producer may be blocked, in milliseconds (0 for no limit)
+		*/
+		void capacity(uint count, Overflow overflow = Overflow::block, uint timeout = 0);
+
+		//! Get the maximum number of jobs waiting to be executed (0 if unbounded)
+		uint capacity() const;
+
+		//! Get the policy when the queue is full
+		Overflow overflow() const;
+
+		/*!
+		** \brief Get the highest number of jobs waiting to be executed at once
+		**
+		** Sampled when the jobs are added, since the creation of the queueservice
+		** or the last call to `resetHighWatermark()`.
+		*/
+		uint highWatermark() const;
+
+		/*!
+		** \brief Reset the high watermark to the current number of waiting jobs
+		** \return The previous high watermark
+		*/
+		uint resetHighWatermark();
+		//@}
+
+
 		//! \name Threads
 		//@{
 		//! Get the minimum number of threads
@@ -231,6 +549,80 @@ namespace Job
 
 		//! Get the current number of working threads
 		uint threadCount() const;
+
+		//! Get the settings of the auto-scaling
+		AutoScaling autoScaling() const;
+		/*!
+		** \brief Set the settings of the auto-scaling of the workers
+		**
+		** \code
+		** Job::QueueService::AutoScaling scaling;
+		** scaling.enabled = true;
+		** queueservice.minmaxThreadCount({4, 64});
+		** queueservice.autoScaling(scaling);
+		** queueservice.start(); // 4 workers, up to 64 when the jobs pile up
+		** \endcode
+		**
+		** \param settings The new settings
+		** \return False if the queueservice is not stopped (the settings can not be changed)
+		*/
+		bool autoScaling(const AutoScaling& settings);
+		//@}
+
+
+		//! \name Ordering
+		//@{
+		//! Get the aging quantum, in milliseconds (0 for strict priorities)
+		uint aging() const;
+		/*!
+		** \brief Set the aging quantum, to prevent the starvation of low priority jobs
+		**
+		** By default, a job is only executed once no job with a higher priority is
+		** waiting, thus a steady flow of `high` jobs may delay the other ones forever.
+		** With aging, the jobs are executed by earliest virtual deadline: the time
+		** when the job has been added plus one quantum per priority level below `high`
+		** (a `low` job waiting for 2 quanta goes before a new `high` job), or the
+		** deadline given to `addWithDeadline()`.
+		**
+		** Only the jobs of the waiting room are concerned (the jobs added by a worker
+		** with work stealing remain in its local deque).
+		** \param quantum The quantum, in milliseconds (0 for strict priorities)
+		** \return False if the queueservice is not stopped (the ordering can not be changed)
+		*/
+		bool aging(uint quantum);
+		//@}
+
+
+		//! \name Tracing
+		//@{
+		//! Get the settings of the tracing
+		Tracing tracing() const;
+		/*!
+		** \brief Set the settings of the tracing (at any time)
+		**
+		** \code
+		** Job::QueueService::Tracing tracing;
+		** tracing.enabled = true;
+		** tracing.sampling = 100; // 1% of the jobs
+		** queueservice.tracing(tracing);
+		** ...
+		** queueservice.exportTrace("/tmp/queueservice.json"); // chrome://tracing or ui.perfetto.dev
+		** \endcode
+		*/
+		void tracing(const Tracing& settings);
+
+		/*!
+		** \brief Export the events recorded so far, as Chrome trace JSON
+		**
+		** The events are still recorded meanwhile. The file can be loaded by
+		** chrome://tracing or Perfetto: a track per thread, with the execution of
+		** each job linked to the thread which has added it.
+		*/
+		void exportTrace(Clob& out) const;
+		//! Export the events recorded so far into a file (see above)
+		bool exportTrace(const AnyString& filename) const;
+		//! Forget the events recorded so far
+		void clearTrace();
 		//@}
 
 
@@ -249,13 +641,63 @@ namespace Job
 
 	private:
 		//! Register a new thread in active duty
-		void registerWorker(void* threadself);
+		void registerWorker(Yuni::Private::QueueService::QueueThread& worker);
 		//! Unregister a thread no longer in active duty
-		void unregisterWorker(void* threadself);
+		void unregisterWorker(Yuni::Private::QueueService::QueueThread& worker);
 		//! Wait for all threads to finish
 		bool waitForAllThreads(uint timeout);
-		//! Wake up thread - some work here !
+		//! Wake up a single idle worker, if needed - some work here !
 		void wakeupWorkers();
+		//! Wake up as many idle workers as needed for a given number of new jobs
+		void wakeupWorkers(uint count);
+		/*!
+		** \brief Get the worker of this queueservice attached to the calling thread, if the
+		**   jobs of a given priority can be kept on its deque (work stealing only)
+		**
+		** The deques are not ordered by priority: only the jobs of the default priority
+		** are kept there, the others go to the waiting room.
+		*/
+		Yuni::Private::QueueService::QueueThread* localWorker(Priority priority) const;
+		//! Push a job onto the deque of a worker
+		void pushLocal(Yuni::Private::QueueService::QueueThread& worker, const IJob::Ptr& job,
+			Priority priority, uint64_t time);
+		//! Get if some jobs are waiting to be executed (approximation, without lock)
+		bool hasWaitingJobs() const;
+		/*!
+		** \brief Wait for some work (spin, then park)
+		** \return False if the worker should stop
+		*/
+		bool waitForJob(Yuni::Private::QueueService::QueueThread& worker);
+		//! Get the next job to execute for a given worker
+		bool nextJob(Yuni::Job::IJob::Ptr& out, Yuni::Private::QueueService::QueueThread& worker);
+		//! Try to steal a job from the other workers
+		bool steal(Yuni::Job::IJob::Ptr& out, Yuni::Private::QueueService::QueueThread& thief);
+		//! Restrict all workers to some processors (see Pinning)
+		void pinWorkersWL();
+		/*!
+		** \brief Add a job regardless of the capacity
+		**
+		** The internal jobs (of a taskgroup, a graph, a timer...) are never evictable.
+		** \param evictable True if the job may be removed by `Overflow::dropOldest`
+		*/
+		void push(const IJob::Ptr& job, Priority priority, bool evictable = false);
+		//! Add several jobs regardless of the capacity
+		template<class IteratorT>
+		void push(IteratorT begin, IteratorT end, Priority priority, bool evictable = false);
+		//! Make some room for new jobs in the waiting room, according to the overflow policy
+		bool admit(uint count, Priority priority);
+		//! Wait until some room is available in the waiting room (Overflow::block)
+		bool waitForRoom(uint count, uint capacity);
+		//! Wake up a producer waiting for some room, if any
+		void notifyRoom();
+		//! Update the high watermark after adding some jobs into the waiting room
+		void updateHighWatermark();
+		//! All workers are busy: add a worker if the jobs pile up (auto-scaling)
+		void scaleUpIfOverloaded();
+		//! Start a dormant worker, if none is idle (auto-scaling)
+		void scaleUp();
+		//! Retire a worker idle for too long (auto-scaling)
+		bool retire(Yuni::Private::QueueService::QueueThread& worker);
 
 	private:
 		//! Flag to know if the service is started [must be protected by the internal mutex]
@@ -269,6 +711,14 @@ namespace Job
 
 		//! The list of all remaining jobs
 		Yuni::Private::QueueService::WaitingRoom pWaitingRoom;
+		//! The scheduling strategy [can only be modified when stopped]
+		Scheduling pScheduling = Scheduling::priority;
+		//! The placement of the workers [can only be modified when stopped]
+		Pinning pPinning = Pinning::none;
+		//! All workers of the thread pool, for work stealing [only modified when starting / stopping]
+		std::vector<Yuni::Private::QueueService::QueueThread*> pWorkers;
+		//! Statistics of all workers already destroyed [must be protected by the internal mutex]
+		Statistics pStatisticsHistory;
 
 		// Scheduler
 
@@ -284,15 +734,65 @@ namespace Job
 		//!
 		Yuni::Thread::Signal pSignalShouldStop;
 
-		//! Set of workers in active duty
-		// The workers may need to unregister several times and it is not safe
-		// to let the worker handle the state (it might be killed or something nasty
-		// may happen - race conditions)
-		// This set is useless (and should not be used in this current form)
-		Yuni::Set<void*>::Unordered  pWorkerSet;
+		//! Number of workers in active duty (not parked)
+		Atomic::Int<32> pActiveWorkers;
+		//! Parked and spinning workers
+		Yuni::Private::QueueService::IdleWorkers pIdleWorkers;
+		//! Flag to know if some timers may dispatch jobs to this queueservice
+		std::atomic<bool> pHasTimers {false};
+
+		// Auto-scaling
+
+		//! Settings of the auto-scaling [can only be modified when stopped]
+		AutoScaling pAutoScaling;
+		//! Number of workers started (not dormant)
+		std::atomic<uint32_t> pRunningWorkers {0};
+		//! Queue wait (ns) above which a worker is added (max if disabled) [only modified when stopped]
+		uint64_t pScaleUpQueueWait = (uint64_t) -1;
+		//! Waiting jobs per running worker above which a worker is added (0 if disabled) [only modified when stopped]
+		uint32_t pScaleUpQueueDepth = 0;
+		//! Minimum delay between two new workers (ns) [only modified when stopped]
+		uint64_t pScaleUpInterval = 0;
+		//! Index of the first worker which may be retired [only modified when stopped]
+		uint32_t pRetirableFrom = (uint32_t) -1;
+		//! Time of the last new worker (ns)
+		std::atomic<uint64_t> pLastScaleUp {0};
+		//! Number of workers added by the auto-scaling
+		std::atomic<uint64_t> pScaledUp {0};
+		//! Number of workers retired by the auto-scaling
+		std::atomic<uint64_t> pScaledDown {0};
+
+		// Flow control
+
+		//! Maximum number of waiting jobs (0 if unbounded)
+		std::atomic<uint32_t> pCapacity {0};
+		//! Policy when the queue is full
+		std::atomic<Overflow> pOverflow {Overflow::block};
+		//! Maximum time a producer may be blocked (ms, 0 for no limit)
+		std::atomic<uint32_t> pBlockTimeout {0};
+		//! Number of producers currently waiting for some room
+		std::atomic<uint32_t> pBlockedProducers {0};
+		//! Futex word, incremented each time some room is made for a blocked producer
+		std::atomic<uint32_t> pRoomEvent {0};
+		//! Highest number of waiting jobs
+		std::atomic<uint32_t> pHighWatermark {0};
+		//! Number of jobs rejected
+		std::atomic<uint64_t> pRejected {0};
+		//! Number of jobs removed from the queue to make some room
+		std::atomic<uint64_t> pDropped {0};
+		//! Number of times a producer has been blocked
+		std::atomic<uint64_t> pBlocked {0};
+
+		//! Recorder of the scheduling events
+		Yuni::Private::QueueService::Tracer pTracer;
 
 		// Nakama !
 		friend class Yuni::Private::QueueService::QueueThread;
+		friend class Yuni::Private::Jobs::CoroutinePromise;
+		friend class TimerService;
+		friend class Strand;
+		friend class Taskgroup;
+		friend class Graph;
 
 	}; // class QueueService
 
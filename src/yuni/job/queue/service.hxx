@@ -11,6 +11,8 @@
 #pragma once
 #include "service.h"
 #include "../../thread/timer.h"
+#include "../../private/thread/futex.h"
+#include <iterator>
 
 
 
@@ -19,9 +21,64 @@ namespace Yuni
 namespace Job
 {
 
-	inline uint QueueService::waitingJobsCount() const
+	inline bool QueueService::add(const IJob::Ptr& job)
 	{
-		return pWaitingRoom.size();
+		return add(job, Priority::normal);
+	}
+
+
+	template<class IteratorT>
+	bool QueueService::add(IteratorT begin, IteratorT end, Priority priority)
+	{
+		if (0 != pCapacity.load(std::memory_order_relaxed) and not localWorker(priority))
+		{
+			uint count = static_cast<uint>(std::distance(begin, end));
+			if (count != 0 and not admit(count, priority))
+				return false;
+		}
+		push(begin, end, priority, true);
+		return true;
+	}
+
+
+	template<class IteratorT>
+	void QueueService::push(IteratorT begin, IteratorT end, Priority priority, bool evictable)
+	{
+		using Accessor = Yuni::Private::QueueService::JobAccessor<IJob>;
+		for (IteratorT it = begin; it != end; ++it)
+		{
+			const IJob::Ptr& job = *it;
+			Accessor::Evictable(*job, evictable);
+		}
+
+		uint count = 0;
+		IteratorT first = begin;
+		if (auto* worker = localWorker(priority))
+		{
+			// a single timestamp for all jobs
+			uint64_t now = Yuni::Private::QueueService::MonotonicTime();
+			for (; begin != end; ++begin, ++count)
+				pushLocal(*worker, *begin, priority, now);
+		}
+		else
+		{
+			count = pWaitingRoom.add(begin, end, priority);
+			updateHighWatermark();
+			if (YUNI_UNLIKELY(pTracer.enabled()))
+			{
+				for (; first != end; ++first)
+					pTracer.enqueued(*(*first));
+			}
+		}
+
+		if (count != 0)
+			wakeupWorkers(count);
+	}
+
+
+	inline bool QueueService::add(const std::vector<IJob::Ptr>& jobs, Priority priority)
+	{
+		return add(jobs.begin(), jobs.end(), priority);
 	}
 
 
@@ -55,8 +112,7 @@ namespace Job
 
 	inline bool QueueService::idle() const
 	{
-		MutexLocker locker(*this);
-		return pWorkerSet.empty();
+		return (0 == pActiveWorkers);
 	}
 
 
@@ -67,6 +123,117 @@ namespace Job
 	}
 
 
+	inline QueueService::Scheduling QueueService::scheduling() const
+	{
+		MutexLocker locker(*this);
+		return pScheduling;
+	}
+
+
+	inline uint QueueService::capacity() const
+	{
+		return pCapacity.load(std::memory_order_relaxed);
+	}
+
+
+	inline QueueService::Overflow QueueService::overflow() const
+	{
+		return pOverflow.load(std::memory_order_relaxed);
+	}
+
+
+	inline uint QueueService::highWatermark() const
+	{
+		return pHighWatermark.load(std::memory_order_relaxed);
+	}
+
+
+	inline void QueueService::updateHighWatermark()
+	{
+		uint32_t size = pWaitingRoom.size();
+		uint32_t highest = pHighWatermark.load(std::memory_order_relaxed);
+		while (size > highest and not pHighWatermark.compare_exchange_weak(highest, size,
+			std::memory_order_relaxed))
+		{}
+	}
+
+
+	inline void QueueService::notifyRoom()
+	{
+		if (0 != pCapacity.load(std::memory_order_relaxed))
+		{
+			// the job must be removed before looking for blocked producers (see waitForRoom())
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (0 != pBlockedProducers.load(std::memory_order_relaxed))
+			{
+				pRoomEvent.fetch_add(1, std::memory_order_release);
+				Yuni::Private::Thread::FutexWakeOne(pRoomEvent);
+			}
+		}
+	}
+
+
+	inline void QueueService::scaleUpIfOverloaded()
+	{
+		if (YUNI_UNLIKELY(pScaleUpQueueDepth != 0))
+		{
+			uint32_t running = pRunningWorkers.load(std::memory_order_relaxed);
+			if (pWaitingRoom.size() > pScaleUpQueueDepth * running)
+				scaleUp();
+		}
+	}
+
+
+	inline QueueService::AutoScaling QueueService::autoScaling() const
+	{
+		MutexLocker locker(*this);
+		return pAutoScaling;
+	}
+
+
+	inline uint QueueService::aging() const
+	{
+		return static_cast<uint>(pWaitingRoom.aging() / 1000000u);
+	}
+
+
+	inline QueueService::Tracing QueueService::tracing() const
+	{
+		Tracing settings;
+		settings.enabled = pTracer.enabled();
+		settings.sampling = pTracer.sampling();
+		settings.capacity = pTracer.capacity();
+		return settings;
+	}
+
+
+	inline void QueueService::tracing(const Tracing& settings)
+	{
+		pTracer.sampling(settings.sampling);
+		pTracer.capacity(settings.capacity);
+		pTracer.enabled(settings.enabled);
+	}
+
+
+	inline void QueueService::exportTrace(Clob& out) const
+	{
+		pTracer.exportJSON(out);
+	}
+
+
+	inline void QueueService::clearTrace()
+	{
+		pTracer.clear();
+	}
+
+
+	inline QueueService::Pinning QueueService::pinning() const
+	{
+		MutexLocker locker(*this);
+		return pPinning;
+	}
+
+
 
 
 
@@ -0,0 +1,204 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "statistics.h"
+#ifdef YUNI_OS_MSVC
+	#include <intrin.h>
+#endif
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	namespace // anonymous
+	{
+
+		//! log2 of the upper bound of the first bucket (1024ns)
+		constexpr static uint firstBucketShift = 10;
+
+
+		//! Index of the most significant bit (value must not be null)
+		inline uint HighestBit(uint64_t value)
+		{
+#if defined(YUNI_OS_GCC) || defined(YUNI_OS_CLANG)
+			return 63u - static_cast<uint>(__builtin_clzll(value));
+#elif defined(YUNI_OS_MSVC) && defined(YUNI_OS_64)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return static_cast<uint>(index);
+#else
+			uint index = 0;
+			while (value >>= 1)
+				++index;
+			return index;
+#endif
+		}
+
+
+	} // anonymous namespace
+
+
+
+
+	uint Statistics::Histogram::Bucket(uint64_t duration)
+	{
+		if (duration < (uint64_t(1) << firstBucketShift))
+			return 0;
+		uint index = HighestBit(duration) - firstBucketShift + 1;
+		return (index < bucketCount) ? index : (bucketCount - 1);
+	}
+
+
+	uint64_t Statistics::Histogram::BucketUpperBound(uint index)
+	{
+		return (index + 1 < bucketCount)
+			? (uint64_t(1) << (index + firstBucketShift))
+			: UINT64_MAX;
+	}
+
+
+	uint64_t Statistics::Histogram::mean() const
+	{
+		return (count != 0) ? (total / count) : 0;
+	}
+
+
+	uint64_t Statistics::Histogram::percentile(double ratio) const
+	{
+		if (count == 0)
+			return 0;
+		if (ratio < 0.)
+			ratio = 0.;
+		if (ratio > 1.)
+			ratio = 1.;
+
+		// the rank of the percentile, at least the first duration
+		uint64_t rank = static_cast<uint64_t>(ratio * static_cast<double>(count));
+		if (rank == 0)
+			rank = 1;
+		uint64_t cumulative = 0;
+		for (uint i = 0; i != bucketCount; ++i)
+		{
+			cumulative += buckets[i];
+			if (cumulative >= rank)
+			{
+				// the highest duration is more accurate for the last bucket in use
+				uint64_t bound = BucketUpperBound(i);
+				return (max != 0 and max < bound) ? max : bound;
+			}
+		}
+		return max;
+	}
+
+
+	Statistics::Histogram& Statistics::Histogram::operator += (const Histogram& rhs)
+	{
+		count += rhs.count;
+		total += rhs.total;
+		if (max < rhs.max)
+			max = rhs.max;
+		for (uint i = 0; i != bucketCount; ++i)
+			buckets[i] += rhs.buckets[i];
+		return *this;
+	}
+
+
+	Statistics::Histogram& Statistics::Histogram::operator -= (const Histogram& rhs)
+	{
+		// the values are cumulative, thus never lower than in a previous snapshot
+		count -= rhs.count;
+		total -= rhs.total;
+		for (uint i = 0; i != bucketCount; ++i)
+			buckets[i] -= rhs.buckets[i];
+		return *this;
+	}
+
+
+	void Statistics::clear()
+	{
+		enqueued = 0;
+		executed = 0;
+		stolen = 0;
+		rejected = 0;
+		dropped = 0;
+		blocked = 0;
+		highWatermark = 0;
+		scaledUp = 0;
+		scaledDown = 0;
+		busyTime = 0;
+		idleTime = 0;
+		for (uint p = 0; p != priorityCount; ++p)
+		{
+			queueWait[p] = Histogram();
+			runTime[p] = Histogram();
+		}
+		workers.clear();
+	}
+
+
+	uint64_t Statistics::executedCount(uint priority) const
+	{
+		return (priority < priorityCount) ? runTime[priority].count : 0;
+	}
+
+
+	Statistics& Statistics::operator += (const Statistics& rhs)
+	{
+		enqueued += rhs.enqueued;
+		executed += rhs.executed;
+		stolen += rhs.stolen;
+		rejected += rhs.rejected;
+		dropped += rhs.dropped;
+		blocked += rhs.blocked;
+		if (highWatermark < rhs.highWatermark)
+			highWatermark = rhs.highWatermark;
+		scaledUp += rhs.scaledUp;
+		scaledDown += rhs.scaledDown;
+		busyTime += rhs.busyTime;
+		idleTime += rhs.idleTime;
+		for (uint p = 0; p != priorityCount; ++p)
+		{
+			queueWait[p] += rhs.queueWait[p];
+			runTime[p] += rhs.runTime[p];
+		}
+		return *this;
+	}
+
+
+	Statistics& Statistics::operator -= (const Statistics& rhs)
+	{
+		enqueued -= rhs.enqueued;
+		executed -= rhs.executed;
+		stolen -= rhs.stolen;
+		rejected -= rhs.rejected;
+		dropped -= rhs.dropped;
+		blocked -= rhs.blocked;
+		scaledUp -= rhs.scaledUp;
+		scaledDown -= rhs.scaledDown;
+		busyTime -= rhs.busyTime;
+		idleTime -= rhs.idleTime;
+		for (uint p = 0; p != priorityCount; ++p)
+		{
+			queueWait[p] -= rhs.queueWait[p];
+			runTime[p] -= rhs.runTime[p];
+		}
+		return *this;
+	}
+
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
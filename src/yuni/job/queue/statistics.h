@@ -0,0 +1,165 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include "../enum.h"
+#include <vector>
+#include <cstdint>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	/*!
+	** \brief Snapshot of the statistics of a queueservice
+	**
+	** All durations are in nanoseconds. All values are cumulative since the
+	** creation of the queueservice (they are never reset): the activity during a
+	** period of time is the difference between two snapshots (see `operator -=`).
+	**
+	** \code
+	** Job::Statistics stats;
+	** queueservice.statistics(stats);
+	** for (uint p = 0; p != Job::priorityCount; ++p)
+	** {
+	**	std::cout << "priority " << p << ": " << stats.executedCount(p) << " jobs, "
+	**		<< "wait p99 < " << (stats.queueWait[p].percentile(0.99) / 1000) << "us, "
+	**		<< "run p99 < " << (stats.runTime[p].percentile(0.99) / 1000) << "us\n";
+	** }
+	** \endcode
+	*/
+	class YUNI_DECL Statistics final
+	{
+	public:
+		/*!
+		** \brief Histogram of durations, on a logarithmic scale
+		**
+		** The first bucket holds the durations below 1us, then each bucket
+		** is twice as large as the previous one. The last one holds all
+		** durations above ~18 minutes.
+		*/
+		class YUNI_DECL Histogram final
+		{
+		public:
+			//! Number of buckets
+			constexpr static uint bucketCount = 32;
+
+			//! Get the bucket of a duration (in nanoseconds)
+			static uint Bucket(uint64_t duration);
+			//! Get the upper bound (excluded) of a bucket (in nanoseconds)
+			static uint64_t BucketUpperBound(uint index);
+
+		public:
+			//! Get the mean duration (0 if empty)
+			uint64_t mean() const;
+			/*!
+			** \brief Get an estimation of a percentile
+			**
+			** \param ratio The percentile, between 0 and 1 (0.99 for p99)
+			** \return The upper bound of the bucket holding the percentile (0 if empty)
+			*/
+			uint64_t percentile(double ratio) const;
+
+			//! Add the values of another histogram
+			Histogram& operator += (const Histogram& rhs);
+			//! Remove the values of a previous snapshot of the same histogram
+			Histogram& operator -= (const Histogram& rhs);
+
+		public:
+			//! Number of durations
+			uint64_t count = 0;
+			//! Sum of all durations
+			uint64_t total = 0;
+			//! Highest duration ever (not affected by `operator -=`)
+			uint64_t max = 0;
+			//! Number of durations per bucket
+			uint64_t buckets[bucketCount] = {};
+
+		}; // class Histogram
+
+
+		//! Statistics of a single worker
+		struct Worker final
+		{
+			//! Index of the worker within the pool
+			uint index = 0;
+			//! Number of jobs added by this worker to its own deque (work stealing only)
+			uint64_t enqueued = 0;
+			//! Number of jobs executed
+			uint64_t executed = 0;
+			//! Number of jobs stolen from the other workers (work stealing only)
+			uint64_t stolen = 0;
+			//! Time spent executing jobs
+			uint64_t busyTime = 0;
+			//! Time spent waiting for some work (spinning or parked)
+			uint64_t idleTime = 0;
+		};
+
+
+	public:
+		//! Reset all values
+		void clear();
+
+		//! Get the number of jobs executed with a given priority
+		uint64_t executedCount(uint priority) const;
+
+		//! Add the values of another snapshot (the workers are not modified)
+		Statistics& operator += (const Statistics& rhs);
+		//! Remove the values of a previous snapshot (the workers are not modified)
+		Statistics& operator -= (const Statistics& rhs);
+
+	public:
+		/*!
+		** \brief Number of jobs added to the queueservice
+		**
+		** With work stealing, the jobs still in the deque of a worker when the
+		** queueservice is stopped are moved back to the queue, and thus counted twice.
+		*/
+		uint64_t enqueued = 0;
+		//! Number of jobs executed
+		uint64_t executed = 0;
+		//! Number of jobs stolen by a worker from another one (work stealing only)
+		uint64_t stolen = 0;
+		//! Number of jobs rejected because the queue was full (see `QueueService::capacity()`)
+		uint64_t rejected = 0;
+		//! Number of jobs removed from the queue to make some room (`Overflow::dropOldest`)
+		uint64_t dropped = 0;
+		//! Number of times a producer has been blocked by a full queue (`Overflow::block`)
+		uint64_t blocked = 0;
+		//! Highest number of waiting jobs (not affected by `operator -=`, see `QueueService::highWatermark()`)
+		uint highWatermark = 0;
+		//! Number of workers added by the auto-scaling (see `QueueService::autoScaling()`)
+		uint64_t scaledUp = 0;
+		//! Number of workers retired by the auto-scaling
+		uint64_t scaledDown = 0;
+		//! Time spent by all workers executing jobs
+		uint64_t busyTime = 0;
+		//! Time spent by all workers waiting for some work
+		uint64_t idleTime = 0;
+		//! Time spent by the jobs in the queue, per priority
+		Histogram queueWait[priorityCount];
+		//! Execution time of the jobs, per priority
+		Histogram runTime[priorityCount];
+		//! Statistics of each worker currently running (thus empty when stopped)
+		std::vector<Worker> workers;
+
+	}; // class Statistics
+
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
@@ -10,6 +10,7 @@
 */
 #include "../../yuni.h"
 #include "waitingroom.h"
+#include <algorithm>
 
 
 namespace Yuni
@@ -26,6 +27,8 @@ namespace QueueService
 		// (with clear() for example)
 		for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
 			pMutexes[i].lock();
+		pDeadlineMutex.lock();
+		pDeadlineMutex.unlock();
 		for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
 			pMutexes[i].unlock();
 	}
@@ -36,23 +39,87 @@ namespace QueueService
 		// we should lock all lists before anything
 		for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
 			pMutexes[i].lock();
+		pDeadlineMutex.lock();
 
 		// reset the total number of job _before_ unlocking
 		pJobCount = 0; // may notify listeners that there is nothing to do
 
 		// clear
 		for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
+		{
 			pJobs[i].clear();
+			pFront[i].store(noJob, std::memory_order_relaxed);
+		}
+		pDeadlineJobs.clear();
+		pHeapTop.store(noJob, std::memory_order_relaxed);
 
 		// unlock all
+		pDeadlineMutex.unlock();
 		for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
 				pMutexes[i].unlock();
 	}
 
 
+	void WaitingRoom::aging(uint64_t quantum)
+	{
+		for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
+			pMutexes[i].lock();
+		pDeadlineMutex.lock();
+
+		pAging.store(quantum, std::memory_order_relaxed);
+		if (quantum != 0)
+		{
+			for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
+				updateFrontWL(i);
+			updateHeapTopWL();
+		}
+		else
+		{
+			// strict priorities: the deadlines are forgotten, in their order
+			std::sort(pDeadlineJobs.begin(), pDeadlineJobs.end(),
+				[](const DeadlineJob& a, const DeadlineJob& b) { return b < a; });
+			for (auto& entry: pDeadlineJobs)
+			{
+				using Accessor = Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>;
+				pJobs[static_cast<uint>(Accessor::Priority(*entry.job))].push_back(entry.job);
+			}
+			pDeadlineJobs.clear();
+			for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
+				pFront[i].store(noJob, std::memory_order_relaxed);
+			pHeapTop.store(noJob, std::memory_order_relaxed);
+		}
+
+		pDeadlineMutex.unlock();
+		for (uint i = 0; i != Yuni::Job::priorityCount; ++i)
+			pMutexes[i].unlock();
+	}
+
+
+	void WaitingRoom::updateFrontWL(uint pindex)
+	{
+		uint64_t score = noJob;
+		if (not pJobs[pindex].empty())
+		{
+			using Accessor = Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>;
+			// one quantum per priority level below the highest one
+			uint64_t levels = Yuni::Job::priorityCount - 1 - pindex;
+			score = Accessor::EnqueuedAt(*(pJobs[pindex].front())) + levels * pAging.load(std::memory_order_relaxed);
+		}
+		pFront[pindex].store(score, std::memory_order_release);
+	}
+
+
+	void WaitingRoom::updateHeapTopWL()
+	{
+		uint64_t score = (pDeadlineJobs.empty()) ? noJob : pDeadlineJobs.front().deadline;
+		pHeapTop.store(score, std::memory_order_release);
+	}
+
+
 	void WaitingRoom::add(const Yuni::Job::IJob::Ptr& job, Yuni::Job::Priority priority)
 	{
 		uint pindex = static_cast<uint>(priority);
+		uint64_t now = MonotonicTime();
 
 		// Locking the priority queue
 		// We should avoid ThreadingPolicy::MutexLocker since it may not be
@@ -60,12 +127,40 @@ namespace QueueService
 		Yuni::MutexLocker locker(pMutexes[pindex]);
 
 		// Resetting some internal variables of the job
-		Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>::AddedInTheWaitingRoom(*job);
+		Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>::AddedInTheWaitingRoom(*job, priority, now);
 		// Adding it into the good priority queue
 		pJobs[pindex].push_back(job);
+		if (pAging.load(std::memory_order_relaxed) != 0 and pJobs[pindex].size() == 1)
+			updateFrontWL(pindex);
 
 		// Resetting our internal state
 		++pJobCount;
+		pEnqueued[pindex].store(pEnqueued[pindex].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+
+	void WaitingRoom::add(const Yuni::Job::IJob::Ptr& job, Yuni::Job::Priority priority, uint64_t deadline)
+	{
+		uint pindex = static_cast<uint>(priority);
+		uint64_t now = MonotonicTime();
+
+		pDeadlineMutex.lock();
+		if (pAging.load(std::memory_order_relaxed) == 0)
+		{
+			// strict priorities (the mutex of the priority queue can not be locked meanwhile)
+			pDeadlineMutex.unlock();
+			add(job, priority);
+			return;
+		}
+
+		Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>::AddedInTheWaitingRoom(*job, priority, now);
+		pDeadlineJobs.push_back(DeadlineJob{deadline, pDeadlineSequence++, job});
+		std::push_heap(pDeadlineJobs.begin(), pDeadlineJobs.end());
+		updateHeapTopWL();
+
+		++pJobCount;
+		pEnqueued[pindex].store(pEnqueued[pindex].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		pDeadlineMutex.unlock();
 	}
 
 
@@ -80,9 +175,10 @@ namespace QueueService
 		if (not pJobs[pindex].empty())
 		{
 			// It remains at least one job to run !
-			out = pJobs[pindex].front();
-			// Removing it from the list of waiting jobs
-			pJobs[pindex].pop_front();
+			// Moving it out of the list of waiting jobs
+			pJobs[pindex].pop_front(out);
+			if (pAging.load(std::memory_order_relaxed) != 0)
+				updateFrontWL(pindex);
 
 			--pJobCount;
 			return true;
@@ -92,8 +188,123 @@ namespace QueueService
 	}
 
 
+	bool WaitingRoom::popDeadline(Yuni::Job::IJob::Ptr& out)
+	{
+		Yuni::MutexLocker locker(pDeadlineMutex);
+		if (pDeadlineJobs.empty())
+			return false;
+
+		std::pop_heap(pDeadlineJobs.begin(), pDeadlineJobs.end());
+		out.swap(pDeadlineJobs.back().job);
+		pDeadlineJobs.pop_back();
+		updateHeapTopWL();
+
+		--pJobCount;
+		return true;
+	}
+
+
+	bool WaitingRoom::popEarliest(Yuni::Job::IJob::Ptr& out)
+	{
+		// a few attempts with the published deadlines, which may have changed meanwhile
+		for (uint attempt = 0; attempt != 4; ++attempt)
+		{
+			uint64_t best = pHeapTop.load(std::memory_order_acquire);
+			uint source = Yuni::Job::priorityCount; // the heap
+			for (uint i = Yuni::Job::priorityCount; i-- > 0; )
+			{
+				uint64_t score = pFront[i].load(std::memory_order_acquire);
+				if (score < best)
+				{
+					best = score;
+					source = i;
+				}
+			}
+			if (best == noJob)
+				break;
+
+			bool found = (source == Yuni::Job::priorityCount)
+				? popDeadline(out)
+				: pop(out, static_cast<Yuni::Job::Priority>(source));
+			if (found)
+				return true;
+		}
+
+		// no luck: any job will do
+		return popDeadline(out)
+			or (pop(out, Yuni::Job::Priority::high))
+			or (pop(out, Yuni::Job::Priority::normal))
+			or (pop(out, Yuni::Job::Priority::low));
+	}
+
+
+	bool WaitingRoom::dropOldest(Yuni::Job::IJob::Ptr& out, Yuni::Job::Priority priority)
+	{
+		using Accessor = Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>;
+
+		for (uint pindex = 0; pindex <= static_cast<uint>(priority); ++pindex)
+		{
+			// the priority queue, then the jobs with an explicit deadline (same order as aging())
+			Yuni::MutexLocker locker(pMutexes[pindex]);
+			Yuni::MutexLocker deadlineLocker(pDeadlineMutex);
+
+			// the oldest evictable job of the priority queue (FIFO)
+			auto& list = pJobs[pindex];
+			uint32_t index = 0;
+			for (; index != list.size(); ++index)
+			{
+				if (Accessor::Evictable(*(list[index])))
+					break;
+			}
+			uint64_t oldest = (index != list.size()) ? Accessor::EnqueuedAt(*(list[index])) : noJob;
+
+			// the oldest evictable job with an explicit deadline and the same priority
+			size_t heapIndex = pDeadlineJobs.size();
+			for (size_t i = 0; i != pDeadlineJobs.size(); ++i)
+			{
+				auto& job = *(pDeadlineJobs[i].job);
+				if (static_cast<uint>(Accessor::Priority(job)) == pindex and Accessor::Evictable(job)
+					and Accessor::EnqueuedAt(job) < oldest)
+				{
+					oldest = Accessor::EnqueuedAt(job);
+					heapIndex = i;
+				}
+			}
+
+			if (heapIndex != pDeadlineJobs.size())
+			{
+				out.swap(pDeadlineJobs[heapIndex].job);
+				if (heapIndex + 1 != pDeadlineJobs.size())
+				{
+					pDeadlineJobs[heapIndex] = std::move(pDeadlineJobs.back());
+					pDeadlineJobs.pop_back();
+					std::make_heap(pDeadlineJobs.begin(), pDeadlineJobs.end());
+				}
+				else
+					pDeadlineJobs.pop_back();
+				updateHeapTopWL();
+			}
+			else if (index != list.size())
+			{
+				list.erase(index, out);
+				if (index == 0 and pAging.load(std::memory_order_relaxed) != 0)
+					updateFrontWL(pindex);
+			}
+			else
+				continue;
+
+			--pJobCount;
+			return true;
+		}
+		return false;
+	}
+
+
 	bool WaitingRoom::pop(Yuni::Job::IJob::Ptr& out)
 	{
+		if (pAging.load(std::memory_order_relaxed) != 0)
+			return popEarliest(out);
+
 		return (pop(out, Yuni::Job::Priority::high))
 			or (pop(out, Yuni::Job::Priority::normal))
 			or (pop(out, Yuni::Job::Priority::low));
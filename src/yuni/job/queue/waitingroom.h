@@ -12,7 +12,10 @@
 #include "../job.h"
 #include "../../core/slist/slist.h"
 #include "../../core/atomic/bool.h"
-#include <deque>
+#include "../../private/jobs/queue/ringbuffer.h"
+#include "../../private/jobs/queue/statistics.h"
+#include <atomic>
+#include <vector>
 
 
 
@@ -25,6 +28,17 @@ namespace QueueService
 
 	/*!
 	** \brief Container for all jobs waiting to be executed
+	**
+	** By default, the jobs are executed by strict priority: a job is only
+	** executed once no job with a higher priority is waiting.
+	**
+	** With aging (see `aging()`), all jobs are ordered by a virtual deadline
+	** instead, the earliest first: the time when the job has been added, plus one
+	** aging quantum per priority level below `high`. A job waiting for a while
+	** thus overtakes the new jobs with a higher priority. The jobs added with
+	** an explicit deadline are ordered in a binary heap, the jobs of each priority
+	** remaining FIFO: the next job is the earliest among four candidates, whose
+	** virtual deadlines are published without lock.
 	*/
 	class YUNI_DECL WaitingRoom final
 	{
@@ -57,6 +71,28 @@ namespace QueueService
 		*/
 		void add(const Yuni::Job::IJob::Ptr& job, Yuni::Job::Priority priority);
 
+		/*!
+		** \brief Add several jobs at once into the waiting room
+		**
+		** All jobs are added with a single lock acquisition.
+		** \param begin Iterator on the first job (any type convertible to IJob::Ptr)
+		** \param end Iterator past the last job
+		** \param priority Their priority
+		** \return The number of jobs added
+		*/
+		template<class IteratorT>
+		uint add(IteratorT begin, IteratorT end, Yuni::Job::Priority priority);
+
+		/*!
+		** \brief Add a job into the waiting room, to be executed before a deadline
+		**
+		** The deadline is ignored without aging (the job is added with its priority).
+		** \param job The job to add
+		** \param priority Its priority
+		** \param deadline The deadline, in nanoseconds (see `MonotonicTime()`)
+		*/
+		void add(const Yuni::Job::IJob::Ptr& job, Yuni::Job::Priority priority, uint64_t deadline);
+
 		/*!
 		** \brief Get the next job to execute for a given priority
 		**
@@ -76,21 +112,97 @@ namespace QueueService
 		*/
 		bool pop(Yuni::Job::IJob::Ptr& out);
 
+		/*!
+		** \brief Remove the oldest job of the lowest priority, to make some room
+		**
+		** Only the evictable jobs are considered (the jobs added by `QueueService::add()`,
+		** not the internal ones of a taskgroup, a graph, a timer...), including the
+		** jobs with an explicit deadline.
+		** \param[out] out The removed job, if any
+		** \param priority The highest priority of the job to remove
+		** \return True if a job has been removed
+		*/
+		bool dropOldest(Yuni::Job::IJob::Ptr& out, Yuni::Job::Priority priority);
+
 		//! Get the number of jobs waiting to be executed
 		uint size() const;
 
 		//! Remove all job waiting
 		void clear();
+
+		//! Get the number of jobs added so far for a given priority
+		uint64_t enqueued(Yuni::Job::Priority priority) const;
+		//@}
+
+
+		//! \name Ordering
+		//@{
+		//! Get the aging quantum, in nanoseconds (0 for strict priorities)
+		uint64_t aging() const;
+		/*!
+		** \brief Set the aging quantum
+		**
+		** The jobs already waiting are reordered. This method must not be called
+		** while the jobs are consumed.
+		** \param quantum Delay after which a waiting job gains a priority level, in
+		**   nanoseconds (0 for strict priorities)
+		*/
+		void aging(uint64_t quantum);
 		//@}
 
 
+	private:
+		//! A job with an explicit deadline
+		struct DeadlineJob final
+		{
+			//! The deadline
+			uint64_t deadline;
+			//! Order of arrival, for jobs with the same deadline
+			uint64_t sequence;
+			//! The job
+			Yuni::Job::IJob::Ptr job;
+
+			//! Order of the heap (the earliest deadline on top)
+			bool operator < (const DeadlineJob& rhs) const;
+		};
+
+		enum : uint64_t
+		{
+			//! Virtual deadline of an empty queue
+			noJob = (uint64_t) -1,
+		};
+
+		//! Get the next job with aging
+		bool popEarliest(Yuni::Job::IJob::Ptr& out);
+		//! Get the job with the earliest explicit deadline
+		bool popDeadline(Yuni::Job::IJob::Ptr& out);
+		//! Publish the virtual deadline of the first job of a priority queue [with its mutex locked]
+		void updateFrontWL(uint pindex);
+		//! Publish the deadline of the top of the heap [with its mutex locked]
+		void updateHeapTopWL();
+
 	private:
 		//! Number of job waiting to be executed
 		Atomic::Int<32>  pJobCount;
 		//! List of waiting jobs by priority
-		std::deque<Yuni::Job::IJob::Ptr>  pJobs[Yuni::Job::priorityCount];
+		RingBuffer<Yuni::Job::IJob::Ptr>  pJobs[Yuni::Job::priorityCount];
 		//! Mutexes, by priority to reduce congestion
 		Mutex pMutexes[Yuni::Job::priorityCount];
+		//! Number of jobs added so far, by priority [only modified with the mutex locked]
+		std::atomic<uint64_t> pEnqueued[Yuni::Job::priorityCount] = {};
+
+		//! The aging quantum (ns, 0 for strict priorities)
+		std::atomic<uint64_t> pAging {0};
+		//! Virtual deadline of the first job of each priority (aging only)
+		std::atomic<uint64_t> pFront[Yuni::Job::priorityCount] = {{noJob}, {noJob}, {noJob}};
+		//! Jobs with an explicit deadline (binary heap, aging only)
+		std::vector<DeadlineJob> pDeadlineJobs;
+		//! Mutex for the jobs with an explicit deadline
+		Mutex pDeadlineMutex;
+		//! Deadline of the top of the heap
+		std::atomic<uint64_t> pHeapTop {noJob};
+		//! Number of jobs added with an explicit deadline so far [only modified with the mutex locked]
+		uint64_t pDeadlineSequence = 0;
 
 	}; // class WaitingRoom
 
@@ -31,6 +31,56 @@ namespace QueueService
 	}
 
 
+	inline uint64_t WaitingRoom::enqueued(Yuni::Job::Priority priority) const
+	{
+		return pEnqueued[static_cast<uint>(priority)].load(std::memory_order_relaxed);
+	}
+
+
+	inline uint64_t WaitingRoom::aging() const
+	{
+		return pAging.load(std::memory_order_relaxed);
+	}
+
+
+	inline bool WaitingRoom::DeadlineJob::operator < (const DeadlineJob& rhs) const
+	{
+		// std::push_heap / pop_heap maintain a max-heap
+		return (deadline != rhs.deadline) ? (deadline > rhs.deadline) : (sequence > rhs.sequence);
+	}
+
+
+	template<class IteratorT>
+	uint WaitingRoom::add(IteratorT begin, IteratorT end, Yuni::Job::Priority priority)
+	{
+		uint pindex = static_cast<uint>(priority);
+		uint count = 0;
+		// a single timestamp for all jobs
+		uint64_t now = MonotonicTime();
+
+		// We should avoid ThreadingPolicy::MutexLocker since it may not be
+		// the good threading policy for these mutexes
+		Yuni::MutexLocker locker(pMutexes[pindex]);
+		auto& list = pJobs[pindex];
+		bool wasEmpty = list.empty();
+		for (; begin != end; ++begin, ++count)
+		{
+			const Yuni::Job::IJob::Ptr& job = *begin;
+			// Resetting some internal variables of the job
+			Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>::AddedInTheWaitingRoom(*job, priority, now);
+			list.push_back(job);
+		}
+
+		if (wasEmpty and count != 0 and pAging.load(std::memory_order_relaxed) != 0)
+			updateFrontWL(pindex);
+
+		// Resetting our internal state, once for all jobs
+		pJobCount += static_cast<sint32>(count);
+		pEnqueued[pindex].store(pEnqueued[pindex].load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		return count;
+	}
+
+
 
 } // namespace QueueService
 } // namespace Private
@@ -0,0 +1,136 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "scratch.h"
+#include "../private/jobs/queue/thread.h"
+#include <cstdlib>
+#include <new>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	ScratchArena& ScratchArena::Current()
+	{
+		if (auto* worker = Yuni::Private::QueueService::QueueThread::Current())
+			return worker->scratch();
+		static thread_local ScratchArena arena;
+		return arena;
+	}
+
+
+	ScratchArena::~ScratchArena()
+	{
+		reset();
+		while (pSpareChunks)
+		{
+			Chunk* next = pSpareChunks->next;
+			::free(pSpareChunks);
+			pSpareChunks = next;
+		}
+	}
+
+
+	void* ScratchArena::allocateFromNewChunk(size_t size, size_t alignment)
+	{
+		size_t required = size + alignment;
+
+		// a spare chunk large enough, otherwise a new one
+		Chunk* chunk = nullptr;
+		for (Chunk** previous = &pSpareChunks; *previous != nullptr; previous = &((*previous)->next))
+		{
+			if ((*previous)->size >= required)
+			{
+				chunk = *previous;
+				*previous = chunk->next;
+				break;
+			}
+		}
+		if (nullptr == chunk)
+		{
+			size_t datasize = (required > chunkSize) ? required : static_cast<size_t>(chunkSize);
+			chunk = static_cast<Chunk*>(::malloc(sizeof(Chunk) + datasize));
+			if (YUNI_UNLIKELY(nullptr == chunk))
+				throw std::bad_alloc();
+			chunk->size = datasize;
+			pCapacity += datasize;
+		}
+
+		chunk->next = pChunks;
+		pChunks = chunk;
+		pCursor = chunk->begin();
+		pEnd = chunk->end();
+		return allocate(size, alignment);
+	}
+
+
+	void ScratchArena::rewind(const Marker& marker)
+	{
+		Chunk* target = static_cast<Chunk*>(marker.chunk);
+		while (pChunks != target)
+		{
+			Chunk* chunk = pChunks;
+			pChunks = chunk->next;
+			chunk->next = pSpareChunks;
+			pSpareChunks = chunk;
+		}
+
+		if (nullptr != target)
+		{
+			pCursor = marker.cursor;
+			pEnd = target->end();
+		}
+		else
+		{
+			pCursor = nullptr;
+			pEnd = nullptr;
+			trim();
+		}
+	}
+
+
+	void ScratchArena::reset()
+	{
+		rewind(Marker{nullptr, nullptr});
+	}
+
+
+	void ScratchArena::trim()
+	{
+		// called when all chunks are spare
+		if (YUNI_LIKELY(pCapacity <= retainedSize))
+			return;
+		size_t kept = 0;
+		for (Chunk** previous = &pSpareChunks; *previous != nullptr; )
+		{
+			Chunk* chunk = *previous;
+			if (kept + chunk->size <= retainedSize)
+			{
+				kept += chunk->size;
+				previous = &chunk->next;
+			}
+			else
+			{
+				*previous = chunk->next;
+				pCapacity -= chunk->size;
+				::free(chunk);
+			}
+		}
+	}
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
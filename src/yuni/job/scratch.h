@@ -0,0 +1,207 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../yuni.h"
+#include "../core/noncopyable.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	/*!
+	** \brief Bump-pointer arena for the temporary allocations of a job
+	**
+	** Each worker of a queueservice owns an arena, rewound after each job: the
+	** memory obtained while a job is running is valid until the end of its
+	** execution, and must not be kept by the job (neither in a member, nor across
+	** a `co_await`). Allocating is a pointer increment within chunks of
+	** `chunkSize` bytes, which are kept for the next jobs.
+	**
+	** \code
+	** class MyJob final : public Job::IJob
+	** {
+	**   virtual void onExecute() override
+	**   {
+	**     Job::ScratchVector<uint> list; // memory from the arena of the worker
+	**     list.resize(1000);
+	**     ...
+	**   }
+	** };
+	** \endcode
+	**
+	** The calling thread uses its own arena when it is not a worker (see `Current()`).
+	** A job executed from within another job only rewinds its own allocations.
+	*/
+	class YUNI_DECL ScratchArena final : public NonCopyable<ScratchArena>
+	{
+	public:
+		enum : size_t
+		{
+			//! Default size of a chunk
+			chunkSize = 64 * 1024,
+			//! Memory kept by the arena once rewound (the extra chunks are released)
+			retainedSize = 1024 * 1024,
+		};
+
+		//! Position in the arena (see `mark()` and `rewind()`)
+		struct Marker final
+		{
+			//! Pointer to the chunk
+			void* chunk;
+			//! The cursor within the chunk
+			char* cursor;
+		};
+
+	public:
+		/*!
+		** \brief Get the arena of the calling thread
+		**
+		** The arena of the worker when called from a worker of a queueservice
+		** (from a job or an `async()` lambda), an arena per thread otherwise.
+		*/
+		static ScratchArena& Current();
+
+	public:
+		//! \name Constructor & Destructor
+		//@{
+		//! Default constructor (no memory is allocated)
+		ScratchArena() = default;
+		//! Destructor
+		~ScratchArena();
+		//@}
+
+
+		//! \name Memory
+		//@{
+		/*!
+		** \brief Allocate a block of memory
+		**
+		** \param size Size in bytes
+		** \param alignment Alignment (power of 2)
+		** \return A pointer to the block (never null, std::bad_alloc on failure)
+		*/
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		/*!
+		** \brief Release a block of memory
+		**
+		** Only the last block allocated is actually reused (like a stack), the
+		** memory of the others is reclaimed when the arena is rewound.
+		*/
+		void deallocate(void* pointer, size_t size);
+
+		//! Get the current position in the arena
+		Marker mark() const;
+		//! Release all blocks allocated after a given position
+		void rewind(const Marker& marker);
+		//! Release all blocks
+		void reset();
+
+		//! Get the number of bytes allocated from the system
+		size_t capacity() const;
+		//@}
+
+
+	private:
+		//! A chunk of memory (the data follows the header)
+		struct alignas(std::max_align_t) Chunk final
+		{
+			//! The previous chunk in use, or the next spare chunk
+			Chunk* next;
+			//! Size of the data
+			size_t size;
+
+			char* begin() { return reinterpret_cast<char*>(this + 1); }
+			char* end() { return begin() + size; }
+		};
+
+		//! Allocate a block from a new chunk
+		void* allocateFromNewChunk(size_t size, size_t alignment);
+		//! Release the spare chunks exceeding `retainedSize`
+		void trim();
+
+	private:
+		//! Position of the next block
+		char* pCursor = nullptr;
+		//! End of the current chunk
+		char* pEnd = nullptr;
+		//! The current chunk, linked to the previous ones
+		Chunk* pChunks = nullptr;
+		//! Chunks available for reuse
+		Chunk* pSpareChunks = nullptr;
+		//! Total size of the chunks
+		size_t pCapacity = 0;
+
+	}; // class ScratchArena
+
+
+
+
+	/*!
+	** \brief STL allocator using a scratch arena
+	**
+	** \tparam T The type of the elements
+	*/
+	template<class T>
+	class ScratchAllocator
+	{
+	public:
+		typedef T value_type;
+
+		template<class U> struct rebind { typedef ScratchAllocator<U> other; };
+
+	public:
+		//! Default constructor, with the arena of the calling thread
+		ScratchAllocator();
+		//! Constructor with a given arena
+		explicit ScratchAllocator(ScratchArena& arena) noexcept;
+		//! Copy constructor from another type
+		template<class U> ScratchAllocator(const ScratchAllocator<U>& rhs) noexcept;
+
+		//! Allocate `count` elements
+		T* allocate(size_t count);
+		//! Release `count` elements
+		void deallocate(T* pointer, size_t count) noexcept;
+
+		//! Get the arena
+		ScratchArena& arena() const noexcept;
+
+		template<class U> bool operator == (const ScratchAllocator<U>& rhs) const noexcept;
+		template<class U> bool operator != (const ScratchAllocator<U>& rhs) const noexcept;
+
+	private:
+		//! The arena
+		ScratchArena* pArena;
+
+	}; // class ScratchAllocator
+
+
+
+	//! A vector allocated from the scratch arena of the calling thread
+	template<class T> using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+	//! A string allocated from the scratch arena of the calling thread
+	typedef std::basic_string<char, std::char_traits<char>, ScratchAllocator<char>> ScratchString;
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
+
+#include "scratch.hxx"
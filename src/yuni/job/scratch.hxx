@@ -0,0 +1,117 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "scratch.h"
+#include <cstdint>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	inline void* ScratchArena::allocate(size_t size, size_t alignment)
+	{
+		uintptr_t cursor = reinterpret_cast<uintptr_t>(pCursor);
+		uintptr_t aligned = (cursor + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+		if (YUNI_LIKELY(aligned + size <= reinterpret_cast<uintptr_t>(pEnd) and pCursor != nullptr))
+		{
+			pCursor = reinterpret_cast<char*>(aligned + size);
+			return reinterpret_cast<void*>(aligned);
+		}
+		return allocateFromNewChunk(size, alignment);
+	}
+
+
+	inline void ScratchArena::deallocate(void* pointer, size_t size)
+	{
+		// the last block can be given back (a vector growing, for example)
+		if (static_cast<char*>(pointer) + size == pCursor)
+			pCursor = static_cast<char*>(pointer);
+	}
+
+
+	inline ScratchArena::Marker ScratchArena::mark() const
+	{
+		return Marker{pChunks, pCursor};
+	}
+
+
+	inline size_t ScratchArena::capacity() const
+	{
+		return pCapacity;
+	}
+
+
+
+
+	template<class T>
+	inline ScratchAllocator<T>::ScratchAllocator()
+		: pArena(&ScratchArena::Current())
+	{}
+
+
+	template<class T>
+	inline ScratchAllocator<T>::ScratchAllocator(ScratchArena& arena) noexcept
+		: pArena(&arena)
+	{}
+
+
+	template<class T>
+	template<class U>
+	inline ScratchAllocator<T>::ScratchAllocator(const ScratchAllocator<U>& rhs) noexcept
+		: pArena(&rhs.arena())
+	{}
+
+
+	template<class T>
+	inline T* ScratchAllocator<T>::allocate(size_t count)
+	{
+		return static_cast<T*>(pArena->allocate(count * sizeof(T), alignof(T)));
+	}
+
+
+	template<class T>
+	inline void ScratchAllocator<T>::deallocate(T* pointer, size_t count) noexcept
+	{
+		pArena->deallocate(pointer, count * sizeof(T));
+	}
+
+
+	template<class T>
+	inline ScratchArena& ScratchAllocator<T>::arena() const noexcept
+	{
+		return *pArena;
+	}
+
+
+	template<class T>
+	template<class U>
+	inline bool ScratchAllocator<T>::operator == (const ScratchAllocator<U>& rhs) const noexcept
+	{
+		return pArena == &rhs.arena();
+	}
+
+
+	template<class T>
+	template<class U>
+	inline bool ScratchAllocator<T>::operator != (const ScratchAllocator<U>& rhs) const noexcept
+	{
+		return pArena != &rhs.arena();
+	}
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
@@ -0,0 +1,212 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "strand.h"
+#include "../private/jobs/pool.h"
+#include "../private/thread/futex.h"
+#include "../private/jobs/queue/statistics.h"
+#include <cassert>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	class Strand::Runner final : public IJob
+	{
+	public:
+		//! Allocation from the job pool
+		static void* operator new(size_t size)
+		{
+			return Yuni::Private::Jobs::JobPool::Allocate(size);
+		}
+
+		//! Release to the job pool
+		static void operator delete(void* pointer)
+		{
+			Yuni::Private::Jobs::JobPool::Release(pointer);
+		}
+
+	public:
+		explicit Runner(Strand& strand)
+			: pStrand(&strand)
+		{}
+
+		virtual ~Runner()
+		{
+			// removed from the queue without being executed
+			if (!(!pStrand))
+				pStrand->drop();
+		}
+
+	protected:
+		virtual void onExecute() override
+		{
+			Strand::Ptr strand = pStrand;
+			pStrand = nullptr;
+			using Accessor = Yuni::Private::QueueService::JobAccessor<IJob>;
+			strand->run(Accessor::AttachedThread(*this));
+		}
+
+	private:
+		//! The strand (null once executed)
+		Strand::Ptr pStrand;
+
+	}; // class Strand::Runner
+
+
+
+
+	void* Strand::Node::operator new(size_t size)
+	{
+		return Yuni::Private::Jobs::JobPool::Allocate(size);
+	}
+
+
+	void Strand::Node::operator delete(void* pointer)
+	{
+		Yuni::Private::Jobs::JobPool::Release(pointer);
+	}
+
+
+
+
+	Strand::Strand(QueueService& queueservice, Priority priority)
+		: pQueueService(queueservice)
+		, pPriority(priority)
+		, pHead(&pStub)
+		, pTail(&pStub)
+	{}
+
+
+	Strand::~Strand()
+	{
+		// a runner holds a reference to the strand as long as some jobs are pending
+		assert(pPending.load() == 0 and "a strand can not be destroyed with pending jobs");
+	}
+
+
+	void Strand::push(Node* node)
+	{
+		node->next.store(nullptr, std::memory_order_relaxed);
+		Node* previous = pHead.exchange(node, std::memory_order_acq_rel);
+		// the node is not reachable by the consumer until linked
+		previous->next.store(node, std::memory_order_release);
+	}
+
+
+	Strand::Node* Strand::pop()
+	{
+		Node* tail = pTail;
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (tail == &pStub)
+		{
+			if (nullptr == next)
+				return nullptr;
+			pTail = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+		if (next)
+		{
+			pTail = next;
+			return tail;
+		}
+		// a producer is pushing a new node
+		if (tail != pHead.load(std::memory_order_acquire))
+			return nullptr;
+		// the last node can only be returned once the stub is behind it
+		push(&pStub);
+		next = tail->next.load(std::memory_order_acquire);
+		if (next)
+		{
+			pTail = next;
+			return tail;
+		}
+		return nullptr;
+	}
+
+
+	Strand::Node* Strand::popPending()
+	{
+		// the node has been counted, but may not be linked yet by its producer
+		Node* node;
+		while (nullptr == (node = pop()))
+			Yuni::Private::Thread::CPUPause();
+		return node;
+	}
+
+
+	void Strand::add(const IJob::Ptr& job)
+	{
+		if (YUNI_UNLIKELY(!job))
+			return;
+
+		using Accessor = Yuni::Private::QueueService::JobAccessor<IJob>;
+		Accessor::AddedInTheWaitingRoom(*job, pPriority, Yuni::Private::QueueService::MonotonicTime());
+
+		Node* node = new Node();
+		node->job = job;
+		push(node);
+
+		// the first pending job: nobody is in charge of the strand
+		if (0 == pPending.fetch_add(1, std::memory_order_acq_rel))
+			schedule();
+	}
+
+
+	void Strand::schedule()
+	{
+		pQueueService.push(new Runner(*this), pPriority);
+	}
+
+
+	void Strand::run(Thread::IThread* thread)
+	{
+		for (uint i = 0; i != batchSize; ++i)
+		{
+			IJob::Ptr job;
+			{
+				Node* node = popPending();
+				job.swap(node->job);
+				delete node;
+			}
+
+			job->execute(thread);
+			job = nullptr;
+
+			// the next job is executed by this runner as long as one is pending
+			if (1 == pPending.fetch_sub(1, std::memory_order_acq_rel))
+				return;
+		}
+		// some jobs are still pending, but the other jobs of the queue must be executed
+		// as well: a new runner is added at the end of the queue
+		schedule();
+	}
+
+
+	void Strand::drop()
+	{
+		do
+		{
+			Node* node = popPending();
+			delete node;
+		}
+		while (1 != pPending.fetch_sub(1, std::memory_order_acq_rel));
+	}
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
@@ -0,0 +1,265 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../yuni.h"
+#include "job.h"
+#include "queue/service.h"
+#include "../core/noncopyable.h"
+#include "../core/smartptr/intrusive.h"
+#include "../thread/mutex.h"
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <memory>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	/*!
+	** \brief Serial executor on top of a queueservice (strand)
+	**
+	** All jobs added to a strand are executed in their order of arrival, and never
+	** concurrently, by the workers of a queueservice. Different strands run in
+	** parallel. This replaces a mutex per entity, held by the jobs while running
+	** and blocking the workers.
+	**
+	** \code
+	** Job::QueueService queueservice;
+	** queueservice.start();
+	** Job::Strand::Ptr strand = new Job::Strand(queueservice);
+	** *strand += new MyFirstJob();
+	** *strand += new MySecondJob(); // executed after MyFirstJob
+	** \endcode
+	**
+	** The jobs are pushed onto a lock-free queue (multiple producers, single
+	** consumer). A single job of the queueservice is in charge of the strand while
+	** some jobs are pending: it executes them one after the other, and gives the
+	** worker back to the other jobs of the queue every `batchSize` jobs.
+	**
+	** Removing the pending jobs from the queueservice (`QueueService::clear()`, or
+	** when destroyed) removes all the jobs of the strand not executed yet.
+	** The queueservice must outlive the strand.
+	*/
+	class YUNI_DECL Strand final
+		: public IIntrusiveSmartPtr<Strand, false>
+		, public NonCopyable<Strand>
+	{
+	public:
+		//! Ancestor
+		typedef IIntrusiveSmartPtr<Strand, false>  Ancestor;
+		//! The most suitable smart pointer for the class
+		typedef Ancestor::SmartPtrType<Strand>::PtrThreadSafe Ptr;
+		//! The threading policy
+		typedef Ancestor::ThreadingPolicy ThreadingPolicy;
+
+		enum
+		{
+			//! Number of jobs executed in a row before giving the worker back to the queue
+			batchSize = 32,
+		};
+
+	public:
+		//! \name Constructor & Destructor
+		//@{
+		/*!
+		** \brief Constructor
+		**
+		** \param queueservice The queueservice executing the jobs
+		** \param priority Priority of the jobs within the queueservice
+		*/
+		explicit Strand(QueueService& queueservice, Priority priority = Priority::normal);
+		//! Destructor
+		~Strand();
+		//@}
+
+
+		//! \name Jobs
+		//@{
+		/*!
+		** \brief Add a job (from any thread)
+		**
+		** The job will be executed after all the jobs previously added.
+		** \param job The job to add
+		*/
+		void add(const IJob::Ptr& job);
+
+		//! Get if no job is pending or running (approximation)
+		bool idle() const;
+
+		//! Get the number of jobs pending or running (approximation)
+		uint pendingJobsCount() const;
+
+		//! Get the queueservice
+		QueueService& queueservice() const;
+		//@}
+
+
+		//! \name Operators
+		//@{
+		//! Add a job
+		Strand& operator += (IJob* job);
+		//! Add a job
+		Strand& operator << (IJob* job);
+		//! Add a job
+		Strand& operator += (const IJob::Ptr& job);
+		//! Add a job
+		Strand& operator << (const IJob::Ptr& job);
+		//@}
+
+
+	private:
+		//! A pending job
+		struct Node final
+		{
+			static void* operator new(size_t size);
+			static void operator delete(void* pointer);
+
+			//! The next node
+			std::atomic<Node*> next {nullptr};
+			//! The job
+			IJob::Ptr job;
+		};
+		//! Job of the queueservice executing the jobs of the strand
+		class Runner;
+
+		//! Push a node (any thread)
+		void push(Node* node);
+		//! Pop the oldest node (consumer only), null if none or not linked yet
+		Node* pop();
+		//! Pop the oldest node, knowing that one is pending (consumer only)
+		Node* popPending();
+		//! Add a new runner to the queueservice
+		void schedule();
+		//! Execute some pending jobs (from the runner)
+		void run(Thread::IThread* thread);
+		//! Remove all pending jobs (runner destroyed without being executed)
+		void drop();
+
+	private:
+		//! The queueservice
+		QueueService& pQueueService;
+		//! Priority of the runners
+		const Priority pPriority;
+		//! Number of jobs pending or running
+		std::atomic<uint32_t> pPending {0};
+		//! The most recent node (producers)
+		alignas(64) std::atomic<Node*> pHead;
+		//! The oldest node (consumer)
+		alignas(64) Node* pTail;
+		//! Stub node, always in the queue when empty
+		Node pStub;
+
+	}; // class Strand
+
+
+
+
+	/*!
+	** \brief Strands keyed by an id (user, session, connection...)
+	**
+	** All jobs added with the same key are executed in order and never concurrently,
+	** jobs with different keys run in parallel.
+	**
+	** \code
+	** Job::Strands<uint64> strands(queueservice);
+	** strands.add(userID, new UpdateProfileJob(userID));
+	** strands.add(userID, new SendNotificationJob(userID)); // after UpdateProfileJob
+	** \endcode
+	**
+	** A strand is created on demand for each key, in a sharded map (short lock on
+	** the shard of the key). Idle strands are removed from time to time, thus
+	** the number of keys is not bounded.
+	**
+	** \tparam KeyT Type of the keys
+	** \tparam HashT Hash of the keys
+	*/
+	template<class KeyT, class HashT = std::hash<KeyT>>
+	class Strands final : public NonCopyable<Strands<KeyT, HashT>>
+	{
+	public:
+		enum
+		{
+			//! Number of shards (power of 2)
+			shardCount = 16,
+			//! Number of strands of a shard before looking for idle strands
+			sweepThreshold = 64,
+		};
+
+	public:
+		//! \name Constructor & Destructor
+		//@{
+		/*!
+		** \brief Constructor
+		**
+		** \param queueservice The queueservice executing the jobs
+		** \param priority Priority of the jobs within the queueservice
+		*/
+		explicit Strands(QueueService& queueservice, Priority priority = Priority::normal);
+		//! Destructor (the pending jobs are still executed)
+		~Strands() = default;
+		//@}
+
+
+		//! \name Jobs
+		//@{
+		/*!
+		** \brief Add a job for a given key (from any thread)
+		**
+		** \param key The key
+		** \param job The job to add
+		*/
+		void add(const KeyT& key, const IJob::Ptr& job);
+
+		//! Get the number of strands currently allocated (approximation)
+		uint size() const;
+		//@}
+
+
+	private:
+		//! Strands of a shard
+		struct Shard final
+		{
+			//! Mutex
+			Mutex mutex;
+			//! All strands of the shard
+			std::unordered_map<KeyT, Strand::Ptr, HashT> strands;
+			//! Number of strands before looking for idle strands
+			size_t sweepAt = sweepThreshold;
+		};
+
+		//! Remove idle strands from a shard
+		static void SweepWL(Shard& shard);
+
+	private:
+		//! The queueservice
+		QueueService& pQueueService;
+		//! Priority of the jobs
+		const Priority pPriority;
+		//! Hash of the keys
+		HashT pHash;
+		//! All shards
+		std::unique_ptr<Shard[]> pShards;
+
+	}; // class Strands
+
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
+
+#include "strand.hxx"
@@ -0,0 +1,133 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "strand.h"
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	inline bool Strand::idle() const
+	{
+		return 0 == pPending.load(std::memory_order_acquire);
+	}
+
+
+	inline uint Strand::pendingJobsCount() const
+	{
+		return static_cast<uint>(pPending.load(std::memory_order_relaxed));
+	}
+
+
+	inline QueueService& Strand::queueservice() const
+	{
+		return pQueueService;
+	}
+
+
+	inline Strand& Strand::operator += (IJob* job)
+	{
+		add(job);
+		return *this;
+	}
+
+
+	inline Strand& Strand::operator << (IJob* job)
+	{
+		add(job);
+		return *this;
+	}
+
+
+	inline Strand& Strand::operator += (const IJob::Ptr& job)
+	{
+		add(job);
+		return *this;
+	}
+
+
+	inline Strand& Strand::operator << (const IJob::Ptr& job)
+	{
+		add(job);
+		return *this;
+	}
+
+
+
+
+	template<class KeyT, class HashT>
+	inline Strands<KeyT, HashT>::Strands(QueueService& queueservice, Priority priority)
+		: pQueueService(queueservice)
+		, pPriority(priority)
+		, pShards(new Shard[shardCount])
+	{}
+
+
+	template<class KeyT, class HashT>
+	void Strands<KeyT, HashT>::add(const KeyT& key, const IJob::Ptr& job)
+	{
+		Shard& shard = pShards[pHash(key) & (shardCount - 1)];
+		MutexLocker locker(shard.mutex);
+		auto it = shard.strands.find(key);
+		if (it == shard.strands.end())
+		{
+			if (shard.strands.size() >= shard.sweepAt)
+			{
+				SweepWL(shard);
+				// amortized: the next sweep once the shard has doubled
+				size_t count = shard.strands.size() * 2;
+				const size_t threshold = sweepThreshold;
+				shard.sweepAt = (count > threshold) ? count : threshold;
+			}
+			it = shard.strands.emplace(key, new Strand(pQueueService, pPriority)).first;
+		}
+		// the strand can not be removed meanwhile (the job is pushed with the lock)
+		it->second->add(job);
+	}
+
+
+	template<class KeyT, class HashT>
+	void Strands<KeyT, HashT>::SweepWL(Shard& shard)
+	{
+		// a strand can only be reached from here, thus an idle strand will remain
+		// idle as long as the lock is held
+		auto end = shard.strands.end();
+		for (auto i = shard.strands.begin(); i != end; )
+		{
+			if (i->second->idle())
+				i = shard.strands.erase(i);
+			else
+				++i;
+		}
+	}
+
+
+	template<class KeyT, class HashT>
+	uint Strands<KeyT, HashT>::size() const
+	{
+		uint count = 0;
+		for (uint i = 0; i != shardCount; ++i)
+		{
+			MutexLocker locker(pShards[i].mutex);
+			count += static_cast<uint>(pShards[i].strands.size());
+		}
+		return count;
+	}
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
@@ -210,11 +210,19 @@ namespace Job
 			pSignalTaskStopped.reset();
 			pJobsDoneCount = 0;
 
-			for (uint i = 0; i != (uint) pJobs.size(); ++i)
-			{
-				ITaskgroupJob* job = pJobs[i];
+			for (auto* job: pJobs)
 				job->taskgroup = this;
-				job->queueservice.add(job);
+
+			// adding the jobs by batch (most of the time, all jobs share the same queueservice)
+			auto first = pJobs.begin();
+			while (first != pJobs.end())
+			{
+				QueueService& queueservice = (*first)->queueservice;
+				auto last = first + 1;
+				while (last != pJobs.end() and &((*last)->queueservice) == &queueservice)
+					++last;
+				queueservice.push(first, last, Priority::normal);
+				first = last;
 			}
 		}
 		else
@@ -284,7 +292,40 @@ namespace Job
 			job->taskgroup = this;
 		}
 
-		queueservice.add(job);
+		queueservice.push(job, Priority::normal);
+	}
+
+
+	void Taskgroup::add(QueueService& queueservice, const std::vector<Bind<bool (IJob&)>>& callbacks)
+	{
+		if (callbacks.empty())
+			return;
+
+		ThreadingPolicy::MutexLocker locker(*this);
+		// register the new jobs
+		auto offset = pJobs.size();
+		pJobs.reserve(offset + callbacks.size());
+		for (auto& callback: callbacks)
+		{
+			ITaskgroupJob* job = new TaskgroupJobCallback(queueservice, callback);
+			job->addRef();
+			pJobs.push_back(job);
+		}
+
+		// get if the jobs should be automatically added to the queue
+		if (not pTaskHasStarted)
+		{
+			// if the task is not running, starting it as if the user did it itself
+			if (pAutostart)
+				startWL();
+			return;
+		}
+
+		auto first = pJobs.begin() + static_cast<std::ptrdiff_t>(offset);
+		for (auto it = first; it != pJobs.end(); ++it)
+			(*it)->taskgroup = this;
+		// the lock must be kept: the list may be cleared as soon as all jobs are terminated
+		queueservice.push(first, pJobs.end(), Priority::normal);
 	}
 
 
@@ -329,6 +370,18 @@ namespace Job
 	}
 
 
+	bool Taskgroup::wait(Thread::Signal::Waiter& waiter)
+	{
+		// checking if not already stopped
+		{
+			ThreadingPolicy::MutexLocker locker(*this);
+			if (not pTaskHasStarted)
+				return false;
+		}
+		return pSignalTaskStopped.wait(waiter);
+	}
+
+
 	Taskgroup::Status Taskgroup::status(uint* jobCount, uint* doneCount) const
 	{
 		ThreadingPolicy::MutexLocker locker(*this);
@@ -15,6 +15,7 @@
 #include "../core/noncopyable.h"
 #include "../core/smartptr/intrusive.h"
 #include "../thread/signal.h"
+#include <vector>
 
 
 
@@ -136,6 +137,14 @@ namespace Job
 		*/
 		Status wait(uint timeout);
 
+		/*!
+		** \brief Wait for the task being complete, without blocking the calling thread
+		**
+		** `waiter.signalled()` will be called once the task is complete (see `status()`).
+		** \return False if the task is not running (the waiter is then not registered)
+		*/
+		bool wait(Thread::Signal::Waiter& waiter);
+
 		/*!
 		** \brief Get the current status of the task and Fetch various information in the same time
 		**
@@ -180,6 +189,25 @@ namespace Job
 		** \param callback A functor / lambda
 		*/
 		void add(QueueService& queueservice, const Bind<bool (IJob&)>& callback);
+
+		/*!
+		** \brief Add several jobs at once in the task
+		**
+		** The jobs will be added to the default queueservice (with a single lock
+		** acquisition) immediatly if the taskgroup is running
+		** \param callbacks Functors / lambdas
+		*/
+		void add(const std::vector<Bind<bool (IJob&)>>& callbacks);
+
+		/*!
+		** \brief Add several jobs at once in the task
+		**
+		** The jobs will be added to the queueservice (with a single lock acquisition)
+		** immediatly if the taskgroup is running
+		** \param queueservice Any queueservice can be used.
+		** \param callbacks Functors / lambdas
+		*/
+		void add(QueueService& queueservice, const std::vector<Bind<bool (IJob&)>>& callbacks);
 		//@}
 
 
@@ -26,6 +26,12 @@ namespace Job
 	}
 
 
+	inline void Taskgroup::add(const std::vector<Bind<bool (IJob&)>>& callbacks)
+	{
+		add(pDefaultQueueservice, callbacks);
+	}
+
+
 	inline Taskgroup& Taskgroup::operator += (const Bind<bool (IJob&)>& callback)
 	{
 		add(pDefaultQueueservice, callback);
@@ -0,0 +1,348 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "service.h"
+#include "../queue/service.h"
+#include "../../thread/utility.h"
+#include "../../private/jobs/pool.h"
+#include "../../private/jobs/queue/statistics.h"
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	namespace // anonymous
+	{
+
+		//! Longest sleep of the thread (in milliseconds), the timers being checked at least at this rate
+		constexpr static uint64_t maxSleep = 60 * 1000;
+
+	} // anonymous namespace
+
+
+
+	/*!
+	** \brief Job of a periodic timer, created for each execution
+	**
+	** It holds a reference to its timer while dispatched, and schedules its next
+	** execution once the callback is done.
+	*/
+	class TimerService::PeriodicJob final : public IJob
+	{
+	public:
+		//! Allocation from the job pool
+		static void* operator new(size_t size)
+		{
+			return Yuni::Private::Jobs::JobPool::Allocate(size);
+		}
+
+		//! Release to the job pool
+		static void operator delete(void* pointer)
+		{
+			Yuni::Private::Jobs::JobPool::Release(pointer);
+		}
+
+	public:
+		explicit PeriodicJob(Timer& timer)
+			: pTimer(&timer)
+		{}
+
+		virtual ~PeriodicJob()
+		{
+			// removed from the queue without being executed, or the callback has thrown
+			if (!(!pTimer))
+				pTimer->pService.rearm(*pTimer, false);
+		}
+
+	protected:
+		virtual void onExecute() override
+		{
+			Timer::Ptr timer = pTimer;
+			bool again = timer->pCallback();
+			pTimer = nullptr;
+			timer->pService.rearm(*timer, again);
+		}
+
+	private:
+		//! The timer (null once executed)
+		Timer::Ptr pTimer;
+
+	}; // class TimerService::PeriodicJob
+
+
+
+
+	TimerService::Timer::Timer(TimerService& service, QueueService& queueservice, Priority priority, uint interval)
+		: pService(service)
+		, pQueueService(&queueservice)
+		, pPriority(priority)
+		, pInterval(interval)
+	{}
+
+
+	TimerService::Timer::~Timer()
+	{
+		assert(not linked and "a timer can not be destroyed while scheduled");
+	}
+
+
+	bool TimerService::Timer::pending() const
+	{
+		MutexLocker locker(pService.pMutex);
+		return not pTerminated;
+	}
+
+
+	inline void TimerService::Timer::terminateWL()
+	{
+		// the job itself (if not dispatched) is released with the timer, never
+		// with the lock of the service (its destructor may use the service)
+		pTerminated = true;
+	}
+
+
+
+
+	TimerService& TimerService::Instance()
+	{
+		// never destroyed, thus available to the queueservices destroyed at exit
+		static TimerService* instance = new TimerService();
+		return *instance;
+	}
+
+
+	uint64_t TimerService::Now()
+	{
+		return Yuni::Private::QueueService::MonotonicTime() / 1000000u;
+	}
+
+
+	TimerService::TimerService()
+		: pWheel(Now())
+	{}
+
+
+	TimerService::~TimerService()
+	{
+		std::unique_ptr<Thread::IThread> thread;
+		std::vector<Timer::Ptr> released;
+		{
+			MutexLocker locker(pMutex);
+			pStopping = true;
+			thread = std::move(pThread);
+			pWheel.each([&](Yuni::Private::Jobs::TimerWheelNode& node)
+			{
+				released.emplace_back(static_cast<Timer*>(&node));
+			});
+			for (auto& timer: released)
+			{
+				pWheel.remove(*timer);
+				timer->terminateWL();
+				timer->release(); // reference of the wheel
+			}
+		}
+		if (thread)
+		{
+			pWakeUp.notify();
+			thread->stop();
+		}
+	}
+
+
+	void TimerService::startWL()
+	{
+		if (not pThread and not pStopping)
+			pThread = spawn([this]() { run(); });
+	}
+
+
+	void TimerService::run()
+	{
+		do
+		{
+			uint64_t delay;
+			{
+				std::vector<Timer::Ptr> released;
+				MutexLocker locker(pMutex);
+				if (pStopping)
+					return;
+				pWakeUp.reset();
+				advanceWL(released);
+				pNextWakeUp = pWheel.nextEvent();
+				delay = (pNextWakeUp != Yuni::Private::Jobs::TimerWheel::noEvent)
+					? (pNextWakeUp - pWheel.now()) : maxSleep;
+				if (delay > maxSleep)
+					delay = maxSleep;
+			}
+			pWakeUp.wait(static_cast<uint>(delay));
+		}
+		while (true);
+	}
+
+
+	void TimerService::advanceWL(std::vector<Timer::Ptr>& released)
+	{
+		pWheel.advance(Now(), [&](Yuni::Private::Jobs::TimerWheelNode& node)
+		{
+			Timer& timer = static_cast<Timer&>(node);
+			// the reference of the wheel, released once unlocked
+			released.emplace_back(&timer);
+			timer.release();
+			dispatchWL(timer);
+		});
+	}
+
+
+	void TimerService::dispatchWL(Timer& timer)
+	{
+		if (timer.pTerminated)
+			return;
+		if (timer.pInterval == 0)
+		{
+			// the queueservice will hold the last reference
+			IJob::Ptr job = timer.pJob;
+			timer.pJob = nullptr;
+			timer.terminateWL();
+			timer.pQueueService->push(job, timer.pPriority);
+		}
+		else
+			timer.pQueueService->push(new PeriodicJob(timer), timer.pPriority);
+	}
+
+
+	void TimerService::scheduleWL(Timer& timer, uint64_t deadline, std::vector<Timer::Ptr>& released)
+	{
+		// the wheel must be up to date to know if the deadline has already been reached
+		advanceWL(released);
+		timer.expires = deadline;
+		if (deadline <= pWheel.now())
+		{
+			dispatchWL(timer);
+			return;
+		}
+
+		pWheel.insert(timer);
+		timer.addRef(); // reference of the wheel
+		if (timer.expires < pNextWakeUp)
+		{
+			// the thread is sleeping for too long
+			pNextWakeUp = timer.expires;
+			pWakeUp.notify();
+		}
+		startWL();
+	}
+
+
+	TimerService::Timer::Ptr TimerService::addAt(QueueService& queueservice, const IJob::Ptr& job,
+		uint64_t deadline, Priority priority)
+	{
+		assert(!(!job) and "invalid job");
+		Timer::Ptr timer = new Timer(*this, queueservice, priority, 0);
+		timer->pJob = job;
+
+		std::vector<Timer::Ptr> released;
+		MutexLocker locker(pMutex);
+		if (not pStopping)
+			scheduleWL(*timer, deadline, released);
+		else
+			timer->terminateWL();
+		return timer;
+	}
+
+
+	TimerService::Timer::Ptr TimerService::every(QueueService& queueservice, uint interval,
+		const Bind<bool ()>& callback, Priority priority)
+	{
+		assert(interval != 0 and "invalid interval");
+		if (interval == 0)
+			interval = 1;
+		Timer::Ptr timer = new Timer(*this, queueservice, priority, interval);
+		timer->pCallback = callback;
+
+		std::vector<Timer::Ptr> released;
+		MutexLocker locker(pMutex);
+		if (not pStopping)
+			scheduleWL(*timer, Now() + interval, released);
+		else
+			timer->terminateWL();
+		return timer;
+	}
+
+
+	void TimerService::rearm(Timer& timer, bool again)
+	{
+		std::vector<Timer::Ptr> released;
+		MutexLocker locker(pMutex);
+		if (timer.pTerminated)
+			return;
+		if (not again or pStopping)
+		{
+			timer.terminateWL();
+			return;
+		}
+
+		// the next deadline, from the previous one (without drifting) unless late
+		advanceWL(released);
+		uint64_t deadline = timer.expires + timer.pInterval;
+		if (deadline <= pWheel.now())
+			deadline = pWheel.now() + timer.pInterval;
+		scheduleWL(timer, deadline, released);
+	}
+
+
+	void TimerService::cancel(Timer& timer)
+	{
+		std::vector<Timer::Ptr> released;
+		MutexLocker locker(pMutex);
+		if (timer.linked)
+		{
+			pWheel.remove(timer);
+			released.emplace_back(&timer);
+			timer.release(); // reference of the wheel
+		}
+		timer.terminateWL();
+	}
+
+
+	void TimerService::cancel(const QueueService& queueservice)
+	{
+		std::vector<Timer::Ptr> released;
+		MutexLocker locker(pMutex);
+		pWheel.each([&](Yuni::Private::Jobs::TimerWheelNode& node)
+		{
+			Timer& timer = static_cast<Timer&>(node);
+			if (timer.pQueueService == &queueservice)
+				released.emplace_back(&timer);
+		});
+		for (auto& timer: released)
+		{
+			pWheel.remove(*timer);
+			timer->terminateWL();
+			timer->release(); // reference of the wheel
+		}
+	}
+
+
+	uint TimerService::size() const
+	{
+		MutexLocker locker(pMutex);
+		return static_cast<uint>(pWheel.size());
+	}
+
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
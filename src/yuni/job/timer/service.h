@@ -0,0 +1,246 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include "../job.h"
+#include "../../core/bind.h"
+#include "../../core/noncopyable.h"
+#include "../../core/smartptr/intrusive.h"
+#include "../../thread/signal.h"
+#include "../../private/jobs/timerwheel.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	// Forward declaration
+	class QueueService;
+
+
+	/*!
+	** \brief Timers dispatching jobs to queueservices
+	**
+	** All timers are stored in a hierarchical timing wheel (1ms per tick) driven by
+	** a single thread, which only dispatches the jobs to their queueservice once
+	** due: the jobs themselves are executed by the workers of the queueservice.
+	** Thus thousands of timers only cost a single (mostly sleeping) thread.
+	**
+	** Most of the time, the timers are created from the queueservice itself:
+	** \code
+	** Job::QueueService queueservice;
+	** queueservice.start();
+	**
+	** // a single execution, in 500ms
+	** queueservice.add(job, std::chrono::milliseconds(500));
+	**
+	** // every second
+	** auto timer = every(queueservice, 1000, [&]() -> bool {
+	**	std::cout << "tick" << std::endl;
+	**	return true; // continue
+	** });
+	** ...
+	** timer->cancel();
+	** \endcode
+	**
+	** Delays longer than ~2 years are clamped.
+	*/
+	class YUNI_DECL TimerService final : private NonCopyable<TimerService>
+	{
+		//! Job of a periodic timer
+		class PeriodicJob;
+
+	public:
+		/*!
+		** \brief A single timer
+		**
+		** The timer remains scheduled until it is canceled, even if the smart
+		** pointer is released. A periodic timer is stopped as well when its job
+		** is removed from the queue without being executed (`QueueService::clear()`).
+		*/
+		class YUNI_DECL Timer final
+			: public IIntrusiveSmartPtr<Timer, false>
+			, private NonCopyable<Timer>
+			, private Yuni::Private::Jobs::TimerWheelNode
+		{
+		public:
+			//! Ancestor
+			typedef IIntrusiveSmartPtr<Timer, false>  Ancestor;
+			//! The most suitable smart pointer for the class
+			typedef Ancestor::SmartPtrType<Timer>::PtrThreadSafe Ptr;
+
+		public:
+			//! Destructor
+			~Timer();
+
+			/*!
+			** \brief Cancel the timer
+			**
+			** A job already dispatched to its queueservice is not canceled, but a
+			** periodic timer will not be dispatched again.
+			*/
+			void cancel();
+
+			//! Get if the timer is still scheduled (or running, for a periodic timer)
+			bool pending() const;
+
+			//! Get the interval of a periodic timer (in milliseconds, 0 for a single execution)
+			uint interval() const;
+
+		private:
+			Timer(TimerService& service, QueueService& queueservice, Priority priority, uint interval);
+			//! Set as not pending anymore (with the lock of the service)
+			void terminateWL();
+
+		private:
+			//! The owner
+			TimerService& pService;
+			//! The queueservice where to dispatch the job
+			QueueService* pQueueService;
+			//! The job to dispatch (single execution)
+			IJob::Ptr pJob;
+			//! The callback (periodic timer)
+			Bind<bool ()> pCallback;
+			//! Priority of the job
+			const Priority pPriority;
+			//! Interval in milliseconds (0 for a single execution)
+			const uint pInterval;
+			//! Flag to know if the timer will never be dispatched again [protected by the mutex of the service]
+			bool pTerminated = false;
+
+			// Nakama !
+			friend class TimerService;
+			friend class TimerService::PeriodicJob;
+
+		}; // class Timer
+
+
+	public:
+		/*!
+		** \brief Get the timer service shared by all queueservices
+		**
+		** Its thread is only created when the first timer is added.
+		*/
+		static TimerService& Instance();
+
+
+	public:
+		//! \name Constructor & Destructor
+		//@{
+		//! Default constructor
+		TimerService();
+		/*!
+		** \brief Destructor
+		**
+		** All timers are canceled. The periodic jobs already dispatched must have
+		** been executed (or removed from their queue).
+		*/
+		~TimerService();
+		//@}
+
+
+		//! \name Timers
+		//@{
+		/*!
+		** \brief Dispatch a job to a queueservice after a delay
+		**
+		** \param queueservice The queueservice where to dispatch the job
+		** \param job The job
+		** \param delay The delay, in milliseconds (0 to dispatch the job right now)
+		** \param priority Its priority execution
+		*/
+		Timer::Ptr add(QueueService& queueservice, const IJob::Ptr& job, uint64_t delay,
+			Priority priority = Priority::normal);
+
+		/*!
+		** \brief Dispatch a job to a queueservice at a given time
+		**
+		** \param queueservice The queueservice where to dispatch the job
+		** \param job The job
+		** \param deadline The deadline, in milliseconds since an arbitrary point of
+		**   time (see `Now()`). A deadline in the past dispatches the job right now.
+		** \param priority Its priority execution
+		*/
+		Timer::Ptr addAt(QueueService& queueservice, const IJob::Ptr& job, uint64_t deadline,
+			Priority priority = Priority::normal);
+
+		/*!
+		** \brief Execute a callback every X milliseconds, as a job of a queueservice
+		**
+		** The callback is never executed concurrently with itself: the next execution
+		** is scheduled once the previous one is finished, without trying to catch
+		** up with the executions which would have been missed.
+		**
+		** \param queueservice The queueservice where to dispatch the job
+		** \param interval The interval, in milliseconds (must not be null)
+		** \param callback The callback (return false to stop the timer)
+		** \param priority Its priority execution
+		*/
+		Timer::Ptr every(QueueService& queueservice, uint interval, const Bind<bool ()>& callback,
+			Priority priority = Priority::normal);
+
+		//! Cancel all timers dispatching jobs to a given queueservice
+		void cancel(const QueueService& queueservice);
+
+		//! Get the number of scheduled timers
+		uint size() const;
+
+		//! Get the current time of the timers (in milliseconds, monotonic)
+		static uint64_t Now();
+		//@}
+
+
+	private:
+		//! Schedule a timer (it must not be in the wheel)
+		void scheduleWL(Timer& timer, uint64_t deadline, std::vector<Timer::Ptr>& released);
+		//! Dispatch the job of an expired timer
+		void dispatchWL(Timer& timer);
+		//! Move the time forward, dispatching the jobs of all timers expired
+		void advanceWL(std::vector<Timer::Ptr>& released);
+		//! Start the thread if not already done
+		void startWL();
+		//! The periodic job of a timer has been executed (or removed from the queue)
+		void rearm(Timer& timer, bool again);
+		//! Loop of the thread
+		void run();
+		//! Cancel a timer
+		void cancel(Timer& timer);
+
+	private:
+		//! The timing wheel
+		Yuni::Private::Jobs::TimerWheel pWheel;
+		//! Mutex
+		mutable Mutex pMutex;
+		//! Signal for waking up the thread (when a timer expires sooner than expected)
+		Thread::Signal pWakeUp;
+		//! Next wake up of the thread [protected by the mutex]
+		uint64_t pNextWakeUp = Yuni::Private::Jobs::TimerWheel::noEvent;
+		//! The thread [protected by the mutex]
+		std::unique_ptr<Thread::IThread> pThread;
+		//! Flag to stop the thread [protected by the mutex]
+		bool pStopping = false;
+
+	}; // class TimerService
+
+
+
+
+
+
+} // namespace Job
+} // namespace Yuni
+
+#include "service.hxx"
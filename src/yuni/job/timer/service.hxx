@@ -0,0 +1,43 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "service.h"
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	inline uint TimerService::Timer::interval() const
+	{
+		return pInterval;
+	}
+
+
+	inline void TimerService::Timer::cancel()
+	{
+		pService.cancel(*this);
+	}
+
+
+	inline TimerService::Timer::Ptr TimerService::add(QueueService& queueservice, const IJob::Ptr& job,
+		uint64_t delay, Priority priority)
+	{
+		return addAt(queueservice, job, Now() + delay, priority);
+	}
+
+
+
+
+} // namespace Job
+} // namespace Yuni
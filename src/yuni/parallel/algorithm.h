@@ -0,0 +1,149 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../yuni.h"
+#include "../job/queue/service.h"
+#include <functional>
+#include <cstddef>
+
+
+
+namespace Yuni
+{
+/*!
+** \brief Data-parallel algorithms on top of a queueservice
+**
+** All algorithms work on random-access ranges and split them into chunks,
+** executed by some helper jobs dispatched to the given queueservice. The calling
+** thread takes part to the work as well (it does not only wait), thus these
+** algorithms may safely be called from a job of the same queueservice and
+** still work (sequentially) if the queueservice is not started.
+**
+** The chunks get smaller as the work runs out (guided scheduling), so the load
+** remains balanced even when the cost of the items is uneven. The parameter
+** `grain` is the minimum size of a chunk (0 for automatic).
+**
+** \code
+** Job::QueueService queueservice;
+** queueservice.start();
+**
+** std::vector<double> values(1000000);
+** Parallel::For(queueservice, 0u, (uint) values.size(), [&](uint i) {
+**	values[i] = std::sqrt((double) i);
+** });
+** double sum = Parallel::Reduce(queueservice, values.begin(), values.end(), 0., std::plus<double>());
+** \endcode
+*/
+namespace Parallel
+{
+
+	/*!
+	** \brief Call `callback(i)` for each index in [from, to)
+	**
+	** \param queueservice The queueservice where to dispatch the helper jobs
+	** \param from The first index
+	** \param to The last index (excluded)
+	** \param callback A functor / lambda `void (IndexT)`
+	** \param grain The minimum number of indexes per chunk (0 for automatic)
+	*/
+	template<class IndexT, class CallbackT>
+	void For(Job::QueueService& queueservice, IndexT from, IndexT to, const CallbackT& callback, size_t grain = 0);
+
+
+	/*!
+	** \brief Call `callback(item)` for each item in [first, last)
+	**
+	** \param queueservice The queueservice where to dispatch the helper jobs
+	** \param first Random-access iterator to the first item
+	** \param last Random-access iterator past the last item
+	** \param callback A functor / lambda `void (T&)`
+	** \param grain The minimum number of items per chunk (0 for automatic)
+	*/
+	template<class IteratorT, class CallbackT>
+	void ForEach(Job::QueueService& queueservice, IteratorT first, IteratorT last, const CallbackT& callback, size_t grain = 0);
+
+
+	/*!
+	** \brief Reduce [first, last) with a binary operation
+	**
+	** The operation must be associative and commutative: the items are combined
+	** in an unspecified order.
+	**
+	** \param queueservice The queueservice where to dispatch the helper jobs
+	** \param first Random-access iterator to the first item
+	** \param last Random-access iterator past the last item
+	** \param init The initial value
+	** \param operation A functor / lambda `T (const T&, const T&)`
+	** \param grain The minimum number of items per chunk (0 for automatic)
+	** \return The result of the reduction (`init` if the range is empty)
+	*/
+	template<class IteratorT, class T, class OperationT = std::plus<T>>
+	T Reduce(Job::QueueService& queueservice, IteratorT first, IteratorT last, T init,
+		const OperationT& operation = OperationT(), size_t grain = 0);
+
+
+	/*!
+	** \brief Store `callback(item)` into `out` for each item in [first, last)
+	**
+	** \param queueservice The queueservice where to dispatch the helper jobs
+	** \param first Random-access iterator to the first item
+	** \param last Random-access iterator past the last item
+	** \param out Random-access iterator to the first output item (can be `first`)
+	** \param callback A functor / lambda `U (const T&)`
+	** \param grain The minimum number of items per chunk (0 for automatic)
+	** \return Iterator past the last output item
+	*/
+	template<class IteratorT, class OutputT, class CallbackT>
+	OutputT Transform(Job::QueueService& queueservice, IteratorT first, IteratorT last, OutputT out,
+		const CallbackT& callback, size_t grain = 0);
+
+
+	/*!
+	** \brief Sort [first, last)
+	**
+	** The range is split into blocks sorted in parallel, then merged two by two,
+	** each round of merges being parallel as well. As `std::sort`, the sort is not stable.
+	**
+	** \param queueservice The queueservice where to dispatch the helper jobs
+	** \param first Random-access iterator to the first item
+	** \param last Random-access iterator past the last item
+	** \param compare A functor / lambda `bool (const T&, const T&)`
+	*/
+	template<class IteratorT, class CompareT = std::less<>>
+	void Sort(Job::QueueService& queueservice, IteratorT first, IteratorT last, const CompareT& compare = CompareT());
+
+
+	/*!
+	** \brief Inclusive prefix sum of [first, last) into `out`
+	**
+	** `out[i]` will be `first[0] op first[1] op ... op first[i]`. The operation
+	** must be associative. The range is split into blocks: the total of each block is
+	** computed in parallel, then the blocks are scanned in parallel from their offsets.
+	**
+	** \param queueservice The queueservice where to dispatch the helper jobs
+	** \param first Random-access iterator to the first item
+	** \param last Random-access iterator past the last item
+	** \param out Random-access iterator to the first output item (can be `first`)
+	** \param operation A functor / lambda `T (const T&, const T&)`
+	** \return Iterator past the last output item
+	*/
+	template<class IteratorT, class OutputT, class OperationT = std::plus<>>
+	OutputT InclusiveScan(Job::QueueService& queueservice, IteratorT first, IteratorT last, OutputT out,
+		const OperationT& operation = OperationT());
+
+
+
+
+
+} // namespace Parallel
+} // namespace Yuni
+
+#include "algorithm.hxx"
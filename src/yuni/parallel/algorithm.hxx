@@ -0,0 +1,268 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "algorithm.h"
+#include "../private/parallel/partitioner.h"
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <mutex>
+#include <memory>
+#include <utility>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Parallel
+{
+
+	//! Below this number of items, sorting or scanning is sequential
+	constexpr static size_t sequentialThreshold = 4096;
+
+	//! Local data of participants which do not need any
+	inline bool NoLocalData()
+	{
+		return false;
+	}
+
+	//! Nothing to do once a participant has terminated
+	inline void NoFinalize(bool)
+	{}
+
+
+	//! Bounds of the block `index` when splitting `count` items into `blocks` blocks
+	inline size_t BlockBound(size_t count, size_t blocks, size_t index)
+	{
+		// no overflow as long as count * blocks fits in 64 bits
+		return static_cast<size_t>((static_cast<uint64_t>(count) * index) / blocks);
+	}
+
+
+} // namespace Parallel
+} // namespace Private
+} // namespace Yuni
+
+
+
+
+namespace Yuni
+{
+namespace Parallel
+{
+
+	template<class IndexT, class CallbackT>
+	void For(Job::QueueService& queueservice, IndexT from, IndexT to, const CallbackT& callback, size_t grain)
+	{
+		if (not (from < to))
+			return;
+		size_t count = static_cast<size_t>(to - from);
+		Private::Parallel::Run(queueservice, count, grain, Private::Parallel::NoLocalData,
+			[&](bool, size_t begin, size_t end)
+			{
+				for (size_t i = begin; i != end; ++i)
+					callback(static_cast<IndexT>(from + static_cast<IndexT>(i)));
+			},
+			Private::Parallel::NoFinalize);
+	}
+
+
+	template<class IteratorT, class CallbackT>
+	void ForEach(Job::QueueService& queueservice, IteratorT first, IteratorT last, const CallbackT& callback, size_t grain)
+	{
+		auto distance = std::distance(first, last);
+		if (distance <= 0)
+			return;
+		Private::Parallel::Run(queueservice, static_cast<size_t>(distance), grain, Private::Parallel::NoLocalData,
+			[&](bool, size_t begin, size_t end)
+			{
+				IteratorT it = first + static_cast<decltype(distance)>(begin);
+				IteratorT itEnd = first + static_cast<decltype(distance)>(end);
+				for (; it != itEnd; ++it)
+					callback(*it);
+			},
+			Private::Parallel::NoFinalize);
+	}
+
+
+	template<class IteratorT, class T, class OperationT>
+	T Reduce(Job::QueueService& queueservice, IteratorT first, IteratorT last, T init,
+		const OperationT& operation, size_t grain)
+	{
+		auto distance = std::distance(first, last);
+		if (distance <= 0)
+			return init;
+
+		// partial results of all participants
+		std::optional<T> result;
+		std::mutex mutex;
+
+		Private::Parallel::Run(queueservice, static_cast<size_t>(distance), grain,
+			[]() { return std::optional<T>(); },
+			[&](std::optional<T>& local, size_t begin, size_t end)
+			{
+				IteratorT it = first + static_cast<decltype(distance)>(begin);
+				IteratorT itEnd = first + static_cast<decltype(distance)>(end);
+				if (not local)
+					local.emplace(*it++);
+				for (; it != itEnd; ++it)
+					*local = operation(*local, *it);
+			},
+			[&](std::optional<T>& local)
+			{
+				if (local)
+				{
+					std::lock_guard<std::mutex> locker(mutex);
+					if (result)
+						*result = operation(*result, *local);
+					else
+						result = std::move(local);
+				}
+			});
+
+		return (result) ? operation(init, *result) : init;
+	}
+
+
+	template<class IteratorT, class OutputT, class CallbackT>
+	OutputT Transform(Job::QueueService& queueservice, IteratorT first, IteratorT last, OutputT out,
+		const CallbackT& callback, size_t grain)
+	{
+		auto distance = std::distance(first, last);
+		if (distance <= 0)
+			return out;
+		Private::Parallel::Run(queueservice, static_cast<size_t>(distance), grain, Private::Parallel::NoLocalData,
+			[&](bool, size_t begin, size_t end)
+			{
+				for (size_t i = begin; i != end; ++i)
+				{
+					auto offset = static_cast<decltype(distance)>(i);
+					out[offset] = callback(first[offset]);
+				}
+			},
+			Private::Parallel::NoFinalize);
+		return out + distance;
+	}
+
+
+	template<class IteratorT, class CompareT>
+	void Sort(Job::QueueService& queueservice, IteratorT first, IteratorT last, const CompareT& compare)
+	{
+		auto distance = std::distance(first, last);
+		size_t count = (distance > 0) ? static_cast<size_t>(distance) : 0;
+		uint participants = Private::Parallel::Concurrency(queueservice);
+		if (participants == 1 or count < Private::Parallel::sequentialThreshold)
+		{
+			std::sort(first, last, compare);
+			return;
+		}
+
+		// number of blocks: a power of 2, about twice the number of participants
+		// for balancing the load, without too small blocks
+		size_t blocks = 2;
+		while (blocks < 2 * participants and count / (blocks * 2) >= Private::Parallel::sequentialThreshold / 4)
+			blocks *= 2;
+
+		auto at = [&](size_t block) -> IteratorT
+		{
+			return first + static_cast<decltype(distance)>(Private::Parallel::BlockBound(count, blocks, block));
+		};
+
+		For(queueservice, size_t(0), blocks, [&](size_t block)
+		{
+			std::sort(at(block), at(block + 1), compare);
+		}, 1);
+
+		// merging the sorted blocks two by two
+		for (size_t width = 1; width < blocks; width *= 2)
+		{
+			For(queueservice, size_t(0), blocks / (2 * width), [&](size_t pair)
+			{
+				size_t block = pair * 2 * width;
+				std::inplace_merge(at(block), at(block + width), at(block + 2 * width), compare);
+			}, 1);
+		}
+	}
+
+
+	template<class IteratorT, class OutputT, class OperationT>
+	OutputT InclusiveScan(Job::QueueService& queueservice, IteratorT first, IteratorT last, OutputT out,
+		const OperationT& operation)
+	{
+		typedef typename std::iterator_traits<IteratorT>::value_type T;
+		typedef decltype(std::distance(first, last)) DifferenceType;
+
+		auto distance = std::distance(first, last);
+		if (distance <= 0)
+			return out;
+		size_t count = static_cast<size_t>(distance);
+
+		// scan of the items [begin, end), starting from the given offset if any
+		auto scan = [&](size_t begin, size_t end, const T* offset)
+		{
+			auto i = static_cast<DifferenceType>(begin);
+			T accumulator = (offset) ? operation(*offset, first[i]) : T(first[i]);
+			out[i] = accumulator;
+			for (++i; i != static_cast<DifferenceType>(end); ++i)
+			{
+				accumulator = operation(accumulator, first[i]);
+				out[i] = accumulator;
+			}
+		};
+
+		uint participants = Private::Parallel::Concurrency(queueservice);
+		if (participants == 1 or count < Private::Parallel::sequentialThreshold)
+		{
+			scan(0, count, nullptr);
+			return out + distance;
+		}
+
+		size_t blocks = 4 * static_cast<size_t>(participants);
+		if (count / blocks < Private::Parallel::sequentialThreshold / 4)
+			blocks = count / (Private::Parallel::sequentialThreshold / 4);
+		auto bound = [&](size_t block) -> size_t
+		{
+			return Private::Parallel::BlockBound(count, blocks, block);
+		};
+
+		// 1. the total of each block (except the last one, not needed)
+		std::unique_ptr<std::optional<T>[]> offsets(new std::optional<T>[blocks]);
+		For(queueservice, size_t(1), blocks, [&](size_t block)
+		{
+			auto i = static_cast<DifferenceType>(bound(block - 1));
+			auto end = static_cast<DifferenceType>(bound(block));
+			T total = first[i];
+			for (++i; i != end; ++i)
+				total = operation(total, first[i]);
+			offsets[block].emplace(std::move(total));
+		}, 1);
+
+		// 2. the offset of each block, from the totals
+		for (size_t block = 2; block < blocks; ++block)
+			offsets[block] = operation(*offsets[block - 1], *offsets[block]);
+
+		// 3. scan of each block from its offset
+		For(queueservice, size_t(0), blocks, [&](size_t block)
+		{
+			scan(bound(block), bound(block + 1), (block != 0) ? &(*offsets[block]) : nullptr);
+		}, 1);
+
+		return out + distance;
+	}
+
+
+
+
+
+} // namespace Parallel
+} // namespace Yuni
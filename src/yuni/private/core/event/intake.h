@@ -0,0 +1,147 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include "../../../core/noncopyable.h"
+#include "../../jobs/pool.h"
+#include <atomic>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Core
+{
+namespace EventLoop
+{
+
+	/*!
+	** \brief Lock-free intake of the requests of an event loop (multiple producers, single consumer)
+	**
+	** The producers push their requests onto an intrusive stack, with a single CAS
+	** even for a batch of requests. The event loop takes all of them at once and
+	** restores their order of arrival. The nodes are allocated from the job pool,
+	** thus without any heap allocation in steady state.
+	*/
+	template<class RequestT>
+	class RequestIntake final : private NonCopyable<RequestIntake<RequestT> >
+	{
+	public:
+		//! A request
+		struct Node final
+		{
+			//! Allocation from the job pool
+			static void* operator new(size_t size)
+			{
+				return Yuni::Private::Jobs::JobPool::Allocate(size);
+			}
+
+			//! Release to the job pool
+			static void operator delete(void* pointer)
+			{
+				Yuni::Private::Jobs::JobPool::Release(pointer);
+			}
+
+			explicit Node(const RequestT& request)
+				: request(request)
+			{}
+
+			//! The request
+			RequestT request;
+			//! The next node
+			Node* next = nullptr;
+		};
+
+	public:
+		//! Default constructor
+		RequestIntake() = default;
+
+		//! Destructor (all pending requests are released)
+		~RequestIntake()
+		{
+			Release(takeAll());
+		}
+
+		//! Get if no request is pending
+		bool empty() const
+		{
+			return pHead.load(std::memory_order_relaxed) == nullptr;
+		}
+
+		/*!
+		** \brief Push a chain of requests (from any thread)
+		**
+		** \param newest The most recent request, the head of the chain
+		** \param oldest The oldest request, the tail of the chain (linked from the newest)
+		*/
+		void push(Node* newest, Node* oldest)
+		{
+			Node* head = pHead.load(std::memory_order_relaxed);
+			do
+			{
+				oldest->next = head;
+			}
+			while (not pHead.compare_exchange_weak(head, newest, std::memory_order_release,
+				std::memory_order_relaxed));
+		}
+
+		//! Push a single request (from any thread)
+		void push(Node* node)
+		{
+			push(node, node);
+		}
+
+		/*!
+		** \brief Take all pending requests, in their order of arrival (from the event loop only)
+		**
+		** \return The oldest request, null if none
+		*/
+		Node* takeAll()
+		{
+			Node* node = pHead.exchange(nullptr, std::memory_order_acquire);
+			Node* result = nullptr;
+			while (node)
+			{
+				Node* next = node->next;
+				node->next = result;
+				result = node;
+				node = next;
+			}
+			return result;
+		}
+
+		//! Release a list of requests
+		static void Release(Node* node)
+		{
+			while (node)
+			{
+				Node* next = node->next;
+				delete node;
+				node = next;
+			}
+		}
+
+	private:
+		//! The most recent request
+		std::atomic<Node*> pHead{nullptr};
+
+	}; // class RequestIntake
+
+
+
+
+
+} // namespace EventLoop
+} // namespace Core
+} // namespace Private
+} // namespace Yuni
@@ -0,0 +1,385 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#ifdef YUNI_HAS_CPP_COROUTINE
+#include "../../job/job.h"
+#include "../../job/queue/service.h"
+#include "../../job/taskgroup.h"
+#include "../../thread/signal.h"
+#include "pool.h"
+#include <coroutine>
+#include <cassert>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <chrono>
+#include <utility>
+
+
+
+namespace Yuni
+{
+namespace Job
+{
+
+	// Forward declaration
+	template<class T> class Task;
+
+} // namespace Job
+} // namespace Yuni
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	/*!
+	** \brief Job resuming a suspended coroutine
+	**
+	** A coroutine never resumed (the job has been removed from the queue, or its
+	** timer canceled) is destroyed with the job, along with all the coroutines
+	** awaiting it.
+	*/
+	class CoroutineJob final : public Yuni::Job::IJob
+	{
+	public:
+		//! Allocation from the job pool
+		static void* operator new(size_t size)
+		{
+			return JobPool::Allocate(size);
+		}
+
+		//! Release to the job pool
+		static void operator delete(void* pointer)
+		{
+			JobPool::Release(pointer);
+		}
+
+	public:
+		CoroutineJob(std::coroutine_handle<> handle, std::coroutine_handle<> root)
+			: pHandle(handle)
+			, pRoot(root)
+		{}
+
+		virtual ~CoroutineJob()
+		{
+			if (pHandle)
+				pRoot.destroy();
+		}
+
+	protected:
+		virtual void onExecute() override
+		{
+			std::coroutine_handle<> handle = pHandle;
+			pHandle = nullptr;
+			handle.resume();
+		}
+
+	private:
+		//! The coroutine to resume (null once resumed)
+		std::coroutine_handle<> pHandle;
+		//! The outermost coroutine, owning all the others
+		std::coroutine_handle<> pRoot;
+
+	}; // class CoroutineJob
+
+
+
+
+	/*!
+	** \brief Part of the promise common to all coroutine tasks
+	*/
+	class CoroutinePromise
+	{
+	public:
+		//! Awaiter of the end of the coroutine
+		struct FinalAwaiter final
+		{
+			bool await_ready() const noexcept { return false; }
+
+			template<class PromiseT>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> handle) noexcept
+			{
+				CoroutinePromise& promise = handle.promise();
+				if (promise.continuation)
+					return promise.continuation;
+				if (promise.detached)
+					handle.destroy();
+				return std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+	public:
+		//! The coroutine is started by `Task::start()` or when awaited
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+
+		FinalAwaiter final_suspend() const noexcept { return {}; }
+
+		void unhandled_exception() noexcept
+		{
+			exception = std::current_exception();
+		}
+
+		//! Resume the coroutine from a new job of its queueservice
+		void schedule(std::coroutine_handle<> handle)
+		{
+			assert(queueservice != nullptr and "the coroutine task has not been started");
+			queueservice->push(new CoroutineJob(handle, root), priority);
+		}
+
+		//! Create the job resuming the coroutine, without dispatching it
+		Yuni::Job::IJob::Ptr resumeJob(std::coroutine_handle<> handle)
+		{
+			return new CoroutineJob(handle, root);
+		}
+
+	public:
+		//! The queueservice executing the coroutine
+		Yuni::Job::QueueService* queueservice = nullptr;
+		//! Priority of the jobs resuming the coroutine
+		Yuni::Job::Priority priority = Yuni::Job::Priority::normal;
+		//! The coroutine awaiting this one, if any
+		std::coroutine_handle<> continuation;
+		//! The outermost coroutine (started with `Task::start()`)
+		std::coroutine_handle<> root;
+		//! Exception thrown by the coroutine
+		std::exception_ptr exception;
+		//! Flag to know if the coroutine owns itself (and must be destroyed when complete)
+		bool detached = false;
+
+	}; // class CoroutinePromise
+
+
+
+
+	//! Promise of a coroutine task returning a value
+	template<class T>
+	class TaskPromise final : public CoroutinePromise
+	{
+	public:
+		Yuni::Job::Task<T> get_return_object() noexcept;
+
+		template<class U>
+		void return_value(U&& value)
+		{
+			result.emplace(std::forward<U>(value));
+		}
+
+		//! Get the result (or rethrow the exception)
+		T get()
+		{
+			if (exception)
+				std::rethrow_exception(exception);
+			return std::move(*result);
+		}
+
+	public:
+		//! The result
+		std::optional<T> result;
+
+	}; // class TaskPromise
+
+
+	//! Promise of a coroutine task returning nothing
+	template<>
+	class TaskPromise<void> final : public CoroutinePromise
+	{
+	public:
+		Yuni::Job::Task<void> get_return_object() noexcept;
+
+		void return_void() const noexcept {}
+
+		//! Rethrow the exception, if any
+		void get()
+		{
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+
+	}; // class TaskPromise
+
+
+
+
+	/*!
+	** \brief Base class of the awaiters suspending a coroutine task
+	**
+	** Only the coroutine tasks (`Job::Task<>`) can be suspended, their
+	** promise holding the queueservice where to resume them.
+	*/
+	class CoroutineAwaiter
+	{
+	public:
+		bool await_ready() const noexcept { return false; }
+
+	protected:
+		template<class PromiseT>
+		void attach(std::coroutine_handle<PromiseT> handle)
+		{
+			static_assert(std::is_base_of<CoroutinePromise, PromiseT>::value,
+				"only a coroutine returning a Job::Task<> can be suspended");
+			pHandle = handle;
+			pPromise = &handle.promise();
+		}
+
+		//! Resume the coroutine from a new job of its queueservice
+		void resume()
+		{
+			pPromise->schedule(pHandle);
+		}
+
+	protected:
+		//! The suspended coroutine
+		std::coroutine_handle<> pHandle;
+		//! Its promise
+		CoroutinePromise* pPromise = nullptr;
+
+	}; // class CoroutineAwaiter
+
+
+	//! Awaiter resuming the coroutine from a new job of a queueservice
+	class ScheduleAwaiter final : public CoroutineAwaiter
+	{
+	public:
+		ScheduleAwaiter(Yuni::Job::QueueService* queueservice, Yuni::Job::Priority priority)
+			: pQueueService(queueservice)
+			, pPriority(priority)
+		{}
+
+		template<class PromiseT>
+		void await_suspend(std::coroutine_handle<PromiseT> handle)
+		{
+			attach(handle);
+			if (pQueueService)
+			{
+				pPromise->queueservice = pQueueService;
+				pPromise->priority = pPriority;
+			}
+			resume();
+		}
+
+		void await_resume() const noexcept {}
+
+	private:
+		//! The new queueservice (null to keep the current one)
+		Yuni::Job::QueueService* pQueueService;
+		//! The new priority
+		Yuni::Job::Priority pPriority;
+
+	}; // class ScheduleAwaiter
+
+
+	//! Awaiter resuming the coroutine from a timer
+	class TimerAwaiter final : public CoroutineAwaiter
+	{
+	public:
+		explicit TimerAwaiter(std::chrono::steady_clock::time_point deadline)
+			: pDeadline(deadline)
+		{}
+
+		template<class PromiseT>
+		void await_suspend(std::coroutine_handle<PromiseT> handle)
+		{
+			attach(handle);
+			// the coroutine may be resumed before the end of the call
+			std::chrono::steady_clock::time_point deadline = pDeadline;
+			Yuni::Job::QueueService& queueservice = *pPromise->queueservice;
+			Yuni::Job::Priority priority = pPromise->priority;
+			queueservice.add(pPromise->resumeJob(pHandle), deadline, priority);
+		}
+
+		void await_resume() const noexcept {}
+
+	private:
+		//! When to resume the coroutine
+		std::chrono::steady_clock::time_point pDeadline;
+
+	}; // class TimerAwaiter
+
+
+	//! Awaiter resuming the coroutine when a signal is notified
+	class SignalAwaiter final : public CoroutineAwaiter, private Yuni::Thread::Signal::Waiter
+	{
+	public:
+		explicit SignalAwaiter(Yuni::Thread::Signal& signal)
+			: pSignal(signal)
+		{}
+
+		template<class PromiseT>
+		bool await_suspend(std::coroutine_handle<PromiseT> handle)
+		{
+			attach(handle);
+			return pSignal.wait(static_cast<Yuni::Thread::Signal::Waiter&>(*this));
+		}
+
+		void await_resume() const noexcept {}
+
+	private:
+		virtual void signalled() override
+		{
+			resume();
+		}
+
+	private:
+		//! The signal
+		Yuni::Thread::Signal& pSignal;
+
+	}; // class SignalAwaiter
+
+
+	//! Awaiter resuming the coroutine when a taskgroup is complete
+	class TaskgroupAwaiter final : public CoroutineAwaiter, private Yuni::Thread::Signal::Waiter
+	{
+	public:
+		explicit TaskgroupAwaiter(Yuni::Job::Taskgroup& taskgroup)
+			: pTaskgroup(taskgroup)
+		{}
+
+		template<class PromiseT>
+		bool await_suspend(std::coroutine_handle<PromiseT> handle)
+		{
+			attach(handle);
+			return pTaskgroup.wait(static_cast<Yuni::Thread::Signal::Waiter&>(*this));
+		}
+
+		Yuni::Job::Taskgroup::Status await_resume() const
+		{
+			return pTaskgroup.status();
+		}
+
+	private:
+		virtual void signalled() override
+		{
+			resume();
+		}
+
+	private:
+		//! The taskgroup
+		Yuni::Job::Taskgroup& pTaskgroup;
+
+	}; // class TaskgroupAwaiter
+
+
+
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
+
+#endif // YUNI_HAS_CPP_COROUTINE
@@ -0,0 +1,74 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include "../../job/job.h"
+#include "pool.h"
+#include <utility>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	/*!
+	** \brief Job executing a callable object, stored inline
+	**
+	** Contrary to a `Bind<>`, the callable object is stored within the job itself,
+	** which is allocated from the `JobPool`.
+	*/
+	template<class CallbackT>
+	class LambdaJob final : public Yuni::Job::IJob
+	{
+	public:
+		//! Allocation from the job pool
+		static void* operator new(size_t size)
+		{
+			return JobPool::Allocate(size);
+		}
+
+		//! Release to the job pool
+		static void operator delete(void* pointer)
+		{
+			JobPool::Release(pointer);
+		}
+
+	public:
+		template<class C>
+		explicit LambdaJob(C&& callback)
+			: pCallback(std::forward<C>(callback))
+		{}
+
+		virtual ~LambdaJob() = default;
+
+	protected:
+		virtual void onExecute() override
+		{
+			pCallback();
+		}
+
+	private:
+		//! The callback to execute
+		CallbackT pCallback;
+
+	}; // class LambdaJob
+
+
+
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
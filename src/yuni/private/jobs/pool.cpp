@@ -0,0 +1,283 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "pool.h"
+#include <atomic>
+#include <vector>
+#include <new>
+#include <cstdint>
+#include <cassert>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	namespace
+	{
+
+	struct Cache;
+
+
+	//! Header stored just before each block
+	struct alignas(JobPool::alignment) Header final
+	{
+		//! The cache owning the block (null for oversized blocks)
+		Cache* owner;
+		//! Size class of the block
+		uint32_t sizeclass;
+	};
+
+	static_assert(sizeof(Header) == JobPool::alignment, "invalid header size");
+
+
+	//! A free block (the link is stored in place of the payload)
+	struct FreeBlock final
+	{
+		Header header;
+		FreeBlock* next;
+	};
+
+
+	//! Payload size of each size class
+	constexpr static size_t classSizes[] = { 128, JobPool::maxBlockSize };
+	//! Number of size classes
+	constexpr static uint32_t classCount = sizeof(classSizes) / sizeof(classSizes[0]);
+	//! Number of blocks allocated at once when a cache is empty
+	constexpr static uint32_t blocksPerSlab = 64;
+	//! Number of remote lists per size class
+	constexpr static uint32_t remoteShards = 8;
+
+
+	//! Head of a remote list, alone on its cache line
+	struct alignas(64) RemoteList final
+	{
+		std::atomic<FreeBlock*> head{nullptr};
+	};
+
+
+	//! Head of the remote lists of a terminated thread, the blocks being counted instead
+	FreeBlock* const closed = reinterpret_cast<FreeBlock*>(static_cast<uintptr_t>(1));
+
+
+	//! Free blocks owned by a single thread
+	struct Cache final
+	{
+		Cache()
+		{
+			for (uint32_t i = 0; i != classCount; ++i)
+				local[i] = nullptr;
+		}
+
+		//! Free blocks, only accessed by the owner
+		FreeBlock* local[classCount];
+		//! Free blocks released by other threads
+		RemoteList remote[classCount][remoteShards];
+		//! All slabs allocated for this cache, only accessed by the owner
+		std::vector<void*> slabs;
+		//! Number of blocks not released yet, once the owner has terminated (may be temporarily negative)
+		std::atomic<int64_t> outstanding{0};
+	};
+
+
+	void destroy(Cache* cache)
+	{
+		for (void* slab: cache->slabs)
+			::operator delete(slab);
+		delete cache;
+	}
+
+
+	//! Number of blocks of a free list
+	int64_t countBlocks(const FreeBlock* block)
+	{
+		int64_t count = 0;
+		for (; block; block = block->next)
+			++count;
+		return count;
+	}
+
+
+	//! Cache of the current thread, freed when the thread terminates
+	struct ThreadCache final
+	{
+		~ThreadCache()
+		{
+			Cache* owned = cache;
+			if (not owned)
+				return;
+			// from now on, the blocks released by this thread are remote ones as well
+			cache = nullptr;
+
+			// closing the remote lists: the blocks released from now on are only counted
+			int64_t available = 0;
+			for (uint32_t i = 0; i != classCount; ++i)
+			{
+				available += countBlocks(owned->local[i]);
+				for (auto& list: owned->remote[i])
+				{
+					FreeBlock* blocks = list.head.exchange(closed, std::memory_order_acq_rel);
+					available += countBlocks(blocks);
+				}
+			}
+			int64_t missing = static_cast<int64_t>(owned->slabs.size()) * blocksPerSlab - available;
+			// the last one, this thread or a releaser, frees the cache
+			if (owned->outstanding.fetch_add(missing, std::memory_order_acq_rel) + missing == 0)
+				destroy(owned);
+		}
+
+		Cache* cache = nullptr;
+	};
+
+	thread_local ThreadCache threadCache;
+
+
+	//! Index of the next remote list for a new releasing thread
+	std::atomic<uint32_t> nextRemoteShard{0};
+
+	//! Remote list used by the current thread to release the blocks of the others
+	thread_local const uint32_t remoteShard = nextRemoteShard.fetch_add(1, std::memory_order_relaxed) % remoteShards;
+
+
+	Cache& acquireCache()
+	{
+		Cache* cache = new Cache();
+		threadCache.cache = cache;
+		return *cache;
+	}
+
+
+	inline Cache& currentCache()
+	{
+		Cache* cache = threadCache.cache;
+		return YUNI_LIKELY(cache) ? *cache : acquireCache();
+	}
+
+
+	inline uint32_t sizeclassOf(size_t size)
+	{
+		uint32_t i = 0;
+		while (i != classCount and size > classSizes[i])
+			++i;
+		return i;
+	}
+
+
+	FreeBlock* allocateSlab(Cache& cache, uint32_t sizeclass)
+	{
+		const size_t blocksize = sizeof(Header) + classSizes[sizeclass];
+		cache.slabs.reserve(cache.slabs.size() + 1);
+		auto* slab = reinterpret_cast<char*>(::operator new(blocksize * blocksPerSlab));
+		cache.slabs.push_back(slab);
+
+		FreeBlock* first = nullptr;
+		for (uint32_t i = blocksPerSlab; i-- > 0; )
+		{
+			auto* block = reinterpret_cast<FreeBlock*>(slab + i * blocksize);
+			block->header.owner = &cache;
+			block->header.sizeclass = sizeclass;
+			block->next = first;
+			first = block;
+		}
+		return first;
+	}
+
+
+	//! Take back the blocks released by other threads in the meantime (a single remote list)
+	FreeBlock* reclaim(Cache& cache, uint32_t sizeclass)
+	{
+		for (auto& list: cache.remote[sizeclass])
+		{
+			if (nullptr != list.head.load(std::memory_order_relaxed))
+				return list.head.exchange(nullptr, std::memory_order_acquire);
+		}
+		return nullptr;
+	}
+
+	} // anonymous namespace
+
+
+
+
+	void* JobPool::Allocate(size_t size)
+	{
+		uint32_t sizeclass = sizeclassOf(size);
+		if (YUNI_UNLIKELY(sizeclass == classCount))
+		{
+			auto* header = reinterpret_cast<Header*>(::operator new(sizeof(Header) + size));
+			header->owner = nullptr;
+			header->sizeclass = classCount;
+			return header + 1;
+		}
+
+		Cache& cache = currentCache();
+		FreeBlock* block = cache.local[sizeclass];
+		if (YUNI_UNLIKELY(not block))
+		{
+			block = reclaim(cache, sizeclass);
+			if (not block)
+				block = allocateSlab(cache, sizeclass);
+		}
+		cache.local[sizeclass] = block->next;
+		return &(block->header) + 1;
+	}
+
+
+	void JobPool::Release(void* pointer)
+	{
+		if (not pointer)
+			return;
+		auto* block = reinterpret_cast<FreeBlock*>(reinterpret_cast<Header*>(pointer) - 1);
+		uint32_t sizeclass = block->header.sizeclass;
+		if (YUNI_UNLIKELY(sizeclass == classCount))
+		{
+			::operator delete(block);
+			return;
+		}
+		assert(sizeclass < classCount);
+
+		Cache* owner = block->header.owner;
+		if (owner == threadCache.cache)
+		{
+			block->next = owner->local[sizeclass];
+			owner->local[sizeclass] = block;
+		}
+		else
+		{
+			// the list is only consumed as a whole by its owner, no ABA to fear
+			auto& remote = owner->remote[sizeclass][remoteShard].head;
+			FreeBlock* head = remote.load(std::memory_order_relaxed);
+			do
+			{
+				if (YUNI_UNLIKELY(head == closed))
+				{
+					// the owner has terminated, the last block frees its cache
+					if (owner->outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+						destroy(owner);
+					return;
+				}
+				block->next = head;
+			}
+			while (not remote.compare_exchange_weak(head, block,
+				std::memory_order_release, std::memory_order_relaxed));
+		}
+	}
+
+
+
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
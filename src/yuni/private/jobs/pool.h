@@ -0,0 +1,70 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include <cstddef>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	/*!
+	** \brief Per-thread pool of fixed-size memory blocks for small jobs
+	**
+	** Blocks are served from a few size classes. Each thread owns a cache of free
+	** blocks per size class: a block released by its owner goes back to the owner's
+	** local free list, a block released by another thread (typically a worker of
+	** a queueservice) is pushed onto one of the lock-free 'remote' lists of the
+	** owner (several per size class, to spread the releasing threads), which are
+	** reclaimed one at a time when the local list is empty. Thus, in steady state,
+	** neither allocating nor releasing a block performs any heap allocation.
+	**
+	** The cache of a terminated thread is freed, at once if all its blocks are back,
+	** or when its last block is released otherwise.
+	** Requests larger than `maxBlockSize` are forwarded to the global allocator.
+	*/
+	class YUNI_DECL JobPool final
+	{
+	public:
+		enum : size_t
+		{
+			//! Alignment guaranteed for all blocks
+			alignment = 16,
+			//! The largest size served from the pool
+			maxBlockSize = 256,
+		};
+
+	public:
+		/*!
+		** \brief Allocate a block of at least `size` bytes
+		** \return A pointer aligned on `alignment` (never null)
+		*/
+		static void* Allocate(size_t size);
+
+		/*!
+		** \brief Release a block previously allocated by `Allocate()`, from any thread
+		*/
+		static void Release(void* pointer);
+
+	}; // class JobPool
+
+
+
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
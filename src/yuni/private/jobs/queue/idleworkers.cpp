@@ -0,0 +1,201 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "idleworkers.h"
+#include "../../thread/futex.h"
+#include <cassert>
+#include <chrono>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	namespace
+	{
+
+	constexpr static uint64_t indexMask = 0xFFFFFFFFull;
+
+
+	inline uint64_t makeHead(uint64_t previous, uint32_t top)
+	{
+		// incrementing the tag at each modification prevents ABA
+		return ((((previous >> 32) + 1) & indexMask) << 32) | top;
+	}
+
+	} // anonymous namespace
+
+
+
+
+	IdleWorkers::IdleWorkers(uint32_t capacity)
+		: pHead(0)
+		, pSpinning(0)
+		, pSlots(new Slot[capacity])
+		, pCapacity(capacity)
+	{
+		reset();
+	}
+
+
+	void IdleWorkers::reset()
+	{
+		pHead.store(0);
+		pSpinning.store(0);
+		for (uint32_t i = 0; i != pCapacity; ++i)
+		{
+			pSlots[i].state.store(running);
+			pSlots[i].next.store(0);
+			pSlots[i].inStack.store(false);
+		}
+	}
+
+
+	void IdleWorkers::push(uint32_t index)
+	{
+		Slot& slot = pSlots[index];
+		uint64_t head = pHead.load();
+		uint64_t newhead;
+		do
+		{
+			slot.next.store(static_cast<uint32_t>(head & indexMask));
+			newhead = makeHead(head, index + 1);
+		}
+		while (not pHead.compare_exchange_weak(head, newhead));
+	}
+
+
+	bool IdleWorkers::pop(uint32_t& index)
+	{
+		uint64_t head = pHead.load();
+		do
+		{
+			uint32_t top = static_cast<uint32_t>(head & indexMask);
+			if (0 == top)
+				return false;
+			// `next` may be obsolete if the slot has been popped and pushed again
+			// in the meantime, but then the tag has changed as well
+			uint32_t next = pSlots[top - 1].next.load();
+			if (pHead.compare_exchange_weak(head, makeHead(head, next)))
+			{
+				index = top - 1;
+				return true;
+			}
+		}
+		while (true);
+	}
+
+
+	void IdleWorkers::prepareToPark(uint32_t index)
+	{
+		assert(index < pCapacity);
+		Slot& slot = pSlots[index];
+		// the state must be published *before* the worker is visible in the stack
+		slot.state.store(parked);
+
+		bool expected = false;
+		if (slot.inStack.compare_exchange_strong(expected, true))
+			push(index);
+		// the caller will check for some work after this point, which must not be
+		// reordered with the publication above (see QueueService::add())
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+
+	void IdleWorkers::park(uint32_t index)
+	{
+		assert(index < pCapacity);
+		Slot& slot = pSlots[index];
+		while (slot.state.load() == parked)
+			Private::Thread::FutexWait(slot.state, parked);
+	}
+
+
+	bool IdleWorkers::park(uint32_t index, uint timeout)
+	{
+		assert(index < pCapacity);
+		Slot& slot = pSlots[index];
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		while (slot.state.load() == parked)
+		{
+			auto now = std::chrono::steady_clock::now();
+			if (now >= deadline)
+			{
+				// the worker may remain in the stack, like with cancelPark()
+				uint32_t expected = parked;
+				// woken up at the very last moment otherwise
+				return not slot.state.compare_exchange_strong(expected, running);
+			}
+			auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+			Private::Thread::FutexWait(slot.state, parked, static_cast<uint>(remaining));
+		}
+		return true;
+	}
+
+
+	bool IdleWorkers::wakeOne()
+	{
+		uint32_t index;
+		return wakeOne(index);
+	}
+
+
+	bool IdleWorkers::wakeOne(uint32_t& index)
+	{
+		while (pop(index))
+		{
+			Slot& slot = pSlots[index];
+			slot.inStack.store(false);
+			if (slot.state.exchange(running) == parked)
+			{
+				Private::Thread::FutexWakeOne(slot.state);
+				return true;
+			}
+			// this worker had finally found some work by itself, trying the next one
+		}
+		return false;
+	}
+
+
+	void IdleWorkers::wakeAll(uint32_t count)
+	{
+		assert(count <= pCapacity);
+		for (uint32_t i = 0; i != count; ++i)
+		{
+			Slot& slot = pSlots[i];
+			if (slot.state.exchange(running) == parked)
+				Private::Thread::FutexWakeOne(slot.state);
+		}
+	}
+
+
+	bool IdleWorkers::startSpinning(uint32_t maxSpinning)
+	{
+		uint32_t current = pSpinning.load();
+		do
+		{
+			if (current >= maxSpinning)
+				return false;
+		}
+		while (not pSpinning.compare_exchange_weak(current, current + 1));
+		return true;
+	}
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
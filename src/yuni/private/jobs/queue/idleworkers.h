@@ -0,0 +1,156 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include "../../../core/noncopyable.h"
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cassert>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	/*!
+	** \brief Lock-free stack of parked workers
+	**
+	** Each worker is identified by a zero-based index (its slot). A worker
+	** goes to sleep in two steps:
+	**   1. `prepareToPark()` publishes the worker onto the stack
+	**   2. the worker checks one last time for some work (see `cancelPark()`),
+	**      and sleeps in `park()` on its own futex word otherwise
+	**
+	** `wakeOne()` pops the most recently parked worker (its caches are more likely
+	** to be hot) and wakes it up. The head of the stack is tagged to prevent ABA.
+	**
+	** This class also keeps track of the number of spinning workers: a job added
+	** while a worker is spinning does not need to wake up anybody.
+	*/
+	class YUNI_DECL IdleWorkers final : private NonCopyable<IdleWorkers>
+	{
+	public:
+		//! \name Constructor
+		//@{
+		/*!
+		** \brief Constructor
+		** \param capacity The maximum number of workers
+		*/
+		explicit IdleWorkers(uint32_t capacity);
+		//@}
+
+
+		//! \name Parking
+		//@{
+		//! Reset the stack (no worker must be running)
+		void reset();
+
+		//! Publish a worker as parked (first step)
+		void prepareToPark(uint32_t index);
+		//! The worker finally found some work and will not sleep
+		void cancelPark(uint32_t index);
+		//! Sleep until woken up (second step)
+		void park(uint32_t index);
+		/*!
+		** \brief Sleep until woken up, with a timeout (second step)
+		**
+		** \param index The index of the worker
+		** \param timeout A timeout in milliseconds
+		** \return False if the timeout has been reached (the worker is no longer parked)
+		*/
+		bool park(uint32_t index, uint timeout);
+
+		/*!
+		** \brief Wake up a single parked worker
+		** \return True if a worker has been woken up
+		*/
+		bool wakeOne();
+		/*!
+		** \brief Wake up a single parked worker
+		** \param[out] index The index of the worker woken up
+		** \return True if a worker has been woken up
+		*/
+		bool wakeOne(uint32_t& index);
+		/*!
+		** \brief Wake up all workers, parked or not (used when stopping)
+		** \param count The number of slots in use
+		*/
+		void wakeAll(uint32_t count);
+		//@}
+
+
+		//! \name Spinning
+		//@{
+		/*!
+		** \brief Register a spinning worker
+		** \param maxSpinning The maximum number of spinning workers at once
+		** \return True if the calling worker is allowed to spin
+		*/
+		bool startSpinning(uint32_t maxSpinning);
+		//! Unregister a spinning worker
+		void stopSpinning();
+		//! Get the number of spinning workers
+		uint32_t spinning() const;
+		//@}
+
+
+	private:
+		//! Try to push a worker onto the stack
+		void push(uint32_t index);
+		//! Try to pop a worker from the stack
+		bool pop(uint32_t& index);
+
+	private:
+		enum : uint32_t
+		{
+			//! The worker is running
+			running = 0,
+			//! The worker is parked (or about to be)
+			parked = 1,
+		};
+
+		//! Data related to a single worker
+		struct Slot final
+		{
+			//! The futex word (running / parked)
+			std::atomic<uint32_t> state;
+			//! Index + 1 of the next worker in the stack (0 for none)
+			std::atomic<uint32_t> next;
+			//! Flag to know if the worker is already in the stack
+			std::atomic<bool> inStack;
+		};
+
+	private:
+		//! Head of the stack: tag (32 bits) | index + 1 of the top (32 bits)
+		std::atomic<uint64_t> pHead;
+		//! Number of spinning workers
+		std::atomic<uint32_t> pSpinning;
+		//! All slots
+		std::unique_ptr<Slot[]> pSlots;
+		//! The number of slots
+		const uint32_t pCapacity;
+
+	}; // class IdleWorkers
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
+
+#include "idleworkers.hxx"
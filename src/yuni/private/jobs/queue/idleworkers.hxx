@@ -0,0 +1,49 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "idleworkers.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	inline uint32_t IdleWorkers::spinning() const
+	{
+		return pSpinning.load();
+	}
+
+
+	inline void IdleWorkers::stopSpinning()
+	{
+		pSpinning.fetch_sub(1);
+	}
+
+
+	inline void IdleWorkers::cancelPark(uint32_t index)
+	{
+		assert(index < pCapacity);
+		// the worker may remain in the stack. Popping it later will only
+		// result in a spurious wakeup
+		pSlots[index].state.store(running);
+	}
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
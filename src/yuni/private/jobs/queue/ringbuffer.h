@@ -0,0 +1,79 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include <memory>
+#include <utility>
+#include <cassert>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	/*!
+	** \brief FIFO queue stored in a growable circular buffer (not thread-safe)
+	**
+	** Unlike `std::deque`, the storage is kept when items are removed, thus a
+	** queue which has reached its working size does not allocate anymore.
+	*/
+	template<class T>
+	class RingBuffer final
+	{
+	public:
+		//! Get if the queue is empty
+		bool empty() const;
+		//! Get the number of items
+		uint32_t size() const;
+
+		//! Append an item at the end of the queue
+		template<class U> void push_back(U&& item);
+		//! Move the first item into `out` and remove it (the queue must not be empty)
+		void pop_front(T& out);
+		//! Get the first item (the queue must not be empty)
+		const T& front() const;
+		//! Get an item, from the front of the queue (`index` must be lower than `size()`)
+		const T& operator [] (uint32_t index) const;
+		//! Move an item into `out` and remove it, the following ones keeping their order
+		void erase(uint32_t index, T& out);
+
+		//! Remove all items (the storage is kept)
+		void clear();
+
+	private:
+		//! Double the capacity
+		void grow();
+
+	private:
+		//! Storage (the capacity is always a power of 2)
+		std::unique_ptr<T[]> pItems;
+		//! Capacity - 1
+		uint32_t pMask = 0;
+		//! Index of the first item
+		uint32_t pHead = 0;
+		//! Number of items
+		uint32_t pCount = 0;
+
+	}; // class RingBuffer
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
+
+#include "ringbuffer.hxx"
@@ -0,0 +1,118 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "ringbuffer.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	template<class T>
+	inline bool RingBuffer<T>::empty() const
+	{
+		return 0 == pCount;
+	}
+
+
+	template<class T>
+	inline uint32_t RingBuffer<T>::size() const
+	{
+		return pCount;
+	}
+
+
+	template<class T>
+	template<class U>
+	inline void RingBuffer<T>::push_back(U&& item)
+	{
+		if (YUNI_UNLIKELY(not pItems or pCount == pMask + 1))
+			grow();
+		pItems[(pHead + pCount) & pMask] = std::forward<U>(item);
+		++pCount;
+	}
+
+
+	template<class T>
+	inline void RingBuffer<T>::pop_front(T& out)
+	{
+		assert(pCount != 0);
+		out = std::move(pItems[pHead]);
+		pItems[pHead] = T();
+		pHead = (pHead + 1) & pMask;
+		--pCount;
+	}
+
+
+	template<class T>
+	inline const T& RingBuffer<T>::front() const
+	{
+		assert(pCount != 0);
+		return pItems[pHead];
+	}
+
+
+	template<class T>
+	inline const T& RingBuffer<T>::operator [] (uint32_t index) const
+	{
+		assert(index < pCount);
+		return pItems[(pHead + index) & pMask];
+	}
+
+
+	template<class T>
+	void RingBuffer<T>::erase(uint32_t index, T& out)
+	{
+		assert(index < pCount);
+		out = std::move(pItems[(pHead + index) & pMask]);
+		// shifting the following items
+		for (uint32_t i = index + 1; i != pCount; ++i)
+			pItems[(pHead + i - 1) & pMask] = std::move(pItems[(pHead + i) & pMask]);
+		--pCount;
+		pItems[(pHead + pCount) & pMask] = T();
+	}
+
+
+	template<class T>
+	void RingBuffer<T>::clear()
+	{
+		for (; pCount != 0; --pCount)
+		{
+			pItems[pHead] = T();
+			pHead = (pHead + 1) & pMask;
+		}
+		pHead = 0;
+	}
+
+
+	template<class T>
+	void RingBuffer<T>::grow()
+	{
+		uint32_t capacity = (pItems) ? (pMask + 1) * 2 : 64;
+		std::unique_ptr<T[]> items(new T[capacity]);
+		for (uint32_t i = 0; i != pCount; ++i)
+			items[i] = std::move(pItems[(pHead + i) & pMask]);
+		pItems.swap(items);
+		pMask = capacity - 1;
+		pHead = 0;
+	}
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
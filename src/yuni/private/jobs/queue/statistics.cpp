@@ -0,0 +1,66 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "statistics.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	void WorkerStatistics::Histogram::exportTo(Yuni::Job::Statistics::Histogram& out) const
+	{
+		// the values may be slightly inconsistent with each other while the worker is running
+		out.count += count.load(std::memory_order_relaxed);
+		out.total += total.load(std::memory_order_relaxed);
+		uint64_t highest = max.load(std::memory_order_relaxed);
+		if (out.max < highest)
+			out.max = highest;
+		for (uint i = 0; i != Yuni::Job::Statistics::Histogram::bucketCount; ++i)
+			out.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+	}
+
+
+	void WorkerStatistics::exportTo(Yuni::Job::Statistics& out) const
+	{
+		out.enqueued += pEnqueued.load(std::memory_order_relaxed);
+		out.executed += pExecuted.load(std::memory_order_relaxed);
+		out.stolen   += pStolen.load(std::memory_order_relaxed);
+		out.busyTime += pBusyTime.load(std::memory_order_relaxed);
+		out.idleTime += pIdleTime.load(std::memory_order_relaxed);
+		for (uint p = 0; p != Yuni::Job::priorityCount; ++p)
+		{
+			pQueueWait[p].exportTo(out.queueWait[p]);
+			pRunTime[p].exportTo(out.runTime[p]);
+		}
+	}
+
+
+	void WorkerStatistics::exportTo(Yuni::Job::Statistics::Worker& out) const
+	{
+		out.enqueued = pEnqueued.load(std::memory_order_relaxed);
+		out.executed = pExecuted.load(std::memory_order_relaxed);
+		out.stolen   = pStolen.load(std::memory_order_relaxed);
+		out.busyTime = pBusyTime.load(std::memory_order_relaxed);
+		out.idleTime = pIdleTime.load(std::memory_order_relaxed);
+	}
+
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
@@ -0,0 +1,99 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include "../../../job/queue/statistics.h"
+#include <atomic>
+#include <cstdint>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	//! Get the current time of a monotonic clock, in nanoseconds
+	uint64_t MonotonicTime();
+
+
+	/*!
+	** \brief Counters of a single worker
+	**
+	** Only the worker modifies its counters, without any read-modify-write
+	** operation (a relaxed load and a relaxed store), thus without any
+	** contention. Any other thread may read them at any time.
+	*/
+	class YUNI_DECL WorkerStatistics final
+	{
+	public:
+		//! Some jobs have been added to the local deque
+		void enqueued(uint count);
+		//! A job has been stolen from another worker
+		void stolen();
+		//! A job has been executed
+		void executed(uint priority, uint64_t queueWait, uint64_t runTime);
+		//! The worker has been waiting for some work
+		void idle(uint64_t duration);
+
+		//! Add the counters to a snapshot
+		void exportTo(Yuni::Job::Statistics& out) const;
+		//! Add the counters to the statistics of a worker
+		void exportTo(Yuni::Job::Statistics::Worker& out) const;
+
+	private:
+		//! A counter which is only modified by a single thread
+		typedef std::atomic<uint64_t> Counter;
+		//! Increment a counter (from the worker only)
+		static void Increment(Counter& counter, uint64_t value);
+
+		//! Histogram of durations (see Job::Statistics::Histogram)
+		struct Histogram final
+		{
+			void add(uint64_t duration);
+			void exportTo(Yuni::Job::Statistics::Histogram& out) const;
+
+			Counter count {0};
+			Counter total {0};
+			Counter max {0};
+			Counter buckets[Yuni::Job::Statistics::Histogram::bucketCount] = {};
+		};
+
+	private:
+		//! Number of jobs added to the local deque
+		Counter pEnqueued {0};
+		//! Number of jobs executed
+		Counter pExecuted {0};
+		//! Number of stolen jobs
+		Counter pStolen {0};
+		//! Time spent executing jobs
+		Counter pBusyTime {0};
+		//! Time spent waiting for some work
+		Counter pIdleTime {0};
+		//! Time spent by the jobs in the queue, per priority
+		Histogram pQueueWait[Yuni::Job::priorityCount];
+		//! Execution time of the jobs, per priority
+		Histogram pRunTime[Yuni::Job::priorityCount];
+
+	}; // class WorkerStatistics
+
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
+
+#include "statistics.hxx"
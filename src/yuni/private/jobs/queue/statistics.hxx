@@ -0,0 +1,79 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "statistics.h"
+#include <chrono>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	inline uint64_t MonotonicTime()
+	{
+		auto now = std::chrono::steady_clock::now().time_since_epoch();
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+	}
+
+
+	inline void WorkerStatistics::Increment(Counter& counter, uint64_t value)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+
+	inline void WorkerStatistics::Histogram::add(uint64_t duration)
+	{
+		Increment(count, 1);
+		Increment(total, duration);
+		if (duration > max.load(std::memory_order_relaxed))
+			max.store(duration, std::memory_order_relaxed);
+		Increment(buckets[Yuni::Job::Statistics::Histogram::Bucket(duration)], 1);
+	}
+
+
+	inline void WorkerStatistics::enqueued(uint count)
+	{
+		Increment(pEnqueued, count);
+	}
+
+
+	inline void WorkerStatistics::stolen()
+	{
+		Increment(pStolen, 1);
+	}
+
+
+	inline void WorkerStatistics::executed(uint priority, uint64_t queueWait, uint64_t runTime)
+	{
+		assert(priority < Yuni::Job::priorityCount);
+		Increment(pExecuted, 1);
+		Increment(pBusyTime, runTime);
+		pQueueWait[priority].add(queueWait);
+		pRunTime[priority].add(runTime);
+	}
+
+
+	inline void WorkerStatistics::idle(uint64_t duration)
+	{
+		Increment(pIdleTime, duration);
+	}
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
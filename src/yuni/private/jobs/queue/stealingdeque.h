@@ -0,0 +1,131 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include "../../../core/noncopyable.h"
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	/*!
+	** \brief Lock-free work-stealing deque (Chase-Lev)
+	**
+	** Only the owner of the deque may call `push()` and `pop()`, which work
+	** on the bottom of the deque (LIFO, for cache locality). Any other thread
+	** may call `steal()`, which takes elements from the top (FIFO).
+	**
+	** The implementation follows "Correct and Efficient Work-Stealing for Weak
+	** Memory Models" (Lê, Pop, Cohen, Zappa Nardelli - PPoPP 2013).
+	** The internal buffer grows when full and never shrinks. Old buffers are
+	** kept alive until the deque is destroyed, since a thief may still read them.
+	**
+	** \tparam T Type of the elements (raw pointers only)
+	*/
+	template<class T>
+	class YUNI_DECL StealingDeque final : private NonCopyable<StealingDeque<T>>
+	{
+	public:
+		//! Result of a steal attempt
+		enum class Steal
+		{
+			//! An element has been stolen
+			success,
+			//! The deque was empty
+			empty,
+			//! Another thread won the race, the caller may retry
+			abort,
+		};
+
+	public:
+		//! \name Constructor & Destructor
+		//@{
+		/*!
+		** \brief Default constructor
+		** \param capacity Initial capacity (power of 2)
+		*/
+		explicit StealingDeque(uint32_t capacity = 256);
+		//! Destructor
+		~StealingDeque();
+		//@}
+
+
+		//! \name Owner
+		//@{
+		//! Push an element at the bottom (owner only)
+		void push(T* item);
+		//! Pop an element from the bottom (owner only), nullptr if empty
+		T* pop();
+		//@}
+
+
+		//! \name Thieves
+		//@{
+		/*!
+		** \brief Try to take an element from the top (any thread)
+		**
+		** \param[out] out The stolen element, untouched if the attempt failed
+		*/
+		Steal steal(T*& out);
+		//@}
+
+
+		//! \name Informations
+		//@{
+		//! Get an approximation of the number of elements in the deque
+		uint32_t size() const;
+		//! Get if the deque is (probably) empty
+		bool empty() const;
+		//@}
+
+
+	private:
+		//! Circular buffer
+		struct Buffer final
+		{
+			explicit Buffer(uint32_t capacity);
+			T* get(int64_t index) const;
+			void put(int64_t index, T* item);
+			Buffer* grow(int64_t bottom, int64_t top) const;
+
+			const int64_t mask;
+			std::atomic<T*>* items;
+		};
+
+	private:
+		//! Index of the next element to steal
+		alignas(64) std::atomic<int64_t> pTop;
+		//! Index of the next free slot for the owner
+		alignas(64) std::atomic<int64_t> pBottom;
+		//! The current buffer
+		std::atomic<Buffer*> pBuffer;
+		//! Retired buffers (only modified by the owner)
+		std::vector<Buffer*> pRetired;
+
+	}; // class StealingDeque
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
+
+#include "stealingdeque.hxx"
@@ -0,0 +1,174 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "stealingdeque.h"
+#include <cassert>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	template<class T>
+	inline StealingDeque<T>::Buffer::Buffer(uint32_t capacity)
+		: mask(static_cast<int64_t>(capacity) - 1)
+		, items(new std::atomic<T*>[capacity])
+	{
+		assert(capacity != 0 and (capacity & (capacity - 1)) == 0 and "capacity must be a power of 2");
+	}
+
+
+	template<class T>
+	inline T* StealingDeque<T>::Buffer::get(int64_t index) const
+	{
+		return items[index & mask].load(std::memory_order_relaxed);
+	}
+
+
+	template<class T>
+	inline void StealingDeque<T>::Buffer::put(int64_t index, T* item)
+	{
+		items[index & mask].store(item, std::memory_order_relaxed);
+	}
+
+
+	template<class T>
+	typename StealingDeque<T>::Buffer*
+	StealingDeque<T>::Buffer::grow(int64_t bottom, int64_t top) const
+	{
+		auto* newbuffer = new Buffer(static_cast<uint32_t>((mask + 1) * 2));
+		for (int64_t i = top; i != bottom; ++i)
+			newbuffer->put(i, get(i));
+		return newbuffer;
+	}
+
+
+
+
+	template<class T>
+	inline StealingDeque<T>::StealingDeque(uint32_t capacity)
+		: pTop(0)
+		, pBottom(0)
+		, pBuffer(new Buffer(capacity))
+	{}
+
+
+	template<class T>
+	StealingDeque<T>::~StealingDeque()
+	{
+		Buffer* buffer = pBuffer.load(std::memory_order_relaxed);
+		delete[] buffer->items;
+		delete buffer;
+		for (auto* retired: pRetired)
+		{
+			delete[] retired->items;
+			delete retired;
+		}
+	}
+
+
+	template<class T>
+	void StealingDeque<T>::push(T* item)
+	{
+		int64_t bottom = pBottom.load(std::memory_order_relaxed);
+		int64_t top = pTop.load(std::memory_order_acquire);
+		Buffer* buffer = pBuffer.load(std::memory_order_relaxed);
+
+		if (YUNI_UNLIKELY(bottom - top > buffer->mask))
+		{
+			// full - the old buffer can not be released yet since thieves
+			// may still be reading from it
+			pRetired.push_back(buffer);
+			buffer = buffer->grow(bottom, top);
+			pBuffer.store(buffer, std::memory_order_release);
+		}
+
+		buffer->put(bottom, item);
+		std::atomic_thread_fence(std::memory_order_release);
+		pBottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+
+	template<class T>
+	T* StealingDeque<T>::pop()
+	{
+		int64_t bottom = pBottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buffer = pBuffer.load(std::memory_order_relaxed);
+		pBottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = pTop.load(std::memory_order_relaxed);
+
+		if (top <= bottom)
+		{
+			T* item = buffer->get(bottom);
+			if (top == bottom)
+			{
+				// last element - racing against thieves
+				if (not pTop.compare_exchange_strong(top, top + 1,
+					std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+				pBottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+		// empty
+		pBottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+
+	template<class T>
+	typename StealingDeque<T>::Steal StealingDeque<T>::steal(T*& out)
+	{
+		int64_t top = pTop.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = pBottom.load(std::memory_order_acquire);
+
+		if (top < bottom)
+		{
+			Buffer* buffer = pBuffer.load(std::memory_order_acquire);
+			T* item = buffer->get(top);
+			if (not pTop.compare_exchange_strong(top, top + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed))
+				return Steal::abort;
+			out = item;
+			return Steal::success;
+		}
+		return Steal::empty;
+	}
+
+
+	template<class T>
+	inline uint32_t StealingDeque<T>::size() const
+	{
+		int64_t bottom = pBottom.load(std::memory_order_relaxed);
+		int64_t top = pTop.load(std::memory_order_relaxed);
+		return (bottom > top) ? static_cast<uint32_t>(bottom - top) : 0u;
+	}
+
+
+	template<class T>
+	inline bool StealingDeque<T>::empty() const
+	{
+		return 0 == size();
+	}
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
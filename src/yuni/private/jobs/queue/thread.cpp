@@ -19,45 +19,183 @@ namespace Private
 namespace QueueService
 {
 
+	namespace
+	{
+
+	//! The worker attached to the calling thread, if any
+	thread_local QueueThread* currentWorker = nullptr;
+
+
+	//! Take ownership of a job previously pushed onto a local deque
+	inline void adopt(Yuni::Job::IJob::Ptr& out, Yuni::Job::IJob* job)
+	{
+		out = job;
+		// the reference acquired in pushLocal() is no longer needed
+		job->release();
+	}
+
+
+	} // anonymous namespace
+
+
+
+
+	QueueThread* QueueThread::Current()
+	{
+		return currentWorker;
+	}
+
 
 	inline void QueueThread::notifyEndOfWork()
 	{
 		// Notify the scheduler that this thread goes to sleep
-		pQueueService.unregisterWorker(this);
+		pQueueService.unregisterWorker(*this);
 	}
 
 
-	bool QueueThread::onExecute()
+	bool QueueThread::onStarting()
 	{
-		// Notify the scheduler that this thread has begun its work
-		pQueueService.registerWorker(this);
+		currentWorker = this;
+		return true;
+	}
+
 
-		// Asking for the next job
-		while (pQueueService.pWaitingRoom.pop(pJob))
+	void QueueThread::pushLocal(const Yuni::Job::IJob::Ptr& job, Yuni::Job::Priority priority, uint64_t time)
+	{
+		assert(currentWorker == this and "pushLocal must be called from the worker itself");
+		// the local deque does not take the priority into account, only the statistics
+		Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>::AddedInTheWaitingRoom(*job, priority, time);
+		pStatistics.enqueued(1);
+		// the deque only stores raw pointers, keeping a reference until the job is popped
+		job->addRef();
+		pLocalJobs.push(const_cast<Yuni::Job::IJob*>(job.pointer()));
+	}
+
+
+	bool QueueThread::popLocal(Yuni::Job::IJob::Ptr& out)
+	{
+		Yuni::Job::IJob* job = pLocalJobs.pop();
+		if (job)
 		{
-			// Execute the job, via a wrapper for symbol visibility issues
-			Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>::Execute(*pJob, this);
-
-			// We must release our pointer to the job here to avoid its destruction
-			// in `pQueueService.nextJob()` (when `pJob` is re-assigned).
-			// This method uses a lock and the destruction of the job may take some time.
-			// Obviously, there is absolutely no guarantee that the job will be destroyed
-			// at this point but we don't really care
-			pJob = nullptr;
+			adopt(out, job);
+			return true;
+		}
+		return false;
+	}
 
-			// Cancellation point
-			if (YUNI_UNLIKELY(shouldAbort())) // We have to stop as soon as possible, no need for hibernation
-				return false;
 
-		} // loop for retrieving jobs to execute
+	QueueThread::LocalJobs::Steal QueueThread::stealLocal(Yuni::Job::IJob::Ptr& out)
+	{
+		Yuni::Job::IJob* job = nullptr;
+		auto result = pLocalJobs.steal(job);
+		if (result == LocalJobs::Steal::success)
+			adopt(out, job);
+		return result;
+	}
 
-		// Returning true, for hibernation
-		return true;
+
+	void QueueThread::clearLocal()
+	{
+		Yuni::Job::IJob::Ptr job;
+		while (not pLocalJobs.empty())
+		{
+			stealLocal(job);
+			job = nullptr;
+		}
+	}
+
+
+	void QueueThread::drainLocal()
+	{
+		Yuni::Job::IJob::Ptr job;
+		while (not pLocalJobs.empty())
+		{
+			if (stealLocal(job) == LocalJobs::Steal::success)
+			{
+				using Accessor = Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>;
+				pQueueService.pWaitingRoom.add(job, Accessor::Priority(*job));
+				job = nullptr;
+			}
+		}
+	}
+
+
+	bool QueueThread::onExecute()
+	{
+		// Notify the scheduler that this thread has begun its work
+		pQueueService.registerWorker(*this);
+
+		do
+		{
+			bool firstJob = true;
+			// Asking for the next job
+			while (pQueueService.nextJob(pJob, *this))
+			{
+				// We have been woken up for a single job. Other workers may be
+				// needed for the remaining ones
+				if (firstJob)
+				{
+					firstJob = false;
+					if (pQueueService.hasWaitingJobs())
+						pQueueService.wakeupWorkers();
+				}
+
+				using Accessor = Yuni::Private::QueueService::JobAccessor<Yuni::Job::IJob>;
+				uint64_t enqueuedAt = Accessor::EnqueuedAt(*pJob);
+				auto priority = Accessor::Priority(*pJob);
+				uint64_t startedAt = MonotonicTime();
+				// the timestamp may be more recent if the job has been added again meanwhile
+				uint64_t queueWait = (startedAt > enqueuedAt) ? (startedAt - enqueuedAt) : 0;
+
+				// the jobs are waiting for too long, more workers may be needed (auto-scaling)
+				if (YUNI_UNLIKELY(queueWait > pQueueService.pScaleUpQueueWait))
+					pQueueService.scaleUp();
+
+				// the events are recorded before and after the execution, the job may be
+				// added again meanwhile (and its timestamp changed)
+				bool tracing = pQueueService.pTracer.enabled();
+				if (YUNI_UNLIKELY(tracing))
+					pQueueService.pTracer.started(*pJob, startedAt);
+
+				// Execute the job, via a wrapper for symbol visibility issues
+				Accessor::Execute(*pJob, this);
+
+				uint64_t now = MonotonicTime();
+				if (YUNI_UNLIKELY(tracing))
+					pQueueService.pTracer.finished(*pJob, now);
+				pStatistics.executed(static_cast<uint>(priority), queueWait, now - startedAt);
+
+				// We must release our pointer to the job here to avoid its destruction
+				// in `pQueueService.nextJob()` (when `pJob` is re-assigned).
+				// This method uses a lock and the destruction of the job may take some time.
+				// Obviously, there is absolutely no guarantee that the job will be destroyed
+				// at this point but we don't really care
+				pJob = nullptr;
+
+				// Cancellation point
+				if (YUNI_UNLIKELY(shouldAbort())) // We have to stop as soon as possible, no need for hibernation
+					return false;
+
+			} // loop for retrieving jobs to execute
+
+			// spin then park until some work is available
+			uint64_t idleSince = MonotonicTime();
+			bool resume = pQueueService.waitForJob(*this);
+			pStatistics.idle(MonotonicTime() - idleSince);
+			if (not resume)
+				break;
+		}
+		while (true);
+
+		// the thread should stop
+		return false;
 	}
 
 
 	void QueueThread::onStop()
 	{
+		// jobs not executed yet will be kept for the next start
+		drainLocal();
 		notifyEndOfWork(); // we are done here !
 	}
 
@@ -79,6 +217,8 @@ namespace QueueService
 			pJob = nullptr;
 		}
 
+		// the thread is no longer running, the local deque can safely be emptied from here
+		drainLocal();
 		notifyEndOfWork(); // we are done here !
 	}
 
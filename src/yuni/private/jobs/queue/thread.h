@@ -12,6 +12,9 @@
 #include "../../../thread/thread.h"
 #include "../../../job/queue/service.h"
 #include "../../../thread/signal.h"
+#include "stealingdeque.h"
+#include "statistics.h"
+#include "../../../job/scratch.h"
 
 
 
@@ -31,6 +34,8 @@ namespace QueueService
 	public:
 		//! The most suitable smart pointer for the class
 		typedef Yuni::Thread::IThread::Ptr::Promote<QueueThread>::Ptr Ptr;
+		//! Local deque of jobs, for work stealing
+		typedef StealingDeque<Yuni::Job::IJob> LocalJobs;
 
 	public:
 		//! \name Constructor & Destructor
@@ -38,7 +43,7 @@ namespace QueueService
 		/*!
 		** \brief Default Constructor
 		*/
-		explicit QueueThread(Yuni::Job::QueueService& queueservice);
+		explicit QueueThread(Yuni::Job::QueueService& queueservice, uint32_t index);
 		//! Destructor
 		virtual ~QueueThread();
 		//@}
@@ -48,8 +53,45 @@ namespace QueueService
 		*/
 		Yuni::Job::IJob::Ptr currentJob() const;
 
+		//! Get the queueservice owning this thread
+		const Yuni::Job::QueueService* queueservice() const;
+		//! Get the index of the thread within the pool
+		uint32_t index() const;
+
+		/*!
+		** \brief Get the worker attached to the calling thread
+		**
+		** \return The worker, nullptr if the calling thread is not a worker
+		*/
+		static QueueThread* Current();
+
+
+		//! \name Work stealing
+		//@{
+		//! Push a job onto the local deque (must be called from this thread)
+		void pushLocal(const Yuni::Job::IJob::Ptr& job, Yuni::Job::Priority priority, uint64_t time);
+		//! Pop a job from the local deque (must be called from this thread)
+		bool popLocal(Yuni::Job::IJob::Ptr& out);
+		//! Try to steal a job from the local deque (any thread)
+		LocalJobs::Steal stealLocal(Yuni::Job::IJob::Ptr& out);
+		//! Get the number of jobs in the local deque (approximation)
+		uint localJobsCount() const;
+		//! Remove all jobs from the local deque
+		void clearLocal();
+		//! Get a pseudo-random number (this thread only)
+		uint32_t randomNumber();
+		//@}
+
+		//! Get the counters of this thread
+		const WorkerStatistics& statistics() const;
+
+		//! Get the scratch arena of this thread (see Job::ScratchArena)
+		Yuni::Job::ScratchArena& scratch();
+
 
 	protected:
+		//! Implementation of the `onStarting` method to register the current worker
+		virtual bool onStarting() override;
 		//! Implementation of the `onExecute` method to run the jobs from the waiting room
 		virtual bool onExecute() override;
 		//! Implementation of the `onKill` method when the thread is killed without mercy
@@ -62,12 +104,33 @@ namespace QueueService
 	private:
 		//! Notify the queueservice that we have stopped to work
 		void notifyEndOfWork();
+		//! Move all jobs from the local deque back into the waiting room
+		void drainLocal();
 
 	private:
 		//! The scheduler
 		Yuni::Job::QueueService& pQueueService;
 		//! The current job
 		Yuni::Job::IJob::Ptr pJob;
+		//! Jobs created by this worker (work stealing only)
+		LocalJobs pLocalJobs;
+		//! State of the pseudo-random generator (xorshift)
+		uint32_t pRandomState;
+		//! Counters (only modified by this thread)
+		WorkerStatistics pStatistics;
+		//! Temporary allocations of the jobs (only used by this thread)
+		Yuni::Job::ScratchArena pScratch;
+		//! Index of the thread within the pool
+		const uint32_t pIndex;
+		//! NUMA node the thread is pinned to (0 if not pinned)
+		uint32_t pNumaNode = 0;
+		//! Flag to know if the thread is in active duty (see QueueService::registerWorker)
+		bool pActive = false;
+		//! Flag to know if the thread is not part of the running pool (auto-scaling) [protected by the queueservice]
+		bool pDormant = false;
+
+		// Nakama !
+		friend class Yuni::Job::QueueService;
 
 	}; // class QueueThread
 
@@ -20,8 +20,10 @@ namespace Private
 namespace QueueService
 {
 
-	inline QueueThread::QueueThread(Yuni::Job::QueueService& queueservice)
+	inline QueueThread::QueueThread(Yuni::Job::QueueService& queueservice, uint32_t index)
 		: pQueueService(queueservice)
+		, pRandomState((index + 1) * 2654435761u)
+		, pIndex(index)
 	{}
 
 
@@ -38,6 +40,47 @@ namespace QueueService
 	}
 
 
+	inline const Yuni::Job::QueueService* QueueThread::queueservice() const
+	{
+		return &pQueueService;
+	}
+
+
+	inline uint32_t QueueThread::index() const
+	{
+		return pIndex;
+	}
+
+
+	inline uint QueueThread::localJobsCount() const
+	{
+		return pLocalJobs.size();
+	}
+
+
+	inline uint32_t QueueThread::randomNumber()
+	{
+		uint32_t x = pRandomState;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		pRandomState = x;
+		return x;
+	}
+
+
+	inline Yuni::Job::ScratchArena& QueueThread::scratch()
+	{
+		return pScratch;
+	}
+
+
+	inline const WorkerStatistics& QueueThread::statistics() const
+	{
+		return pStatistics;
+	}
+
+
 	inline void WaitingRoom::add(const Yuni::Job::IJob::Ptr& job)
 	{
 		add(job, Yuni::Job::Priority::normal);
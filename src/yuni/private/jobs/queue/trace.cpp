@@ -0,0 +1,406 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "trace.h"
+#include "thread.h"
+#include "statistics.h"
+#include "../../../job/job.h"
+#include "../../../thread/id.h"
+#include <algorithm>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	namespace // anonymous
+	{
+
+		//! Source of the unique IDs of the tracers
+		std::atomic<uint64_t> nextTracerID {1};
+
+
+		//! A buffer recently used by the calling thread
+		struct CachedBuffer final
+		{
+			uint64_t tracer = 0;
+			std::shared_ptr<TraceBuffer> buffer;
+		};
+
+		//! Buffers recently used by the calling thread (a thread rarely uses more than one queueservice)
+		struct CachedBuffers final
+		{
+			~CachedBuffers()
+			{
+				// the thread is terminating: its tracers may release the buffers
+				for (auto& entry: entries)
+				{
+					if (entry.buffer)
+						entry.buffer->retire();
+				}
+			}
+
+			CachedBuffer entries[4];
+			//! The next entry to replace
+			uint next = 0;
+		};
+
+		thread_local CachedBuffers cachedBuffers;
+
+
+		inline uint64_t mix(uint64_t x)
+		{
+			// splitmix64 finalizer
+			x ^= x >> 30;
+			x *= 0xbf58476d1ce4e5b9ull;
+			x ^= x >> 27;
+			x *= 0x94d049bb133111ebull;
+			x ^= x >> 31;
+			return x;
+		}
+
+
+		inline uint64_t roundUpToPowerOfTwo(uint64_t x)
+		{
+			uint64_t result = 1;
+			while (result < x)
+				result <<= 1;
+			return result;
+		}
+
+
+		//! Append a timestamp in microseconds with 3 decimals
+		void appendMicroseconds(Clob& out, uint64_t ns)
+		{
+			out << (ns / 1000) << '.';
+			uint64_t fraction = ns % 1000;
+			if (fraction < 100)
+				out << '0';
+			if (fraction < 10)
+				out << '0';
+			out << fraction;
+		}
+
+
+		//! Append the beginning of an event, up to the timestamp (included)
+		void appendEvent(Clob& out, const char* name, const char* phase, uint64_t pid, uint tid, uint64_t ns)
+		{
+			out << ",\n{\"name\":\"" << name << "\",\"cat\":\"job\",\"ph\":\"" << phase << "\",\"pid\":" << pid
+				<< ",\"tid\":" << tid << ",\"ts\":";
+			appendMicroseconds(out, ns);
+		}
+
+	} // anonymous namespace
+
+
+
+
+	TraceBuffer::TraceBuffer(uint capacity, const AnyString& name)
+		: pMask(roundUpToPowerOfTwo(capacity) - 1)
+		, pName(name)
+	{
+		pSlots.reset(new Slot[pMask + 1]);
+	}
+
+
+	void TraceBuffer::read(std::vector<TraceEvent>& out) const
+	{
+		uint64_t head = pHead.load(std::memory_order_acquire);
+		uint64_t capacity = pMask + 1;
+		uint64_t first = (head > capacity) ? (head - capacity) : 0;
+		uint64_t floor = pFloor.load(std::memory_order_relaxed);
+		if (first < floor)
+			first = floor;
+
+		size_t offset = out.size();
+		for (uint64_t i = first; i < head; ++i)
+		{
+			const Slot& slot = pSlots[i & pMask];
+			uint64_t typeAndArg = slot.typeAndArg.load(std::memory_order_relaxed);
+			out.push_back(TraceEvent{slot.time.load(std::memory_order_relaxed), slot.id.load(std::memory_order_relaxed),
+				static_cast<TraceEventType>(typeAndArg >> 32), static_cast<uint32_t>(typeAndArg)});
+		}
+
+		// the events overwritten meanwhile by the owner thread are discarded (the
+		// slot of the next event may be being written as well)
+		std::atomic_thread_fence(std::memory_order_acquire);
+		uint64_t current = pHead.load(std::memory_order_relaxed);
+		if (current + 1 > first + capacity)
+		{
+			uint64_t overwritten = std::min<uint64_t>(current + 1 - capacity - first, head - first);
+			out.erase(out.begin() + static_cast<ptrdiff_t>(offset),
+				out.begin() + static_cast<ptrdiff_t>(offset + overwritten));
+		}
+	}
+
+
+	void TraceBuffer::clear()
+	{
+		pFloor.store(pHead.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+
+
+
+
+	Tracer::Tracer(const Yuni::Job::QueueService& queueservice)
+		: pQueueService(queueservice)
+		, pID(nextTracerID.fetch_add(1, std::memory_order_relaxed))
+	{}
+
+
+	TraceBuffer& Tracer::local()
+	{
+		for (auto& entry: cachedBuffers.entries)
+		{
+			if (entry.tracer == pID)
+				return *entry.buffer;
+		}
+
+		// first event of the calling thread for this queueservice
+		String name;
+		auto* worker = QueueThread::Current();
+		if (worker and worker->queueservice() == &pQueueService)
+			name << "worker " << worker->index();
+		else
+			name << "thread " << Yuni::Thread::ID();
+
+		auto buffer = std::make_shared<TraceBuffer>(pCapacity.load(std::memory_order_relaxed), name);
+		{
+			Yuni::MutexLocker locker(pMutex);
+			releaseRetiredBuffersWL();
+			pBuffers.push_back(buffer);
+		}
+		CachedBuffer& entry = cachedBuffers.entries[cachedBuffers.next++ % 4];
+		// a thread using more than 4 queueservices gets a new buffer when coming back
+		if (entry.buffer)
+			entry.buffer->retire();
+		entry.tracer = pID;
+		entry.buffer = std::move(buffer);
+		return *entry.buffer;
+	}
+
+
+	void Tracer::releaseRetiredBuffersWL()
+	{
+		size_t retired = 0;
+		for (auto& buffer: pBuffers)
+			retired += (buffer->retired()) ? 1 : 0;
+		if (retired <= maxRetiredBuffers)
+			return;
+
+		// the oldest ones first, the events of the threads terminated recently are kept
+		size_t excess = retired - maxRetiredBuffers;
+		size_t kept = 0;
+		for (size_t i = 0; i != pBuffers.size(); ++i)
+		{
+			if (excess != 0 and pBuffers[i]->retired())
+				--excess;
+			else
+				pBuffers[kept++].swap(pBuffers[i]);
+		}
+		pBuffers.resize(kept);
+	}
+
+
+	inline uint64_t Tracer::idOf(const Yuni::Job::IJob& job) const
+	{
+		// the same job may be added several times, the timestamp distinguishes them
+		using Accessor = JobAccessor<Yuni::Job::IJob>;
+		uint64_t id = mix(reinterpret_cast<uintptr_t>(&job) ^ (Accessor::EnqueuedAt(job) * 0x9e3779b97f4a7c15ull));
+		uint sampling = pSampling.load(std::memory_order_relaxed);
+		if (sampling > 1 and (id % sampling) != 0)
+			return 0;
+		return (id != 0) ? id : 1;
+	}
+
+
+	void Tracer::enqueued(const Yuni::Job::IJob& job)
+	{
+		if (uint64_t id = idOf(job))
+		{
+			using Accessor = JobAccessor<Yuni::Job::IJob>;
+			local().push(TraceEventType::enqueued, Accessor::EnqueuedAt(job), id,
+				static_cast<uint32_t>(Accessor::Priority(job)));
+		}
+	}
+
+
+	void Tracer::stolen(const Yuni::Job::IJob& job, uint32_t victim)
+	{
+		if (uint64_t id = idOf(job))
+			local().push(TraceEventType::stolen, MonotonicTime(), id, victim);
+	}
+
+
+	void Tracer::started(const Yuni::Job::IJob& job, uint64_t time)
+	{
+		if (uint64_t id = idOf(job))
+		{
+			using Accessor = JobAccessor<Yuni::Job::IJob>;
+			local().push(TraceEventType::started, time, id, static_cast<uint32_t>(Accessor::Priority(job)));
+		}
+	}
+
+
+	void Tracer::finished(const Yuni::Job::IJob& job, uint64_t time)
+	{
+		if (uint64_t id = idOf(job))
+			local().push(TraceEventType::finished, time, id, 0);
+	}
+
+
+	void Tracer::woken(uint32_t worker)
+	{
+		local().push(TraceEventType::woken, MonotonicTime(), 0, worker);
+	}
+
+
+	void Tracer::parked(bool value)
+	{
+		local().push((value ? TraceEventType::parked : TraceEventType::unparked), MonotonicTime(), 0, 0);
+	}
+
+
+	void Tracer::dropped(const Yuni::Job::IJob& job)
+	{
+		if (uint64_t id = idOf(job))
+		{
+			using Accessor = JobAccessor<Yuni::Job::IJob>;
+			local().push(TraceEventType::dropped, MonotonicTime(), id,
+				static_cast<uint32_t>(Accessor::Priority(job)));
+		}
+	}
+
+
+	void Tracer::clear()
+	{
+		Yuni::MutexLocker locker(pMutex);
+		for (auto& buffer: pBuffers)
+			buffer->clear();
+	}
+
+
+	void Tracer::exportJSON(Clob& out) const
+	{
+		// copying all events first, the buffers are still written meanwhile
+		std::vector<std::vector<TraceEvent>> events;
+		std::vector<String> names;
+		{
+			Yuni::MutexLocker locker(pMutex);
+			events.resize(pBuffers.size());
+			names.reserve(pBuffers.size());
+			for (size_t i = 0; i != pBuffers.size(); ++i)
+			{
+				pBuffers[i]->read(events[i]);
+				names.push_back(pBuffers[i]->name());
+			}
+		}
+
+		// timestamps relative to the oldest event
+		uint64_t origin = (uint64_t) -1;
+		for (auto& list: events)
+		{
+			if (not list.empty() and list.front().time < origin)
+				origin = list.front().time;
+		}
+
+		static const char* const priorities[] = {"low", "normal", "high"};
+		const uint64_t pid = pID;
+
+		out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":0,\"args\":{\"name\":\"queueservice "
+			<< pid << "\"}}";
+
+		for (uint t = 0; t != static_cast<uint>(events.size()); ++t)
+		{
+			uint tid = t + 1;
+			out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+				<< ",\"args\":{\"name\":\"" << names[t] << "\"}}";
+
+			for (auto& event: events[t])
+			{
+				uint64_t ts = (event.time > origin) ? (event.time - origin) : 0;
+				const char* priority = priorities[(event.arg < 3) ? event.arg : 1];
+				switch (event.type)
+				{
+					case TraceEventType::enqueued:
+					{
+						appendEvent(out, "enqueue", "X", pid, tid, ts);
+						out << ",\"dur\":0,\"args\":{\"priority\":\"" << priority << "\"}}";
+						// flow from the producer to the worker
+						appendEvent(out, "job", "s", pid, tid, ts);
+						out << ",\"id\":\"0x";
+						out.appendFormat("%016llx", static_cast<unsigned long long>(event.id));
+						out << "\"}";
+						break;
+					}
+					case TraceEventType::started:
+					{
+						appendEvent(out, "job", "B", pid, tid, ts);
+						out << ",\"args\":{\"priority\":\"" << priority << "\"}}";
+						appendEvent(out, "job", "f", pid, tid, ts);
+						out << ",\"bp\":\"e\",\"id\":\"0x";
+						out.appendFormat("%016llx", static_cast<unsigned long long>(event.id));
+						out << "\"}";
+						break;
+					}
+					case TraceEventType::finished:
+					{
+						appendEvent(out, "job", "E", pid, tid, ts);
+						out << '}';
+						break;
+					}
+					case TraceEventType::stolen:
+					{
+						appendEvent(out, "steal", "i", pid, tid, ts);
+						out << ",\"s\":\"t\",\"args\":{\"victim\":" << event.arg << "}}";
+						break;
+					}
+					case TraceEventType::woken:
+					{
+						appendEvent(out, "wake", "i", pid, tid, ts);
+						out << ",\"s\":\"t\",\"args\":{\"worker\":" << event.arg << "}}";
+						break;
+					}
+					case TraceEventType::parked:
+					{
+						appendEvent(out, "idle", "B", pid, tid, ts);
+						out << '}';
+						break;
+					}
+					case TraceEventType::unparked:
+					{
+						appendEvent(out, "idle", "E", pid, tid, ts);
+						out << '}';
+						break;
+					}
+					case TraceEventType::dropped:
+					{
+						appendEvent(out, "drop", "i", pid, tid, ts);
+						out << ",\"s\":\"t\",\"args\":{\"priority\":\"" << priority << "\"}}";
+						break;
+					}
+				}
+			}
+		}
+		out << "\n]}\n";
+	}
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
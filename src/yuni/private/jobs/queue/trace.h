@@ -0,0 +1,223 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../../yuni.h"
+#include "../../../core/string.h"
+#include "../../../core/noncopyable.h"
+#include "../../../thread/mutex.h"
+#include "../../../job/fwd.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Yuni { namespace Job { class QueueService; }}
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	//! Type of a trace event
+	enum class TraceEventType : uint32_t
+	{
+		//! A job has been added to the queue (producer)
+		enqueued,
+		//! A worker starts to execute a job
+		started,
+		//! A worker has executed a job
+		finished,
+		//! A worker has stolen a job from another one (argument: the victim)
+		stolen,
+		//! A parked worker has been woken up (argument: the worker)
+		woken,
+		//! A worker goes to sleep
+		parked,
+		//! A worker has been woken up
+		unparked,
+		//! A job has been removed from a full queue (producer, argument: its priority)
+		dropped,
+	};
+
+
+	//! A trace event, as read from a buffer
+	struct TraceEvent final
+	{
+		//! Timestamp (ns, see MonotonicTime())
+		uint64_t time;
+		//! ID of the job (0 if none)
+		uint64_t id;
+		//! Type
+		TraceEventType type;
+		//! Argument (priority, worker index...)
+		uint32_t arg;
+	};
+
+
+
+
+	/*!
+	** \brief Ring buffer of trace events, written by a single thread
+	**
+	** The oldest events are overwritten once the buffer is full. The events can
+	** be read from any thread at any time: each field is a relaxed atomic and the
+	** events possibly overwritten while reading are discarded.
+	*/
+	class YUNI_DECL TraceBuffer final : private NonCopyable<TraceBuffer>
+	{
+	public:
+		/*!
+		** \brief Constructor
+		** \param capacity The number of events (rounded up to a power of 2)
+		** \param name Name of the thread
+		*/
+		TraceBuffer(uint capacity, const AnyString& name);
+
+		//! Add an event (owner thread only)
+		void push(TraceEventType type, uint64_t time, uint64_t id, uint32_t arg);
+
+		//! Get a copy of the events, the oldest first (any thread)
+		void read(std::vector<TraceEvent>& out) const;
+		//! Forget all events written so far (any thread)
+		void clear();
+
+		//! Name of the thread
+		const String& name() const;
+
+		//! Get if the owner thread does not write into the buffer anymore
+		bool retired() const;
+		//! The owner thread does not write into the buffer anymore (terminated)
+		void retire();
+
+	private:
+		//! Storage of an event
+		struct Slot final
+		{
+			std::atomic<uint64_t> time;
+			std::atomic<uint64_t> id;
+			//! Type (high 32 bits) and argument
+			std::atomic<uint64_t> typeAndArg;
+		};
+
+		//! All events
+		std::unique_ptr<Slot[]> pSlots;
+		//! Capacity - 1
+		const uint64_t pMask;
+		//! Number of events written so far
+		std::atomic<uint64_t> pHead {0};
+		//! Events below this index have been cleared
+		std::atomic<uint64_t> pFloor {0};
+		//! Name of the thread
+		const String pName;
+		//! Flag to know if the owner thread does not write anymore
+		std::atomic<bool> pRetired {false};
+
+	}; // class TraceBuffer
+
+
+
+
+	/*!
+	** \brief Recorder of the scheduling events of a queueservice
+	**
+	** Each thread writes into its own ring buffer (created on its first event and
+	** found again from a small thread-local cache), without lock or allocation.
+	** The buffer is retired when its thread terminates, and only the most recent
+	** retired buffers are kept (see `maxRetiredBuffers`), thus the memory does not
+	** grow with short-lived producer threads.
+	** With sampling, only one job out of N is recorded, all events of a job (added,
+	** stolen, started, finished) being kept or dropped together. Parking and
+	** waking up workers are always recorded.
+	*/
+	class YUNI_DECL Tracer final : private NonCopyable<Tracer>
+	{
+	public:
+		enum
+		{
+			//! Maximum number of buffers kept after the termination of their thread
+			maxRetiredBuffers = 8,
+		};
+
+	public:
+		//! Constructor
+		explicit Tracer(const Yuni::Job::QueueService& queueservice);
+
+		//! Get if the events are recorded
+		bool enabled() const;
+		//! Start or stop recording
+		void enabled(bool value);
+		//! Get the sampling (one job out of N)
+		uint sampling() const;
+		//! Set the sampling (1 to record all jobs)
+		void sampling(uint value);
+		//! Get the number of events per thread
+		uint capacity() const;
+		//! Set the number of events per thread (for the threads without buffer yet)
+		void capacity(uint value);
+
+		//! A job has been added to the queue (after its timestamp has been set)
+		void enqueued(const Yuni::Job::IJob& job);
+		//! A worker has stolen a job
+		void stolen(const Yuni::Job::IJob& job, uint32_t victim);
+		//! A worker starts to execute a job
+		void started(const Yuni::Job::IJob& job, uint64_t time);
+		//! A worker has executed a job
+		void finished(const Yuni::Job::IJob& job, uint64_t time);
+		//! A parked worker has been woken up
+		void woken(uint32_t worker);
+		//! A worker goes to sleep (or has been woken up)
+		void parked(bool value);
+		//! A job has been removed from a full queue
+		void dropped(const Yuni::Job::IJob& job);
+
+		//! Export all events as Chrome trace JSON (chrome://tracing, Perfetto)
+		void exportJSON(Clob& out) const;
+		//! Forget all events recorded so far
+		void clear();
+
+	private:
+		//! ID of a job for the trace (0 if not sampled)
+		uint64_t idOf(const Yuni::Job::IJob& job) const;
+		//! Get the buffer of the calling thread
+		TraceBuffer& local();
+		//! Release the oldest retired buffers, above the limit [with the mutex locked]
+		void releaseRetiredBuffersWL();
+
+	private:
+		//! Flag to record the events
+		std::atomic<bool> pEnabled {false};
+		//! Sampling (one job out of N)
+		std::atomic<uint> pSampling {1};
+		//! Number of events per buffer
+		std::atomic<uint> pCapacity {16384};
+		//! The queueservice
+		const Yuni::Job::QueueService& pQueueService;
+		//! Unique ID (for the thread-local caches, and the process ID of the trace)
+		const uint64_t pID;
+		//! Mutex for the list of buffers
+		mutable Yuni::Mutex pMutex;
+		//! All buffers, one per thread (shared with the thread-local caches)
+		std::vector<std::shared_ptr<TraceBuffer>> pBuffers;
+
+	}; // class Tracer
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
+
+#include "trace.hxx"
@@ -0,0 +1,97 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "trace.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace QueueService
+{
+
+	inline void TraceBuffer::push(TraceEventType type, uint64_t time, uint64_t id, uint32_t arg)
+	{
+		uint64_t head = pHead.load(std::memory_order_relaxed);
+		// the slot must not be overwritten before the previous index is visible (see read())
+		std::atomic_thread_fence(std::memory_order_release);
+		Slot& slot = pSlots[head & pMask];
+		slot.time.store(time, std::memory_order_relaxed);
+		slot.id.store(id, std::memory_order_relaxed);
+		slot.typeAndArg.store((static_cast<uint64_t>(type) << 32) | arg, std::memory_order_relaxed);
+		pHead.store(head + 1, std::memory_order_release);
+	}
+
+
+	inline const String& TraceBuffer::name() const
+	{
+		return pName;
+	}
+
+
+	inline bool TraceBuffer::retired() const
+	{
+		return pRetired.load(std::memory_order_acquire);
+	}
+
+
+	inline void TraceBuffer::retire()
+	{
+		pRetired.store(true, std::memory_order_release);
+	}
+
+
+
+
+	inline bool Tracer::enabled() const
+	{
+		return pEnabled.load(std::memory_order_relaxed);
+	}
+
+
+	inline void Tracer::enabled(bool value)
+	{
+		pEnabled.store(value, std::memory_order_relaxed);
+	}
+
+
+	inline uint Tracer::sampling() const
+	{
+		return pSampling.load(std::memory_order_relaxed);
+	}
+
+
+	inline void Tracer::sampling(uint value)
+	{
+		pSampling.store((value != 0) ? value : 1, std::memory_order_relaxed);
+	}
+
+
+	inline uint Tracer::capacity() const
+	{
+		return pCapacity.load(std::memory_order_relaxed);
+	}
+
+
+	inline void Tracer::capacity(uint value)
+	{
+		pCapacity.store((value >= 16) ? value : 16, std::memory_order_relaxed);
+	}
+
+
+
+
+
+} // namespace QueueService
+} // namespace Private
+} // namespace Yuni
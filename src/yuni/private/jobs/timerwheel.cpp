@@ -0,0 +1,171 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "timerwheel.h"
+#include <cassert>
+#ifdef YUNI_OS_MSVC
+	#include <intrin.h>
+#endif
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	namespace // anonymous
+	{
+
+		//! Index of the most significant bit (value must not be null)
+		inline uint HighestBit(uint64_t value)
+		{
+#if defined(YUNI_OS_GCC) || defined(YUNI_OS_CLANG)
+			return 63u - static_cast<uint>(__builtin_clzll(value));
+#elif defined(YUNI_OS_MSVC) && defined(YUNI_OS_64)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return static_cast<uint>(index);
+#else
+			uint index = 0;
+			while (value >>= 1)
+				++index;
+			return index;
+#endif
+		}
+
+
+		//! Index of the least significant bit (value must not be null)
+		inline uint LowestBit(uint64_t value)
+		{
+#if defined(YUNI_OS_GCC) || defined(YUNI_OS_CLANG)
+			return static_cast<uint>(__builtin_ctzll(value));
+#elif defined(YUNI_OS_MSVC) && defined(YUNI_OS_64)
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return static_cast<uint>(index);
+#else
+			uint index = 0;
+			while ((value & 1) == 0)
+			{
+				value >>= 1;
+				++index;
+			}
+			return index;
+#endif
+		}
+
+
+		//! Rotate the bits to the right
+		inline uint64_t RotateRight(uint64_t value, uint count)
+		{
+			return (count == 0) ? value : ((value >> count) | (value << (64 - count)));
+		}
+
+
+	} // anonymous namespace
+
+
+
+
+	void TimerWheel::insert(TimerWheelNode& node)
+	{
+		assert(not node.linked and "the node is already in the wheel");
+		assert(node.expires > pNow and "the deadline must be in the future");
+
+		uint64_t delay = node.expires - pNow;
+		if (YUNI_UNLIKELY(delay > maxDelay))
+		{
+			delay = maxDelay;
+			node.expires = pNow + maxDelay;
+		}
+
+		// the lowest level whose rotation can hold the delay
+		uint level = HighestBit(delay) / slotBits;
+		uint slot = static_cast<uint>((node.expires >> (level * slotBits)) & (slotCount - 1));
+
+		TimerWheelNode*& head = pSlots[level][slot];
+		node.prev = nullptr;
+		node.next = head;
+		if (head)
+			head->prev = &node;
+		head = &node;
+		node.level = static_cast<uint8_t>(level);
+		node.slot = static_cast<uint8_t>(slot);
+		node.linked = true;
+		pOccupied[level] |= uint64_t(1) << slot;
+		++pCount;
+	}
+
+
+	void TimerWheel::remove(TimerWheelNode& node)
+	{
+		if (not node.linked)
+			return;
+
+		if (node.prev)
+			node.prev->next = node.next;
+		else
+		{
+			pSlots[node.level][node.slot] = node.next;
+			if (not node.next)
+				pOccupied[node.level] &= ~(uint64_t(1) << node.slot);
+		}
+		if (node.next)
+			node.next->prev = node.prev;
+
+		node.prev = nullptr;
+		node.next = nullptr;
+		node.linked = false;
+		--pCount;
+	}
+
+
+	TimerWheelNode* TimerWheel::detach(uint level, uint slot)
+	{
+		TimerWheelNode* head = pSlots[level][slot];
+		pSlots[level][slot] = nullptr;
+		pOccupied[level] &= ~(uint64_t(1) << slot);
+		return head;
+	}
+
+
+	uint64_t TimerWheel::nextEvent() const
+	{
+		uint64_t result = noEvent;
+		for (uint level = 0; level != levelCount; ++level)
+		{
+			uint64_t occupied = pOccupied[level];
+			if (occupied == 0)
+				continue;
+
+			// the current slot has already been processed, thus the first
+			// slot to come is the next one, up to a whole rotation
+			uint shift = level * slotBits;
+			uint64_t base = pNow >> shift;
+			uint current = static_cast<uint>(base & (slotCount - 1));
+			uint64_t distance = LowestBit(RotateRight(occupied, (current + 1) & (slotCount - 1))) + 1;
+			uint64_t tick = (base + distance) << shift;
+			if (tick < result)
+				result = tick;
+		}
+		return result;
+	}
+
+
+
+
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
@@ -0,0 +1,141 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include "../../core/noncopyable.h"
+#include <cstdint>
+#include <cstddef>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	//! Intrusive node of a timer wheel
+	struct TimerWheelNode
+	{
+		//! Previous node in the same slot
+		TimerWheelNode* prev = nullptr;
+		//! Next node in the same slot
+		TimerWheelNode* next = nullptr;
+		//! Tick when the node expires
+		uint64_t expires = 0;
+		//! Level of the slot holding the node
+		uint8_t level = 0;
+		//! Index of the slot holding the node
+		uint8_t slot = 0;
+		//! Flag to know if the node is currently in the wheel
+		bool linked = false;
+	};
+
+
+	/*!
+	** \brief Hierarchical timing wheel
+	**
+	** Each level has 64 slots, each slot of a level covering a whole rotation of
+	** the level below: 64 ticks for the first level, then 4096 ticks, etc. A node
+	** is inserted into the lowest level able to hold its deadline, then moved down
+	** ("cascaded") when the time reaches its slot. Insertion and removal are O(1),
+	** and the next deadline is found with a few bit scans, without walking any
+	** empty slot. With 6 levels and 1 tick per millisecond, deadlines up to ~2 years
+	** can be scheduled (longer deadlines are clamped).
+	**
+	** This class is not thread-safe.
+	*/
+	class YUNI_DECL TimerWheel final : private NonCopyable<TimerWheel>
+	{
+	public:
+		//! Number of levels
+		constexpr static uint levelCount = 6;
+		//! Number of bits for the slot index within a level
+		constexpr static uint slotBits = 6;
+		//! Number of slots per level
+		constexpr static uint slotCount = 1u << slotBits;
+		//! Highest delay, in ticks
+		constexpr static uint64_t maxDelay = (uint64_t(1) << (levelCount * slotBits)) - 1;
+		//! Value returned by `nextEvent()` when the wheel is empty
+		constexpr static uint64_t noEvent = UINT64_MAX;
+
+	public:
+		//! Constructor, with the current tick
+		explicit TimerWheel(uint64_t now);
+
+		//! Get the current tick
+		uint64_t now() const;
+		//! Get the number of nodes in the wheel
+		size_t size() const;
+
+		/*!
+		** \brief Insert a node
+		**
+		** \param node A node not in the wheel, with a deadline strictly in the future
+		*/
+		void insert(TimerWheelNode& node);
+		//! Remove a node from the wheel (no effect if not in the wheel)
+		void remove(TimerWheelNode& node);
+
+		/*!
+		** \brief Get the next tick when the wheel has something to do
+		**
+		** It may be earlier than the next deadline (when some nodes must be
+		** cascaded) but never later.
+		** \return The tick, `noEvent` if the wheel is empty
+		*/
+		uint64_t nextEvent() const;
+
+		/*!
+		** \brief Move the time forward
+		**
+		** `expired(node)` is called for each node reaching its deadline, in
+		** chronological order. The node is no longer in the wheel at this point
+		** and may be inserted again (but no other node may be removed).
+		** \param time The new current tick (ignored if in the past)
+		** \param expired A functor / lambda `void (TimerWheelNode&)`
+		*/
+		template<class ExpiredT> void advance(uint64_t time, const ExpiredT& expired);
+
+		/*!
+		** \brief Call `callback(node)` for each node in the wheel
+		**
+		** The wheel must not be modified meanwhile.
+		*/
+		template<class CallbackT> void each(const CallbackT& callback);
+
+	private:
+		//! Take all nodes of a slot (the slot is empty afterwards)
+		TimerWheelNode* detach(uint level, uint slot);
+
+	private:
+		//! Current tick
+		uint64_t pNow;
+		//! Number of nodes
+		size_t pCount = 0;
+		//! Bitmap of the non-empty slots, for each level
+		uint64_t pOccupied[levelCount] = {};
+		//! Head of the list of each slot
+		TimerWheelNode* pSlots[levelCount][slotCount] = {};
+
+	}; // class TimerWheel
+
+
+
+
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
+
+#include "timerwheel.hxx"
@@ -0,0 +1,101 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "timerwheel.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Jobs
+{
+
+	inline TimerWheel::TimerWheel(uint64_t now)
+		: pNow(now)
+	{}
+
+
+	inline uint64_t TimerWheel::now() const
+	{
+		return pNow;
+	}
+
+
+	inline size_t TimerWheel::size() const
+	{
+		return pCount;
+	}
+
+
+	template<class ExpiredT>
+	void TimerWheel::advance(uint64_t time, const ExpiredT& expired)
+	{
+		do
+		{
+			uint64_t tick = nextEvent();
+			if (tick > time)
+				break;
+			pNow = tick;
+
+			// from the highest level, so that the nodes cascaded into the
+			// current slot of the first level are processed as well
+			for (uint level = levelCount; level-- > 0; )
+			{
+				uint shift = level * slotBits;
+				if (level != 0 and (tick & ((uint64_t(1) << shift) - 1)) != 0)
+					continue; // not the beginning of a slot of this level
+				uint slot = static_cast<uint>((tick >> shift) & (slotCount - 1));
+				TimerWheelNode* node = detach(level, slot);
+				while (node)
+				{
+					TimerWheelNode* next = node->next;
+					node->prev = nullptr;
+					node->next = nullptr;
+					node->linked = false;
+					--pCount;
+					if (node->expires <= tick)
+						expired(*node);
+					else
+						insert(*node); // back into a lower level
+					node = next;
+				}
+			}
+		}
+		while (true);
+
+		if (time > pNow)
+			pNow = time;
+	}
+
+
+	template<class CallbackT>
+	void TimerWheel::each(const CallbackT& callback)
+	{
+		for (uint level = 0; level != levelCount; ++level)
+		{
+			if (pOccupied[level] == 0)
+				continue;
+			for (uint slot = 0; slot != slotCount; ++slot)
+			{
+				for (TimerWheelNode* node = pSlots[level][slot]; node; node = node->next)
+					callback(*node);
+			}
+		}
+	}
+
+
+
+
+} // namespace Jobs
+} // namespace Private
+} // namespace Yuni
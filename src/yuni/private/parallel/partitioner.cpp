@@ -0,0 +1,127 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "partitioner.h"
+#include "../thread/futex.h"
+#include "../../job/queue/service.h"
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Parallel
+{
+
+	namespace // anonymous
+	{
+
+		//! Number of chunks per participant, for an automatic grain
+		constexpr static size_t chunksPerParticipant = 128;
+		//! Number of spin rounds before sleeping in `wait()`
+		constexpr static uint spinRounds = 256;
+
+	} // anonymous namespace
+
+
+
+
+	Partitioner::Partitioner(size_t count, size_t grain, uint participants)
+		: pNext(0)
+		, pCompleted(0)
+		, pFinished(0)
+		, pAborted(false)
+		, pCount(count)
+		, pGrain((grain != 0) ? grain : (count / (participants * chunksPerParticipant) + 1))
+		, pDivisor(2 * static_cast<size_t>(participants))
+	{}
+
+
+	bool Partitioner::next(size_t& begin, size_t& end)
+	{
+		size_t current = pNext.load(std::memory_order_relaxed);
+		do
+		{
+			if (current >= pCount)
+				return false;
+			size_t remaining = pCount - current;
+			size_t chunk = remaining / pDivisor;
+			if (chunk < pGrain)
+				chunk = pGrain;
+			if (chunk > remaining)
+				chunk = remaining;
+
+			if (pNext.compare_exchange_weak(current, current + chunk, std::memory_order_relaxed))
+			{
+				begin = current;
+				end = current + chunk;
+				return true;
+			}
+		}
+		while (true);
+	}
+
+
+	void Partitioner::done(size_t count)
+	{
+		if (pCompleted.fetch_add(count, std::memory_order_acq_rel) + count == pCount)
+		{
+			pFinished.store(1, std::memory_order_release);
+			Private::Thread::FutexWakeAll(pFinished);
+		}
+	}
+
+
+	void Partitioner::wait()
+	{
+		for (uint i = 0; i != spinRounds; ++i)
+		{
+			if (pFinished.load(std::memory_order_acquire) != 0)
+				return;
+			Private::Thread::CPUPause();
+		}
+		while (pFinished.load(std::memory_order_acquire) == 0)
+			Private::Thread::FutexWait(pFinished, 0);
+	}
+
+
+	void Partitioner::failed(std::exception_ptr exception)
+	{
+		std::lock_guard<std::mutex> locker(pMutex);
+		if (not pException)
+			pException = exception;
+		pAborted.store(true, std::memory_order_relaxed);
+	}
+
+
+	void Partitioner::rethrow()
+	{
+		if (pAborted.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> locker(pMutex);
+			if (pException)
+				std::rethrow_exception(pException);
+		}
+	}
+
+
+	uint Concurrency(Job::QueueService& queueservice)
+	{
+		return (queueservice.started() ? queueservice.threadCount() : 0) + 1;
+	}
+
+
+
+
+
+} // namespace Parallel
+} // namespace Private
+} // namespace Yuni
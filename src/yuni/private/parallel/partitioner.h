@@ -0,0 +1,122 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include "../../core/noncopyable.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+namespace Yuni { namespace Job { class QueueService; }}
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Parallel
+{
+
+	/*!
+	** \brief Distribute the indexes [0, count) between several participants
+	**
+	** Chunks are grabbed with a single atomic operation and get smaller as the work
+	** runs out (guided scheduling): large chunks at first for a low overhead, small
+	** ones at the end so that all participants terminate at about the same time.
+	*/
+	class YUNI_DECL Partitioner final : private NonCopyable<Partitioner>
+	{
+	public:
+		/*!
+		** \brief Constructor
+		** \param count The number of items
+		** \param grain The minimum size of a chunk (0 for automatic)
+		** \param participants The number of participants (caller included)
+		*/
+		Partitioner(size_t count, size_t grain, uint participants);
+
+		/*!
+		** \brief Grab the next chunk
+		** \return False if no work remains
+		*/
+		bool next(size_t& begin, size_t& end);
+
+		//! Acknowledge a chunk as done
+		void done(size_t count);
+
+		//! Wait for all chunks being done
+		void wait();
+
+		//! Keep the first exception, the remaining chunks will be skipped
+		void failed(std::exception_ptr exception);
+		//! Get if an exception has been thrown by a participant
+		bool aborted() const;
+		//! Rethrow the exception thrown by a participant, if any
+		void rethrow();
+
+	private:
+		//! Index of the next chunk
+		alignas(64) std::atomic<size_t> pNext;
+		//! Number of items done
+		alignas(64) std::atomic<size_t> pCompleted;
+		//! Futex word, 1 when all items are done
+		std::atomic<uint32_t> pFinished;
+		//! Flag to skip all remaining chunks
+		std::atomic<bool> pAborted;
+		//! Total number of items
+		const size_t pCount;
+		//! Minimum size of a chunk
+		const size_t pGrain;
+		//! The remaining work is divided by this number for each chunk
+		const size_t pDivisor;
+		//! The first exception
+		std::exception_ptr pException;
+		//! Mutex for the exception
+		std::mutex pMutex;
+
+	}; // class Partitioner
+
+
+
+	/*!
+	** \brief Get the maximum number of participants for a parallel algorithm
+	**
+	** The number of workers of the queueservice, plus the calling thread.
+	*/
+	YUNI_DECL uint Concurrency(Job::QueueService& queueservice);
+
+
+	/*!
+	** \brief Run a parallel loop on [0, count)
+	**
+	** Some helper jobs are dispatched to the queueservice while the calling thread
+	** participates as well. Each participant creates its own local data with
+	** `initialize()`, calls `process(local, begin, end)` for each chunk it grabs
+	** and `finalize(local)` once no chunk remains. This function returns when all
+	** chunks are done and all participants have called `finalize()`.
+	** The first exception thrown by a participant is rethrown.
+	*/
+	template<class InitializeT, class ProcessT, class FinalizeT>
+	void Run(Job::QueueService& queueservice, size_t count, size_t grain,
+		const InitializeT& initialize, const ProcessT& process, const FinalizeT& finalize);
+
+
+
+
+
+} // namespace Parallel
+} // namespace Private
+} // namespace Yuni
+
+#include "partitioner.hxx"
@@ -0,0 +1,117 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "partitioner.h"
+#include "../../thread/utility.h"
+#include <memory>
+#include <optional>
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Parallel
+{
+
+	inline bool Partitioner::aborted() const
+	{
+		return pAborted.load(std::memory_order_relaxed);
+	}
+
+
+	template<class InitializeT, class ProcessT, class FinalizeT>
+	void Run(Job::QueueService& queueservice, size_t count, size_t grain,
+		const InitializeT& initialize, const ProcessT& process, const FinalizeT& finalize)
+	{
+		if (count == 0)
+			return;
+
+		uint participants = Concurrency(queueservice);
+		auto state = std::make_shared<Partitioner>(count, grain, participants);
+
+		// Work of a single participant, starting from a chunk it already owns
+		// (thus the caller can not return in the meantime and all references remain valid)
+		auto participate = [&](size_t begin, size_t end)
+		{
+			Partitioner& partitioner = *state;
+			// the local data must be destroyed before acknowledging the last chunk
+			std::optional<decltype(initialize())> local;
+			local.emplace(initialize());
+			do
+			{
+				if (not partitioner.aborted())
+				{
+					try
+					{
+						process(*local, begin, end);
+					}
+					catch (...)
+					{
+						partitioner.failed(std::current_exception());
+					}
+				}
+
+				size_t done = end - begin;
+				if (not partitioner.next(begin, end))
+				{
+					// the last chunk must be acknowledged *after* `finalize()`
+					try
+					{
+						finalize(*local);
+					}
+					catch (...)
+					{
+						partitioner.failed(std::current_exception());
+					}
+					local.reset();
+					partitioner.done(done);
+					return;
+				}
+				partitioner.done(done);
+			}
+			while (true);
+		};
+
+		// helpers - a helper coming too late will not find any chunk to grab and
+		// will only access the partitioner, kept alive by its own reference
+		size_t minChunk = (grain != 0) ? grain : 1;
+		size_t maxHelpers = (count + minChunk - 1) / minChunk - 1;
+		uint helpers = participants - 1;
+		if (maxHelpers < helpers)
+			helpers = static_cast<uint>(maxHelpers);
+		for (uint i = 0; i != helpers; ++i)
+		{
+			async(queueservice, [state, &participate]()
+			{
+				size_t begin, end;
+				if (state->next(begin, end))
+					participate(begin, end);
+			});
+		}
+
+		// the calling thread participates as well instead of only waiting
+		size_t begin, end;
+		if (state->next(begin, end))
+			participate(begin, end);
+
+		state->wait();
+		state->rethrow();
+	}
+
+
+
+
+
+} // namespace Parallel
+} // namespace Private
+} // namespace Yuni
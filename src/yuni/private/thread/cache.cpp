@@ -0,0 +1,274 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "cache.h"
+#if !defined(YUNI_NO_THREAD_SAFE) && !defined(YUNI_OS_WINDOWS)
+#include "futex.h"
+#include "../../thread/thread.h"
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#ifdef YUNI_OS_LINUX
+# include <sched.h>
+#endif
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Thread
+{
+
+	namespace // anonymous
+	{
+
+		//! A native thread of the cache
+		struct Carrier final
+		{
+			//! ID of the native thread (set by the thread itself)
+			pthread_t id;
+			//! Stack size of the native thread
+			uint stacksize;
+			//! The next thread to run
+			std::atomic<Yuni::Thread::IThread*> thread {nullptr};
+			//! Event for waking up the native thread while parked
+			std::atomic<uint32_t> event {0};
+		};
+
+
+		struct Cache final
+		{
+			//! Mutex
+			Yuni::Mutex mutex;
+			//! Parked native threads (the most recent last)
+			std::vector<Carrier*> idle;
+			//! Keep-alive delay (ms)
+			std::atomic<uint> keepAlive {0};
+		};
+
+
+		inline Cache& cache()
+		{
+			// never destroyed, some native threads may remain parked at exit
+			static Cache& instance = *(new Cache());
+			return instance;
+		}
+
+
+		inline uint64_t now()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+
+		//! Wait for the next thread to run, false if the native thread must exit
+		bool park(Carrier& carrier)
+		{
+			Cache& c = cache();
+			uint64_t parkedAt = now();
+			{
+				Yuni::MutexLocker locker(c.mutex);
+				if (c.keepAlive.load(std::memory_order_relaxed) == 0 or c.idle.size() >= ThreadCache::maxIdleThreads)
+					return false;
+				c.idle.push_back(&carrier);
+			}
+
+			do
+			{
+				if (nullptr != carrier.thread.load(std::memory_order_acquire))
+					return true;
+
+				// the delay may have been changed meanwhile
+				uint64_t deadline = parkedAt + c.keepAlive.load(std::memory_order_relaxed);
+				uint64_t current = now();
+				if (current < deadline)
+				{
+					Yuni::Private::Thread::FutexWait(carrier.event, 0, static_cast<uint>(deadline - current));
+					continue;
+				}
+
+				Yuni::MutexLocker locker(c.mutex);
+				auto it = std::find(c.idle.begin(), c.idle.end(), &carrier);
+				if (it != c.idle.end())
+				{
+					c.idle.erase(it);
+					return false;
+				}
+				// taken by ThreadCache::Start() meanwhile, the thread is coming
+				break;
+			}
+			while (true);
+
+			while (nullptr == carrier.thread.load(std::memory_order_acquire))
+				Yuni::Private::Thread::FutexWait(carrier.event, 0);
+			return true;
+		}
+
+
+		void* carrierMain(void* arg)
+		{
+			Carrier* carrier = static_cast<Carrier*>(arg);
+			carrier->id = ::pthread_self();
+
+			# ifdef YUNI_OS_LINUX
+			// the affinity of a thread must not be inherited by the next one
+			cpu_set_t initial;
+			bool hasAffinity = (0 == ::pthread_getaffinity_np(carrier->id, sizeof(initial), &initial));
+			# endif
+
+			do
+			{
+				Yuni::Thread::IThread* thread = carrier->thread.exchange(nullptr, std::memory_order_acq_rel);
+				carrier->event.store(0, std::memory_order_relaxed);
+
+				threadCallbackExecute(thread);
+				ThreadCache::Release(*thread); // the thread may be destroyed from now on
+
+				# ifdef YUNI_OS_LINUX
+				if (hasAffinity)
+				{
+					cpu_set_t current;
+					if (0 == ::pthread_getaffinity_np(carrier->id, sizeof(current), &current)
+						and not CPU_EQUAL(&current, &initial))
+						::pthread_setaffinity_np(carrier->id, sizeof(initial), &initial);
+				}
+				# endif
+			}
+			while (park(*carrier));
+
+			delete carrier;
+			return nullptr;
+		}
+
+	} // anonymous namespace
+
+
+
+
+	bool ThreadCache::Start(Yuni::Thread::IThread& thread, uint stacksize, pthread_t& id)
+	{
+		Cache& c = cache();
+		Carrier* carrier = nullptr;
+		{
+			Yuni::MutexLocker locker(c.mutex);
+			// the most recent one first, with a large enough stack
+			for (auto it = c.idle.rbegin(); it != c.idle.rend(); ++it)
+			{
+				if ((*it)->stacksize >= stacksize)
+				{
+					carrier = *it;
+					c.idle.erase(std::next(it).base());
+					break;
+				}
+			}
+		}
+
+		if (carrier)
+		{
+			id = carrier->id;
+			carrier->thread.store(&thread, std::memory_order_release);
+			carrier->event.store(1, std::memory_order_release);
+			Yuni::Private::Thread::FutexWakeOne(carrier->event);
+			return true;
+		}
+
+		carrier = new Carrier();
+		carrier->stacksize = stacksize;
+		carrier->thread.store(&thread, std::memory_order_relaxed);
+
+		pthread_attr_t attr;
+		::pthread_attr_init(&attr);
+		::pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+		# ifdef YUNI_HAS_PTHREAD_ATTR_SETSTACKSIZE
+		::pthread_attr_setstacksize(&attr, stacksize);
+		# endif
+		bool success = (0 == ::pthread_create(&id, &attr, carrierMain, carrier));
+		::pthread_attr_destroy(&attr);
+		if (not success)
+			delete carrier;
+		return success;
+	}
+
+
+	void ThreadCache::Release(Yuni::Thread::IThread& thread)
+	{
+		// last access to the thread object
+		auto& borrowed = thread.pBorrowed;
+		if (3 == borrowed.exchange(2, std::memory_order_acq_rel))
+		{
+			// the object may already be destroyed: only its address is given to the
+			// kernel, and a spurious wake-up is harmless for any futex
+			Yuni::Private::Thread::FutexWakeAll(borrowed);
+		}
+	}
+
+
+	void ThreadCache::Join(Yuni::Thread::IThread& thread)
+	{
+		auto& borrowed = thread.pBorrowed;
+		uint32_t state = borrowed.load(std::memory_order_acquire);
+		while (state != 2)
+		{
+			// a joiner is waiting, the native thread must wake it up
+			if (state == 1 and not borrowed.compare_exchange_weak(state, 3, std::memory_order_acquire))
+				continue;
+			Yuni::Private::Thread::FutexWait(borrowed, 3);
+			state = borrowed.load(std::memory_order_acquire);
+		}
+		borrowed.store(0, std::memory_order_relaxed);
+	}
+
+
+	bool ThreadCache::Enabled()
+	{
+		return 0 != cache().keepAlive.load(std::memory_order_relaxed);
+	}
+
+
+	uint ThreadCache::KeepAlive()
+	{
+		return cache().keepAlive.load(std::memory_order_relaxed);
+	}
+
+
+	void ThreadCache::KeepAlive(uint milliseconds)
+	{
+		Cache& c = cache();
+		Yuni::MutexLocker locker(c.mutex);
+		uint previous = c.keepAlive.exchange(milliseconds, std::memory_order_relaxed);
+		if (milliseconds < previous)
+		{
+			// the parked threads must check their new deadline
+			for (auto* carrier: c.idle)
+				Yuni::Private::Thread::FutexWakeOne(carrier->event);
+		}
+	}
+
+
+	uint ThreadCache::IdleCount()
+	{
+		Cache& c = cache();
+		Yuni::MutexLocker locker(c.mutex);
+		return static_cast<uint>(c.idle.size());
+	}
+
+
+
+
+
+} // namespace Thread
+} // namespace Private
+} // namespace Yuni
+
+#endif
@@ -0,0 +1,97 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include "../../thread/fwd.h"
+#if !defined(YUNI_NO_THREAD_SAFE) && !defined(YUNI_OS_WINDOWS)
+# include <pthread.h>
+#endif
+
+
+
+namespace Yuni { namespace Thread { class IThread; }}
+
+#if !defined(YUNI_NO_THREAD_SAFE) && !defined(YUNI_OS_WINDOWS)
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Thread
+{
+
+	/*!
+	** \brief Cache of native threads, parked once their IThread has terminated
+	**
+	** A thread using the cache (see `IThread::useThreadCache()`) borrows a parked
+	** native thread when started, instead of creating a new one. Once the thread
+	** has stopped, the native thread parks for the keep-alive delay, waiting for
+	** the next one, then exits. Joining such a thread only waits for the native
+	** thread to release the IThread object.
+	**
+	** The cache is disabled by default (keep-alive of 0).
+	*/
+	class YUNI_DECL ThreadCache final
+	{
+	public:
+		enum
+		{
+			//! Maximum number of parked native threads
+			maxIdleThreads = 64,
+		};
+
+	public:
+		/*!
+		** \brief Run a thread from a parked native thread, or a new one
+		**
+		** \param thread The thread to run (see threadCallbackExecute())
+		** \param stacksize The minimum stack size, in bytes
+		** \param[out] id The ID of the native thread
+		** \return False if no native thread could be created
+		*/
+		static bool Start(Yuni::Thread::IThread& thread, uint stacksize, pthread_t& id);
+
+		/*!
+		** \brief Notify that a native thread does not access a thread anymore
+		**
+		** Called by the native thread once `threadCallbackExecute()` has returned.
+		*/
+		static void Release(Yuni::Thread::IThread& thread);
+
+		/*!
+		** \brief Wait until a native thread of the cache has released a thread
+		**
+		** The waiting thread sleeps until woken up by `Release()`.
+		*/
+		static void Join(Yuni::Thread::IThread& thread);
+
+		//! Get if the cache is enabled
+		static bool Enabled();
+
+		//! Get the keep-alive delay (ms)
+		static uint KeepAlive();
+		//! Set the keep-alive delay (ms, 0 to disable the cache)
+		static void KeepAlive(uint milliseconds);
+
+		//! Get the number of parked native threads
+		static uint IdleCount();
+
+	}; // class ThreadCache
+
+
+
+
+
+} // namespace Thread
+} // namespace Private
+} // namespace Yuni
+
+#endif
@@ -0,0 +1,162 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#include "futex.h"
+#include "../../core/system/cpu.h"
+#ifdef YUNI_OS_LINUX
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# include <time.h>
+# include <climits>
+# include <cerrno>
+#else
+# include <mutex>
+# include <condition_variable>
+# include <chrono>
+#endif
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Thread
+{
+
+	#ifdef YUNI_OS_LINUX
+
+	namespace
+	{
+
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "invalid atomic layout for futex");
+
+	inline long futex(std::atomic<uint32_t>& word, int op, uint32_t value, const struct timespec* timeout)
+	{
+		return ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), op, value, timeout, nullptr, 0);
+	}
+
+	} // anonymous namespace
+
+
+	void FutexWait(std::atomic<uint32_t>& word, uint32_t expected)
+	{
+		futex(word, FUTEX_WAIT_PRIVATE, expected, nullptr);
+	}
+
+
+	bool FutexWait(std::atomic<uint32_t>& word, uint32_t expected, uint timeout)
+	{
+		struct timespec ts;
+		ts.tv_sec  = static_cast<time_t>(timeout / 1000);
+		ts.tv_nsec = static_cast<long>((timeout % 1000) * 1000000);
+		// relative timeout
+		long r = futex(word, FUTEX_WAIT_PRIVATE, expected, &ts);
+		return not (r == -1 and errno == ETIMEDOUT);
+	}
+
+
+	void FutexWakeOne(std::atomic<uint32_t>& word)
+	{
+		futex(word, FUTEX_WAKE_PRIVATE, 1, nullptr);
+	}
+
+
+	void FutexWakeAll(std::atomic<uint32_t>& word)
+	{
+		futex(word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+	}
+
+
+	#else // generic implementation
+
+
+	namespace
+	{
+
+	//! A bucket of waiters, shared by all words with the same hash
+	struct Bucket final
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+
+	//! Number of buckets (power of 2)
+	constexpr static uint32_t bucketCount = 64;
+
+	Bucket buckets[bucketCount];
+
+
+	inline Bucket& bucketFor(const std::atomic<uint32_t>& word)
+	{
+		auto address = reinterpret_cast<uintptr_t>(&word);
+		return buckets[(address >> 4) & (bucketCount - 1)];
+	}
+
+	} // anonymous namespace
+
+
+	void FutexWait(std::atomic<uint32_t>& word, uint32_t expected)
+	{
+		Bucket& bucket = bucketFor(word);
+		std::unique_lock<std::mutex> locker(bucket.mutex);
+		if (word.load() == expected)
+			bucket.condition.wait(locker);
+	}
+
+
+	bool FutexWait(std::atomic<uint32_t>& word, uint32_t expected, uint timeout)
+	{
+		Bucket& bucket = bucketFor(word);
+		std::unique_lock<std::mutex> locker(bucket.mutex);
+		if (word.load() != expected)
+			return true;
+		return std::cv_status::no_timeout
+			== bucket.condition.wait_for(locker, std::chrono::milliseconds(timeout));
+	}
+
+
+	void FutexWakeOne(std::atomic<uint32_t>& word)
+	{
+		// several words may share the same bucket, all waiters must be woken up
+		// (they will check their own word again)
+		FutexWakeAll(word);
+	}
+
+
+	void FutexWakeAll(std::atomic<uint32_t>& word)
+	{
+		Bucket& bucket = bucketFor(word);
+		// the lock guarantees that a waiter can not miss the notification between
+		// checking the word and sleeping
+		std::lock_guard<std::mutex> locker(bucket.mutex);
+		bucket.condition.notify_all();
+	}
+
+
+	#endif // YUNI_OS_LINUX
+
+
+
+
+	bool SpinningIsUseful()
+	{
+		static const bool useful = (Yuni::System::CPU::Count() > 1);
+		return useful;
+	}
+
+
+
+
+
+} // namespace Thread
+} // namespace Private
+} // namespace Yuni
@@ -0,0 +1,83 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../../yuni.h"
+#include <atomic>
+#include <cstdint>
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+# include <immintrin.h>
+#endif
+
+
+
+namespace Yuni
+{
+namespace Private
+{
+namespace Thread
+{
+
+	/*!
+	** \brief Wait as long as a 32-bit word holds a given value
+	**
+	** On Linux, this is a direct `futex` system call. On other platforms, waiters
+	** are parked on a small table of mutex/condition variable pairs, indexed by
+	** the address of the word.
+	** Spurious wakeups may happen: the caller must check the word again.
+	**
+	** \param word The word to watch
+	** \param expected The value the word must hold for the calling thread to sleep
+	*/
+	YUNI_DECL void FutexWait(std::atomic<uint32_t>& word, uint32_t expected);
+
+	/*!
+	** \brief Wait as long as a 32-bit word holds a given value, with timeout
+	**
+	** \param word The word to watch
+	** \param expected The value the word must hold for the calling thread to sleep
+	** \param timeout A timeout in milliseconds
+	** \return False if the timeout has been reached
+	*/
+	YUNI_DECL bool FutexWait(std::atomic<uint32_t>& word, uint32_t expected, uint timeout);
+
+	//! Wake up one thread waiting on a word
+	YUNI_DECL void FutexWakeOne(std::atomic<uint32_t>& word);
+
+	//! Wake up all threads waiting on a word
+	YUNI_DECL void FutexWakeAll(std::atomic<uint32_t>& word);
+
+
+	//! Hint for the processor that the calling thread is in a spin-wait loop
+	inline void CPUPause()
+	{
+		# if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+		_mm_pause();
+		# elif defined(__aarch64__) || defined(__arm__)
+		__asm__ __volatile__("yield");
+		# endif
+	}
+
+
+	/*!
+	** \brief Get if spinning may be worth it before sleeping
+	**
+	** False on a single processor, where the thread holding a resource can not
+	** run while the calling thread spins.
+	*/
+	YUNI_DECL bool SpinningIsUseful();
+
+
+
+
+
+} // namespace Thread
+} // namespace Private
+} // namespace Yuni
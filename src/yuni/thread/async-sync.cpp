@@ -44,6 +44,16 @@ namespace Yuni
 	}
 
 
+	void async(Job::QueueService& queueservice, const std::vector<Bind<void ()>>& callbacks)
+	{
+		std::vector<Job::IJob::Ptr> jobs;
+		jobs.reserve(callbacks.size());
+		for (auto& callback: callbacks)
+			jobs.emplace_back(new AsyncJob(callback));
+		queueservice.add(jobs);
+	}
+
+
 	Job::IJob::Ptr  async(const Bind<void ()>& callback)
 	{
 		return new AsyncJob(callback);
@@ -9,6 +9,7 @@
 ** github: https://github.com/libyuni/libyuni/ {mirror}
 */
 #include "../thread/utility.h"
+#include "../job/queue/service.h"
 #include "../datetime/timestamp.h"
 #ifdef YUNI_HAS_CPP_MOVE
 # include <utility>
@@ -115,4 +116,10 @@ namespace Yuni
 	}
 
 
+	Job::TimerService::Timer::Ptr every(Job::QueueService& queueservice, uint ms, const Bind<bool ()>& callback)
+	{
+		return queueservice.every(ms, callback);
+	}
+
+
 } // namespace Yuni
@@ -83,6 +83,9 @@ namespace Thread
 	*/
 	extern "C"  YUNI_THREAD_FNC_RETURN  threadCallbackExecute(void* arg);
 
+	// forward declaration
+	class ThreadCache;
+
 
 
 } // namespace Yuni
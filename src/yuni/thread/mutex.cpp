@@ -14,6 +14,7 @@
 #include <cerrno>
 
 #include "../core/atomic/int.h"
+#include "../private/thread/futex.h"
 #if YUNI_ATOMIC_MUST_USE_MUTEX != 0
 #warning Atomic types must ue mutex. the implementation should be checked YUNI_OS_GCC_VERSION
 #endif
@@ -80,6 +81,7 @@ namespace Yuni
 		InitializeCriticalSectionAndSpinCount(&pSection, static_cast<DWORD>(spinCount));
 		(void) rhs; // unused
 		# else
+		pSpinning = rhs.pSpinning;
 		::pthread_mutexattr_init(&pAttr);
 		int type; // = PTHREAD_MUTEX_NORMAL;
 		if (0 == ::pthread_mutexattr_gettype(&rhs.pAttr, &type))
@@ -115,13 +117,15 @@ namespace Yuni
 	}
 
 
-	Mutex::Mutex(bool recursive)
+	Mutex::Mutex(bool recursive, Waiting waiting)
 	{
 		# ifndef YUNI_NO_THREAD_SAFE
 		# ifdef YUNI_OS_WINDOWS
 		(void) recursive; // already recursive on Windows
+		(void) waiting; // the critical section always spins
 		InitializeCriticalSectionAndSpinCount(&pSection, static_cast<DWORD>(spinCount));
 		# else
+		pSpinning = (waiting == Waiting::spin) and Private::Thread::SpinningIsUseful();
 		::pthread_mutexattr_init(&pAttr);
 		if (recursive)
 		{
@@ -135,10 +139,27 @@ namespace Yuni
 		# endif
 		# else
 		(void) recursive;
+		(void) waiting;
 		# endif
 	}
 
 
+	# if not defined(YUNI_NO_THREAD_SAFE) and not defined(YUNI_OS_WINDOWS)
+	void Mutex::lockContended()
+	{
+		// exponential backoff between two attempts (255 pauses overall)
+		for (uint i = 0; i != 8; ++i)
+		{
+			for (uint p = 0; p != (1u << i); ++p)
+				Private::Thread::CPUPause();
+			if (0 == ::pthread_mutex_trylock(&pLock))
+				return;
+		}
+		::pthread_mutex_lock(&pLock);
+	}
+	# endif
+
+
 	Mutex& Mutex::operator = (const Mutex& rhs)
 	{
 		// We will recreate the mutex
@@ -27,6 +27,11 @@ namespace Yuni
 	/*!
 	** \brief  Mechanism to avoid the simultaneous use of a common resource
 	**
+	** When the mutex is already locked, the calling thread is put to sleep by the
+	** system. With `Waiting::spin`, it spins briefly before (the critical sections
+	** being usually short), on multi-processors only. The spin count of the critical
+	** section is always used on Windows.
+	**
 	** \ingroup Threads
 	*/
 	class YUNI_DECL Mutex final
@@ -47,6 +52,25 @@ namespace Yuni
 
 		}; // class ClassLevelLockable
 
+		//! Behavior of `lock()` when the mutex is already locked by another thread
+		enum class Waiting
+		{
+			//! Sleep at once (default)
+			sleep,
+			/*!
+			** \brief Spin with an exponential backoff, then sleep
+			**
+			** Suitable for very short critical sections with a few threads, when
+			** the owner is likely to be running on another processor. Ignored
+			** on single-processor machines.
+			**
+			** \note Opt-in, and not used by the library itself: its gain on
+			**   multi-processors has not been measured yet (see the benchmark
+			**   `yn-bench-thread-signal` to compare both modes on a given machine)
+			*/
+			spin,
+		};
+
 
 	public:
 		//! \name Constructor & Destructor
@@ -56,8 +80,10 @@ namespace Yuni
 		**
 		** Recursive by default to keep homogeneous behavior between
 		** platforms.
+		** \param recursive True to create a recursive mutex
+		** \param waiting Behavior of `lock()` when the mutex is already locked
 		*/
-		explicit Mutex(bool recursive = true);
+		explicit Mutex(bool recursive = true, Waiting waiting = Waiting::sleep);
 		/*!
 		** \brief Copy constructor
 		**
@@ -116,6 +142,10 @@ namespace Yuni
 		inline void destroy();
 		//! Create the mutex with settings from another mutex
 		inline void copy(const Mutex& rhs);
+		# if not defined(YUNI_NO_THREAD_SAFE) and not defined(YUNI_OS_WINDOWS)
+		//! Lock the mutex already locked by another thread
+		void lockContended();
+		# endif
 
 	private:
 		# ifndef YUNI_NO_THREAD_SAFE
@@ -126,6 +156,8 @@ namespace Yuni
 		//! The PThread mutex
 		::pthread_mutex_t pLock;
 		::pthread_mutexattr_t pAttr;
+		//! Flag to spin before sleeping (see Waiting::spin)
+		bool pSpinning;
 		# endif
 		# endif
 
@@ -22,7 +22,14 @@ namespace Yuni
 		# ifdef YUNI_OS_WINDOWS
 		EnterCriticalSection(&pSection);
 		# else
-		::pthread_mutex_lock(&pLock);
+		if (not pSpinning)
+			::pthread_mutex_lock(&pLock);
+		else
+		{
+			// fast path, then spinning a little before sleeping
+			if (0 != ::pthread_mutex_trylock(&pLock))
+				lockContended();
+		}
 		# endif
 		# endif
 	}
@@ -9,33 +9,168 @@
 ** github: https://github.com/libyuni/libyuni/ {mirror}
 */
 #include "rwmutex.h"
+#ifndef YUNI_NO_THREAD_SAFE
+# include "../private/thread/futex.h"
+#endif
 
 
 namespace Yuni
 {
 
+	# ifndef YUNI_NO_THREAD_SAFE
+
+	namespace // anonymous
+	{
+
+		//! Number of iterations spent spinning before sleeping
+		constexpr static uint spinCount = 64;
+
+		//! Next index of reader counter to give to a thread
+		static std::atomic<uint> nextStripe{0};
+
+	} // anonymous namespace
+
+
+
+	inline RWMutex::Stripe& RWMutex::stripe()
+	{
+		// the threads are spread over the counters in a round-robin fashion
+		static thread_local uint index = nextStripe.fetch_add(1, std::memory_order_relaxed);
+		return pStripes[index % stripeCount];
+	}
+
+
+	void RWMutex::waitForWriter()
+	{
+		uint count = Private::Thread::SpinningIsUseful() ? spinCount : 0;
+		for (uint i = 0; i != count; ++i)
+		{
+			if (pWriter.load(std::memory_order_relaxed) == 0)
+				return;
+			Private::Thread::CPUPause();
+		}
+
+		uint32_t writer = pWriter.load(std::memory_order_relaxed);
+		while (writer != 0)
+		{
+			// telling the writer that someone is sleeping
+			if (writer == 2 or pWriter.compare_exchange_weak(writer, 2, std::memory_order_relaxed))
+				Private::Thread::FutexWait(pWriter, 2);
+			writer = pWriter.load(std::memory_order_relaxed);
+		}
+	}
+
+
+	inline uint32_t RWMutex::readers() const
+	{
+		// a read lock may be released by another thread, thus onto another counter
+		// (wrapping around): only the sum is meaningful
+		uint32_t sum = 0;
+		for (uint s = 0; s != stripeCount; ++s)
+			sum += pStripes[s].readers.load(std::memory_order_seq_cst);
+		return sum;
+	}
+
+
+	void RWMutex::readerGone()
+	{
+		pReaderGone.fetch_add(1, std::memory_order_seq_cst);
+		if (pWriterSleeping.load(std::memory_order_seq_cst) != 0)
+			Private::Thread::FutexWakeOne(pReaderGone);
+	}
+
+
+	void RWMutex::readLock()
+	{
+		std::atomic<uint32_t>& readers = stripe().readers;
+		do
+		{
+			// the counter is increased before checking the writer, and
+			// the writer does the opposite (thus one of them will see the other)
+			readers.fetch_add(1, std::memory_order_seq_cst);
+			if (YUNI_LIKELY(pWriter.load(std::memory_order_seq_cst) == 0))
+				return;
+
+			// a writer has precedence
+			readers.fetch_sub(1, std::memory_order_seq_cst);
+			readerGone();
+			waitForWriter();
+		}
+		while (true);
+	}
+
+
+	void RWMutex::readUnlock()
+	{
+		stripe().readers.fetch_sub(1, std::memory_order_seq_cst);
+		// a writer may wait for the last reader
+		if (YUNI_UNLIKELY(pWriter.load(std::memory_order_seq_cst) != 0))
+			readerGone();
+	}
+
 
 	void RWMutex::writeLock()
 	{
-		# ifndef YUNI_NO_THREAD_SAFE
-		pMutex.lock();
-		pSemaphore.acquire(pSemaphore.maxReaders());
-		pMutex.unlock();
-		# endif
+		// only one writer at a time
+		const uint spins = Private::Thread::SpinningIsUseful() ? spinCount : 0;
+		uint32_t expected = 0;
+		if (not pWriter.compare_exchange_strong(expected, 1, std::memory_order_seq_cst))
+		{
+			uint i = 0;
+			do
+			{
+				expected = 0;
+				if (i < spins)
+				{
+					if (pWriter.compare_exchange_weak(expected, 1, std::memory_order_seq_cst))
+						break;
+					Private::Thread::CPUPause();
+					++i;
+				}
+				else
+				{
+					// the flag may remain at 2 without any sleeping thread, the
+					// only drawback being a spurious wake up
+					if (pWriter.exchange(2, std::memory_order_seq_cst) == 0)
+						break;
+					Private::Thread::FutexWait(pWriter, 2);
+				}
+			}
+			while (true);
+		}
+
+		// waiting for the readers, which will not come back until the lock is released
+		uint i = 0;
+		do
+		{
+			uint32_t event = pReaderGone.load(std::memory_order_seq_cst);
+			if (readers() == 0)
+				break;
+			if (i < spins)
+			{
+				Private::Thread::CPUPause();
+				++i;
+				continue;
+			}
+			// the readers leaving from now on will wake us up (see readerGone())
+			pWriterSleeping.store(1, std::memory_order_seq_cst);
+			if (readers() != 0)
+				Private::Thread::FutexWait(pReaderGone, event);
+			pWriterSleeping.store(0, std::memory_order_relaxed);
+		}
+		while (true);
 	}
 
 
 	void RWMutex::writeUnlock()
 	{
-		# ifndef YUNI_NO_THREAD_SAFE
-		pMutex.lock();
-		pSemaphore.release(pSemaphore.maxReaders());
-		pMutex.unlock();
-		# endif
+		if (pWriter.exchange(0, std::memory_order_seq_cst) == 2)
+			Private::Thread::FutexWakeAll(pWriter);
 	}
 
+	# endif // YUNI_NO_THREAD_SAFE
 
 
 
-} // namespace Yuni
 
+} // namespace Yuni
@@ -10,7 +10,10 @@
 */
 #pragma once
 #include "mutex.h"
-#include "semaphore.h"
+#ifndef YUNI_NO_THREAD_SAFE
+# include <atomic>
+# include <cstdint>
+#endif
 
 
 
@@ -21,6 +24,19 @@ namespace Yuni
 	/*!
 	** \brief Read/Write Mutex (allows several readers but one writer)
 	**
+	** Designed for read-mostly data: the readers are spread over several counters
+	** (one cache line each, chosen from the calling thread), thus concurrent readers
+	** do not contend on a single word. A writer has precedence over the new
+	** readers: it raises a flag then waits for the counters to drain. Sleeping
+	** threads are parked on futexes (Linux), no system call being made
+	** without contention.
+	**
+	** A read lock may be released by another thread than the one which acquired
+	** it, but can not be acquired recursively while a writer may be waiting (the
+	** writer has precedence, thus the second read lock would wait for the writer,
+	** itself waiting for the first read lock).
+	**
+	** \see SeqLock for tiny structures read very frequently
 	** \ingroup Threads
 	*/
 	class YUNI_DECL RWMutex final : public NonMovable<RWMutex>
@@ -46,8 +62,10 @@ namespace Yuni
 		//@{
 		/*!
 		** \brief Default constructor
+		**
+		** The number of concurrent readers is not limited.
 		*/
-		explicit RWMutex(uint maxReaders = 64); // arbitrary limit
+		RWMutex();
 		/*!
 		** \brief Copy constructor
 		**
@@ -95,10 +113,34 @@ namespace Yuni
 
 	private:
 		# ifndef YUNI_NO_THREAD_SAFE
-		//! Semaphore
-		Semaphore pSemaphore;
-		//! Real mutex
-		Mutex pMutex;
+		enum
+		{
+			//! Number of reader counters
+			stripeCount = 16,
+		};
+		//! Counter of readers, alone in its cache line
+		struct alignas(64) Stripe final
+		{
+			std::atomic<uint32_t> readers{0};
+		};
+
+		//! Get the reader counter of the calling thread
+		Stripe& stripe();
+		//! Wait for the writer flag to be released
+		void waitForWriter();
+		//! Number of readers (the sum of all counters, a counter alone may be 'negative')
+		uint32_t readers() const;
+		//! Tell a writer waiting for the readers that a reader has gone
+		void readerGone();
+
+		//! The reader counters
+		Stripe pStripes[stripeCount];
+		//! Writer flag (0: none, 1: locked, 2: locked with sleeping threads)
+		alignas(64) std::atomic<uint32_t> pWriter{0};
+		//! Incremented by the readers leaving while a writer is waiting for them
+		std::atomic<uint32_t> pReaderGone{0};
+		//! Flag to know if the writer sleeps until the readers have gone
+		std::atomic<uint32_t> pWriterSleeping{0};
 		# endif
 
 	}; // class RWMutex
@@ -16,19 +16,13 @@
 namespace Yuni
 {
 
-	inline RWMutex::RWMutex(uint maxReaders)
-		# ifndef YUNI_NO_THREAD_SAFE
-		: pSemaphore(maxReaders), pMutex()
-		# endif
+	inline RWMutex::RWMutex()
 	{
 	}
 
 
-	inline RWMutex::RWMutex(const RWMutex& copy)
+	inline RWMutex::RWMutex(const RWMutex&)
 		: NonMovable()
-		# ifndef YUNI_NO_THREAD_SAFE
-		, pSemaphore(copy.pSemaphore), pMutex()
-		# endif
 	{
 	}
 
@@ -40,20 +34,12 @@ namespace Yuni
 	}
 
 
-	inline void RWMutex::readLock()
-	{
-		# ifndef YUNI_NO_THREAD_SAFE
-		pSemaphore.acquire();
-		# endif
-	}
-
-
-	inline void RWMutex::readUnlock()
-	{
-		# ifndef YUNI_NO_THREAD_SAFE
-		pSemaphore.release();
-		# endif
-	}
+	# ifdef YUNI_NO_THREAD_SAFE
+	inline void RWMutex::readLock() {}
+	inline void RWMutex::readUnlock() {}
+	inline void RWMutex::writeLock() {}
+	inline void RWMutex::writeUnlock() {}
+	# endif
 
 
 
@@ -0,0 +1,110 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "../yuni.h"
+#include "../core/noncopyable.h"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+
+
+namespace Yuni
+{
+
+	/*!
+	** \brief Sequence lock, for tiny structures read very frequently and rarely modified
+	**
+	** The readers never write to shared memory: they read the value optimistically
+	** and retry if a writer has modified it meanwhile. Thus any number of readers
+	** can run in parallel without any contention (contrary to `RWMutex`), but a
+	** reader may spin while a writer is active. The writers are serialized with
+	** a spin lock, and should be short and rare.
+	**
+	** \code
+	** struct Config { uint32_t timeout; uint32_t retries; };
+	** SeqLock<Config> config;
+	**
+	** // for each request
+	** Config current = config.load();
+	**
+	** // once in a while
+	** config.update([](Config& value) { value.timeout = 42; });
+	** \endcode
+	**
+	** \tparam T A trivially copyable type (a few words at most)
+	** \ingroup Threads
+	*/
+	template<class T>
+	class YUNI_DECL SeqLock final : private NonCopyable<SeqLock<T> >
+	{
+	public:
+		//! The value type
+		typedef T Type;
+
+	public:
+		//! \name Constructors
+		//@{
+		//! Default constructor
+		SeqLock();
+		//! Constructor with an initial value
+		explicit SeqLock(const T& value);
+		//@}
+
+		//! \name Read & Write
+		//@{
+		//! Get a consistent copy of the value (from any thread, never blocks a writer)
+		T load() const;
+
+		//! Replace the value
+		void store(const T& value);
+
+		/*!
+		** \brief Modify the value in place
+		**
+		** \param callback A functor / lambda `void (T&)`, called with the writer lock
+		*/
+		template<class CallbackT> void update(const CallbackT& callback);
+		//@}
+
+	private:
+		//! Acquire the writer lock
+		void lockWriter();
+		//! Release the writer lock
+		void unlockWriter();
+		//! Read the value (the sequence must be checked afterwards)
+		void read(T& value) const;
+		//! Write the value (with the writer lock)
+		void write(const T& value);
+
+	private:
+		static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+		enum
+		{
+			//! Number of words for the value
+			wordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t),
+		};
+
+		//! Sequence number (odd while a writer is active)
+		std::atomic<uint32_t> pSequence{0};
+		//! The value, word by word
+		std::atomic<uint64_t> pData[wordCount];
+
+	}; // class SeqLock
+
+
+
+
+
+} // namespace Yuni
+
+#include "seqlock.hxx"
@@ -0,0 +1,126 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "seqlock.h"
+#include "../private/thread/futex.h"
+#include <cstring>
+
+
+
+namespace Yuni
+{
+
+	template<class T>
+	inline SeqLock<T>::SeqLock()
+	{
+		write(T());
+	}
+
+
+	template<class T>
+	inline SeqLock<T>::SeqLock(const T& value)
+	{
+		write(value);
+	}
+
+
+	template<class T>
+	inline void SeqLock<T>::read(T& value) const
+	{
+		uint64_t words[wordCount];
+		for (uint i = 0; i != static_cast<uint>(wordCount); ++i)
+			words[i] = pData[i].load(std::memory_order_relaxed);
+		std::memcpy(static_cast<void*>(&value), words, sizeof(T));
+	}
+
+
+	template<class T>
+	inline void SeqLock<T>::write(const T& value)
+	{
+		uint64_t words[wordCount] = {};
+		std::memcpy(words, static_cast<const void*>(&value), sizeof(T));
+		for (uint i = 0; i != static_cast<uint>(wordCount); ++i)
+			pData[i].store(words[i], std::memory_order_relaxed);
+	}
+
+
+	template<class T>
+	T SeqLock<T>::load() const
+	{
+		T value;
+		do
+		{
+			uint32_t sequence = pSequence.load(std::memory_order_acquire);
+			if (YUNI_LIKELY((sequence & 1) == 0))
+			{
+				read(value);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (YUNI_LIKELY(pSequence.load(std::memory_order_relaxed) == sequence))
+					return value;
+			}
+			Yuni::Private::Thread::CPUPause();
+		}
+		while (true);
+	}
+
+
+	template<class T>
+	void SeqLock<T>::lockWriter()
+	{
+		uint32_t sequence = pSequence.load(std::memory_order_relaxed);
+		do
+		{
+			if ((sequence & 1) == 0
+				and pSequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire,
+				std::memory_order_relaxed))
+				break;
+			Yuni::Private::Thread::CPUPause();
+			sequence = pSequence.load(std::memory_order_relaxed);
+		}
+		while (true);
+		// the new data must not be visible before the odd sequence
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+
+	template<class T>
+	inline void SeqLock<T>::unlockWriter()
+	{
+		pSequence.fetch_add(1, std::memory_order_release);
+	}
+
+
+	template<class T>
+	void SeqLock<T>::store(const T& value)
+	{
+		lockWriter();
+		write(value);
+		unlockWriter();
+	}
+
+
+	template<class T>
+	template<class CallbackT>
+	void SeqLock<T>::update(const CallbackT& callback)
+	{
+		lockWriter();
+		T value;
+		read(value);
+		callback(value);
+		write(value);
+		unlockWriter();
+	}
+
+
+
+
+
+} // namespace Yuni
@@ -12,6 +12,10 @@
 #include <cassert>
 
 #ifndef YUNI_NO_THREAD_SAFE
+# ifdef YUNI_OS_LINUX
+#	include "../private/thread/futex.h"
+#	include <chrono>
+# endif
 # ifdef YUNI_OS_WINDOWS
 #	include "../core/system/windows.hdr.h"
 # else
@@ -28,6 +32,205 @@ namespace Yuni
 namespace Thread
 {
 
+	#if defined(YUNI_OS_LINUX) and not defined(YUNI_NO_THREAD_SAFE)
+
+	namespace // anonymous
+	{
+
+		enum : uint32_t
+		{
+			//! The signal has been notified
+			stNotified = 1,
+			//! At least one thread may be sleeping on the futex
+			stSleeping = 2,
+			//! The list of waiters is not empty
+			stWaiters = 4,
+			//! The list of waiters is locked
+			stLocked = 8,
+		};
+
+		//! Number of iterations spent spinning before sleeping
+		constexpr static uint spinCount = 100;
+
+
+		//! Lock the list of waiters (the critical sections are only a few instructions long)
+		inline uint32_t LockWaiters(std::atomic<uint32_t>& state)
+		{
+			uint32_t current = state.load(std::memory_order_relaxed);
+			do
+			{
+				if ((current & stLocked) == 0
+					and state.compare_exchange_weak(current, current | stLocked, std::memory_order_acquire,
+						std::memory_order_relaxed))
+					return current | stLocked;
+				Yuni::Private::Thread::CPUPause();
+				current = state.load(std::memory_order_relaxed);
+			}
+			while (true);
+		}
+
+
+		//! Spin a little while the signal is not notified
+		inline uint32_t Spin(const std::atomic<uint32_t>& state)
+		{
+			uint32_t current = state.load(std::memory_order_acquire);
+			uint count = Yuni::Private::Thread::SpinningIsUseful() ? spinCount : 0;
+			for (uint i = 0; i != count and (current & stNotified) == 0; ++i)
+			{
+				Yuni::Private::Thread::CPUPause();
+				current = state.load(std::memory_order_acquire);
+			}
+			return current;
+		}
+
+
+		//! Mark the signal as having a sleeping thread
+		inline bool MarkAsSleeping(std::atomic<uint32_t>& state, uint32_t& current)
+		{
+			if ((current & stSleeping) != 0)
+				return true;
+			if (state.compare_exchange_weak(current, current | stSleeping, std::memory_order_relaxed))
+			{
+				current |= stSleeping;
+				return true;
+			}
+			return false;
+		}
+
+	} // anonymous namespace
+
+
+
+	Signal::Signal()
+	{}
+
+
+	Signal::Signal(const Signal&)
+	{}
+
+
+	Signal::~Signal()
+	{
+		assert(pWaiters == nullptr and "a signal can not be destroyed while waited");
+	}
+
+
+	bool Signal::reset()
+	{
+		pState.fetch_and(~static_cast<uint32_t>(stNotified), std::memory_order_relaxed);
+		return true;
+	}
+
+
+	void Signal::wait()
+	{
+		uint32_t current = Spin(pState);
+		while ((current & stNotified) == 0)
+		{
+			if (MarkAsSleeping(pState, current))
+			{
+				Yuni::Private::Thread::FutexWait(pState, current);
+				current = pState.load(std::memory_order_acquire);
+			}
+		}
+	}
+
+
+	bool Signal::wait(uint timeout)
+	{
+		uint32_t current = Spin(pState);
+		if ((current & stNotified) != 0)
+			return true;
+
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		do
+		{
+			if (MarkAsSleeping(pState, current))
+			{
+				auto now = std::chrono::steady_clock::now();
+				if (now >= deadline)
+					return false;
+				auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+				Yuni::Private::Thread::FutexWait(pState, current, static_cast<uint>(remaining + 1));
+				current = pState.load(std::memory_order_acquire);
+			}
+		}
+		while ((current & stNotified) == 0);
+		return true;
+	}
+
+
+	void Signal::waitAndReset()
+	{
+		do
+		{
+			wait();
+			uint32_t current = pState.load(std::memory_order_relaxed);
+			while ((current & stNotified) != 0)
+			{
+				// only one thread gets the notification
+				if (pState.compare_exchange_weak(current, current & ~static_cast<uint32_t>(stNotified),
+					std::memory_order_acquire, std::memory_order_relaxed))
+					return;
+			}
+		}
+		while (true);
+	}
+
+
+	bool Signal::wait(Waiter& waiter)
+	{
+		uint32_t current = LockWaiters(pState);
+		if ((current & stNotified) != 0)
+		{
+			pState.fetch_and(~static_cast<uint32_t>(stLocked), std::memory_order_release);
+			return false;
+		}
+		waiter.pNext = pWaiters;
+		pWaiters = &waiter;
+		pState.fetch_or(stWaiters, std::memory_order_relaxed);
+		pState.fetch_and(~static_cast<uint32_t>(stLocked), std::memory_order_release);
+		return true;
+	}
+
+
+	bool Signal::notify()
+	{
+		// fast path: a single CAS, without any system call if no thread is sleeping
+		uint32_t current = pState.load(std::memory_order_relaxed);
+		while ((current & (stWaiters | stLocked)) == 0)
+		{
+			if (pState.compare_exchange_weak(current, stNotified, std::memory_order_release,
+				std::memory_order_relaxed))
+			{
+				if ((current & stSleeping) != 0)
+					Yuni::Private::Thread::FutexWakeAll(pState);
+				return true;
+			}
+		}
+
+		LockWaiters(pState);
+		Waiter* waiters = pWaiters;
+		pWaiters = nullptr;
+		current = pState.exchange(stNotified, std::memory_order_release);
+		if ((current & stSleeping) != 0)
+			Yuni::Private::Thread::FutexWakeAll(pState);
+
+		// the waiters may be released as soon as notified
+		while (waiters)
+		{
+			Waiter* next = waiters->pNext;
+			waiters->pNext = nullptr;
+			waiters->signalled();
+			waiters = next;
+		}
+		return true;
+	}
+
+
+	#else // generic implementation
+
+
 
 	Signal::Signal()
 	{
@@ -76,6 +279,7 @@ namespace Thread
 	Signal::~Signal()
 	{
 		#ifndef YUNI_NO_THREAD_SAFE
+		assert(pWaiters == nullptr and "a signal can not be destroyed while waited");
 		# ifdef YUNI_OS_WINDOWS
 		CloseHandle(pHandle);
 		# else
@@ -238,28 +442,82 @@ namespace Thread
 	}
 
 
+	bool Signal::wait(Waiter& waiter)
+	{
+		#ifndef YUNI_NO_THREAD_SAFE
+		# ifdef YUNI_OS_WINDOWS
+
+		MutexLocker locker(pWaitersMutex);
+		if (not pHandle or WAIT_OBJECT_0 == WaitForSingleObject(pHandle, 0))
+			return false;
+		waiter.pNext = pWaiters;
+		pWaiters = &waiter;
+		return true;
+
+		# else
+
+		::pthread_mutex_lock(&pMutex);
+		bool registered = not pSignalled;
+		if (registered)
+		{
+			waiter.pNext = pWaiters;
+			pWaiters = &waiter;
+		}
+		::pthread_mutex_unlock(&pMutex);
+		return registered;
+
+		# endif
+
+		# else // NO THREADSAFE
+		(void) waiter;
+		return false;
+		# endif
+	}
+
+
 	bool Signal::notify()
 	{
 		#ifndef YUNI_NO_THREAD_SAFE
+		Waiter* waiters;
 		# ifdef YUNI_OS_WINDOWS
 
-		return (pHandle and SetEvent(pHandle));
+		bool result;
+		{
+			MutexLocker locker(pWaitersMutex);
+			result = (pHandle and SetEvent(pHandle));
+			waiters = pWaiters;
+			pWaiters = nullptr;
+		}
 
 		# else
 
 		::pthread_mutex_lock(&pMutex);
 		pSignalled = true;
 		::pthread_cond_signal(&pCondition);
+		waiters = pWaiters;
+		pWaiters = nullptr;
 		::pthread_mutex_unlock(&pMutex);
-		return true;
+		bool result = true;
 
 		# endif
 
+		// the waiters may be released as soon as notified
+		while (waiters)
+		{
+			Waiter* next = waiters->pNext;
+			waiters->pNext = nullptr;
+			waiters->signalled();
+			waiters = next;
+		}
+		return result;
+
 		# else // NO THREADSAFE
 		return true;
 		# endif
 	}
 
+	#endif // futex implementation
+
 
 
 
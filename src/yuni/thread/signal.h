@@ -12,6 +12,13 @@
 #include "../yuni.h"
 #include "../core/smartptr.h"
 #include "pthread.h"
+#ifdef YUNI_OS_WINDOWS
+# include "mutex.h"
+#endif
+#ifdef YUNI_OS_LINUX
+# include <atomic>
+# include <cstdint>
+#endif
 
 
 
@@ -22,6 +29,10 @@ namespace Thread
 
 	/*!
 	** \brief Mecanism for notifying a waiting thread of the occurrence of a particular event
+	**
+	** On Linux, the signal is a single atomic word: the waiting threads spin
+	** briefly then sleep on a futex, and `notify()` only makes a system call
+	** when a thread is actually sleeping.
 	*/
 	class YUNI_DECL Signal final
 	{
@@ -29,6 +40,28 @@ namespace Thread
 		//! Most suitable smart pointer for the class
 		typedef Yuni::SmartPtr<Signal> Ptr;
 
+		/*!
+		** \brief Waiter notified without blocking any thread
+		**
+		** The waiter is called by the thread notifying the signal, without
+		** any lock, and must remain valid until then.
+		*/
+		class YUNI_DECL Waiter
+		{
+		public:
+			//! Destructor
+			virtual ~Waiter() = default;
+
+			//! The signal has been notified
+			virtual void signalled() = 0;
+
+		private:
+			//! Next waiter of the same signal
+			Waiter* pNext = nullptr;
+			// Nakama !
+			friend class Signal;
+		};
+
 
 	public:
 		//! \name Constructor & Destructor
@@ -73,6 +106,15 @@ namespace Thread
 		*/
 		void waitAndReset();
 
+		/*!
+		** \brief Wait for being notified, without blocking the calling thread
+		**
+		** `waiter.signalled()` will be called by the next call to `notify()`
+		** (all waiters are notified at once).
+		** \return False if the signal has already been notified (the waiter is then not registered)
+		*/
+		bool wait(Waiter& waiter);
+
 		/*!
 		** \brief Notify the waiter
 		*/
@@ -106,11 +148,18 @@ namespace Thread
 		# ifdef YUNI_OS_WINDOWS
 		//! Event handle (HANDLE)
 		void* pHandle;
+		//! Mutex for the waiters
+		Mutex pWaitersMutex;
+		# elif defined(YUNI_OS_LINUX)
+		//! State (notified, sleeping threads, waiters, lock of the waiters)
+		std::atomic<uint32_t> pState{0};
 		# else
 		pthread_mutex_t pMutex;
 		pthread_cond_t  pCondition;
 		volatile bool pSignalled;
 		# endif
+		//! Waiters not blocking any thread (single linked list)
+		Waiter* pWaiters = nullptr;
 		#endif
 
 	}; // class Signal
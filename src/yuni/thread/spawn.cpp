@@ -9,6 +9,7 @@
 ** github: https://github.com/libyuni/libyuni/ {mirror}
 */
 #include "../thread/utility.h"
+#include "../private/thread/cache.h"
 #ifdef YUNI_HAS_CPP_MOVE
 # include <utility>
 #endif
@@ -22,7 +23,10 @@ namespace Yuni
 	public:
 		SpawnThread(const Bind<void ()>& callback) :
 			pCallback(callback)
-		{}
+		{
+			// the native thread may be reused (see spawnKeepAlive())
+			useThreadCache();
+		}
 
 		virtual ~SpawnThread()
 		{
@@ -55,4 +59,24 @@ namespace Yuni
 	}
 
 
+	void spawnKeepAlive(uint milliseconds)
+	{
+		# if !defined(YUNI_NO_THREAD_SAFE) && !defined(YUNI_OS_WINDOWS)
+		Yuni::Private::Thread::ThreadCache::KeepAlive(milliseconds);
+		# else
+		(void) milliseconds; // not supported
+		# endif
+	}
+
+
+	uint spawnKeepAlive()
+	{
+		# if !defined(YUNI_NO_THREAD_SAFE) && !defined(YUNI_OS_WINDOWS)
+		return Yuni::Private::Thread::ThreadCache::KeepAlive();
+		# else
+		return 0;
+		# endif
+	}
+
+
 } // namespace Yuni
@@ -19,6 +19,7 @@
 #	endif
 #	include <unistd.h>
 #	include <sys/time.h>
+#	include <sched.h>
 #else
 #	include "../core/system/windows.hdr.h"
 #	include <process.h>
@@ -26,6 +27,7 @@
 #endif
 
 #include "thread.h"
+#include "../private/thread/cache.h"
 #include <limits.h> // for PTHREAD_STACK_MIN
 #include <iostream>
 
@@ -57,7 +59,13 @@
 		{ \
 			if (pThreadIDValid) \
 			{ \
-				::pthread_join(pThreadID, nullptr); \
+				if (0 == pBorrowed.load(std::memory_order_acquire)) \
+					::pthread_join(pThreadID, nullptr); \
+				else \
+				{ \
+					/* the native thread goes back to the cache, it only has to release this object */ \
+					Yuni::Private::Thread::ThreadCache::Join(*this); \
+				} \
 				pThreadIDValid = false; \
 			} \
 		} \
@@ -81,6 +89,60 @@ namespace Thread
 
 	# ifndef YUNI_NO_THREAD_SAFE
 
+	namespace // anonymous
+	{
+
+		# if defined(YUNI_OS_LINUX)
+		bool setAffinity(pthread_t thread, const std::vector<uint>& processors)
+		{
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			if (processors.empty())
+			{
+				for (uint i = 0; i != CPU_SETSIZE; ++i)
+					CPU_SET(i, &set);
+			}
+			else
+			{
+				for (uint id: processors)
+				{
+					if (id < CPU_SETSIZE)
+						CPU_SET(id, &set);
+				}
+			}
+			return 0 == ::pthread_setaffinity_np(thread, sizeof(set), &set);
+		}
+
+		# elif defined(YUNI_OS_WINDOWS)
+		bool setAffinity(HANDLE thread, const std::vector<uint>& processors)
+		{
+			DWORD_PTR mask = 0;
+			if (processors.empty())
+			{
+				DWORD_PTR systemMask;
+				if (not GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask))
+					return false;
+			}
+			else
+			{
+				for (uint id: processors)
+				{
+					if (id < sizeof(DWORD_PTR) * 8)
+						mask |= (static_cast<DWORD_PTR>(1) << id);
+				}
+			}
+			return mask != 0 and 0 != SetThreadAffinityMask(thread, mask);
+		}
+
+		# else
+		template<class T> bool setAffinity(T, const std::vector<uint>&)
+		{
+			return false; // not supported
+		}
+		# endif
+
+	} // anonymous namespace
+
 	/*!
 	** \brief This procedure will be run in a separate thread and will run IThread::onExecute()
 	*/
@@ -105,6 +167,19 @@ namespace Thread
 		::pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
 		# endif
 
+		// restricting the thread to some processors, before any user code
+		{
+			Yuni::MutexLocker flagLocker(thread.pInnerFlagMutex);
+			if (not thread.pAffinity.empty())
+			{
+				# ifdef YUNI_OS_WINDOWS
+				setAffinity(GetCurrentThread(), thread.pAffinity);
+				# else
+				setAffinity(::pthread_self(), thread.pAffinity);
+				# endif
+			}
+		}
+
 		if (thread.onStarting())
 		{
 			// onStarting authorized us to continue. So say we are now running.
@@ -267,20 +342,31 @@ namespace Thread
 			this, 0, nullptr);
 		if (not pThreadHandle)
 		# else
-		// Thread attributes
-		pthread_attr_t attr;
-		pthread_attr_init(&attr);
-		// reset the thread stack size
-		# ifdef YUNI_HAS_PTHREAD_ATTR_SETSTACKSIZE
-		if (0 != pthread_attr_setstacksize(&attr, pStackSize * 1024))
-			std::cerr << "Yuni::Thread: impossible to set thread stack size to " << (pStackSize * 1024) << " bytes" << std::endl;
-		# endif
-		// Lock the startup condition before creating the thread,
-		// then wait for it. The thread will signal the condition when it
-		// successfully have set isRunning _and_ called the triggers.
-		// Then we can check the isRunning status and determine if the startup
-		// was a success or not.
-		pThreadIDValid = (0 == ::pthread_create(&pThreadID, &attr, Yuni::Private::Thread::threadCallbackExecute, this));
+		if (pUseThreadCache and Yuni::Private::Thread::ThreadCache::Enabled())
+		{
+			// a native thread from the cache (created if none is available)
+			pBorrowed.store(1, std::memory_order_relaxed);
+			pThreadIDValid = Yuni::Private::Thread::ThreadCache::Start(*this, pStackSize * 1024, pThreadID);
+			if (not pThreadIDValid)
+				pBorrowed.store(0, std::memory_order_relaxed);
+		}
+		else
+		{
+			// Thread attributes
+			pthread_attr_t attr;
+			pthread_attr_init(&attr);
+			// reset the thread stack size
+			# ifdef YUNI_HAS_PTHREAD_ATTR_SETSTACKSIZE
+			if (0 != pthread_attr_setstacksize(&attr, pStackSize * 1024))
+				std::cerr << "Yuni::Thread: impossible to set thread stack size to " << (pStackSize * 1024) << " bytes" << std::endl;
+			# endif
+			// Lock the startup condition before creating the thread,
+			// then wait for it. The thread will signal the condition when it
+			// successfully have set isRunning _and_ called the triggers.
+			// Then we can check the isRunning status and determine if the startup
+			// was a success or not.
+			pThreadIDValid = (0 == ::pthread_create(&pThreadID, &attr, Yuni::Private::Thread::threadCallbackExecute, this));
+		}
 		if (not pThreadIDValid)
 		# endif
 		{
@@ -356,7 +442,8 @@ namespace Thread
 			if (pThreadHandle)
 				TerminateThread(pThreadHandle, 0);
 			# else
-			if (pThreadIDValid)
+			// (a native thread from the cache is never killed, see useThreadCache())
+			if (pThreadIDValid and 0 == pBorrowed.load(std::memory_order_acquire))
 				::pthread_cancel(pThreadID);
 			# endif
 			// Stopping the native thread - we should call onKill after that the
@@ -466,6 +553,46 @@ namespace Thread
 	}
 
 
+	bool IThread::affinity(const std::vector<uint>& processors)
+	{
+		# ifndef YUNI_NO_THREAD_SAFE
+		Yuni::MutexLocker flagLocker(pInnerFlagMutex);
+		pAffinity = processors;
+		if (not pStarted)
+		{
+			# if defined(YUNI_OS_LINUX) || defined(YUNI_OS_WINDOWS)
+			return true;
+			# else
+			return false;
+			# endif
+		}
+		# ifdef YUNI_OS_WINDOWS
+		return pThreadHandle and Yuni::Private::Thread::setAffinity(pThreadHandle, processors);
+		# else
+		return pThreadIDValid and Yuni::Private::Thread::setAffinity(pThreadID, processors);
+		# endif
+		# else // YUNI_NO_THREAD_SAFE
+		pAffinity = processors;
+		return false;
+		# endif
+	}
+
+
+	std::vector<uint> IThread::affinity() const
+	{
+		# ifndef YUNI_NO_THREAD_SAFE
+		Yuni::MutexLocker flagLocker(pInnerFlagMutex);
+		# endif
+		return pAffinity;
+	}
+
+
+	void IThread::useThreadCache(bool enabled)
+	{
+		pUseThreadCache = enabled;
+	}
+
+
 	Error IThread::restart(uint timeout)
 	{
 		assert(timeout < INVALID_TIMEOUT and "Invalid range for timeout, IThread::restart");
@@ -14,6 +14,7 @@
 #include "signal.h"
 #include "../core/string.h"
 #include <vector>
+#include <atomic>
 #include "fwd.h"
 #include "../core/noncopyable.h"
 #include "../core/smartptr/intrusive.h"
@@ -103,6 +104,10 @@ namespace Thread
 		/*!
 		** \brief Stop the execution of the thread and wait for it, if not already stopped
 		**
+		** A thread running from the cache of native threads (see `useThreadCache()`)
+		** can not be killed: once the timeout has been reached, this method still waits
+		** for `onExecute()` to return (and returns `errTimeout`).
+		**
 		** \param timeout The timeout in milliseconds before killing the thread (default: 5000ms)
 		** \return An error status (`errNone` if succeeded)
 		*/
@@ -188,6 +193,25 @@ namespace Thread
 		//@}
 
 
+		//! \name Affinity
+		//@{
+		/*!
+		** \brief Restrict the thread to some logical processors
+		**
+		** The affinity is applied when the thread starts, or immediately if the thread
+		** is already running. This is only supported on Linux and Windows.
+		**
+		** \param processors Operating system indexes of the processors (see `System::CPU::Topology`),
+		**   empty for no restriction
+		** \return True if the affinity is supported and could be applied (if running)
+		*/
+		bool affinity(const std::vector<uint>& processors);
+
+		//! Get the processors the thread is restricted to (empty if none)
+		std::vector<uint> affinity() const;
+		//@}
+
+
 		//! \name Operators
 		//@{
 		//! Get if the thread is currently stopped
@@ -260,6 +284,17 @@ namespace Thread
 		*/
 		virtual void onKill() {}
 
+		/*!
+		** \brief Run the thread from a cache of native threads (see `spawnKeepAlive()`)
+		**
+		** When the cache is enabled, starting the thread borrows a native thread
+		** already created, which is parked again for another thread once this
+		** one has stopped. Such a thread is never killed: `stop()` waits for
+		** `onExecute()` to return, even after the timeout (POSIX only, ignored on Windows).
+		** This method must be called before starting the thread.
+		*/
+		void useThreadCache(bool enabled = true);
+
 
 	private:
 		# ifndef YUNI_NO_THREAD_SAFE
@@ -277,8 +312,8 @@ namespace Thread
 		Signal pSignalMustStop;
 		//! The thread can wake up
 		Signal pSignalWakeUp;
-		//! Mutex for protecting pShouldStop and pStarted
-		Mutex pInnerFlagMutex;
+		//! Mutex for protecting pShouldStop, pStarted and pAffinity
+		mutable Mutex pInnerFlagMutex;
 
 		# ifdef YUNI_OS_WINDOWS
 		void* pThreadHandle;
@@ -288,9 +323,13 @@ namespace Thread
 		//! Flag to determine whether pThreadID is valid or not
 		// There is no portable value to determine if pThreadID is valid or not. We have to use a separate flag
 		bool pThreadIDValid;
+		//! Native thread borrowed from the cache: 0 (no), 1 (in use), 2 (released), 3 (in use, joined)
+		std::atomic<uint32_t> pBorrowed {0};
 		# endif // YUNI_OS_WINDOWS
 		# endif // YUNI_NO_THREAD_SAFE
 
+		//! Processors the thread is restricted to (must be protected by pInnerFlagMutex)
+		std::vector<uint> pAffinity;
 		//! Get if the thread is running (must be protected by pInnerFlagMutex)
 		volatile bool pStarted;
 		# ifndef YUNI_NO_THREAD_SAFE
@@ -302,11 +341,14 @@ namespace Thread
 		//! Thread stack size
 		const uint pStackSize;
 		# endif
+		//! Use the cache of native threads
+		bool pUseThreadCache = false;
 
 		# ifndef YUNI_NO_THREAD_SAFE
 		// our friend
 		friend class Yuni::Job::IJob;
 		friend YUNI_THREAD_FNC_RETURN Yuni::Private::Thread::threadCallbackExecute(void* arg);
+		friend class Yuni::Private::Thread::ThreadCache;
 		# endif
 
 	}; // class IThread
@@ -12,8 +12,11 @@
 #include "../yuni.h"
 #include "timer.h"
 #include "../job/job.h"
+#include "../job/timer/service.h"
 #include "../core/bind.h"
 #include <memory>
+#include <vector>
+#include <type_traits>
 
 namespace Yuni { namespace Job { class QueueService; }}
 namespace Yuni { namespace Job { class Taskgroup; }}
@@ -62,11 +65,39 @@ namespace Yuni
 	*/
 	std::unique_ptr<Thread::IThread> spawn(const Bind<void ()>& callback, bool autostart = true);
 
+	/*!
+	** \brief Set how long the native threads of `spawn()` are kept for reuse
+	**
+	** Once the callback has returned, the native thread is parked for the
+	** keep-alive delay, and reused by the next call to `spawn()` instead of
+	** creating a new one (at most 64 parked threads). The returned thread
+	** behaves as before, except that it is never killed by `stop()`.
+	** Disabled by default (POSIX only).
+	**
+	** \code
+	** spawnKeepAlive(30000); // 30s
+	** for (uint i = 0; i != 1000; ++i)
+	**	spawn([&] () { ... })->wait(); // a single native thread
+	** \endcode
+	**
+	** \param milliseconds The keep-alive delay (0 to not reuse the threads)
+	*/
+	void spawnKeepAlive(uint milliseconds);
+
+	//! Get how long the native threads of `spawn()` are kept for reuse (ms, see above)
+	uint spawnKeepAlive();
+
 
 	/*!
 	** \brief Convenient wrapper for executing some code every X milliseconds
 	**
-	** The code will be executed into another thread.
+	** The code will be executed into another thread, dedicated to this timer
+	** (see `every(Job::QueueService&, ...)` for a lightweight timer).
+	**
+	** \note This variant does not use the timer wheel of `Job::TimerService`: the
+	**   timer returned is a thread, controlled with `start()`, `stop()`, `reload()`...
+	**   and the callback may block as long as needed without delaying any other
+	**   timer. The wheel dispatches the callbacks to a queueservice instead.
 	** From sample:
 	** \code
 	** #include <yuni/yuni.h>
@@ -99,7 +130,8 @@ namespace Yuni
 	** \brief Convenient wrapper for executing some code every X milliseconds and
 	** getting the time elapsed between each tick
 	**
-	** The code will be executed into another thread.
+	** The code will be executed into another thread, dedicated to this timer
+	** (see the note of `every(uint, const Bind<bool ()>&, bool)`).
 	** \code
 	** #include <yuni/yuni.h>
 	** #include <yuni/thread/thread.h>
@@ -127,6 +159,32 @@ namespace Yuni
 	std::unique_ptr<Thread::Timer> every(uint ms, bool precise, const Bind<bool (uint64 /*elapsed*/)>& callback, bool autostart = true);
 
 
+	/*!
+	** \brief Convenient wrapper for executing some code every X milliseconds, as a job
+	**
+	** Contrary to the other variants, no thread is created for the timer: all
+	** these timers share the single thread of the timer service, which dispatches
+	** the callback to the queueservice when due.
+	** \code
+	** Job::QueueService queueservice;
+	** queueservice.start();
+	**
+	** auto timer = every(queueservice, 1000, [&] () -> bool {
+	**	std::cout << "tick" << std::endl;
+	**	return true; // continue looping
+	** });
+	** ...
+	** timer->cancel();
+	** \endcode
+	**
+	** \param queueservice The queueservice where to execute the callback
+	** \param ms An amount of time, in milliseconds
+	** \param callback The callback to execute
+	** \return The timer (releasing it does not stop the timer, see `cancel()`)
+	*/
+	Job::TimerService::Timer::Ptr every(Job::QueueService& queueservice, uint ms, const Bind<bool ()>& callback);
+
+
 	/*!
 	** \brief Convenient wrapper for executing a new job
 	**
@@ -154,6 +212,32 @@ namespace Yuni
 	Job::IJob::Ptr  async(Job::QueueService& queueservice, const Bind<void ()>& callback);
 
 
+	/*!
+	** \brief Convenient wrapper for executing a new job from a lambda, without any heap allocation
+	**
+	** The lambda is stored within the job itself, which is allocated from a per-thread
+	** pool and recycled once the job is destroyed. Lambdas larger than a few dozen
+	** bytes (or over-aligned) are still accepted, but fall back to the global allocator.
+	**
+	** \param queueservice The queueservice to dispatch the new job
+	** \param callback The callback to execute (any callable object without argument)
+	*/
+	template<class C, class = typename std::enable_if<
+		not std::is_same<typename std::decay<C>::type, Bind<void ()>>::value
+		and std::is_invocable<typename std::decay<C>::type&>::value>::type>
+	Job::IJob::Ptr  async(Job::QueueService& queueservice, C&& callback);
+
+
+	/*!
+	** \brief Convenient wrapper for executing several new jobs at once
+	**
+	** All jobs are added to the queue with a single lock acquisition.
+	** \param queueservice The queueservice to dispatch the new jobs
+	** \param callbacks The callbacks to execute
+	*/
+	void async(Job::QueueService& queueservice, const std::vector<Bind<void ()>>& callbacks);
+
+
 	/*!
 	** \brief Convenient wrapper for creating a job from a lambda
 	**
@@ -172,3 +256,5 @@ namespace Yuni
 
 
 } // namespace Yuni
+
+#include "utility.hxx"
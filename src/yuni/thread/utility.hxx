@@ -0,0 +1,38 @@
+/*
+** This file is part of libyuni, a cross-platform C++ framework (http://libyuni.org).
+**
+** This Source Code Form is subject to the terms of the Mozilla Public License
+** v.2.0. If a copy of the MPL was not distributed with this file, You can
+** obtain one at http://mozilla.org/MPL/2.0/.
+**
+** gitlab: https://gitlab.com/libyuni/libyuni/
+** github: https://github.com/libyuni/libyuni/ {mirror}
+*/
+#pragma once
+#include "utility.h"
+#include "../job/queue/service.h"
+#include "../private/jobs/lambda.h"
+
+
+
+namespace Yuni
+{
+
+	template<class C, class>
+	inline Job::IJob::Ptr  async(Job::QueueService& queueservice, C&& callback)
+	{
+		typedef typename std::decay<C>::type CallbackType;
+		if constexpr (alignof(CallbackType) <= Private::Jobs::JobPool::alignment)
+		{
+			Job::IJob::Ptr job = new Private::Jobs::LambdaJob<CallbackType>(std::forward<C>(callback));
+			queueservice.add(job);
+			return job;
+		}
+		else
+			return async(queueservice, Bind<void ()>(std::forward<C>(callback)));
+	}
+
+
+
+
+} // namespace Yuni